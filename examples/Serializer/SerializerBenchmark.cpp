@@ -0,0 +1,106 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  SerializerBenchmark.cpp
+ * @brief Benchmark of the cdr and fixed_cdr serializers
+ * $Date$
+ *
+ * $Id$
+ */
+
+#include <rtm/idl/BasicDataTypeSkel.h>
+#include <rtm/idl/ExtendedDataTypesSkel.h>
+#include <rtm/CORBA_CdrMemoryStream.h>
+#include <rtm/FixedLayoutSerializer.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+//シリアライズ、送信バッファへのコピー、受信側への書き込み、デシリアライズの
+//1サンプルあたりの時間を計測する
+template <class DataType>
+double measure(RTC::ByteDataStream<DataType>& out,
+               RTC::ByteDataStream<DataType>& in,
+               const DataType& data, bool little_endian, long count)
+{
+    std::vector<unsigned char> buffer;
+    DataType result;
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < count; ++i)
+    {
+        out.isLittleEndian(little_endian);
+        out.serialize(data);
+        buffer.resize(out.getDataLength());
+        out.readData(buffer.data(), static_cast<unsigned long>(buffer.size()));
+        in.isLittleEndian(little_endian);
+        in.writeData(buffer.data(), static_cast<unsigned long>(buffer.size()));
+        in.deserialize(result);
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / count;
+}
+
+template <class DataType>
+void benchmark(const std::string& name, const DataType& data, long count)
+{
+    for (bool little_endian : {true, false})
+    {
+        RTC::CORBA_CdrSerializer<DataType> cdr_out, cdr_in;
+        RTC::FixedLayoutSerializer<DataType> fixed_out, fixed_in;
+        double cdr = measure<DataType>(cdr_out, cdr_in, data, little_endian, count);
+        double fixed = measure<DataType>(fixed_out, fixed_in, data, little_endian, count);
+        std::cout << std::left << std::setw(14) << name
+                  << std::setw(8) << (little_endian ? "little" : "big")
+                  << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(10) << cdr << " ns"
+                  << std::setw(10) << fixed << " ns"
+                  << "  memcpy: "
+                  << (RTC::FixedLayoutSerializer<DataType>::cdrLength() != 0 ? "yes" : "no")
+                  << std::endl;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    long count = argc > 1 ? std::atol(argv[1]) : 1000000;
+    if (count <= 0)
+    {
+        std::cerr << "usage: " << argv[0] << " [samples]" << std::endl;
+        return 1;
+    }
+
+    std::cout << std::left << std::setw(14) << "type"
+              << std::setw(8) << "endian"
+              << std::right << std::setw(13) << "cdr"
+              << std::setw(13) << "fixed_cdr" << std::endl;
+
+    RTC::TimedDouble timed_double;
+    timed_double.tm.sec = 1;
+    timed_double.tm.nsec = 2;
+    timed_double.data = 3.0;
+    benchmark("TimedDouble", timed_double, count);
+
+    RTC::TimedPose2D timed_pose2d;
+    timed_pose2d.tm.sec = 1;
+    timed_pose2d.tm.nsec = 2;
+    timed_pose2d.data.position.x = 3.0;
+    timed_pose2d.data.position.y = 4.0;
+    timed_pose2d.data.heading = 5.0;
+    benchmark("TimedPose2D", timed_pose2d, count);
+
+    RTC::TimedPose3D timed_pose3d;
+    timed_pose3d.tm.sec = 1;
+    timed_pose3d.tm.nsec = 2;
+    timed_pose3d.data.position.x = 3.0;
+    timed_pose3d.data.position.y = 4.0;
+    timed_pose3d.data.position.z = 5.0;
+    timed_pose3d.data.orientation.r = 6.0;
+    timed_pose3d.data.orientation.p = 7.0;
+    timed_pose3d.data.orientation.y = 8.0;
+    benchmark("TimedPose3D", timed_pose3d, count);
+
+    return 0;
+}
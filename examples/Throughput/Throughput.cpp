@@ -38,6 +38,7 @@ static const char* const throughput_spec[] =
     "conf.default.maxsize", "1000000",
     "conf.default.maxsend", "1000",
     "conf.default.maxsample", "100",
+    "conf.default.bytedata_pool", "on",
 
     // Widget
     "conf.__widget__.datatype", "radio",
@@ -48,9 +49,11 @@ static const char* const throughput_spec[] =
     "conf.__widget__.maxsize", "text",
     "conf.__widget__.maxsend", "text",
     "conf.__widget__.maxsample", "text",
+    "conf.__widget__.bytedata_pool", "radio",
     // Constraints
     "conf.__constraints__.datatype", "(octet,short,long,float,double)",
     "conf.__constraints__.mode", "(logincr,incr,const)",
+    "conf.__constraints__.bytedata_pool", "(on,off)",
 
     "conf.__type__.datatype", "string",
     "conf.__type__.outputfile", "string",
@@ -60,6 +63,7 @@ static const char* const throughput_spec[] =
     "conf.__type__.maxsize", "long",
     "conf.__type__.maxsend", "long",
     "conf.__type__.maxsample", "long",
+    "conf.__type__.bytedata_pool", "string",
 
     ""
   };
@@ -77,7 +81,7 @@ Throughput::Throughput(RTC::Manager* manager)
     // Configuration parameters
     m_datatype("double"), m_outputfile("throughput.dat"),
     m_increment(100), m_mode("logincr"), m_maxsize(100000000),
-    m_maxsend(1000), m_maxsample(100),
+    m_maxsend(1000), m_maxsample(100), m_bytedata_pool("on"),
 
     // InPort, OutPort
     m_inOctetIn("in", m_inOctet),   m_outOctetOut("out", m_outOctet),
@@ -189,6 +193,7 @@ RTC::ReturnCode_t Throughput::onInitialize()
   bindParameter("maxsize", m_maxsize, "100000");
   bindParameter("maxsend", m_maxsend, "1000");
   bindParameter("maxsample", m_maxsample, "100");
+  bindParameter("bytedata_pool", m_bytedata_pool, "on");
   // </rtc-template>
 
   m_record.reserve(m_maxsample);
@@ -203,6 +208,9 @@ RTC::ReturnCode_t Throughput::onActivated(RTC::UniqueId  /*ec_id*/)
   m_sendcount = 0;
   m_logmulcnt = 0;
 
+  RTC::ByteData::setPoolEnabled(coil::normalize(m_bytedata_pool) != "off");
+  m_poolstats = RTC::ByteData::getPoolStatistics();
+
   return RTC::RTC_OK;
 }
 
@@ -449,18 +457,31 @@ void Throughput::receiveData(const RTC::Time &tm, const CORBA::ULong seq_length)
       // Time tm (long, long) = 4byte + 4byte [Mbps]
       throughput = ((((size * m_varsize) + 8) * 8) / mean_latency) / (1024 * 1024);
 
-      // size[byte], min[s], max[s], mean[s], stddev[s], throughpiut[Mbps]
+      // ByteData heap allocations and copied bytes per sample
+      RTC::ByteDataPoolStatistics stats(RTC::ByteData::getPoolStatistics());
+      double allocs(static_cast<double>(stats.heap_allocations
+                                        - m_poolstats.heap_allocations)
+                    / record_num);
+      double copies(static_cast<double>(stats.copied_bytes
+                                        - m_poolstats.copied_bytes)
+                    / record_num / ((size * m_varsize) + 8));
+      m_poolstats = stats;
+
+      // size[byte], min[s], max[s], mean[s], stddev[s], throughpiut[Mbps],
+      // allocs/sample, copies/sample
       m_fs << size << "\t";
       m_fs << min_latency << "\t" << max_latency << "\t";
       m_fs << mean_latency << "\t" << stddev << "\t";
-      m_fs << throughput << std::endl;
+      m_fs << throughput << "\t";
+      m_fs << allocs << "\t" << copies << std::endl;
 
 #ifdef DEBUG
       std::cout << "==============================" << std::endl;
       std::cout << size << "\t";
       std::cout << min_latency << "\t" << max_latency << "\t";
       std::cout << mean_latency << "\t" << stddev << "\t";
-      std::cout << throughput << std::endl;
+      std::cout << throughput << "\t";
+      std::cout << allocs << "\t" << copies << std::endl;
 #endif // DEBUG
       // reset size/index variables
       record_num = 0;
@@ -511,6 +532,7 @@ void Throughput::setConnectorProfile(const RTC::ConnectorInfo &info)
 
   // print header
   m_fs << "size[byte]\tmin[s]\tmax[s]\tmean[s]\tstddev[s]\tthroughpiut[Mbps]";
+  m_fs << "\tallocs/sample\tcopies/sample";
   m_fs << std::endl;
   m_record.resize(m_maxsample);
 
@@ -35,6 +35,7 @@
 #include <rtm/CorbaPort.h>
 #include <rtm/DataInPort.h>
 #include <rtm/DataOutPort.h>
+#include <rtm/ByteData.h>
 
 #include <vector>
 #include <fstream>
@@ -353,6 +354,14 @@ class Throughput
    */
   unsigned long m_maxsample;
 
+  /*!
+   * ByteData のメモリプールを使用するか(on)、しないか(off)の設定
+   *
+   * - Name: bytedata_pool bytedata_pool
+   * - DefaultValue: on
+   */
+  std::string m_bytedata_pool;
+
   // </rtc-template>
 
   // OutPort, InPort declaration
@@ -413,6 +422,8 @@ class Throughput
   // data size to be send
   unsigned long m_datasize;
   std::vector<std::chrono::nanoseconds> m_record;
+  // ByteData pool statistics at the beginning of the data set
+  RTC::ByteDataPoolStatistics m_poolstats;
 
   // received data store
   size_t m_sendcount;
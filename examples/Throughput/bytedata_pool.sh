@@ -0,0 +1,26 @@
+#!/bin/bash
+
+DATATYPES="octet double"
+
+#------------------------------------------------------------
+# corba_cdr with two component with same proc,
+# ByteData memory pool enabled/disabled
+#------------------------------------------------------------
+for p in on off ; do
+    for d in $DATATYPES ; do
+        cat <<EOF2 > tmp.conf
+logger.enable: NO
+corba.args: -ORBgiopMaxMsgSize 209715200
+manager.components.precreate: Throughput
+manager.components.preconnect: Throughput0.out:Throughput1.in(dataflow_type=push&interface_type=corba_cdr
+manager.components.preactivation: Throughput0, Throughput1
+example.Throughput.conf.default.maxsize: 100000000
+example.Throughput.conf.default.datatype: ${d}
+example.Throughput.conf.default.bytedata_pool: ${p}
+example.Throughput.conf.default.filesuffix: -pool_${p}
+
+EOF2
+        ./ThroughputComp -f tmp.conf
+    done
+done
+rm -f tmp.conf
@@ -0,0 +1,656 @@
+﻿// -*- C++ -*-
+/*!
+ * @file DataTriggeredEC.cpp
+ * @brief DataTriggeredEC class
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <algorithm>
+#include <iterator>
+
+#include <coil/stringutil.h>
+
+#include <rtm/ECFactory.h>
+#include <rtm/InPortBase.h>
+#include <rtm/RTObject.h>
+#include <rtm/RTObjectStateMachine.h>
+#include "DataTriggeredEC.h"
+
+namespace RTC_exp
+{
+  /*!
+   * @if jp
+   * @brief コンストラクタ
+   * @else
+   * @brief Constructor
+   * @endif
+   */
+  DataTriggeredEC::DataTriggeredEC()
+    : ExecutionContextBase("data_triggered_ec")
+  {
+    RTC_TRACE(("DataTriggeredEC()"));
+
+    // getting my reference
+    setObjRef(this->_this());
+
+    // profile initialization
+    setKind(RTC::EVENT_DRIVEN);
+    setRate(DEFAULT_EXECUTION_RATE);
+
+    RTC_DEBUG(("Actual period: %lld [nsec]", m_profile.getPeriod().count()));
+  }
+
+  /*!
+   * @if jp
+   * @brief デストラクタ
+   * @else
+   * @brief Destructor
+   * @endif
+   */
+  DataTriggeredEC::~DataTriggeredEC()
+  {
+    RTC_TRACE(("~DataTriggeredEC()"));
+    unbindTriggers(nullptr);
+    {
+      std::lock_guard<std::mutex> guard(m_svcmutex);
+      m_svc = false;
+    }
+    tick();
+    wait();
+  }
+
+  /*!
+   * @if jp
+   * @brief ExecutionContextの初期化を行う
+   * @else
+   * @brief Initialize the ExecutionContext
+   * @endif
+   */
+  void DataTriggeredEC::init(coil::Properties& props)
+  {
+    RTC_TRACE(("init()"));
+    ExecutionContextBase::init(props);
+
+    m_ports = coil::split(coil::eraseBlank(props["trigger.ports"]), ",", true);
+    m_all = coil::normalize(props["trigger.mode"]) == "all";
+    double interval(0.0);
+    if (!props["trigger.min_interval"].empty() &&
+        coil::stringTo(interval, props["trigger.min_interval"].c_str()) &&
+        interval > 0.0)
+      {
+        m_minInterval = std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::duration<double>(interval));
+      }
+    RTC_DEBUG(("trigger.ports: %s, trigger.mode: %s, "
+               "trigger.min_interval: %f [s]",
+               props["trigger.ports"].c_str(), m_all ? "all" : "any",
+               interval));
+    RTC_DEBUG(("init() done"));
+  }
+
+  /*------------------------------------------------------------
+   * Start activity
+   * ACE_Task class method over ride.
+   *------------------------------------------------------------*/
+  /*!
+   * @if jp
+   * @brief ExecutionContext用アクティビティスレッドを生成する
+   * @else
+   * @brief Generate internal activity thread for ExecutionContext
+   * @endif
+   */
+  int DataTriggeredEC::open(void * /*args*/)
+  {
+    RTC_TRACE(("open()"));
+    activate();
+    return 0;
+  }
+
+  /*!
+   * @if jp
+   * @brief 各 Component の処理を呼び出す。
+   *
+   * データの到着または状態遷移を待ち、min_interval を満たしてから到着
+   * 済みのフラグを下ろして実行する。実行中の到着は次の実行を起こす。
+   *
+   * @else
+   * @brief Invoke each component's operation
+   *
+   * Waits for a data arrival or a state transition, and executes after
+   * clearing the arrived flags once min_interval is satisfied. An
+   * arrival during the execution causes the next execution.
+   *
+   * @endif
+   */
+  int DataTriggeredEC::svc()
+  {
+    RTC_TRACE(("svc()"));
+    auto last = std::chrono::steady_clock::now() - m_minInterval;
+    do
+      {
+        {
+          std::unique_lock<std::mutex> guard(m_worker.mutex_);
+          m_worker.cond_.wait(guard, [this] { return ready(); });
+          if (!m_worker.ticked_)
+            {
+              // the arrivals until then are coalesced
+              m_worker.cond_.wait_until(guard, last + m_minInterval,
+                                        [this] { return m_worker.ticked_; });
+            }
+          m_worker.ticked_ = false;
+          for (auto& trigger : m_triggers)
+            {
+              trigger->m_arrived.store(false, std::memory_order_release);
+            }
+        }
+        if (!threadRunning()) { break; }
+        if (!isRunning()) { continue; }
+
+        last = std::chrono::steady_clock::now();
+        ExecutionContextBase::invokeWorkerPreDo();
+        ExecutionContextBase::invokeWorkerDo();
+        ExecutionContextBase::invokeWorkerPostDo();
+      } while (threadRunning());
+
+    RTC_DEBUG(("Thread terminated."));
+    return 0;
+  }
+
+  /*!
+   * @if jp
+   * @brief ExecutionContext 用のスレッド実行関数
+   * @else
+   * @brief Thread execution function for ExecutionContext
+   * @endif
+   */
+  int DataTriggeredEC::close(unsigned long  /*flags*/)
+  {
+    RTC_TRACE(("close()"));
+    // At this point, this component have to be finished.
+    // Current state and Next state should be RTC_EXITING.
+    return 0;
+  }
+
+  //============================================================
+  // ExecutionContextService
+  //============================================================
+  /*!
+   * @if jp
+   * @brief ExecutionContext 実行状態確認関数
+   * @else
+   * @brief Check for ExecutionContext running state
+   * @endif
+   */
+  CORBA::Boolean DataTriggeredEC::is_running()
+  {
+    return ExecutionContextBase::isRunning();
+  }
+
+  /*!
+   * @if jp
+   * @brief ExecutionContext の実行を開始
+   * @else
+   * @brief Start the ExecutionContext
+   * @endif
+   */
+  RTC::ReturnCode_t DataTriggeredEC::start()
+  {
+    return ExecutionContextBase::start();
+  }
+
+  /*!
+   * @if jp
+   * @brief ExecutionContext の実行を停止
+   * @else
+   * @brief Stop the ExecutionContext
+   * @endif
+   */
+  RTC::ReturnCode_t DataTriggeredEC::stop()
+  {
+    return ExecutionContextBase::stop();
+  }
+
+  /*!
+   * @if jp
+   * @brief ExecutionContext の実行周期(Hz)を取得する
+   * @else
+   * @brief Get execution rate(Hz) of ExecutionContext
+   * @endif
+   */
+  CORBA::Double DataTriggeredEC::get_rate()
+  {
+    return ExecutionContextBase::getRate();
+  }
+
+  /*!
+   * @if jp
+   * @brief ExecutionContext の実行周期(Hz)を設定する
+   * @else
+   * @brief Set execution rate(Hz) of ExecutionContext
+   * @endif
+   */
+  RTC::ReturnCode_t DataTriggeredEC::set_rate(CORBA::Double rate)
+  {
+    return ExecutionContextBase::setRate(rate);
+  }
+
+  /*!
+   * @if jp
+   * @brief RTコンポーネントを追加する
+   * @else
+   * @brief Add an RT-Component
+   * @endif
+   */
+  RTC::ReturnCode_t
+  DataTriggeredEC::add_component(RTC::LightweightRTObject_ptr comp)
+  {
+    return ExecutionContextBase::addComponent(comp);
+  }
+
+  /*!
+   * @if jp
+   * @brief コンポーネントをコンポーネントリストから削除する
+   * @else
+   * @brief Remove the RT-Component from participant list
+   * @endif
+   */
+  RTC::ReturnCode_t DataTriggeredEC::
+  remove_component(RTC::LightweightRTObject_ptr comp)
+  {
+    return ExecutionContextBase::removeComponent(comp);
+  }
+
+  /*!
+   * @if jp
+   * @brief RTコンポーネントをアクティブ化する
+   * @else
+   * @brief Activate an RT-Component
+   * @endif
+   */
+  RTC::ReturnCode_t DataTriggeredEC::
+  activate_component(RTC::LightweightRTObject_ptr comp)
+  {
+    return ExecutionContextBase::activateComponent(comp);
+  }
+
+  /*!
+   * @if jp
+   * @brief RTコンポーネントを非アクティブ化する
+   * @else
+   * @brief Deactivate an RT-Component
+   * @endif
+   */
+  RTC::ReturnCode_t DataTriggeredEC::
+  deactivate_component(RTC::LightweightRTObject_ptr comp)
+  {
+    return ExecutionContextBase::deactivateComponent(comp);
+  }
+
+  /*!
+   * @if jp
+   * @brief RTコンポーネントをリセットする
+   * @else
+   * @brief Reset the RT-Component
+   * @endif
+   */
+  RTC::ReturnCode_t DataTriggeredEC::
+  reset_component(RTC::LightweightRTObject_ptr comp)
+  {
+    return ExecutionContextBase::resetComponent(comp);
+  }
+
+  /*!
+   * @if jp
+   * @brief RTコンポーネントの状態を取得する
+   * @else
+   * @brief Get RT-Component's state
+   * @endif
+   */
+  RTC::LifeCycleState DataTriggeredEC::
+  get_component_state(RTC::LightweightRTObject_ptr comp)
+  {
+    return ExecutionContextBase::getComponentState(comp);
+  }
+
+  /*!
+   * @if jp
+   * @brief ExecutionKind を取得する
+   * @else
+   * @brief Get the ExecutionKind
+   * @endif
+   */
+  RTC::ExecutionKind DataTriggeredEC::get_kind()
+  {
+    return ExecutionContextBase::getKind();
+  }
+
+  /*!
+   * @if jp
+   * @brief ExecutionContextProfile を取得する
+   * @else
+   * @brief Get the ExecutionContextProfile
+   * @endif
+   */
+  RTC::ExecutionContextProfile* DataTriggeredEC::get_profile()
+  {
+    return ExecutionContextBase::getProfile();
+  }
+
+  //============================================================
+  // protected functions
+  //============================================================
+  /*!
+   * @brief onStarted() template function
+   */
+  RTC::ReturnCode_t DataTriggeredEC::onStarted()
+  {
+    // change EC thread state
+    std::lock_guard<std::mutex> guard(m_svcmutex);
+    if (!m_svc)
+      { // If start() is called first time, start the worker thread.
+        m_svc = true;
+        this->open(nullptr);
+      }
+    return RTC::RTC_OK;
+  }
+
+  /*!
+   * @brief onAddedComponent() template function
+   */
+  RTC::ReturnCode_t DataTriggeredEC::
+  onAddedComponent(RTC::LightweightRTObject_ptr  /*rtobj*/)
+  {
+    std::lock_guard<std::mutex> guard(m_worker.mutex_);
+    if (!m_worker.ticked_)
+      {
+        ExecutionContextBase::m_worker.updateComponentList();
+      }
+    return RTC::RTC_OK;
+  }
+
+  /*!
+   * @brief onRemovedComponent() template function
+   */
+  RTC::ReturnCode_t DataTriggeredEC::
+  onRemovedComponent(RTC::LightweightRTObject_ptr rtobj)
+  {
+    // normally unbound on deactivation
+    std::vector<RTC::RTObject_impl*> comps;
+    {
+      std::lock_guard<std::mutex> guard(m_worker.mutex_);
+      for (auto& trigger : m_triggers)
+        {
+          RTC::RTObject_var ref = trigger->m_comp->getObjRef();
+          if (ref->_is_equivalent(rtobj))
+            {
+              comps.push_back(trigger->m_comp);
+            }
+        }
+    }
+    for (auto* comp : comps) { unbindTriggers(comp); }
+
+    std::lock_guard<std::mutex> guard(m_worker.mutex_);
+    if (!m_worker.ticked_)
+      {
+        ExecutionContextBase::m_worker.updateComponentList();
+      }
+    return RTC::RTC_OK;
+  }
+
+  /*!
+   * @brief onWaitingActivated() template function
+   */
+  RTC::ReturnCode_t DataTriggeredEC::
+  onWaitingActivated(RTC_impl::RTObjectStateMachine* comp, long int count)
+  {
+    RTC_TRACE(("onWaitingActivated(count = %d)", count));
+    RTC_PARANOID(("curr: %s, next: %s",
+                  getStateString(comp->getStates().curr),
+                  getStateString(comp->getStates().next)));
+    tick();
+    return RTC::RTC_OK;
+  }
+
+  /*!
+   * @brief onActivated() template function
+   */
+  RTC::ReturnCode_t DataTriggeredEC::
+  onActivated(RTC_impl::RTObjectStateMachine* comp, long int count)
+  {
+    RTC_TRACE(("onActivated(count = %d)", count));
+    // the ports are created in onInitialize(), after attaching the EC
+    bindTriggers(comp->getServant());
+    // count = -1; Asynch mode. onWaitingActivated() is not called.
+    if (count < 0) { tick(); }
+    return RTC::RTC_OK;
+  }
+
+  /*!
+   * @brief onWaitingDeactivated() template function
+   */
+  RTC::ReturnCode_t DataTriggeredEC::
+  onWaitingDeactivated(RTC_impl::RTObjectStateMachine* comp, long int count)
+  {
+    RTC_TRACE(("onWaitingDeactivated(count = %d)", count));
+    RTC_PARANOID(("curr: %s, next: %s",
+                  getStateString(comp->getStates().curr),
+                  getStateString(comp->getStates().next)));
+    tick();
+    return RTC::RTC_OK;
+  }
+
+  /*!
+   * @brief onDeactivated() template function
+   */
+  RTC::ReturnCode_t DataTriggeredEC::
+  onDeactivated(RTC_impl::RTObjectStateMachine* comp, long int count)
+  {
+    RTC_TRACE(("onDeactivated(count = %d)", count));
+    if (count < 0) { tick(); }
+    unbindTriggers(comp->getServant());
+    return RTC::RTC_OK;
+  }
+
+  /*!
+   * @brief onWaitingReset() template function
+   */
+  RTC::ReturnCode_t DataTriggeredEC::
+  onWaitingReset(RTC_impl::RTObjectStateMachine* comp, long int count)
+  {
+    RTC_TRACE(("onWaitingReset(count = %d)", count));
+    RTC_PARANOID(("curr: %s, next: %s",
+                  getStateString(comp->getStates().curr),
+                  getStateString(comp->getStates().next)));
+    tick();
+    return RTC::RTC_OK;
+  }
+
+  //============================================================
+  // private functions
+  //============================================================
+  /*!
+   * @if jp
+   * @brief データの到着を EC に通知する
+   * @else
+   * @brief Notify the EC of the data arrival
+   * @endif
+   */
+  void DataTriggeredEC::Trigger::operator()(const RTC::ConnectorInfo& /*info*/)
+  {
+    // already waiting for the execution
+    if (m_arrived.exchange(true, std::memory_order_acq_rel)) { return; }
+    std::lock_guard<std::mutex> guard(m_ec.m_worker.mutex_);
+    m_ec.m_worker.cond_.notify_one();
+  }
+
+  /*!
+   * @if jp
+   * @brief ワーカを1回実行させる
+   * @else
+   * @brief Make the worker execute once
+   * @endif
+   */
+  void DataTriggeredEC::tick()
+  {
+    std::lock_guard<std::mutex> guard(m_worker.mutex_);
+    m_worker.ticked_ = true;
+    m_worker.cond_.notify_one();
+  }
+
+  /*!
+   * @if jp
+   * @brief 実行の条件を満たしたか
+   *
+   * m_worker.mutex_ を保持して呼び出すこと。
+   *
+   * @else
+   * @brief Whether the condition of the execution is satisfied
+   *
+   * Must be called with m_worker.mutex_ held.
+   *
+   * @endif
+   */
+  bool DataTriggeredEC::ready()
+  {
+    if (m_worker.ticked_) { return true; }
+    if (m_triggers.empty()) { return false; }
+    for (auto& trigger : m_triggers)
+      {
+        bool arrived(trigger->m_arrived.load(std::memory_order_acquire));
+        if (m_all && !arrived) { return false; }
+        if (!m_all && arrived) { return true; }
+      }
+    return m_all;
+  }
+
+  /*!
+   * @if jp
+   * @brief trigger.ports で選択されたポートか
+   * @else
+   * @brief Whether the port is selected by trigger.ports
+   * @endif
+   */
+  bool DataTriggeredEC::isTriggerPort(const std::string& name)
+  {
+    if (m_ports.empty()) { return true; }
+    // the port name is "instance_name.port_name"
+    std::string::size_type pos(name.find('.'));
+    std::string short_name(pos == std::string::npos ?
+                           name : name.substr(pos + 1));
+    for (auto& port : m_ports)
+      {
+        if (port == name || port == short_name) { return true; }
+      }
+    return false;
+  }
+
+  /*!
+   * @if jp
+   * @brief コンポーネントの InPort にデータ到着リスナを登録する
+   * @else
+   * @brief Register the data arrival listeners to the InPorts of a
+   *        component
+   * @endif
+   */
+  void DataTriggeredEC::bindTriggers(RTC::RTObject_impl* comp)
+  {
+    if (comp == nullptr)
+      {
+        RTC_WARN(("The component is not in this process. "
+                  "It is executed only on the other triggers."));
+        return;
+      }
+    std::lock_guard<std::mutex> bind(m_bindMutex);
+    for (auto* port : comp->getInPorts())
+      {
+        if (!isTriggerPort(port->getName())) { continue; }
+        Trigger* trigger(nullptr);
+        {
+          std::lock_guard<std::mutex> guard(m_worker.mutex_);
+          auto it = std::find_if(m_triggers.begin(), m_triggers.end(),
+                                 [port](const std::unique_ptr<Trigger>& t)
+                                 { return t->m_port == port; });
+          if (it != m_triggers.end()) { continue; }
+          m_triggers.emplace_back(new Trigger(*this, comp, port));
+          trigger = m_triggers.back().get();
+        }
+        port->getListeners()->addDataArrivalListener(trigger);
+        RTC_DEBUG(("Triggered by %s", port->getName()));
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief コンポーネントのデータ到着リスナの登録を解除する
+   *
+   * リスナはポートから削除した後に解放するため、実行中のコールバック
+   * と競合しない。
+   *
+   * @param comp コンポーネント。nullptr の場合はすべて
+   *
+   * @else
+   * @brief Unregister the data arrival listeners of a component
+   *
+   * The listeners are deleted after removed from the ports, so that
+   * they do not race with the running callbacks.
+   *
+   * @param comp Component. All if nullptr
+   *
+   * @endif
+   */
+  void DataTriggeredEC::unbindTriggers(RTC::RTObject_impl* comp)
+  {
+    std::lock_guard<std::mutex> bind(m_bindMutex);
+    std::vector<std::unique_ptr<Trigger>> removed;
+    {
+      std::lock_guard<std::mutex> guard(m_worker.mutex_);
+      auto it = std::stable_partition(m_triggers.begin(), m_triggers.end(),
+                                      [comp](const std::unique_ptr<Trigger>& t)
+                                      {
+                                        return comp != nullptr &&
+                                          t->m_comp != comp;
+                                      });
+      std::move(it, m_triggers.end(), std::back_inserter(removed));
+      m_triggers.erase(it, m_triggers.end());
+    }
+    for (auto& trigger : removed)
+      {
+        trigger->m_port->getListeners()->removeDataArrivalListener(trigger.get());
+      }
+  }
+} // namespace RTC_exp
+
+extern "C"
+{
+  /*!
+   * @if jp
+   * @brief ECFactoryへの登録のための初期化関数
+   * @else
+   * @brief Initialization function to register to ECFactory
+   * @endif
+   */
+  void DataTriggeredECInit(RTC::Manager*  /*manager*/)
+  {
+    RTC::ExecutionContextFactory::
+      instance().addFactory("DataTriggeredEC",
+                            ::coil::Creator< ::RTC::ExecutionContextBase,
+                            ::RTC_exp::DataTriggeredEC>,
+                            ::coil::Destructor< ::RTC::ExecutionContextBase,
+                            ::RTC_exp::DataTriggeredEC>);
+    RTC::ExecutionContextFactory::
+      instance().addFactory("data_triggered_ec",
+                            ::coil::Creator< ::RTC::ExecutionContextBase,
+                            ::RTC_exp::DataTriggeredEC>,
+                            ::coil::Destructor< ::RTC::ExecutionContextBase,
+                            ::RTC_exp::DataTriggeredEC>);
+  }
+}
@@ -0,0 +1,272 @@
+﻿// -*- C++ -*-
+/*!
+ * @file DataTriggeredEC.h
+ * @brief DataTriggeredEC class
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_DATATRIGGEREDEC_H
+#define RTC_DATATRIGGEREDEC_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <coil/Task.h>
+
+#include <rtm/ExecutionContextBase.h>
+#include <rtm/ConnectorListener.h>
+
+namespace RTC
+{
+  class InPortBase;
+} // namespace RTC
+
+namespace RTC_exp
+{
+  /*!
+   * @if jp
+   * @class DataTriggeredEC
+   * @brief DataTriggeredEC クラス
+   *
+   * InPort へのデータの到着で駆動される実行コンテキスト。参加している
+   * コンポーネントがアクティブ化されると、その InPort のうち
+   * trigger.ports で選択されたものにデータ到着リスナを登録する。ネット
+   * ワーク接続のバッファやダイレクト接続のチャネルにデータが格納される
+   * と EC のスレッドが起床し、すべてのコンポーネントを1回実行する。
+   * on_execute() で isNew() をポーリングする必要はない。
+   *
+   * 設定 (exec_cxt 以下)
+   * - trigger.ports: 対象の InPort 名 (カンマ区切り)。"インスタンス名.
+   *   ポート名" またはポート名。空の場合はすべての InPort
+   * - trigger.mode: any (いずれかに到着, 既定) / all (すべてに到着)
+   * - trigger.min_interval: 実行開始の最小間隔 [s] (既定 0)
+   *
+   * 実行を待つ間に到着したデータは1回の実行にまとめられる。
+   * min_interval 内に到着したバーストも同様。状態遷移は
+   * ExtTrigExecutionContext と同様に即座に処理される。
+   *
+   * @since 2.1.0
+   *
+   * @else
+   * @class DataTriggeredEC
+   * @brief DataTriggeredEC class
+   *
+   * The execution context driven by data arrivals at InPorts. When a
+   * participating component is activated, data arrival listeners are
+   * registered to its InPorts selected by trigger.ports. When data is
+   * stored into the buffer of a network connection or the channel of
+   * a direct connection, the EC thread wakes up and executes all the
+   * components once. Polling isNew() in on_execute() is not needed.
+   *
+   * Configuration (under exec_cxt)
+   * - trigger.ports: Names of the InPorts (comma separated), as
+   *   "instance_name.port_name" or port names. All the InPorts if
+   *   empty
+   * - trigger.mode: any (arrival at any, default) / all (arrival at
+   *   all)
+   * - trigger.min_interval: Minimum interval between the starts of
+   *   executions [s] (default 0)
+   *
+   * The data arriving while an execution is waited for is coalesced
+   * into one execution, and so are the bursts arriving within
+   * min_interval. State transitions are handled immediately as with
+   * ExtTrigExecutionContext.
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  class DataTriggeredEC
+    : public virtual POA_RTC::ExecutionContextService,
+      public virtual PortableServer::RefCountServantBase,
+      public RTC::ExecutionContextBase,
+      public coil::Task
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @else
+     * @brief Constructor
+     * @endif
+     */
+    DataTriggeredEC();
+
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     *
+     * データ到着リスナの登録をすべて解除する。
+     *
+     * @else
+     * @brief Destructor
+     *
+     * Unregisters all the data arrival listeners.
+     *
+     * @endif
+     */
+    ~DataTriggeredEC() override;
+
+    /*!
+     * @if jp
+     * @brief ExecutionContextの初期化を行う
+     *
+     * trigger 以下の設定を読み込む。
+     *
+     * @else
+     * @brief Initialize the ExecutionContext
+     *
+     * Reads the settings under trigger.
+     *
+     * @endif
+     */
+    void init(coil::Properties& props) override;
+
+    int open(void *args) override;
+    int svc() override;
+    int close(unsigned long flags) override;
+
+    //============================================================
+    // ExecutionContextService
+    //============================================================
+    CORBA::Boolean is_running() override;
+    RTC::ReturnCode_t start() override;
+    RTC::ReturnCode_t stop() override;
+    CORBA::Double get_rate() override;
+    RTC::ReturnCode_t  set_rate(CORBA::Double rate) override;
+    RTC::ReturnCode_t
+    activate_component(RTC::LightweightRTObject_ptr comp) override;
+    RTC::ReturnCode_t
+    deactivate_component(RTC::LightweightRTObject_ptr comp) override;
+    RTC::ReturnCode_t
+    reset_component(RTC::LightweightRTObject_ptr comp) override;
+    RTC::LifeCycleState
+    get_component_state(RTC::LightweightRTObject_ptr comp) override;
+    RTC::ExecutionKind get_kind() override;
+    RTC::ReturnCode_t add_component(RTC::LightweightRTObject_ptr comp) override;
+    RTC::ReturnCode_t
+    remove_component(RTC::LightweightRTObject_ptr comp) override;
+    RTC::ExecutionContextProfile* get_profile() override;
+
+  protected:
+    RTC::ReturnCode_t onStarted() override;
+    RTC::ReturnCode_t
+    onAddedComponent(RTC::LightweightRTObject_ptr rtobj) override;
+    RTC::ReturnCode_t
+    onRemovedComponent(RTC::LightweightRTObject_ptr rtobj) override;
+    RTC::ReturnCode_t
+    onWaitingActivated(RTC_impl::RTObjectStateMachine* comp, long int count) override;
+    RTC::ReturnCode_t
+    onActivated(RTC_impl::RTObjectStateMachine* comp, long int count) override;
+    RTC::ReturnCode_t
+    onWaitingDeactivated(RTC_impl::RTObjectStateMachine* comp, long int count) override;
+    RTC::ReturnCode_t
+    onDeactivated(RTC_impl::RTObjectStateMachine* comp, long int count) override;
+    RTC::ReturnCode_t
+    onWaitingReset(RTC_impl::RTObjectStateMachine* comp, long int count) override;
+
+  private:
+    /*!
+     * @if jp
+     * @brief InPort に登録するデータ到着リスナ
+     *
+     * 到着済みのフラグが立っている間の到着は EC を起床させない。
+     *
+     * @else
+     * @brief Data arrival listener registered to an InPort
+     *
+     * The arrivals while the arrived flag is set do not wake up the
+     * EC.
+     *
+     * @endif
+     */
+    class Trigger
+      : public RTC::DataArrivalListener
+    {
+    public:
+      Trigger(DataTriggeredEC& ec, RTC::RTObject_impl* comp,
+              RTC::InPortBase* port)
+        : m_ec(ec), m_comp(comp), m_port(port) {}
+      void operator()(const RTC::ConnectorInfo& info) override;
+
+      DataTriggeredEC& m_ec;
+      RTC::RTObject_impl* m_comp;
+      RTC::InPortBase* m_port;
+      std::atomic<bool> m_arrived{false};
+    };
+
+    bool threadRunning()
+    {
+      std::lock_guard<std::mutex> guard(m_svcmutex);
+      return m_svc;
+    }
+    void tick();
+    bool ready();
+    bool isTriggerPort(const std::string& name);
+    void bindTriggers(RTC::RTObject_impl* comp);
+    void unbindTriggers(RTC::RTObject_impl* comp);
+
+    RTC::Logger rtclog{"data_triggered_ec"};
+    bool m_svc{false};
+    std::mutex m_svcmutex;
+
+    struct Worker
+    {
+      Worker() {}
+      std::mutex mutex_;
+      std::condition_variable cond_;
+      bool ticked_{false};
+    };
+    // A condition variable for the data arrivals and state transitions
+    Worker m_worker;
+
+    /*!
+     * @if jp
+     * @brief 登録したデータ到着リスナ
+     *
+     * m_worker.mutex_ で保護する。登録と解除は m_bindMutex で直列化す
+     * る。
+     *
+     * @else
+     * @brief Registered data arrival listeners
+     *
+     * Guarded by m_worker.mutex_. Registering and unregistering are
+     * serialized by m_bindMutex.
+     *
+     * @endif
+     */
+    std::vector<std::unique_ptr<Trigger>> m_triggers;
+    std::mutex m_bindMutex;
+
+    std::vector<std::string> m_ports;
+    bool m_all{false};
+    std::chrono::nanoseconds m_minInterval{0};
+  };  // class DataTriggeredEC
+} // namespace RTC_exp
+
+extern "C"
+{
+  /*!
+   * @if jp
+   * @brief ECFactoryへの登録のための初期化関数
+   * @else
+   * @brief Initialization function to register to ECFactory
+   * @endif
+   */
+  void DataTriggeredECInit(RTC::Manager* manager);
+}
+
+#endif  // RTC_DATATRIGGEREDEC_H
@@ -17,6 +17,7 @@
  *
  */
 
+#include <limits>
 #include <mutex>
 #include <coil/ClockManager.h>
 
@@ -124,9 +125,13 @@ namespace RTC
             }
         }
         auto t0 = std::chrono::steady_clock::now();
-        ExecutionContextBase::invokeWorkerPreDo();
-        ExecutionContextBase::invokeWorkerDo();
-        ExecutionContextBase::invokeWorkerPostDo();
+        {
+          // not concurrently with run_steps()
+          std::lock_guard<std::mutex> guard(m_tickmutex);
+          ExecutionContextBase::invokeWorkerPreDo();
+          ExecutionContextBase::invokeWorkerDo();
+          ExecutionContextBase::invokeWorkerPostDo();
+        }
         {
           std::lock_guard<std::mutex> guard(m_worker.mutex_);
           m_worker.ticked_ = false;
@@ -199,6 +204,129 @@ namespace RTC
     usec = static_cast<::CORBA::ULong>((time_us - time_s).count());
   }
 
+  /*!
+   * @if jp
+   * @brief 処理を複数ステップ進める
+   * @else
+   * @brief Move forward multiple steps of ExecutionContext
+   * @endif
+   */
+  ::CORBA::ULong LogicalTimeTriggeredEC::
+  run_steps(::CORBA::ULong n, ::CORBA::ULong dt_sec, ::CORBA::ULong dt_usec)
+  {
+    RTC_TRACE(("run_steps(n = %d, dt_sec = %d, dt_usec = %d)",
+               n, dt_sec, dt_usec));
+    std::chrono::nanoseconds dt(std::chrono::seconds(dt_sec)
+                                + std::chrono::microseconds(dt_usec));
+    if (dt.count() == 0) { dt = getPeriod(); }
+    return runSteps(n, dt, std::chrono::nanoseconds::max());
+  }
+
+  /*!
+   * @if jp
+   * @brief 指定した時刻まで処理を進める
+   * @else
+   * @brief Move forward until the given time
+   * @endif
+   */
+  ::CORBA::ULong LogicalTimeTriggeredEC::
+  run_until(::CORBA::ULong sec, ::CORBA::ULong usec)
+  {
+    RTC_TRACE(("run_until(sec = %d, usec = %d)", sec, usec));
+    return runSteps(std::numeric_limits< ::CORBA::ULong>::max(), getPeriod(),
+                    std::chrono::seconds(sec) + std::chrono::microseconds(usec));
+  }
+
+  /*!
+   * @if jp
+   * @brief run_steps() と run_until() を止める
+   * @else
+   * @brief Stop run_steps() and run_until()
+   * @endif
+   */
+  void LogicalTimeTriggeredEC::stop_steps()
+  {
+    RTC_TRACE(("stop_steps()"));
+    m_stopSteps.store(true, std::memory_order_relaxed);
+  }
+
+  /*!
+   * @if jp
+   * @brief run_steps() と run_until() の終了条件を設定する
+   * @else
+   * @brief Set the stop condition of run_steps() and run_until()
+   * @endif
+   */
+  void LogicalTimeTriggeredEC::
+  setStepCondition(std::function<bool(std::chrono::nanoseconds)> cond)
+  {
+    std::lock_guard<std::mutex> guard(m_conditionMutex);
+    m_stepCondition = std::move(cond);
+  }
+
+  /*!
+   * @if jp
+   * @brief ステップを続けて実行する
+   *
+   * 実行中は m_tickmutex を保持するため、tick() は終了後に実行される。
+   *
+   * @param n 最大のステップ数
+   * @param dt 1ステップの時間
+   * @param until 論理時刻の上限
+   * @return 実行したステップ数
+   *
+   * @else
+   * @brief Execute the steps in a row
+   *
+   * m_tickmutex is held during the execution, so tick() is executed
+   * after it finishes.
+   *
+   * @param n Maximum number of the steps
+   * @param dt Time of a step
+   * @param until Upper limit of the logical time
+   * @return Number of the executed steps
+   *
+   * @endif
+   */
+  ::CORBA::ULong LogicalTimeTriggeredEC::
+  runSteps(::CORBA::ULong n, std::chrono::nanoseconds dt,
+           std::chrono::nanoseconds until)
+  {
+    if (!isRunning())
+      {
+        RTC_DEBUG(("EC is not running. do nothing."));
+        return 0;
+      }
+    if (dt.count() <= 0)
+      {
+        RTC_WARN(("Invalid step time: %lld [nsec]", dt.count()));
+        return 0;
+      }
+    std::function<bool(std::chrono::nanoseconds)> cond;
+    {
+      std::lock_guard<std::mutex> guard(m_conditionMutex);
+      cond = m_stepCondition;
+    }
+
+    std::lock_guard<std::mutex> guard(m_tickmutex);
+    m_stopSteps.store(false, std::memory_order_relaxed);
+    ::CORBA::ULong steps(0);
+    while (steps < n && !m_stopSteps.load(std::memory_order_relaxed) &&
+           isRunning())
+      {
+        std::chrono::nanoseconds time(m_clock.gettime() + dt);
+        if (time > until) { break; }
+        m_clock.settime(time);
+        ExecutionContextBase::invokeWorkerPreDo();
+        ExecutionContextBase::invokeWorkerDo();
+        ExecutionContextBase::invokeWorkerPostDo();
+        ++steps;
+        if (cond && cond(time)) { break; }
+      }
+    RTC_DEBUG(("%d steps executed.", steps));
+    return steps;
+  }
+
   //============================================================
   // ExecutionContextService
   //============================================================
@@ -20,7 +20,9 @@
 
 #include <rtm/RTC.h>
 
+#include <atomic>
 #include <condition_variable>
+#include <functional>
 #include <coil/Task.h>
 #include <coil/ClockManager.h>
 
@@ -203,6 +205,107 @@ namespace RTC
     void tick(::CORBA::ULong sec, ::CORBA::ULong usec) override;
     void get_time(::CORBA::ULong& sec, ::CORBA::ULong& usec) override;
 
+    /*!
+     * @if jp
+     * @brief 処理を複数ステップ進める
+     *
+     * 論理時刻を dt ずつ進めながら n 周期分の処理を続けて実行し、すべ
+     * て終了してから戻る。tick() を n 回呼び出すのと同じだが、1ステッ
+     * プごとの呼び出しと実時間の周期の待ちがない。stop_steps() または
+     * setStepCondition() の条件で途中で終了する。非同期 tick モードで
+     * も呼び出したスレッドで実行する。
+     *
+     * @param n ステップ数
+     * @param dt_sec 1ステップの時間 [s]
+     * @param dt_usec 1ステップの時間 [us]。dt が 0 の場合は EC の周期
+     * @return 実行したステップ数
+     *
+     * @else
+     * @brief Move forward multiple steps of ExecutionContext
+     *
+     * Executes n periods in a row advancing the logical time by dt, and
+     * returns after all of them finish. It is the same as calling
+     * tick() n times, without the call for each step and without
+     * waiting for the period in real time. It finishes early by
+     * stop_steps() or the condition of setStepCondition(). It runs in
+     * the calling thread even in the asynchronous tick mode.
+     *
+     * @param n Number of the steps
+     * @param dt_sec Time of a step [s]
+     * @param dt_usec Time of a step [us]. The EC period if dt is zero
+     * @return Number of the executed steps
+     *
+     * @endif
+     */
+    ::CORBA::ULong run_steps(::CORBA::ULong n, ::CORBA::ULong dt_sec,
+                             ::CORBA::ULong dt_usec) override;
+
+    /*!
+     * @if jp
+     * @brief 指定した時刻まで処理を進める
+     *
+     * 論理時刻を EC の周期ずつ進めながら、指定した時刻を超えない範囲で
+     * 処理を続けて実行する。終了条件は run_steps() と同じ。
+     *
+     * @param sec 時刻 [s]
+     * @param usec 時刻 [us]
+     * @return 実行したステップ数
+     *
+     * @else
+     * @brief Move forward until the given time
+     *
+     * Executes the periods in a row advancing the logical time by the
+     * EC period, as long as the given time is not passed. It finishes
+     * early as run_steps() does.
+     *
+     * @param sec Time [s]
+     * @param usec Time [us]
+     * @return Number of the executed steps
+     *
+     * @endif
+     */
+    ::CORBA::ULong run_until(::CORBA::ULong sec, ::CORBA::ULong usec) override;
+
+    /*!
+     * @if jp
+     * @brief run_steps() と run_until() を止める
+     *
+     * 実行中のステップの終了後に戻らせる。コンポーネントの on_execute()
+     * からも呼び出せる。
+     *
+     * @else
+     * @brief Stop run_steps() and run_until()
+     *
+     * Makes them return after the current step. It can also be called
+     * from on_execute() of a component.
+     *
+     * @endif
+     */
+    void stop_steps() override;
+
+    /*!
+     * @if jp
+     * @brief run_steps() と run_until() の終了条件を設定する
+     *
+     * 条件は各ステップの後に論理時刻を引数として呼び出され、true を返
+     * すと実行を終了する。同じプロセスのシミュレータやコンポーネントが
+     * 使用する。
+     *
+     * @param cond 終了条件。空の場合は解除
+     *
+     * @else
+     * @brief Set the stop condition of run_steps() and run_until()
+     *
+     * The condition is called with the logical time after each step, and
+     * the execution finishes if it returns true. Used by the simulators
+     * and the components in the same process.
+     *
+     * @param cond Stop condition. Cleared if empty
+     *
+     * @endif
+     */
+    void setStepCondition(std::function<bool(std::chrono::nanoseconds)> cond);
+
     //============================================================
     // ExecutionContextService
     //============================================================
@@ -615,6 +718,8 @@ namespace RTC
       std::lock_guard<std::mutex> guard(m_svcmutex);
       return m_svc;
     }
+    ::CORBA::ULong runSteps(::CORBA::ULong n, std::chrono::nanoseconds dt,
+                            std::chrono::nanoseconds until);
     /*!
      * @if jp
      * @brief ロガーストリーム
@@ -658,6 +763,18 @@ namespace RTC
     std::mutex m_svcmutex;
     std::mutex m_tickmutex;
 
+    /*!
+     * @if jp
+     * @brief run_steps() と run_until() の終了要求と終了条件
+     * @else
+     * @brief Stop request and stop condition of run_steps() and
+     *        run_until()
+     * @endif
+     */
+    std::atomic<bool> m_stopSteps{false};
+    std::function<bool(std::chrono::nanoseconds)> m_stepCondition;
+    std::mutex m_conditionMutex;
+
     /*!
      * @if jp
      * @brief worker 用状態変数クラス
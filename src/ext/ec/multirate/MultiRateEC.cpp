@@ -0,0 +1,503 @@
+﻿// -*- C++ -*-
+/*!
+ * @file MultiRateEC.cpp
+ * @brief MultiRateEC class
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include <coil/stringutil.h>
+
+#include <rtm/ECFactory.h>
+#include <rtm/RTObjectStateMachine.h>
+#include "MultiRateEC.h"
+
+namespace
+{
+  uint64_t gcd(uint64_t a, uint64_t b)
+  {
+    while (b != 0)
+      {
+        uint64_t r(a % b);
+        a = b;
+        b = r;
+      }
+    return a;
+  }
+} // namespace
+
+namespace RTC_exp
+{
+  /*!
+   * @if jp
+   * @brief コンストラクタ
+   * @else
+   * @brief Constructor
+   * @endif
+   */
+  MultiRateEC::MultiRateEC()
+  {
+    RTC_TRACE(("MultiRateEC()"));
+  }
+
+  /*!
+   * @if jp
+   * @brief デストラクタ
+   * @else
+   * @brief Destructor
+   * @endif
+   */
+  MultiRateEC::~MultiRateEC()
+  {
+    RTC_TRACE(("~MultiRateEC()"));
+    {
+      std::lock_guard<std::mutex> guard(m_svcmutex);
+      m_svc = false;
+    }
+    {
+      std::lock_guard<std::mutex> guard(m_workerthread.mutex_);
+      m_workerthread.running_ = true;
+      m_workerthread.cond_.notify_one();
+    }
+    wait();
+  }
+
+  /*!
+   * @if jp
+   * @brief ExecutionContextの初期化を行う
+   * @else
+   * @brief Initialize the ExecutionContext
+   * @endif
+   */
+  void MultiRateEC::init(coil::Properties& props)
+  {
+    RTC_TRACE(("init()"));
+    PeriodicExecutionContext::init(props);
+
+    m_rates.clear();
+    for (auto& item : coil::split(props.getProperty("component_rates"), ",", true))
+      {
+        coil::vstring rate(coil::split(item, ":"));
+        double hz(0.0);
+        if (rate.size() != 2 || rate[0].empty() ||
+            !coil::stringTo(hz, rate[1].c_str()) || hz <= 0.0)
+          {
+            RTC_WARN(("Invalid component rate: %s", item.c_str()));
+            continue;
+          }
+        m_rates[rate[0]] = hz;
+        RTC_DEBUG(("component rate: %s: %f [Hz]", rate[0].c_str(), hz));
+      }
+
+    std::string policy(coil::normalize(props.getProperty("dispatch_policy", "rm")));
+    m_edf = (policy == "edf");
+    if (!m_edf && policy != "rm")
+      {
+        RTC_WARN(("Unknown dispatch policy: %s. rm is used.", policy.c_str()));
+      }
+    getProperty(props, "max_schedule_frames", m_maxFrames);
+    if (m_maxFrames == 0) { m_maxFrames = 1; }
+    RTC_DEBUG(("dispatch policy: %s, max schedule frames: %d",
+               m_edf ? "edf" : "rm", m_maxFrames));
+    RTC_DEBUG(("init() done"));
+  }
+
+  /*!
+   * @if jp
+   * @brief ExecutionContext 用のスレッド実行関数
+   *
+   * 過ぎたマイナーフレームのコンポーネントをリリースし、実行可能なコン
+   * ポーネントを1つ実行する。実行可能なものがなければ次のフレームの開
+   * 始時刻まで待つ。
+   *
+   * @else
+   * @brief Thread execution function for ExecutionContext
+   *
+   * Releases the components of the minor frames passed and executes
+   * one of the ready components. If none is ready, waits for the start
+   * time of the next frame.
+   *
+   * @endif
+   */
+  int MultiRateEC::svc()
+  {
+    RTC_TRACE(("svc()"));
+    applyCpuAffinity();
+
+    bool resync(true);
+    do
+      {
+        if (!workerRunning())
+          {
+            // The state transitions are completed before stopping the
+            // thread, as PeriodicExecutionContext does.
+            ExecutionContextBase::invokeWorkerPreDo();
+            m_worker.updateComponentList();
+            std::unique_lock<std::mutex> guard(m_workerthread.mutex_);
+            while (!m_workerthread.running_)
+              {
+                m_workerthread.cond_.wait(guard);
+              }
+            resync = true;
+            continue;
+          }
+
+        m_worker.updateComponentList();
+        std::shared_ptr<const CompList> comps(m_worker.components());
+        if (comps != m_tableComps || getPeriod() != m_tablePeriod)
+          {
+            buildSchedule(comps);
+            resync = true;
+          }
+        auto now = std::chrono::steady_clock::now();
+        if (resync)
+          {
+            alignFrame(now);
+            resync = false;
+          }
+        releaseFrames(now);
+
+        Entry* entry(nextEntry());
+        if (entry != nullptr)
+          {
+            dispatch(*entry);
+            continue;
+          }
+        sleepUntil(m_frameTime);
+        if (m_statistics)
+          {
+            m_stats.sleep_error.record(std::chrono::steady_clock::now()
+                                       - m_frameTime);
+          }
+      } while (threadRunning());
+
+    RTC_DEBUG(("Thread terminated."));
+    return 0;
+  }
+
+  //============================================================
+  // protected functions
+  //============================================================
+  void MultiRateEC::setParallelExecution(coil::Properties& props)
+  {
+    RTC_TRACE(("setParallelExecution()"));
+    size_t threads(0);
+    getProperty(props, "parallel_threads", threads);
+    if (threads > 1)
+      {
+        RTC_WARN(("parallel_threads is not supported. "
+                  "The components are executed one by one."));
+      }
+  }
+
+  //============================================================
+  // private functions
+  //============================================================
+  bool MultiRateEC::workerRunning()
+  {
+    std::lock_guard<std::mutex> guard(m_workerthread.mutex_);
+    return m_workerthread.running_;
+  }
+
+  /*!
+   * @if jp
+   * @brief スケジュール表を作る
+   *
+   * 周期はマイクロ秒単位に丸める。ハイパーピリオドのフレーム数が
+   * max_schedule_frames を超える場合は、最短周期をマイナーフレームと
+   * し、各周期をその2のべき乗倍に丸める。
+   *
+   * @else
+   * @brief Build the schedule table
+   *
+   * The periods are rounded to microseconds. If the number of the
+   * frames of the hyperperiod exceeds max_schedule_frames, the shortest
+   * period is used as the minor frame and the periods are rounded to
+   * its power-of-two multiples.
+   *
+   * @endif
+   */
+  void MultiRateEC::
+  buildSchedule(const std::shared_ptr<const CompList>& comps)
+  {
+    RTC_TRACE(("buildSchedule()"));
+    const std::chrono::nanoseconds usec(std::chrono::microseconds(1));
+    m_tableComps = comps;
+    m_tablePeriod = getPeriod();
+    m_entries.clear();
+    m_table.clear();
+
+    for (size_t i(0); i < comps->size(); ++i)
+      {
+        Entry entry;
+        entry.comp = (*comps)[i];
+        entry.name = m_worker.componentName(*entry.comp);
+        entry.period = m_tablePeriod;
+        auto it = m_rates.find(entry.name);
+        if (it != m_rates.end())
+          {
+            entry.period = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::duration<double>(1.0 / it->second));
+          }
+        entry.period = std::max(usec, (entry.period + usec / 2) / usec * usec);
+        m_entries.push_back(entry);
+      }
+    if (m_entries.empty())
+      {
+        m_minorFrame = std::max(usec, m_tablePeriod);
+        m_table.resize(1);
+        return;
+      }
+
+    uint64_t minor(0);
+    for (auto& entry : m_entries)
+      {
+        minor = gcd(minor, static_cast<uint64_t>(entry.period / usec));
+      }
+    uint64_t frames(1);
+    for (auto& entry : m_entries)
+      {
+        entry.frames = static_cast<size_t>(entry.period / usec / minor);
+        frames = frames / gcd(frames, entry.frames) * entry.frames;
+        if (frames > m_maxFrames) { break; }
+      }
+    m_minorFrame = usec * static_cast<long long>(minor);
+
+    if (frames > m_maxFrames)
+      {
+        RTC_WARN(("The hyperperiod exceeds %d frames. "
+                  "The periods are rounded.", m_maxFrames));
+        size_t limit(1);
+        while (limit * 2 <= m_maxFrames) { limit *= 2; }
+        m_minorFrame = std::min_element(m_entries.begin(), m_entries.end(),
+                                        [](const Entry& a, const Entry& b)
+                                        { return a.period < b.period; })->period;
+        frames = 1;
+        for (auto& entry : m_entries)
+          {
+            double ratio(static_cast<double>(entry.period.count()) /
+                         static_cast<double>(m_minorFrame.count()));
+            // the nearest power of two in the log scale
+            entry.frames = 1;
+            while (entry.frames * 2 <= limit &&
+                   ratio >= static_cast<double>(entry.frames) * std::sqrt(2.0))
+              {
+                entry.frames *= 2;
+              }
+            entry.period = m_minorFrame * static_cast<long long>(entry.frames);
+            frames = std::max<uint64_t>(frames, entry.frames);
+            RTC_WARN(("%s: %f [Hz]", entry.name.c_str(),
+                      1.0 / std::chrono::duration<double>(entry.period).count()));
+          }
+      }
+
+    m_table.resize(static_cast<size_t>(frames));
+    for (size_t k(0); k < m_table.size(); ++k)
+      {
+        for (size_t i(0); i < m_entries.size(); ++i)
+          {
+            if (k % m_entries[i].frames == 0) { m_table[k].push_back(i); }
+          }
+      }
+
+    RTC_DEBUG(("minor frame: %lld [nsec], hyperperiod: %d frames",
+               m_minorFrame.count(), m_table.size()));
+    for (auto& entry : m_entries)
+      {
+        RTC_DEBUG(("%s: period: %lld [nsec], every %d frames",
+                   entry.name.c_str(), entry.period.count(), entry.frames));
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 現在のフレームに合わせる
+   *
+   * フレームは PeriodicExecutionContext の絶対時刻リリースと同様に
+   * steady_clock のエポックから phase_offset + n * マイナーフレームの
+   * 時刻に置く。実行可能なコンポーネントは破棄する。
+   *
+   * @else
+   * @brief Align to the current frame
+   *
+   * The frames are placed at phase_offset + n * minor frame from the
+   * epoch of steady_clock, as the absolute release of
+   * PeriodicExecutionContext. The ready components are discarded.
+   *
+   * @endif
+   */
+  void MultiRateEC::alignFrame(std::chrono::steady_clock::time_point now)
+  {
+    m_frameTime = floorRelease(now, m_minorFrame);
+    auto since = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   m_frameTime.time_since_epoch()) - m_phase;
+    auto size = static_cast<long long>(m_table.size());
+    auto frame = (since / m_minorFrame) % size;
+    if (frame < 0) { frame += size; }
+    m_frame = static_cast<size_t>(frame);
+    for (auto& entry : m_entries) { entry.ready = false; }
+  }
+
+  /*!
+   * @if jp
+   * @brief 開始時刻を過ぎたフレームのコンポーネントをリリースする
+   *
+   * 実行を待っているコンポーネントが再びリリースされた場合、古いリリー
+   * スは飛ばされる。
+   *
+   * @else
+   * @brief Release the components of the frames whose start time has
+   *        passed
+   *
+   * If a component waiting for the execution is released again, the
+   * older release is skipped.
+   *
+   * @endif
+   */
+  void MultiRateEC::releaseFrames(std::chrono::steady_clock::time_point now)
+  {
+    // the table repeats every hyperperiod
+    auto hyperperiod = m_minorFrame * static_cast<long long>(m_table.size());
+    auto behind = (now - m_frameTime) / hyperperiod;
+    if (behind > 0)
+      {
+        m_frameTime += hyperperiod * behind;
+        if (m_statistics)
+          {
+            auto frames = static_cast<uint64_t>(behind) * m_table.size();
+            m_stats.cycles.fetch_add(frames, std::memory_order_relaxed);
+            m_stats.overrun.fetch_add(frames, std::memory_order_relaxed);
+            for (auto& entry : m_entries)
+              {
+                entry.comp->statistics().skipped.
+                  fetch_add(frames / entry.frames, std::memory_order_relaxed);
+              }
+          }
+      }
+
+    while (m_frameTime <= now)
+      {
+        for (auto i : m_table[m_frame])
+          {
+            Entry& entry(m_entries[i]);
+            if (entry.ready && m_statistics)
+              {
+                entry.comp->statistics().skipped.
+                  fetch_add(1, std::memory_order_relaxed);
+              }
+            entry.ready = true;
+            entry.release = m_frameTime;
+            entry.deadline = m_frameTime + entry.period;
+          }
+        m_frameTime += m_minorFrame;
+        m_frame = (m_frame + 1) % m_table.size();
+        if (m_statistics)
+          {
+            m_stats.cycles.fetch_add(1, std::memory_order_relaxed);
+            if (m_frameTime <= now)
+              {
+                m_stats.overrun.fetch_add(1, std::memory_order_relaxed);
+              }
+          }
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 次に実行するコンポーネントを選ぶ
+   *
+   * rm では周期、edf では期限の順。同じ場合は参加者リストの順。
+   *
+   * @return コンポーネント。実行可能なものがなければ nullptr
+   *
+   * @else
+   * @brief Choose the component to be executed next
+   *
+   * In the order of the periods for rm, and of the deadlines for edf.
+   * Ties are broken by the order in the participant list.
+   *
+   * @return Component. nullptr if none is ready
+   *
+   * @endif
+   */
+  MultiRateEC::Entry* MultiRateEC::nextEntry()
+  {
+    Entry* next(nullptr);
+    for (auto& entry : m_entries)
+      {
+        if (!entry.ready) { continue; }
+        if (next == nullptr)
+          {
+            next = &entry;
+          }
+        else if (m_edf && entry.deadline != next->deadline)
+          {
+            if (entry.deadline < next->deadline) { next = &entry; }
+          }
+        else if (entry.period < next->period)
+          {
+            next = &entry;
+          }
+      }
+    return next;
+  }
+
+  /*!
+   * @if jp
+   * @brief コンポーネントを実行する
+   * @else
+   * @brief Execute a component
+   * @endif
+   */
+  void MultiRateEC::dispatch(Entry& entry)
+  {
+    entry.ready = false;
+    if (m_statistics)
+      {
+        if (entry.comp->isCurrentState(RTC::ACTIVE_STATE))
+          {
+            entry.comp->statistics().release_jitter.
+              record(std::chrono::steady_clock::now() - entry.release);
+          }
+        m_worker.setDeadline(entry.deadline);
+      }
+    m_worker.invokeComponent(*entry.comp);
+  }
+} // namespace RTC_exp
+
+extern "C"
+{
+  /*!
+   * @if jp
+   * @brief ECFactoryへの登録のための初期化関数
+   * @else
+   * @brief Initialization function to register to ECFactory
+   * @endif
+   */
+  void MultiRateECInit(RTC::Manager*  /*manager*/)
+  {
+    RTC::ExecutionContextFactory::
+      instance().addFactory("MultiRateEC",
+                            ::coil::Creator< ::RTC::ExecutionContextBase,
+                            ::RTC_exp::MultiRateEC>,
+                            ::coil::Destructor< ::RTC::ExecutionContextBase,
+                            ::RTC_exp::MultiRateEC>);
+    RTC::ExecutionContextFactory::
+      instance().addFactory("multirate_ec",
+                            ::coil::Creator< ::RTC::ExecutionContextBase,
+                            ::RTC_exp::MultiRateEC>,
+                            ::coil::Destructor< ::RTC::ExecutionContextBase,
+                            ::RTC_exp::MultiRateEC>);
+  }
+}
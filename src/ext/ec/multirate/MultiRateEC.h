@@ -0,0 +1,237 @@
+﻿// -*- C++ -*-
+/*!
+ * @file MultiRateEC.h
+ * @brief MultiRateEC class
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_MULTIRATEEC_H
+#define RTC_MULTIRATEEC_H
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <rtm/PeriodicExecutionContext.h>
+
+namespace RTC_exp
+{
+  /*!
+   * @if jp
+   * @class MultiRateEC
+   * @brief MultiRateEC クラス
+   *
+   * 参加しているコンポーネントをそれぞれの周期で、1つのスレッドで実行
+   * する実行コンテキスト。周期の最大公約数をマイナーフレーム、最小公倍
+   * 数をハイパーピリオドとするスケジュール表を作り、各マイナーフレーム
+   * の開始時刻にそのフレームでリリースされるコンポーネントを実行可能に
+   * する。実行可能なコンポーネントは1つずつ、dispatch_policy の順に
+   * 実行する (ノンプリエンプティブ)。
+   *
+   * - rm: Rate Monotonic。周期の短いものから実行する
+   * - edf: Earliest Deadline First。期限 (リリース時刻 + 周期) の早い
+   *   ものから実行する
+   *
+   * 設定 (exec_cxt 以下)
+   * - periodic.rate: component_rates に指定のないコンポーネントの周期
+   *   [Hz]
+   * - component_rates: "インスタンス名:周期[Hz]" のカンマ区切りのリスト
+   * - dispatch_policy: rm (既定) / edf
+   * - max_schedule_frames: スケジュール表のフレーム数の上限 (既定
+   *   10000)。超える場合は周期を最短周期の2のべき乗倍に丸める
+   * - cpu_affinity, statistics, phase_offset: PeriodicExecutionContext
+   *   と同じ
+   *
+   * 前回のリリースを実行する前に次のリリースが来た場合は古いリリース
+   * を飛ばす。statistics が有効な場合、コンポーネントごとにリリース時
+   * 刻から実行開始までの遅れ (rtcs.<インスタンス名>.release_jitter.*)
+   * と飛ばした回数 (rtcs.<インスタンス名>.skipped) を記録する。
+   * cycles はマイナーフレームの数、overrun は次のフレームの開始時刻を
+   * 過ぎてからリリースしたフレームの数。
+   *
+   * @since 2.1.0
+   *
+   * @else
+   * @class MultiRateEC
+   * @brief MultiRateEC class
+   *
+   * The execution context executing each participating component at
+   * its own period on one thread. It builds the schedule table whose
+   * minor frame is the greatest common divisor of the periods and
+   * whose hyperperiod is the least common multiple, and makes the
+   * components released in each minor frame ready at its start time.
+   * The ready components are executed one by one in the order of
+   * dispatch_policy (non-preemptive).
+   *
+   * - rm: Rate Monotonic. Shorter periods first
+   * - edf: Earliest Deadline First. Earlier deadlines (release time +
+   *   period) first
+   *
+   * Configuration (under exec_cxt)
+   * - periodic.rate: Rate [Hz] of the components not in
+   *   component_rates
+   * - component_rates: Comma separated list of
+   *   "instance_name:rate[Hz]"
+   * - dispatch_policy: rm (default) / edf
+   * - max_schedule_frames: Maximum number of the frames of the schedule
+   *   table (default 10000). If exceeded, the periods are rounded to
+   *   power-of-two multiples of the shortest one
+   * - cpu_affinity, statistics, phase_offset: Same as
+   *   PeriodicExecutionContext
+   *
+   * If the next release comes before the previous one is executed, the
+   * older release is skipped. If statistics is enabled, the delay from
+   * the release time to the start of the execution
+   * (rtcs.<instance name>.release_jitter.*) and the number of the
+   * skipped releases (rtcs.<instance name>.skipped) are recorded for
+   * each component. cycles is the number of the minor frames, and
+   * overrun is the number of the frames released after the start time
+   * of the next frame.
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  class MultiRateEC
+    : public PeriodicExecutionContext
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @else
+     * @brief Constructor
+     * @endif
+     */
+    MultiRateEC();
+
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     *
+     * スケジュール表を解放する前にスレッドを停止する。
+     *
+     * @else
+     * @brief Destructor
+     *
+     * Stops the thread before the schedule table is released.
+     *
+     * @endif
+     */
+    ~MultiRateEC() override;
+
+    /*!
+     * @if jp
+     * @brief ExecutionContextの初期化を行う
+     *
+     * PeriodicExecutionContext の設定に加えて component_rates,
+     * dispatch_policy, max_schedule_frames を読み込む。
+     *
+     * @else
+     * @brief Initialize the ExecutionContext
+     *
+     * Reads component_rates, dispatch_policy and max_schedule_frames in
+     * addition to the settings of PeriodicExecutionContext.
+     *
+     * @endif
+     */
+    void init(coil::Properties& props) override;
+
+    /*!
+     * @if jp
+     * @brief ExecutionContext 用のスレッド実行関数
+     * @else
+     * @brief Thread execution function for ExecutionContext
+     * @endif
+     */
+    int svc() override;
+
+  protected:
+    /*!
+     * @brief parallel execution is not supported
+     */
+    void setParallelExecution(coil::Properties& props) override;
+
+  private:
+    using CompList = RTC_impl::ExecutionContextWorker::CompList;
+
+    /*!
+     * @if jp
+     * @brief スケジュール表のコンポーネント
+     * @else
+     * @brief Component in the schedule table
+     * @endif
+     */
+    struct Entry
+    {
+      std::shared_ptr<RTC_impl::RTObjectStateMachine> comp;
+      std::string name;
+      std::chrono::nanoseconds period{0};
+      size_t frames{1};    // period in minor frames
+      bool ready{false};
+      std::chrono::steady_clock::time_point release;
+      std::chrono::steady_clock::time_point deadline;
+    };
+
+    bool workerRunning();
+    void buildSchedule(const std::shared_ptr<const CompList>& comps);
+    void alignFrame(std::chrono::steady_clock::time_point now);
+    void releaseFrames(std::chrono::steady_clock::time_point now);
+    Entry* nextEntry();
+    void dispatch(Entry& entry);
+
+    RTC::Logger rtclog{"multirate_ec"};
+
+    std::map<std::string, double> m_rates;
+    bool m_edf{false};
+    size_t m_maxFrames{10000};
+
+    /*!
+     * @if jp
+     * @brief スケジュール表
+     *
+     * m_table[k] はフレーム k でリリースされるコンポーネントの
+     * m_entries のインデックス。EC のスレッドのみがアクセスする。
+     *
+     * @else
+     * @brief Schedule table
+     *
+     * m_table[k] is the indices in m_entries of the components released
+     * in the frame k. Accessed only by the EC thread.
+     *
+     * @endif
+     */
+    std::vector<Entry> m_entries;
+    std::vector<std::vector<size_t>> m_table;
+    std::shared_ptr<const CompList> m_tableComps;
+    std::chrono::nanoseconds m_tablePeriod{0};
+    std::chrono::nanoseconds m_minorFrame{0};
+    size_t m_frame{0};
+    std::chrono::steady_clock::time_point m_frameTime;
+  };  // class MultiRateEC
+} // namespace RTC_exp
+
+extern "C"
+{
+  /*!
+   * @if jp
+   * @brief ECFactoryへの登録のための初期化関数
+   * @else
+   * @brief Initialization function to register to ECFactory
+   * @endif
+   */
+  void MultiRateECInit(RTC::Manager* manager);
+}
+
+#endif  // RTC_MULTIRATEEC_H
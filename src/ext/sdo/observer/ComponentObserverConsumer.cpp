@@ -22,6 +22,8 @@
 #include "ComponentObserverSkel.h"
 #include "ComponentObserverConsumer.h"
 #include <iostream>
+#include <map>
+#include <string>
 
 namespace RTC
 {
@@ -57,6 +59,7 @@ namespace RTC
         unsetExecutionContextListeners();
         unsetConfigurationListeners();
         unsetHeartbeat();
+        unsetConnectorStatistics();
       }
 
       {
@@ -87,6 +90,7 @@ namespace RTC
     coil::Properties prop;
     NVUtil::copyToProperties(prop, profile.properties);
     setHeartbeat(prop);
+    setConnectorStatistics(prop);
     setDataPortInterval(prop);
     setListeners(prop);
     return true;
@@ -116,6 +120,7 @@ namespace RTC
     coil::Properties prop;
     NVUtil::copyToProperties(prop, profile.properties);
     setHeartbeat(prop);
+    setConnectorStatistics(prop);
     setListeners(prop);
     return true;
   }
@@ -319,6 +324,75 @@ namespace RTC
       }
   }
 
+  /*!
+   * @if jp
+   * @brief コネクタの統計の通知を設定する
+   * @else
+   * @brief Setting the notification of the connector statistics
+   * @endif
+   */
+  void ComponentObserverConsumer::setConnectorStatistics(coil::Properties& prop)
+  {
+    unsetConnectorStatistics();
+    if (coil::toBool(prop["connector_statistics.enable"], "YES", "NO", false))
+      {
+        std::chrono::nanoseconds interval{std::chrono::seconds(10)};
+        if (prop["connector_statistics.interval"].empty()
+            || !coil::stringTo(interval,
+                               prop["connector_statistics.interval"].c_str()))
+          {
+            interval = std::chrono::seconds(10);
+          }
+        m_connstat = true;
+        m_cstaskid = Manager::instance().addTask([this]{
+          if (m_connstat) { notifyConnectorStatistics(); }
+        }, interval);
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief コネクタの統計の通知を解除する
+   * @else
+   * @brief Unsetting the notification of the connector statistics
+   * @endif
+   */
+  void ComponentObserverConsumer::unsetConnectorStatistics()
+  {
+    if (m_connstat)
+      {
+        Manager::instance().removeTask(m_cstaskid);
+        m_connstat = false;
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief コネクタの統計を通知する
+   * @else
+   * @brief Notifying the connector statistics
+   * @endif
+   */
+  void ComponentObserverConsumer::notifyConnectorStatistics()
+  {
+    // Group "<port>.<connector ID>.<key>" by the part before the key.
+    coil::Properties prop(m_rtobj->getConnectorStatistics());
+    std::map<std::string, std::string> messages;
+    for (auto& name : prop.propertyNames())
+      {
+        std::string::size_type pos(name.rfind('.'));
+        if (pos == std::string::npos) { continue; }
+        std::string& msg(messages[name.substr(0, pos)]);
+        if (!msg.empty()) { msg += ","; }
+        msg += name.substr(pos + 1) + "=" + prop[name];
+      }
+    for (auto& msg : messages)
+      {
+        updateStatus(OpenRTM::PORT_PROFILE,
+                     ("STATISTICS:" + msg.first + ":" + msg.second).c_str());
+      }
+  }
+
 
   //============================================================
   // Component status
@@ -188,6 +188,47 @@ namespace RTC
      */
     void unsetHeartbeat();
 
+    /*!
+     * @if jp
+     * @brief コネクタの統計の通知を設定する
+     *
+     * connector_statistics.enable が YES の場合、
+     * connector_statistics.interval (秒、デフォルト 10) ごとに、データ
+     * ポートの各コネクタの統計を PORT_PROFILE として通知する。hint は
+     * "STATISTICS:<ポート名>.<コネクタID>:name=<コネクタ名>,
+     * sent_samples=<値>,..." となる。
+     *
+     * @else
+     * @brief Setting the notification of the connector statistics
+     *
+     * If connector_statistics.enable is YES, the statistics of each
+     * connector of the data ports are notified as PORT_PROFILE every
+     * connector_statistics.interval seconds (10 by default). The hint is
+     * "STATISTICS:<port name>.<connector ID>:name=<connector name>,
+     * sent_samples=<value>,...".
+     *
+     * @endif
+     */
+    void setConnectorStatistics(coil::Properties& prop);
+
+    /*!
+     * @if jp
+     * @brief コネクタの統計の通知を解除する
+     * @else
+     * @brief Unsetting the notification of the connector statistics
+     * @endif
+     */
+    void unsetConnectorStatistics();
+
+    /*!
+     * @if jp
+     * @brief コネクタの統計を通知する
+     * @else
+     * @brief Notifying the connector statistics
+     * @endif
+     */
+    void notifyConnectorStatistics();
+
     //============================================================
     // Component status related functions
     /*!
@@ -580,6 +621,10 @@ namespace RTC
     bool m_heartbeat{false};
     Manager::TaskId m_hbtaskid;
 
+    // Connector statistics
+    bool m_connstat{false};
+    Manager::TaskId m_cstaskid;
+
     std::mutex mutex;
 
     std::vector<DataPortAction*> m_recievedactions;
@@ -0,0 +1,603 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  MulticastChannel.cpp
+ * @brief UDP multicast channel of the udp_multicast interface
+ * @date  $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *
+ *     All rights reserved.
+ *
+ *
+ */
+
+#include "MulticastChannel.h"
+#include <rtm/ConnectorBase.h>
+#include <coil/stringutil.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+namespace
+{
+  /*
+   * Header of each datagram, in network byte order.
+   *
+   *  0  magic "RTMC"
+   *  4  version (1 byte), reserved (3 bytes)
+   *  8  stream ID of the OutPort
+   * 12  sequence number of the sample
+   * 16  length of the sample
+   * 20  offset of the fragment in the sample
+   * 24  index of the fragment (2 bytes)
+   * 26  number of the fragments (2 bytes)
+   */
+  const unsigned long HEADER_SIZE = 28;
+  const unsigned char MAGIC[4] = {'R', 'T', 'M', 'C'};
+  const unsigned char VERSION = 2;
+  const size_t HISTORY_LENGTH = 8;
+
+  struct Header
+  {
+    uint32_t stream;
+    uint32_t sequence;
+    uint32_t length;
+    uint32_t offset;
+    uint16_t index;
+    uint16_t count;
+  };
+
+  void put32(unsigned char* p, uint32_t value)
+  {
+    p[0] = static_cast<unsigned char>(value >> 24);
+    p[1] = static_cast<unsigned char>(value >> 16);
+    p[2] = static_cast<unsigned char>(value >> 8);
+    p[3] = static_cast<unsigned char>(value);
+  }
+
+  uint32_t get32(const unsigned char* p)
+  {
+    return (static_cast<uint32_t>(p[0]) << 24) |
+      (static_cast<uint32_t>(p[1]) << 16) |
+      (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+  }
+
+  void putHeader(unsigned char* p, const Header& header)
+  {
+    memcpy(p, MAGIC, sizeof(MAGIC));
+    p[4] = VERSION;
+    p[5] = p[6] = p[7] = 0;
+    put32(p + 8, header.stream);
+    put32(p + 12, header.sequence);
+    put32(p + 16, header.length);
+    put32(p + 20, header.offset);
+    p[24] = static_cast<unsigned char>(header.index >> 8);
+    p[25] = static_cast<unsigned char>(header.index);
+    p[26] = static_cast<unsigned char>(header.count >> 8);
+    p[27] = static_cast<unsigned char>(header.count);
+  }
+
+  bool getHeader(const unsigned char* p, unsigned long length, Header& header)
+  {
+    if (length < HEADER_SIZE || memcmp(p, MAGIC, sizeof(MAGIC)) != 0 ||
+        p[4] != VERSION)
+      {
+        return false;
+      }
+    header.stream = get32(p + 8);
+    header.sequence = get32(p + 12);
+    header.length = get32(p + 16);
+    header.offset = get32(p + 20);
+    header.index = static_cast<uint16_t>((p[24] << 8) | p[25]);
+    header.count = static_cast<uint16_t>((p[26] << 8) | p[27]);
+    return true;
+  }
+
+  bool isAfter(uint32_t a, uint32_t b)
+  {
+    return static_cast<int32_t>(a - b) > 0;
+  }
+
+  bool sameContent(const RTC::ByteData& a, const RTC::ByteData& b)
+  {
+    unsigned long length(a.getDataLength());
+    if (length != b.getDataLength()) { return false; }
+    return a.getBuffer() == b.getBuffer() ||
+      memcmp(a.getBuffer(), b.getBuffer(), length) == 0;
+  }
+
+  bool toAddress(const std::string& str, in_addr& addr)
+  {
+    return inet_pton(AF_INET, str.c_str(), &addr) == 1;
+  }
+} // namespace
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @brief プロパティから設定を読み出すコンストラクタ
+   * @else
+   * @brief Constructor reading the settings from the properties
+   * @endif
+   */
+  MulticastSettings::MulticastSettings(const coil::Properties& prop)
+  {
+    if (!coil::stringTo(stream,
+                        prop.getProperty("outport.stream_id", "0").c_str()))
+      {
+        stream = 0;
+      }
+    address = coil::eraseBothEndsBlank(prop.getProperty("multicast.address",
+                                                        address));
+    interface_address =
+      coil::eraseBothEndsBlank(prop.getProperty("multicast.interface"));
+    coil::stringTo(port, prop.getProperty("multicast.port", "50100").c_str());
+    coil::stringTo(ttl, prop.getProperty("multicast.ttl", "1").c_str());
+    loopback = coil::toBool(prop.getProperty("multicast.loopback"),
+                            "YES", "NO", true);
+    if (!coil::stringTo(datagram_size,
+                        prop.getProperty("multicast.datagram_size",
+                                         "1472").c_str()) ||
+        datagram_size <= HEADER_SIZE || datagram_size > 65507)
+      {
+        datagram_size = 1472;
+      }
+    ordered = coil::normalize(prop.getProperty("multicast.delivery",
+                                               "latest")) == "ordered";
+    if (!coil::stringTo(reorder_window,
+                        prop.getProperty("multicast.reorder_window",
+                                         "8").c_str()) ||
+        reorder_window == 0)
+      {
+        reorder_window = 8;
+      }
+    unsigned long timeout(100);
+    coil::stringTo(timeout,
+                   prop.getProperty("multicast.reorder_timeout",
+                                    "100").c_str());
+    reorder_timeout = std::chrono::milliseconds(timeout);
+    coil::stringTo(receive_buffer,
+                   prop.getProperty("multicast.receive_buffer",
+                                    "0").c_str());
+    if (!coil::stringTo(max_sample_size,
+                        prop.getProperty("multicast.max_sample_size",
+                                         "16777216").c_str()) ||
+        max_sample_size == 0)
+      {
+        max_sample_size = 16UL * 1024 * 1024;
+      }
+  }
+
+  //============================================================
+  // MulticastSender
+  MulticastSender::MulticastSender(const MulticastSettings& settings)
+    : m_settings(settings), m_stream(settings.stream)
+  {
+  }
+
+  MulticastSender::~MulticastSender()
+  {
+    closeMulticastSocket(m_socket);
+  }
+
+  /*!
+   * @if jp
+   * @brief ストリーム、グループとポートに対応する送信者を取得する
+   * @else
+   * @brief Get the sender of the stream to the group and the port
+   * @endif
+   */
+  std::shared_ptr<MulticastSender>
+  MulticastSender::get(const MulticastSettings& settings)
+  {
+    static std::mutex mutex;
+    static std::map<std::string, std::weak_ptr<MulticastSender>> senders;
+
+    // keyed by the stream so that the OutPorts sharing the group do not
+    // share the sequence numbers and the history
+    std::string key(coil::otos(settings.stream) + "@" + settings.address +
+                    ":" + coil::otos(settings.port));
+    std::lock_guard<std::mutex> guard(mutex);
+    std::shared_ptr<MulticastSender> sender(senders[key].lock());
+    if (sender) { return sender; }
+
+    sender.reset(new MulticastSender(settings));
+    if (!sender->open()) { return nullptr; }
+    senders[key] = sender;
+    return sender;
+  }
+
+  bool MulticastSender::open()
+  {
+    in_addr group;
+    if (!toAddress(m_settings.address, group) ||
+        !IN_MULTICAST(ntohl(group.s_addr)))
+      {
+        return false;
+      }
+    m_socket = ::socket(AF_INET, SOCK_DGRAM, 0);
+    if (m_socket < 0) { return false; }
+
+    unsigned char ttl(static_cast<unsigned char>(m_settings.ttl));
+    unsigned char loop(m_settings.loopback ? 1 : 0);
+    bool ok(::setsockopt(m_socket, IPPROTO_IP, IP_MULTICAST_TTL,
+                         &ttl, sizeof(ttl)) == 0 &&
+            ::setsockopt(m_socket, IPPROTO_IP, IP_MULTICAST_LOOP,
+                         &loop, sizeof(loop)) == 0);
+    if (ok && !m_settings.interface_address.empty())
+      {
+        in_addr iface;
+        ok = toAddress(m_settings.interface_address, iface) &&
+          ::setsockopt(m_socket, IPPROTO_IP, IP_MULTICAST_IF,
+                       &iface, sizeof(iface)) == 0;
+      }
+    if (ok)
+      {
+        sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(m_settings.port);
+        addr.sin_addr = group;
+        ok = ::connect(m_socket, reinterpret_cast<sockaddr*>(&addr),
+                       sizeof(addr)) == 0;
+      }
+    if (!ok)
+      {
+        closeMulticastSocket(m_socket);
+        m_socket = -1;
+      }
+    return ok;
+  }
+
+  /*!
+   * @if jp
+   * @brief 最後に送ったサンプルの通番
+   * @else
+   * @brief Sequence number of the last sample sent
+   * @endif
+   */
+  uint32_t MulticastSender::sequence()
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_sequence;
+  }
+
+  /*!
+   * @if jp
+   * @brief サンプルを送る
+   * @else
+   * @brief Send a sample
+   * @endif
+   */
+  DataPortStatus MulticastSender::send(uint32_t& last, const ByteData& data)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    for (auto& sent : m_history)
+      {
+        if (isAfter(sent.first, last) && sameContent(sent.second, data))
+          {
+            last = sent.first;
+            return DataPortStatus::PORT_OK;
+          }
+      }
+
+    unsigned long length(data.getDataLength());
+    unsigned long chunk(m_settings.datagram_size - HEADER_SIZE);
+    unsigned long count(length == 0 ? 1 : (length + chunk - 1) / chunk);
+    if (count > 0xffff) { return DataPortStatus::PORT_ERROR; }
+
+    // The sequence number is consumed even if the send fails, so that
+    // the receivers count the sample as lost.
+    Header header{m_stream, ++m_sequence, static_cast<uint32_t>(length), 0,
+                  0, static_cast<uint16_t>(count)};
+    last = header.sequence;
+    unsigned char head[HEADER_SIZE];
+    iovec iov[2];
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = 2;
+
+    for (unsigned long i(0); i < count; ++i)
+      {
+        header.index = static_cast<uint16_t>(i);
+        header.offset = static_cast<uint32_t>(i * chunk);
+        putHeader(head, header);
+        iov[0].iov_base = head;
+        iov[0].iov_len = HEADER_SIZE;
+        // sendmsg() only reads the data
+        iov[1].iov_base = const_cast<unsigned char*>(data.getBuffer())
+          + header.offset;
+        iov[1].iov_len = std::min(chunk, length - header.offset);
+        if (::sendmsg(m_socket, &msg, 0) < 0)
+          {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS)
+              {
+                return DataPortStatus::SEND_FULL;
+              }
+            return DataPortStatus::PORT_ERROR;
+          }
+      }
+
+    m_history.emplace_back(header.sequence, data);
+    if (m_history.size() > HISTORY_LENGTH) { m_history.pop_front(); }
+    return DataPortStatus::PORT_OK;
+  }
+
+  //============================================================
+  // MulticastReassembler
+  MulticastReassembler::MulticastReassembler(const MulticastSettings& settings)
+    : m_ordered(settings.ordered),
+      m_window(settings.reorder_window),
+      m_timeout(settings.reorder_timeout),
+      m_maxSampleSize(settings.max_sample_size)
+  {
+  }
+
+  /*!
+   * @if jp
+   * @brief データグラムを受け取る
+   * @else
+   * @brief Take a datagram
+   * @endif
+   */
+  void MulticastReassembler::receive(const unsigned char* datagram,
+                                     unsigned long length,
+                                     std::vector<ByteData>& samples)
+  {
+    Header header;
+    if (!getHeader(datagram, length, header)) { return; }
+    unsigned long size(length - HEADER_SIZE);
+    if (header.count == 0 || header.index >= header.count ||
+        header.offset > header.length || header.length - header.offset < size ||
+        header.length > static_cast<uint64_t>(header.count) * 65507)
+      {
+        return;
+      }
+
+    uint32_t stream(m_stream);
+    if (stream == 0 || header.stream != stream) { return; }
+
+    // The length comes from an unauthenticated datagram, so it is not
+    // allocated beyond the limit. Each sample is counted once, at its
+    // first datagram.
+    if (header.length > m_maxSampleSize)
+      {
+        if (header.index == 0 && m_statistics != nullptr)
+          {
+            ConnectorStatistics::increment(m_statistics->drop);
+          }
+        return;
+      }
+
+    if (!m_started)
+      {
+        m_started = true;
+        m_next = header.sequence;
+        m_partials.clear();
+        m_held.clear();
+      }
+
+    auto it(m_partials.find(header.sequence));
+    if (it == m_partials.end())
+      {
+        // The oldest incomplete sample is given up, and counted as lost
+        // when the samples after it are delivered.
+        if (m_partials.size() >= m_window)
+          {
+            m_partials.erase(m_partials.begin());
+          }
+        it = m_partials.emplace(header.sequence, Partial()).first;
+        it->second.data.setDataLength(header.length);
+        it->second.received.assign(header.count, false);
+        it->second.remaining = header.count;
+      }
+
+    Partial& partial(it->second);
+    if (partial.data.getDataLength() != header.length ||
+        partial.received.size() != header.count ||
+        partial.received[header.index])
+      {
+        return;
+      }
+    if (size > 0)
+      {
+        memcpy(partial.data.mutableBuffer() + header.offset,
+               datagram + HEADER_SIZE, size);
+      }
+    partial.received[header.index] = true;
+    if (--partial.remaining > 0) { return; }
+
+    ByteData data;
+    data = std::move(partial.data);
+    m_partials.erase(it);
+    complete(header.sequence, data, samples);
+  }
+
+  /*!
+   * @if jp
+   * @brief reorder_timeout を過ぎた欠落を諦める
+   * @else
+   * @brief Give up the missing samples past reorder_timeout
+   * @endif
+   */
+  void MulticastReassembler::expire(std::vector<ByteData>& samples)
+  {
+    if (m_held.empty() ||
+        std::chrono::steady_clock::now() - m_heldSince < m_timeout)
+      {
+        return;
+      }
+    skipTo(m_held.begin()->first, samples);
+  }
+
+  void MulticastReassembler::complete(uint32_t sequence, ByteData& data,
+                                      std::vector<ByteData>& samples)
+  {
+    if (isAfter(m_next, sequence))
+      {
+        countReordered();
+        return;
+      }
+
+    if (!m_ordered)
+      {
+        countLost(sequence - m_next);
+        samples.push_back(data);
+        m_next = sequence + 1;
+        flush(samples);
+        return;
+      }
+
+    if (sequence != m_next)
+      {
+        if (m_held.empty())
+          {
+            m_heldSince = std::chrono::steady_clock::now();
+          }
+        m_held[sequence] = data;
+        if (m_held.size() > m_window)
+          {
+            skipTo(m_held.begin()->first, samples);
+          }
+        return;
+      }
+
+    // the samples after this one have already arrived
+    if (!m_held.empty()) { countReordered(); }
+    samples.push_back(data);
+    ++m_next;
+    flush(samples);
+  }
+
+  void MulticastReassembler::skipTo(uint32_t sequence,
+                                    std::vector<ByteData>& samples)
+  {
+    countLost(sequence - m_next);
+    m_next = sequence;
+    flush(samples);
+  }
+
+  void MulticastReassembler::flush(std::vector<ByteData>& samples)
+  {
+    while (!m_held.empty() && m_held.begin()->first == m_next)
+      {
+        samples.push_back(m_held.begin()->second);
+        m_held.erase(m_held.begin());
+        ++m_next;
+      }
+    if (!m_held.empty())
+      {
+        m_heldSince = std::chrono::steady_clock::now();
+      }
+    // the samples which can no longer be delivered
+    while (!m_partials.empty() && isAfter(m_next, m_partials.begin()->first))
+      {
+        m_partials.erase(m_partials.begin());
+      }
+  }
+
+  void MulticastReassembler::countLost(uint32_t count)
+  {
+    if (count > 0 && m_statistics != nullptr)
+      {
+        ConnectorStatistics::increment(m_statistics->lost, count);
+      }
+  }
+
+  void MulticastReassembler::countReordered()
+  {
+    if (m_statistics != nullptr)
+      {
+        ConnectorStatistics::increment(m_statistics->reordered);
+      }
+  }
+
+  //============================================================
+  /*!
+   * @if jp
+   * @brief マルチキャストグループに参加した受信ソケットを開く
+   * @else
+   * @brief Open a receiving socket joined to the multicast group
+   * @endif
+   */
+  int openMulticastReceiver(const MulticastSettings& settings)
+  {
+    in_addr group;
+    if (!toAddress(settings.address, group) ||
+        !IN_MULTICAST(ntohl(group.s_addr)))
+      {
+        return -1;
+      }
+    ip_mreq mreq;
+    memset(&mreq, 0, sizeof(mreq));
+    mreq.imr_multiaddr = group;
+    mreq.imr_interface.s_addr = htonl(INADDR_ANY);
+    if (!settings.interface_address.empty() &&
+        !toAddress(settings.interface_address, mreq.imr_interface))
+      {
+        return -1;
+      }
+
+    int sock(::socket(AF_INET, SOCK_DGRAM, 0));
+    if (sock < 0) { return -1; }
+
+    // several subscribers on a host share the port
+    int on(1);
+    bool ok(::setsockopt(sock, SOL_SOCKET, SO_REUSEADDR,
+                         &on, sizeof(on)) == 0);
+#ifdef SO_REUSEPORT
+    ok = ok && ::setsockopt(sock, SOL_SOCKET, SO_REUSEPORT,
+                            &on, sizeof(on)) == 0;
+#endif
+    if (ok && settings.receive_buffer > 0)
+      {
+        ok = ::setsockopt(sock, SOL_SOCKET, SO_RCVBUF,
+                          &settings.receive_buffer,
+                          sizeof(settings.receive_buffer)) == 0;
+      }
+    if (ok)
+      {
+        // bound to the group so that the other groups on the port are
+        // not received
+        sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(settings.port);
+        addr.sin_addr = group;
+        ok = ::bind(sock, reinterpret_cast<sockaddr*>(&addr),
+                    sizeof(addr)) == 0 &&
+          ::setsockopt(sock, IPPROTO_IP, IP_ADD_MEMBERSHIP,
+                       &mreq, sizeof(mreq)) == 0;
+      }
+    if (!ok)
+      {
+        closeMulticastSocket(sock);
+        return -1;
+      }
+    return sock;
+  }
+
+  /*!
+   * @if jp
+   * @brief ソケットを閉じる
+   * @else
+   * @brief Close the socket
+   * @endif
+   */
+  void closeMulticastSocket(int socket)
+  {
+    if (socket >= 0) { ::close(socket); }
+  }
+} // namespace RTC
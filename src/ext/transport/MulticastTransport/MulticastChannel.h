@@ -0,0 +1,365 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  MulticastChannel.h
+ * @brief UDP multicast channel of the udp_multicast interface
+ * @date  $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *
+ *     All rights reserved.
+ *
+ *
+ */
+
+#ifndef RTC_MULTICASTCHANNEL_H
+#define RTC_MULTICASTCHANNEL_H
+
+#include <rtm/ByteData.h>
+#include <rtm/DataPortStatus.h>
+#include <coil/Properties.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace RTC
+{
+  struct ConnectorStatistics;
+
+  /*!
+   * @if jp
+   * @class MulticastSettings
+   * @brief udp_multicast インターフェースの設定
+   *
+   * コネクタプロファイルの dataport.multicast 以下から読み出す。
+   *
+   * - stream: OutPort のストリーム ID。dataport.outport.stream_id か
+   *   ら読み出す。複数の OutPort が同じグループとポートを共有でき、
+   *   受信側はこの ID で自分の OutPort のデータのみを受け取る
+   * - address: マルチキャストグループ (デフォルト 239.255.0.1)
+   * - port: ポート番号 (デフォルト 50100)
+   * - interface: 送受信に用いるインターフェースの IP アドレス。
+   *   127.0.0.1 とすると単一ホスト内のループバックマルチキャストとなる。
+   *   空の場合はシステムのデフォルト
+   * - ttl: マルチキャストの TTL (デフォルト 1)
+   * - loopback: 同一ホストの受信者にも配送するか (デフォルト YES)
+   * - datagram_size: ヘッダを含むデータグラムの最大長 (デフォルト 1472)
+   * - delivery: latest (新しいサンプルのみ、デフォルト) または ordered
+   *   (通番順)
+   * - reorder_window: 組み立て中、及び ordered で順番待ちのサンプルの
+   *   最大数 (デフォルト 8)
+   * - reorder_timeout: ordered で欠落したサンプルを待つ最大時間 [ms]
+   *   (デフォルト 100)
+   * - receive_buffer: 受信ソケットのバッファサイズ。0 はシステムのデフォ
+   *   ルト
+   * - max_sample_size: 受信するサンプルの最大長 (デフォルト 16777216)。
+   *   これを超えるサンプルは確保せずに捨て、drop として数える
+   *
+   * @else
+   * @class MulticastSettings
+   * @brief Settings of the udp_multicast interface
+   *
+   * Read from dataport.multicast of the connector profile.
+   *
+   * - stream: Stream ID of the OutPort, read from
+   *   dataport.outport.stream_id. Several OutPorts can share a group
+   *   and a port, and the receivers take only the data of their OutPort
+   *   by this ID.
+   * - address: Multicast group (239.255.0.1 by default)
+   * - port: Port number (50100 by default)
+   * - interface: IP address of the interface to send and receive. With
+   *   127.0.0.1 the multicast is looped back within a single host. The
+   *   system default if empty.
+   * - ttl: TTL of the multicast (1 by default)
+   * - loopback: Whether the receivers on the same host get the data
+   *   (YES by default)
+   * - datagram_size: Maximum size of a datagram including the header
+   *   (1472 by default)
+   * - delivery: latest (only newer samples, default) or ordered (in
+   *   the order of the sequence numbers)
+   * - reorder_window: Maximum number of the samples being reassembled,
+   *   and of the samples waiting for their turn with ordered (8 by
+   *   default)
+   * - reorder_timeout: Maximum time in ms to wait for a missing sample
+   *   with ordered (100 by default)
+   * - receive_buffer: Buffer size of the receiving socket. 0 is the
+   *   system default.
+   * - max_sample_size: Maximum length of a sample to receive
+   *   (16777216 by default). Longer samples are dropped without being
+   *   allocated, and counted as drop.
+   *
+   * @endif
+   */
+  struct MulticastSettings
+  {
+    MulticastSettings() = default;
+    explicit MulticastSettings(const coil::Properties& prop);
+
+    uint32_t stream{0};
+    std::string address{"239.255.0.1"};
+    unsigned short port{50100};
+    std::string interface_address;
+    int ttl{1};
+    bool loopback{true};
+    unsigned long datagram_size{1472};
+    bool ordered{false};
+    unsigned long reorder_window{8};
+    std::chrono::milliseconds reorder_timeout{100};
+    int receive_buffer{0};
+    unsigned long max_sample_size{16UL * 1024 * 1024};
+  };
+
+  /*!
+   * @if jp
+   * @class MulticastSender
+   * @brief マルチキャストグループへの送信
+   *
+   * サンプルをデータグラムに分割し、ヘッダ (ストリーム ID、通番、サン
+   * プル長、フラグメントの位置) を付けて送る。同一プロセス内で同じス
+   * トリームをグループとポートに送るコネクタ、即ちひとつの OutPort の
+   * コネクタはひとつの MulticastSender を共有する。
+   * OutPort が複数の InPort と接続している場合、各コネクタが同じサン
+   * プルを送ろうとするが、他のコネクタが送信済みのサンプルは送らない。
+   * このため、購読者の数によらずサンプルごとの送信は1回となる。
+   *
+   * @else
+   * @class MulticastSender
+   * @brief Sender to a multicast group
+   *
+   * Splits a sample into datagrams and sends them with a header (the
+   * stream ID, the sequence number, the sample length and the position
+   * of the fragment). The connectors in a process sending the same
+   * stream to the same group and port, that is the connectors of one
+   * OutPort, share one MulticastSender. When an OutPort is
+   * connected to several InPorts, each connector tries to send the same
+   * sample, but a sample already sent by another connector is not sent
+   * again. So each sample is sent once regardless of the number of the
+   * subscribers.
+   *
+   * @endif
+   */
+  class MulticastSender
+  {
+  public:
+    ~MulticastSender();
+    MulticastSender(const MulticastSender&) = delete;
+    MulticastSender& operator=(const MulticastSender&) = delete;
+
+    /*!
+     * @if jp
+     * @brief ストリーム、グループとポートに対応する送信者を取得する
+     * @return 送信者。ソケットを開けない場合は空
+     * @else
+     * @brief Get the sender of the stream to the group and the port
+     * @return The sender. Empty if the socket cannot be opened.
+     * @endif
+     */
+    static std::shared_ptr<MulticastSender>
+    get(const MulticastSettings& settings);
+
+    /*!
+     * @if jp
+     * @brief 最後に送ったサンプルの通番
+     *
+     * コネクタが送信者を取得したときに、送信済みの通番の初期値とする。
+     *
+     * @else
+     * @brief Sequence number of the last sample sent
+     *
+     * Used as the initial sequence number sent by a connector when the
+     * connector gets the sender.
+     *
+     * @endif
+     */
+    uint32_t sequence();
+
+    /*!
+     * @if jp
+     * @brief サンプルを送る
+     *
+     * last より後に他のコネクタが同じ内容のサンプルを送っていれば送ら
+     * ない。
+     *
+     * @param last コネクタが最後に送った通番。送信後に更新される
+     * @param data サンプル
+     *
+     * @else
+     * @brief Send a sample
+     *
+     * Not sent if another connector has sent a sample with the same
+     * content after last.
+     *
+     * @param last Sequence number the connector sent last. Updated
+     *             after the send.
+     * @param data Sample
+     *
+     * @endif
+     */
+    DataPortStatus send(uint32_t& last, const ByteData& data);
+
+  private:
+    explicit MulticastSender(const MulticastSettings& settings);
+    bool open();
+
+    MulticastSettings m_settings;
+    int m_socket{-1};
+    uint32_t m_stream;
+    uint32_t m_sequence{0};
+    std::deque<std::pair<uint32_t, ByteData>> m_history;
+    std::mutex m_mutex;
+  };
+
+  /*!
+   * @if jp
+   * @class MulticastReassembler
+   * @brief 受信したデータグラムからのサンプルの組み立て
+   *
+   * フラグメントからサンプルを組み立て、通番から欠落と順序の入れ替わ
+   * りを検出する。latest では前に渡したサンプルより新しいサンプルのみ
+   * を渡し、遅れて届いたサンプルは捨てる。ordered では欠落したサンプル
+   * を reorder_window 個または reorder_timeout まで待ち、通番順に渡す。
+   * 諦めたサンプルを lost、遅れて届いたサンプルを reordered として数え
+   * る。setStream() で設定したストリーム以外のデータグラムは捨てる。
+   *
+   * @else
+   * @class MulticastReassembler
+   * @brief Reassembly of the samples from the received datagrams
+   *
+   * Reassembles the samples from the fragments, and detects the losses
+   * and the reorders from the sequence numbers. With latest only the
+   * samples newer than the previously delivered one are delivered, and
+   * late samples are discarded. With ordered a missing sample is waited
+   * for up to reorder_window samples or reorder_timeout, and the
+   * samples are delivered in the order of the sequence numbers. The
+   * samples given up are counted as lost, and the late samples as
+   * reordered. The datagrams of the streams other than the one set by
+   * setStream() are discarded.
+   *
+   * @endif
+   */
+  class MulticastReassembler
+  {
+  public:
+    explicit MulticastReassembler(const MulticastSettings& settings);
+
+    void setStatistics(ConnectorStatistics* statistics)
+    {
+      m_statistics = statistics;
+    }
+
+    /*!
+     * @if jp
+     * @brief 受け取るストリームを設定する
+     *
+     * 受信スレッドとは別のスレッドから呼べる。0 の間は全てのデータグ
+     * ラムを捨てる。
+     *
+     * @param stream OutPort のストリーム ID
+     * @else
+     * @brief Set the stream to take
+     *
+     * Can be called from a thread other than the receiving thread. All
+     * the datagrams are discarded while it is 0.
+     *
+     * @param stream Stream ID of the OutPort
+     * @endif
+     */
+    void setStream(uint32_t stream)
+    {
+      m_stream = stream;
+    }
+
+    /*!
+     * @if jp
+     * @brief データグラムを受け取る
+     * @param datagram 受信したデータグラム
+     * @param length データグラムの長さ
+     * @param samples 渡せるようになったサンプルが追加される
+     * @else
+     * @brief Take a datagram
+     * @param datagram Received datagram
+     * @param length Length of the datagram
+     * @param samples The samples ready to be delivered are appended
+     * @endif
+     */
+    void receive(const unsigned char* datagram, unsigned long length,
+                 std::vector<ByteData>& samples);
+
+    /*!
+     * @if jp
+     * @brief reorder_timeout を過ぎた欠落を諦める
+     * @param samples 渡せるようになったサンプルが追加される
+     * @else
+     * @brief Give up the missing samples past reorder_timeout
+     * @param samples The samples ready to be delivered are appended
+     * @endif
+     */
+    void expire(std::vector<ByteData>& samples);
+
+  private:
+    struct SequenceLess
+    {
+      bool operator()(uint32_t a, uint32_t b) const
+      {
+        return static_cast<int32_t>(a - b) < 0;
+      }
+    };
+
+    struct Partial
+    {
+      ByteData data;
+      std::vector<bool> received;
+      size_t remaining{0};
+    };
+
+    void complete(uint32_t sequence, ByteData& data,
+                  std::vector<ByteData>& samples);
+    void skipTo(uint32_t sequence, std::vector<ByteData>& samples);
+    void flush(std::vector<ByteData>& samples);
+    void countLost(uint32_t count);
+    void countReordered();
+
+    bool m_ordered;
+    unsigned long m_window;
+    std::chrono::milliseconds m_timeout;
+    unsigned long m_maxSampleSize;
+    std::atomic<uint32_t> m_stream{0};
+    bool m_started{false};
+    uint32_t m_next{0};
+    std::map<uint32_t, Partial, SequenceLess> m_partials;
+    std::map<uint32_t, ByteData, SequenceLess> m_held;
+    std::chrono::steady_clock::time_point m_heldSince;
+    ConnectorStatistics* m_statistics{nullptr};
+  };
+
+  /*!
+   * @if jp
+   * @brief マルチキャストグループに参加した受信ソケットを開く
+   * @return ソケット。失敗した場合は -1
+   * @else
+   * @brief Open a receiving socket joined to the multicast group
+   * @return The socket. -1 on failure.
+   * @endif
+   */
+  int openMulticastReceiver(const MulticastSettings& settings);
+
+  /*!
+   * @if jp
+   * @brief ソケットを閉じる
+   * @else
+   * @brief Close the socket
+   * @endif
+   */
+  void closeMulticastSocket(int socket);
+} // namespace RTC
+
+#endif // RTC_MULTICASTCHANNEL_H
@@ -0,0 +1,270 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  MulticastInPort.cpp
+ * @brief MulticastInPort class
+ * @date  $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *
+ *     All rights reserved.
+ *
+ *
+ */
+
+#include "MulticastInPort.h"
+#include <rtm/NVUtil.h>
+#include <rtm/InPortConnector.h>
+
+#include <poll.h>
+#include <sys/socket.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @brief コンストラクタ
+   * @else
+   * @brief Constructor
+   * @endif
+   */
+  MulticastInPort::MulticastInPort()
+  {
+    // PortProfile setting
+    setInterfaceType("udp_multicast");
+  }
+
+  /*!
+   * @if jp
+   * @brief デストラクタ
+   * @else
+   * @brief Destructor
+   * @endif
+   */
+  MulticastInPort::~MulticastInPort()
+  {
+    RTC_PARANOID(("~MulticastInPort()"));
+    m_running = false;
+    if (m_thread.joinable())
+      {
+        m_thread.join();
+      }
+    closeMulticastSocket(m_socket);
+  }
+
+  /*!
+   * @if jp
+   * @brief 設定初期化
+   * @else
+   * @brief Initializing configuration
+   * @endif
+   */
+  void MulticastInPort::init(coil::Properties& /*prop*/)
+  {
+  }
+
+  /*!
+   * @if jp
+   * @brief バッファをセットする
+   * @else
+   * @brief Setting outside buffer's pointer
+   * @endif
+   */
+  void MulticastInPort::setBuffer(BufferBase<ByteData>* buffer)
+  {
+    m_buffer = buffer;
+  }
+
+  /*!
+   * @if jp
+   * @brief リスナを設定する
+   * @else
+   * @brief Set the listener
+   * @endif
+   */
+  void MulticastInPort::setListener(ConnectorInfo& info,
+                                    ConnectorListenersBase* listeners)
+  {
+    m_profile = info;
+    m_listeners = listeners;
+  }
+
+  /*!
+   * @if jp
+   * @brief Connectorを設定する。
+   * @else
+   * @brief set Connector
+   * @endif
+   */
+  void MulticastInPort::setConnector(InPortConnector* connector)
+  {
+    m_connector = connector;
+    if (m_socket < 0 || m_running) { return; }
+
+    m_reassembler.reset(new MulticastReassembler(m_settings));
+    m_reassembler->setStatistics(&m_profile.statistics());
+    m_reassembler->setStream(m_settings.stream);
+    m_running = true;
+    m_thread = std::thread([this] { svc(); });
+  }
+
+  /*!
+   * @if jp
+   * @brief Interface情報を公開する
+   * @else
+   * @brief Publish Interface information
+   * @endif
+   */
+  bool MulticastInPort::publishInterface(SDOPackage::NVList& properties)
+  {
+    if (!InPortProvider::publishInterface(properties)) { return false; }
+    if (m_socket >= 0) { return true; }
+
+    coil::Properties prop;
+    NVUtil::copyToProperties(prop, properties);
+    m_settings = MulticastSettings(prop.getNode("dataport"));
+    m_socket = openMulticastReceiver(m_settings);
+    if (m_socket < 0)
+      {
+        RTC_ERROR(("cannot join the multicast group %s:%d",
+                   m_settings.address.c_str(), m_settings.port));
+        return false;
+      }
+    RTC_DEBUG(("joined the multicast group %s:%d",
+               m_settings.address.c_str(), m_settings.port));
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief 接続先の Interface 情報を受け取る
+   * @else
+   * @brief Receive the interface information of the peer
+   * @endif
+   */
+  bool MulticastInPort::subscribeInterface(const SDOPackage::NVList& properties)
+  {
+    coil::Properties prop;
+    NVUtil::copyToProperties(prop, properties);
+    uint32_t stream(MulticastSettings(prop.getNode("dataport")).stream);
+    if (stream == 0)
+      {
+        RTC_ERROR(("dataport.outport.stream_id not found"));
+        return false;
+      }
+    RTC_DEBUG(("taking the stream %u", stream));
+    m_settings.stream = stream;
+    if (m_reassembler) { m_reassembler->setStream(stream); }
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief 受信スレッド
+   * @else
+   * @brief Receiving thread
+   * @endif
+   */
+  void MulticastInPort::svc()
+  {
+    std::vector<unsigned char> datagram(65536);
+    std::vector<ByteData> samples;
+    pollfd fd{m_socket, POLLIN, 0};
+    // polled at least every 100 ms to stop the thread and to expire
+    // the missing samples with ordered
+    int timeout(static_cast<int>(std::max<long long>(
+      1, std::min<long long>(100, m_settings.reorder_timeout.count()))));
+
+    while (m_running)
+      {
+        samples.clear();
+        if (::poll(&fd, 1, timeout) > 0)
+          {
+            ssize_t length(::recv(m_socket, datagram.data(),
+                                  datagram.size(), 0));
+            if (length > 0)
+              {
+                m_reassembler->receive(datagram.data(),
+                                       static_cast<unsigned long>(length),
+                                       samples);
+              }
+          }
+        m_reassembler->expire(samples);
+        for (auto& sample : samples)
+          {
+            put(sample);
+          }
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 受信データをバッファに書き込む
+   * @else
+   * @brief Write the received data into the buffer
+   * @endif
+   */
+  void MulticastInPort::put(ByteData& data)
+  {
+    RTC_PARANOID(("MulticastInPort::put()"));
+    RTC_VERBOSE(("read data length:%d", data.getDataLength()));
+    if (m_connector == nullptr)
+      {
+        onReceiverError(data);
+        return;
+      }
+    onReceived(data);
+    BufferStatus ret = m_connector->write(data);
+    convertReturn(ret, data);
+  }
+
+  /*!
+   * @if jp
+   * @brief リターンコード変換
+   * @else
+   * @brief Return codes conversion
+   * @endif
+   */
+  void MulticastInPort::convertReturn(BufferStatus status, ByteData& data)
+  {
+    switch (status)
+      {
+      case BufferStatus::OK:
+        onBufferWrite(data);
+        return;
+
+      case BufferStatus::BUFFER_ERROR:
+        onReceiverError(data);
+        return;
+
+      case BufferStatus::FULL:
+        onBufferFull(data);
+        onReceiverFull(data);
+        return;
+
+      case BufferStatus::EMPTY:
+        // never come here
+        return;
+
+      case BufferStatus::PRECONDITION_NOT_MET:
+        onReceiverError(data);
+        return;
+
+      case BufferStatus::TIMEOUT:
+        onBufferWriteTimeout(data);
+        onReceiverTimeout(data);
+        return;
+
+      case BufferStatus::NOT_SUPPORTED:
+
+      default:
+        onReceiverError(data);
+        return;
+      }
+  }
+} // namespace RTC
@@ -0,0 +1,204 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  MulticastInPort.h
+ * @brief MulticastInPort class
+ * @date  $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *
+ *     All rights reserved.
+ *
+ *
+ */
+
+#ifndef RTC_MULTICASTINPORT_H
+#define RTC_MULTICASTINPORT_H
+
+#include <rtm/BufferBase.h>
+#include <rtm/InPortProvider.h>
+#include <rtm/ConnectorListener.h>
+#include <rtm/ConnectorBase.h>
+#include "MulticastChannel.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class MulticastInPort
+   * @brief MulticastInPort クラス
+   *
+   * InPortProvider
+   *
+   * UDP マルチキャストでデータを受信する InPort プロバイダ。接続時に
+   * dataport.multicast.address のグループに参加し、受信スレッドで組み
+   * 立てたサンプルをバッファに書き込む。欠落と順序の入れ替わりはコネ
+   * クタの統計の lost と reordered に数える。
+   *
+   * @else
+   * @class MulticastInPort
+   * @brief MulticastInPort class
+   *
+   * InPortProvider
+   *
+   * The InPort provider receiving the data by UDP multicast. It joins
+   * the group of dataport.multicast.address on connection, and a
+   * receiving thread writes the reassembled samples into the buffer.
+   * The losses and the reorders are counted in lost and reordered of
+   * the connector statistics.
+   *
+   * @endif
+   */
+  class MulticastInPort
+    : public InPortProvider
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @else
+     * @brief Constructor
+     * @endif
+     */
+    MulticastInPort();
+
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     *
+     * 受信スレッドを停止し、グループから離脱する。
+     *
+     * @else
+     * @brief Destructor
+     *
+     * Stops the receiving thread and leaves the group.
+     *
+     * @endif
+     */
+    ~MulticastInPort() override;
+
+    void init(coil::Properties& prop) override;
+
+    void setBuffer(BufferBase<ByteData>* buffer) override;
+
+    void setListener(ConnectorInfo& info,
+                     ConnectorListenersBase* listeners) override;
+
+    /*!
+     * @if jp
+     * @brief Connectorを設定する。
+     *
+     * 受信スレッドを開始する。
+     *
+     * @else
+     * @brief set Connector
+     *
+     * Starts the receiving thread.
+     *
+     * @endif
+     */
+    void setConnector(InPortConnector* connector) override;
+
+    /*!
+     * @if jp
+     * @brief Interface情報を公開する
+     *
+     * コネクタプロファイルの dataport.multicast 以下の設定でグループに
+     * 参加する。参加できない場合は接続を失敗させる。
+     *
+     * @else
+     * @brief Publish Interface information
+     *
+     * Joins the group with dataport.multicast of the connector profile.
+     * The connection fails if it cannot join.
+     *
+     * @endif
+     */
+    bool publishInterface(SDOPackage::NVList& properties) override;
+
+    /*!
+     * @if jp
+     * @brief 接続先の Interface 情報を受け取る
+     *
+     * dataport.outport.stream_id のストリームのみを受け取るように設定
+     * する。同じグループとポートを共有する他の OutPort のデータは捨て
+     * る。
+     *
+     * @else
+     * @brief Receive the interface information of the peer
+     *
+     * Sets up to take only the stream of dataport.outport.stream_id.
+     * The data of the other OutPorts sharing the group and the port are
+     * discarded.
+     *
+     * @endif
+     */
+    bool subscribeInterface(const SDOPackage::NVList& properties) override;
+
+  private:
+    void svc();
+    void put(ByteData& data);
+    void convertReturn(BufferStatus status, ByteData& data);
+
+    inline void onBufferWrite(ByteData& data)
+    {
+      m_listeners->notifyIn(ConnectorDataListenerType::ON_BUFFER_WRITE,
+                            m_profile, data);
+    }
+
+    inline void onBufferFull(ByteData& data)
+    {
+      m_listeners->notifyIn(ConnectorDataListenerType::ON_BUFFER_FULL,
+                            m_profile, data);
+    }
+
+    inline void onBufferWriteTimeout(ByteData& data)
+    {
+      m_listeners->notifyIn(ConnectorDataListenerType::ON_BUFFER_WRITE_TIMEOUT,
+                            m_profile, data);
+    }
+
+    inline void onReceived(ByteData& data)
+    {
+      m_listeners->notifyIn(ConnectorDataListenerType::ON_RECEIVED,
+                            m_profile, data);
+    }
+
+    inline void onReceiverFull(ByteData& data)
+    {
+      m_listeners->notifyIn(ConnectorDataListenerType::ON_RECEIVER_FULL,
+                            m_profile, data);
+    }
+
+    inline void onReceiverTimeout(ByteData& data)
+    {
+      m_listeners->notifyIn(ConnectorDataListenerType::ON_RECEIVER_TIMEOUT,
+                            m_profile, data);
+    }
+
+    inline void onReceiverError(ByteData& data)
+    {
+      m_listeners->notifyIn(ConnectorDataListenerType::ON_RECEIVER_ERROR,
+                            m_profile, data);
+    }
+
+    CdrBufferBase* m_buffer{nullptr};
+    ConnectorListenersBase* m_listeners{nullptr};
+    ConnectorInfo m_profile;
+    InPortConnector* m_connector{nullptr};
+
+    MulticastSettings m_settings;
+    std::unique_ptr<MulticastReassembler> m_reassembler;
+    int m_socket{-1};
+    std::atomic<bool> m_running{false};
+    std::thread m_thread;
+  };
+} // namespace RTC
+
+#endif // RTC_MULTICASTINPORT_H
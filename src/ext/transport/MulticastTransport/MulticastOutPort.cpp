@@ -0,0 +1,138 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  MulticastOutPort.cpp
+ * @brief MulticastOutPort class
+ * @date  $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *
+ *     All rights reserved.
+ *
+ *
+ */
+
+#include "MulticastOutPort.h"
+#include <rtm/NVUtil.h>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @brief コンストラクタ
+   * @else
+   * @brief Constructor
+   * @endif
+   */
+  MulticastOutPort::MulticastOutPort()
+    : rtclog("MulticastOutPort")
+  {
+  }
+
+  /*!
+   * @if jp
+   * @brief デストラクタ
+   * @else
+   * @brief Destructor
+   * @endif
+   */
+  MulticastOutPort::~MulticastOutPort()
+  {
+    RTC_PARANOID(("~MulticastOutPort()"));
+  }
+
+  /*!
+   * @if jp
+   * @brief 設定初期化
+   * @else
+   * @brief Initializing configuration
+   * @endif
+   */
+  void MulticastOutPort::init(coil::Properties& /*prop*/)
+  {
+  }
+
+  /*!
+   * @if jp
+   * @brief データの送信
+   * @else
+   * @brief Send the data
+   * @endif
+   */
+  DataPortStatus MulticastOutPort::put(ByteData& data)
+  {
+    RTC_PARANOID(("put()"));
+    RTC_VERBOSE(("Data size:%d", data.getDataLength()));
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (!m_sender)
+      {
+        return DataPortStatus::PRECONDITION_NOT_MET;
+      }
+    return m_sender->send(m_last, data);
+  }
+
+  /*!
+   * @if jp
+   * @brief InterfaceProfile情報を公開する
+   * @else
+   * @brief Publish InterfaceProfile information
+   * @endif
+   */
+  void MulticastOutPort::
+  publishInterfaceProfile(SDOPackage::NVList& /*properties*/)
+  {
+  }
+
+  /*!
+   * @if jp
+   * @brief データ送信通知への登録
+   * @else
+   * @brief Subscribe to the data sending notification
+   * @endif
+   */
+  bool MulticastOutPort::
+  subscribeInterface(const SDOPackage::NVList& properties)
+  {
+    RTC_TRACE(("subscribeInterface()"));
+    RTC_DEBUG_STR((NVUtil::toString(properties)));
+
+    coil::Properties prop;
+    NVUtil::copyToProperties(prop, properties);
+    MulticastSettings settings(prop.getNode("dataport"));
+    if (settings.stream == 0)
+      {
+        RTC_ERROR(("dataport.outport.stream_id not found"));
+        return false;
+      }
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_sender = MulticastSender::get(settings);
+    if (!m_sender)
+      {
+        RTC_ERROR(("cannot send to the multicast group %s:%d",
+                   settings.address.c_str(), settings.port));
+        return false;
+      }
+    m_last = m_sender->sequence();
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief データ送信通知からの登録解除
+   * @else
+   * @brief Unsubscribe the data send notification
+   * @endif
+   */
+  void MulticastOutPort::
+  unsubscribeInterface(const SDOPackage::NVList& properties)
+  {
+    RTC_TRACE(("unsubscribeInterface()"));
+    RTC_DEBUG_STR((NVUtil::toString(properties)));
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_sender.reset();
+  }
+} // namespace RTC
@@ -0,0 +1,125 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  MulticastOutPort.h
+ * @brief MulticastOutPort class
+ * @date  $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *
+ *     All rights reserved.
+ *
+ *
+ */
+
+#ifndef RTC_MULTICASTOUTPORT_H
+#define RTC_MULTICASTOUTPORT_H
+
+#include <rtm/InPortConsumer.h>
+#include <rtm/SystemLogger.h>
+#include "MulticastChannel.h"
+
+#include <memory>
+#include <mutex>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class MulticastOutPort
+   * @brief MulticastOutPort クラス
+   *
+   * InPortConsumer
+   *
+   * UDP マルチキャストでデータを送信する InPort コンシューマ。同じ
+   * OutPort のコネクタは MulticastSender を共有し、OutPort の各サンプ
+   * ルは購読者の数によらず1回だけ送られる。データグラムには OutPort
+   * のストリーム ID が付くため、複数の OutPort が同じグループとポート
+   * を共有できる。
+   *
+   * @else
+   * @class MulticastOutPort
+   * @brief MulticastOutPort class
+   *
+   * InPortConsumer
+   *
+   * The InPort consumer sending the data by UDP multicast. The
+   * connectors of the same OutPort share a MulticastSender, and each
+   * sample of the OutPort is sent once regardless of the number of the
+   * subscribers. The datagrams carry the stream ID of the OutPort, so
+   * several OutPorts can share a group and a port.
+   *
+   * @endif
+   */
+  class MulticastOutPort
+    : public InPortConsumer
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @else
+     * @brief Constructor
+     * @endif
+     */
+    MulticastOutPort();
+
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     * @else
+     * @brief Destructor
+     * @endif
+     */
+    ~MulticastOutPort() override;
+
+    void init(coil::Properties& prop) override;
+
+    /*!
+     * @if jp
+     * @brief データの送信
+     *
+     * 同じ OutPort の他のコネクタが送信済みのサンプルは送らない。
+     *
+     * @else
+     * @brief Send the data
+     *
+     * The sample already sent by another connector of the same OutPort
+     * is not sent.
+     *
+     * @endif
+     */
+    DataPortStatus put(ByteData& data) override;
+
+    void publishInterfaceProfile(SDOPackage::NVList& properties) override;
+
+    /*!
+     * @if jp
+     * @brief データ送信通知への登録
+     *
+     * コネクタプロファイルの dataport.multicast 以下の設定で送信用のソ
+     * ケットを開く。dataport.outport.stream_id がない場合は失敗する。
+     *
+     * @else
+     * @brief Subscribe to the data sending notification
+     *
+     * Opens the sending socket with dataport.multicast of the connector
+     * profile. Fails without dataport.outport.stream_id.
+     *
+     * @endif
+     */
+    bool subscribeInterface(const SDOPackage::NVList& properties) override;
+
+    void unsubscribeInterface(const SDOPackage::NVList& properties) override;
+
+  private:
+    mutable Logger rtclog;
+    std::shared_ptr<MulticastSender> m_sender;
+    uint32_t m_last{0};
+    std::mutex m_mutex;
+  };
+} // namespace RTC
+
+#endif // RTC_MULTICASTOUTPORT_H
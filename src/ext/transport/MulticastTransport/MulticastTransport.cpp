@@ -0,0 +1,50 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  MulticastTransport.cpp
+ * @brief UDP multicast transport module
+ * @date  $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *
+ *     All rights reserved.
+ *
+ *
+ */
+
+#include "MulticastTransport.h"
+#include "MulticastOutPort.h"
+#include "MulticastInPort.h"
+
+extern "C"
+{
+  /*!
+   * @if jp
+   * @brief モジュール初期化関数
+   * @else
+   * @brief Module initialization
+   * @endif
+   */
+  void MulticastTransportInit(RTC::Manager* /*manager*/)
+  {
+    {
+      RTC::InPortProviderFactory& factory(RTC::InPortProviderFactory::instance());
+      factory.addFactory("udp_multicast",
+                        ::coil::Creator< ::RTC::InPortProvider,
+                                          ::RTC::MulticastInPort>,
+                        ::coil::Destructor< ::RTC::InPortProvider,
+                                            ::RTC::MulticastInPort>);
+    }
+
+    {
+      RTC::InPortConsumerFactory& factory(RTC::InPortConsumerFactory::instance());
+      factory.addFactory("udp_multicast",
+                        ::coil::Creator< ::RTC::InPortConsumer,
+                                          ::RTC::MulticastOutPort>,
+                        ::coil::Destructor< ::RTC::InPortConsumer,
+                                            ::RTC::MulticastOutPort>);
+    }
+  }
+}
@@ -0,0 +1,42 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  MulticastTransport.h
+ * @brief UDP multicast transport module
+ * @date  $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *
+ *     All rights reserved.
+ *
+ *
+ */
+
+#ifndef RTC_MULTICASTTRANSPORT_H
+#define RTC_MULTICASTTRANSPORT_H
+
+#include <rtm/Manager.h>
+
+extern "C"
+{
+  /*!
+   * @if jp
+   * @brief モジュール初期化関数
+   *
+   * MulticastOutPort、MulticastInPort のファクトリをインターフェース型
+   * udp_multicast として登録する初期化関数。
+   *
+   * @else
+   * @brief Module initialization
+   *
+   * Registers the factories of MulticastOutPort and MulticastInPort as
+   * the interface type udp_multicast.
+   *
+   * @endif
+   */
+  DLL_EXPORT void MulticastTransportInit(RTC::Manager* manager);
+}
+
+#endif // RTC_MULTICASTTRANSPORT_H
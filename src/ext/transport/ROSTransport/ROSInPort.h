@@ -628,7 +628,7 @@ namespace RTC
       {
         
         m_cdr.setDataLength(size + ROSMsglenSize);
-        memcpy(m_cdr.getBuffer() + ROSMsglenSize, buffer.get(), size);
+        memcpy(m_cdr.mutableBuffer() + ROSMsglenSize, buffer.get(), size);
         
         onReceiverError(m_cdr);
       }
@@ -638,7 +638,7 @@ namespace RTC
         RTC_PARANOID(("received data size: %d", size));
 
         m_cdr.setDataLength(size + ROSMsglenSize);
-        memcpy(m_cdr.getBuffer() + ROSMsglenSize, buffer.get(), size);
+        memcpy(m_cdr.mutableBuffer() + ROSMsglenSize, buffer.get(), size);
 
         RTC_PARANOID(("converted CDR data size: %d", m_cdr.getDataLength()));
 
@@ -137,7 +137,7 @@ namespace RTC
     }
 
     data.setDataLength(shm_get_address(m_sens_sid)->size);
-    SSM_tid tid = readSSM_time(m_sens_sid, reinterpret_cast<char*>(data.getBuffer()), measured_time, &time);
+    SSM_tid tid = readSSM_time(m_sens_sid, reinterpret_cast<char*>(data.mutableBuffer()), measured_time, &time);
 
     RTC_PARANOID(("data length: %d",  data.getDataLength()));
     RTC_PARANOID(("data count: %d",  tid));
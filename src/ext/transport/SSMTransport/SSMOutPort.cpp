@@ -116,7 +116,7 @@ namespace RTC
       }
     }
     ssmTimeT measured_time = 0;
-    writeSSM(m_sens_sid, reinterpret_cast<char*>(data.getBuffer()), measured_time);
+    writeSSM(m_sens_sid, reinterpret_cast<const char*>(data.getBuffer()), measured_time);
     return DataPortStatus::PORT_OK;
     
   }
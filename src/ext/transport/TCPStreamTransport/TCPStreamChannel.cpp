@@ -0,0 +1,352 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  TCPStreamChannel.cpp
+ * @brief Settings and sockets of the tcp_stream transport
+ * @date  $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *
+ *     All rights reserved.
+ *
+ *
+ */
+
+#include "TCPStreamChannel.h"
+#include <coil/stringutil.h>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <ifaddrs.h>
+#include <net/if.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/sockios.h>
+#endif
+
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+  bool setOption(int socket, int level, int name, int value)
+  {
+    return ::setsockopt(socket, level, name, &value, sizeof(value)) == 0;
+  }
+
+  bool setNonBlocking(int socket)
+  {
+    int flags(::fcntl(socket, F_GETFL, 0));
+    return flags >= 0 && ::fcntl(socket, F_SETFL, flags | O_NONBLOCK) == 0;
+  }
+
+  std::string toString(const in_addr& addr)
+  {
+    char str[INET_ADDRSTRLEN];
+    if (inet_ntop(AF_INET, &addr, str, sizeof(str)) == nullptr)
+      {
+        return "";
+      }
+    return str;
+  }
+
+  // the addresses of the interfaces that are up, loopback last
+  std::vector<std::string> interfaceAddresses()
+  {
+    std::vector<std::string> addresses, loopbacks;
+    ifaddrs* list(nullptr);
+    if (::getifaddrs(&list) != 0) { return addresses; }
+    for (ifaddrs* ifa(list); ifa != nullptr; ifa = ifa->ifa_next)
+      {
+        if (ifa->ifa_addr == nullptr || ifa->ifa_addr->sa_family != AF_INET ||
+            (ifa->ifa_flags & IFF_UP) == 0)
+          {
+            continue;
+          }
+        std::string address(toString(
+          reinterpret_cast<sockaddr_in*>(ifa->ifa_addr)->sin_addr));
+        if (address.empty()) { continue; }
+        if ((ifa->ifa_flags & IFF_LOOPBACK) != 0)
+          {
+            loopbacks.push_back(address);
+          }
+        else
+          {
+            addresses.push_back(address);
+          }
+      }
+    ::freeifaddrs(list);
+    addresses.insert(addresses.end(), loopbacks.begin(), loopbacks.end());
+    return addresses;
+  }
+
+  int connectTo(const sockaddr* addr, socklen_t length,
+                const RTC::TCPStreamSettings& settings)
+  {
+    int sock(::socket(AF_INET, SOCK_STREAM, 0));
+    if (sock < 0) { return -1; }
+    // the buffer sizes are set before connect() to take effect on the
+    // window negotiation
+    if (!RTC::setupTCPStreamSocket(sock, settings))
+      {
+        RTC::closeTCPStreamSocket(sock);
+        return -1;
+      }
+    if (::connect(sock, addr, length) != 0)
+      {
+        if (errno != EINPROGRESS)
+          {
+            RTC::closeTCPStreamSocket(sock);
+            return -1;
+          }
+        pollfd fd{sock, POLLOUT, 0};
+        int error(0);
+        socklen_t size(sizeof(error));
+        if (::poll(&fd, 1,
+                   static_cast<int>(settings.connect_timeout.count())) <= 0 ||
+            ::getsockopt(sock, SOL_SOCKET, SO_ERROR, &error, &size) != 0 ||
+            error != 0)
+          {
+            RTC::closeTCPStreamSocket(sock);
+            return -1;
+          }
+      }
+    return sock;
+  }
+} // namespace
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @brief プロパティから設定を読み出すコンストラクタ
+   * @else
+   * @brief Constructor reading the settings from the properties
+   * @endif
+   */
+  TCPStreamSettings::TCPStreamSettings(const coil::Properties& prop)
+  {
+    address = coil::eraseBothEndsBlank(prop.getProperty("tcp_stream.address"));
+    coil::stringTo(port, prop.getProperty("tcp_stream.port", "0").c_str());
+    nodelay = coil::toBool(prop.getProperty("tcp_stream.nodelay"),
+                           "YES", "NO", true);
+    coil::stringTo(send_buffer,
+                   prop.getProperty("tcp_stream.send_buffer", "0").c_str());
+    coil::stringTo(receive_buffer,
+                   prop.getProperty("tcp_stream.receive_buffer", "0").c_str());
+    coil::stringTo(send_queue,
+                   prop.getProperty("tcp_stream.send_queue", "0").c_str());
+    unsigned long timeout(3000);
+    coil::stringTo(timeout,
+                   prop.getProperty("tcp_stream.connect_timeout",
+                                    "3000").c_str());
+    connect_timeout = std::chrono::milliseconds(timeout);
+    if (!coil::stringTo(max_frame_size,
+                        prop.getProperty("tcp_stream.max_frame_size",
+                                         "67108864").c_str()) ||
+        max_frame_size == 0 || max_frame_size > 0xffffffffUL)
+      {
+        max_frame_size = 64UL * 1024 * 1024;
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief フレームヘッダを書き込む
+   * @else
+   * @brief Write the frame header
+   * @endif
+   */
+  void putFrameHeader(unsigned char* header, uint32_t length)
+  {
+    header[0] = static_cast<unsigned char>(length >> 24);
+    header[1] = static_cast<unsigned char>(length >> 16);
+    header[2] = static_cast<unsigned char>(length >> 8);
+    header[3] = static_cast<unsigned char>(length);
+  }
+
+  /*!
+   * @if jp
+   * @brief フレームヘッダを読み出す
+   * @else
+   * @brief Read the frame header
+   * @endif
+   */
+  uint32_t getFrameHeader(const unsigned char* header)
+  {
+    return (static_cast<uint32_t>(header[0]) << 24) |
+      (static_cast<uint32_t>(header[1]) << 16) |
+      (static_cast<uint32_t>(header[2]) << 8) |
+      static_cast<uint32_t>(header[3]);
+  }
+
+  /*!
+   * @if jp
+   * @brief 待ち受けソケットを開く
+   * @else
+   * @brief Open a listening socket
+   * @endif
+   */
+  int openTCPStreamListener(const TCPStreamSettings& settings,
+                            std::string& endpoints)
+  {
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(settings.port);
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (!settings.address.empty() &&
+        inet_pton(AF_INET, settings.address.c_str(), &addr.sin_addr) != 1)
+      {
+        return -1;
+      }
+
+    int sock(::socket(AF_INET, SOCK_STREAM, 0));
+    if (sock < 0) { return -1; }
+    // the accepted sockets inherit the receive buffer size
+    bool ok(setOption(sock, SOL_SOCKET, SO_REUSEADDR, 1) &&
+            setupTCPStreamSocket(sock, settings) &&
+            ::bind(sock, reinterpret_cast<sockaddr*>(&addr),
+                   sizeof(addr)) == 0 &&
+            ::listen(sock, SOMAXCONN) == 0);
+    socklen_t length(sizeof(addr));
+    ok = ok && ::getsockname(sock, reinterpret_cast<sockaddr*>(&addr),
+                             &length) == 0;
+    if (!ok)
+      {
+        closeTCPStreamSocket(sock);
+        return -1;
+      }
+
+    std::string port(coil::otos(ntohs(addr.sin_port)));
+    std::vector<std::string> hosts;
+    if (addr.sin_addr.s_addr == htonl(INADDR_ANY))
+      {
+        hosts = interfaceAddresses();
+      }
+    else
+      {
+        hosts.push_back(toString(addr.sin_addr));
+      }
+    endpoints.clear();
+    for (auto& host : hosts)
+      {
+        if (!endpoints.empty()) { endpoints += ","; }
+        endpoints += host + ":" + port;
+      }
+    return sock;
+  }
+
+  /*!
+   * @if jp
+   * @brief 受け付けたソケットを設定する
+   * @else
+   * @brief Set up an accepted socket
+   * @endif
+   */
+  bool setupTCPStreamSocket(int socket, const TCPStreamSettings& settings)
+  {
+    bool ok(setNonBlocking(socket));
+    if (ok && settings.nodelay)
+      {
+        ok = setOption(socket, IPPROTO_TCP, TCP_NODELAY, 1);
+      }
+    if (ok && settings.send_buffer > 0)
+      {
+        ok = setOption(socket, SOL_SOCKET, SO_SNDBUF, settings.send_buffer);
+      }
+    if (ok && settings.receive_buffer > 0)
+      {
+        ok = setOption(socket, SOL_SOCKET, SO_RCVBUF,
+                       settings.receive_buffer);
+      }
+    return ok;
+  }
+
+  /*!
+   * @if jp
+   * @brief 接続する
+   * @else
+   * @brief Connect
+   * @endif
+   */
+  int connectTCPStream(const std::string& endpoints,
+                       const TCPStreamSettings& settings)
+  {
+    for (auto& endpoint : coil::split(endpoints, ","))
+      {
+        std::string::size_type pos(endpoint.rfind(':'));
+        if (pos == std::string::npos) { continue; }
+        std::string host(endpoint.substr(0, pos));
+        std::string port(endpoint.substr(pos + 1));
+
+        addrinfo hints;
+        memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_flags = AI_NUMERICSERV;
+        addrinfo* result(nullptr);
+        if (::getaddrinfo(host.c_str(), port.c_str(), &hints, &result) != 0)
+          {
+            continue;
+          }
+        int sock(-1);
+        for (addrinfo* ai(result); ai != nullptr && sock < 0;
+             ai = ai->ai_next)
+          {
+            sock = connectTo(ai->ai_addr, ai->ai_addrlen, settings);
+          }
+        ::freeaddrinfo(result);
+        if (sock >= 0) { return sock; }
+      }
+    return -1;
+  }
+
+  /*!
+   * @if jp
+   * @brief 送信キューに溜まっているバイト数
+   * @else
+   * @brief Number of the bytes queued to be sent
+   * @endif
+   */
+  unsigned long queuedTCPStreamBytes(int socket)
+  {
+#if defined(SIOCOUTQ)
+    int queued(0);
+    if (::ioctl(socket, SIOCOUTQ, &queued) == 0 && queued > 0)
+      {
+        return static_cast<unsigned long>(queued);
+      }
+#elif defined(FIONWRITE)
+    int queued(0);
+    if (::ioctl(socket, FIONWRITE, &queued) == 0 && queued > 0)
+      {
+        return static_cast<unsigned long>(queued);
+      }
+#else
+    (void)socket;
+#endif
+    return 0;
+  }
+
+  /*!
+   * @if jp
+   * @brief ソケットを閉じる
+   * @else
+   * @brief Close the socket
+   * @endif
+   */
+  void closeTCPStreamSocket(int socket)
+  {
+    if (socket >= 0) { ::close(socket); }
+  }
+} // namespace RTC
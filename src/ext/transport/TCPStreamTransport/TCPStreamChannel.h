@@ -0,0 +1,180 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  TCPStreamChannel.h
+ * @brief Settings and sockets of the tcp_stream transport
+ * @date  $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *
+ *     All rights reserved.
+ *
+ *
+ */
+
+#ifndef RTC_TCPSTREAMCHANNEL_H
+#define RTC_TCPSTREAMCHANNEL_H
+
+#include <coil/Properties.h>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class TCPStreamSettings
+   * @brief tcp_stream インターフェースの設定
+   *
+   * コネクタプロファイルの dataport.tcp_stream 以下から読み出す。
+   *
+   * - address: InPort が待ち受ける IP アドレス。空の場合はすべてのイン
+   *   ターフェースで待ち受け、各インターフェースのアドレスを公開する
+   * - port: InPort が待ち受けるポート番号。0 (デフォルト) は空いている
+   *   ポート
+   * - nodelay: TCP_NODELAY を設定するか (デフォルト YES)
+   * - send_buffer: 送信ソケットのバッファサイズ。0 はシステムのデフォ
+   *   ルト
+   * - receive_buffer: 受信ソケットのバッファサイズ。0 はシステムのデ
+   *   フォルト
+   * - send_queue: 送信キューに溜まったバイト数がこれ以上の場合は
+   *   SEND_FULL を返す。0 (デフォルト) はソケットのバッファが一杯になっ
+   *   た場合のみ
+   * - connect_timeout: 接続のタイムアウト [ms] (デフォルト 3000)
+   * - max_frame_size: 受け付けるサンプルの最大長 (デフォルト 64MiB)
+   *
+   * @else
+   * @class TCPStreamSettings
+   * @brief Settings of the tcp_stream interface
+   *
+   * Read from dataport.tcp_stream of the connector profile.
+   *
+   * - address: IP address the InPort listens on. If empty, it listens
+   *   on all the interfaces and publishes the address of each
+   *   interface.
+   * - port: Port number the InPort listens on. 0 (default) is any free
+   *   port.
+   * - nodelay: Whether TCP_NODELAY is set (YES by default)
+   * - send_buffer: Buffer size of the sending socket. 0 is the system
+   *   default.
+   * - receive_buffer: Buffer size of the receiving socket. 0 is the
+   *   system default.
+   * - send_queue: SEND_FULL is returned while this many bytes or more
+   *   are queued to be sent. 0 (default) only when the socket buffer is
+   *   full.
+   * - connect_timeout: Timeout of the connection in ms (3000 by default)
+   * - max_frame_size: Maximum length of an accepted sample (64MiB by
+   *   default)
+   *
+   * @endif
+   */
+  struct TCPStreamSettings
+  {
+    TCPStreamSettings() = default;
+    explicit TCPStreamSettings(const coil::Properties& prop);
+
+    std::string address;
+    unsigned short port{0};
+    bool nodelay{true};
+    int send_buffer{0};
+    int receive_buffer{0};
+    unsigned long send_queue{0};
+    std::chrono::milliseconds connect_timeout{3000};
+    unsigned long max_frame_size{64UL * 1024 * 1024};
+  };
+
+  /*!
+   * @if jp
+   * @brief フレームヘッダの長さ
+   *
+   * 各サンプルの前に、サンプルの長さをネットワークバイトオーダの 32bit
+   * で送る。
+   *
+   * @else
+   * @brief Length of the frame header
+   *
+   * Each sample is preceded by its length as 32 bits in network byte
+   * order.
+   *
+   * @endif
+   */
+  const unsigned long TCPSTREAM_HEADER_SIZE = 4;
+
+  void putFrameHeader(unsigned char* header, uint32_t length);
+  uint32_t getFrameHeader(const unsigned char* header);
+
+  /*!
+   * @if jp
+   * @brief 待ち受けソケットを開く
+   * @param settings 設定
+   * @param endpoints 接続先として公開する "host:port" のカンマ区切りの
+   *                  リスト
+   * @return ソケット。失敗した場合は -1
+   * @else
+   * @brief Open a listening socket
+   * @param settings Settings
+   * @param endpoints Comma separated list of "host:port" published as
+   *                  the destinations
+   * @return The socket. -1 on failure.
+   * @endif
+   */
+  int openTCPStreamListener(const TCPStreamSettings& settings,
+                            std::string& endpoints);
+
+  /*!
+   * @if jp
+   * @brief 受け付けたソケットを設定する
+   * @else
+   * @brief Set up an accepted socket
+   * @endif
+   */
+  bool setupTCPStreamSocket(int socket, const TCPStreamSettings& settings);
+
+  /*!
+   * @if jp
+   * @brief 接続する
+   *
+   * endpoints の先頭から順に接続を試みる。
+   *
+   * @return 非ブロッキングのソケット。失敗した場合は -1
+   * @else
+   * @brief Connect
+   *
+   * Tries to connect to endpoints from the first one.
+   *
+   * @return Non-blocking socket. -1 on failure.
+   * @endif
+   */
+  int connectTCPStream(const std::string& endpoints,
+                       const TCPStreamSettings& settings);
+
+  /*!
+   * @if jp
+   * @brief 送信キューに溜まっているバイト数
+   *
+   * 取得できないプラットフォームでは 0 を返す。
+   *
+   * @else
+   * @brief Number of the bytes queued to be sent
+   *
+   * Returns 0 on the platforms where it is not available.
+   *
+   * @endif
+   */
+  unsigned long queuedTCPStreamBytes(int socket);
+
+  /*!
+   * @if jp
+   * @brief ソケットを閉じる
+   * @else
+   * @brief Close the socket
+   * @endif
+   */
+  void closeTCPStreamSocket(int socket);
+} // namespace RTC
+
+#endif // RTC_TCPSTREAMCHANNEL_H
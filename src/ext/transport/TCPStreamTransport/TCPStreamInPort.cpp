@@ -0,0 +1,522 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  TCPStreamInPort.cpp
+ * @brief TCPStreamInPort class
+ * @date  $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *
+ *     All rights reserved.
+ *
+ *
+ */
+
+#include "TCPStreamInPort.h"
+#include "TCPStreamReactor.h"
+#include <rtm/CORBA_SeqUtil.h>
+#include <rtm/NVUtil.h>
+#include <rtm/InPortConnector.h>
+
+#include <sys/epoll.h>
+#include <sys/socket.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+namespace
+{
+  const size_t READ_SIZE = 65536;
+  // read per event at most, so that a busy connection does not starve
+  // the other connectors sharing the reactor. Also the size of the
+  // queue to the writer thread beyond which the socket is not read.
+  const size_t READ_LIMIT = 1024 * 1024;
+} // namespace
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @brief コンストラクタ
+   * @else
+   * @brief Constructor
+   * @endif
+   */
+  TCPStreamInPort::TCPStreamInPort()
+  {
+    // PortProfile setting
+    setInterfaceType("tcp_stream");
+  }
+
+  /*!
+   * @if jp
+   * @brief デストラクタ
+   * @else
+   * @brief Destructor
+   * @endif
+   */
+  TCPStreamInPort::~TCPStreamInPort()
+  {
+    RTC_PARANOID(("~TCPStreamInPort()"));
+    // the handlers running in the reactor may replace or close m_socket
+    TCPStreamReactor& reactor(TCPStreamReactor::instance());
+    reactor.execute([this, &reactor]
+                    {
+                      if (m_accepting) { reactor.remove(m_listener); }
+                      close();
+                    });
+    closeTCPStreamSocket(m_listener);
+
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      m_running = false;
+    }
+    m_cond.notify_all();
+    if (m_writer.joinable())
+      {
+        m_writer.join();
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 設定初期化
+   * @else
+   * @brief Initializing configuration
+   * @endif
+   */
+  void TCPStreamInPort::init(coil::Properties& /*prop*/)
+  {
+  }
+
+  /*!
+   * @if jp
+   * @brief バッファをセットする
+   * @else
+   * @brief Setting outside buffer's pointer
+   * @endif
+   */
+  void TCPStreamInPort::setBuffer(BufferBase<ByteData>* buffer)
+  {
+    m_buffer = buffer;
+  }
+
+  /*!
+   * @if jp
+   * @brief リスナを設定する
+   * @else
+   * @brief Set the listener
+   * @endif
+   */
+  void TCPStreamInPort::setListener(ConnectorInfo& info,
+                                    ConnectorListenersBase* listeners)
+  {
+    m_profile = info;
+    m_listeners = listeners;
+  }
+
+  /*!
+   * @if jp
+   * @brief Connectorを設定する。
+   * @else
+   * @brief set Connector
+   * @endif
+   */
+  void TCPStreamInPort::setConnector(InPortConnector* connector)
+  {
+    m_connector = connector;
+    if (m_listener < 0 || m_accepting) { return; }
+
+    if (!m_writer.joinable())
+      {
+        m_running = true;
+        m_writer = std::thread([this] { svc(); });
+      }
+    m_accepting = TCPStreamReactor::instance().add(m_listener, EPOLLIN,
+                                                   [this](uint32_t)
+                                                   {
+                                                     accept();
+                                                   });
+    if (!m_accepting)
+      {
+        RTC_ERROR(("cannot register the socket to the reactor"));
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief Interface情報を公開する
+   * @else
+   * @brief Publish Interface information
+   * @endif
+   */
+  bool TCPStreamInPort::publishInterface(SDOPackage::NVList& properties)
+  {
+    if (!NVUtil::isStringValue(properties,
+                               "dataport.interface_type",
+                               "tcp_stream"))
+      {
+        return false;
+      }
+
+    if (m_listener < 0)
+      {
+        coil::Properties prop;
+        NVUtil::copyToProperties(prop, properties);
+        m_settings = TCPStreamSettings(prop.getNode("dataport"));
+
+        std::string endpoints;
+        m_listener = openTCPStreamListener(m_settings, endpoints);
+        if (m_listener < 0 || endpoints.empty())
+          {
+            RTC_ERROR(("cannot listen on %s:%d",
+                       m_settings.address.c_str(), m_settings.port));
+            closeTCPStreamSocket(m_listener);
+            m_listener = -1;
+            return false;
+          }
+        RTC_DEBUG(("listening on %s", endpoints.c_str()));
+        CORBA_SeqUtil::
+          push_back(m_properties,
+                    NVUtil::newNV("dataport.tcp_stream.endpoints",
+                                  endpoints.c_str()));
+      }
+    return InPortProvider::publishInterface(properties);
+  }
+
+  /*!
+   * @if jp
+   * @brief 接続を受け付ける
+   * @else
+   * @brief Accept the connection
+   * @endif
+   */
+  void TCPStreamInPort::accept()
+  {
+    int sock(::accept(m_listener, nullptr, nullptr));
+    if (sock < 0) { return; }
+    if (!setupTCPStreamSocket(sock, m_settings))
+      {
+        closeTCPStreamSocket(sock);
+        return;
+      }
+    if (m_socket >= 0)
+      {
+        // the OutPort reconnected
+        RTC_WARN(("the previous connection is replaced"));
+        close();
+      }
+
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      m_socket = sock;
+    }
+    if (!TCPStreamReactor::instance().add(m_socket,
+                                          EPOLLIN | EPOLLRDHUP,
+                                          [this](uint32_t events)
+                                          {
+                                            receive(events);
+                                          }))
+      {
+        RTC_ERROR(("cannot register the socket to the reactor"));
+        std::lock_guard<std::mutex> guard(m_mutex);
+        closeTCPStreamSocket(m_socket);
+        m_socket = -1;
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief ソケットから読み出す
+   * @else
+   * @brief Read from the socket
+   * @endif
+   */
+  void TCPStreamInPort::receive(uint32_t events)
+  {
+    if (m_paused)
+      {
+        // only the errors are reported while paused
+        if ((events & (EPOLLERR | EPOLLHUP)) != 0) { close(); }
+        return;
+      }
+
+    size_t total(0);
+    while (m_socket >= 0 && !m_paused && total < READ_LIMIT)
+      {
+        // room for the whole frame being received, if it is known
+        size_t size(m_length + READ_SIZE);
+        if (m_length >= TCPSTREAM_HEADER_SIZE)
+          {
+            size = std::max<size_t>(size, TCPSTREAM_HEADER_SIZE +
+                                    getFrameHeader(m_received.data()));
+          }
+        if (m_received.size() < size) { m_received.resize(size); }
+
+        ssize_t length(::recv(m_socket, &m_received[m_length],
+                              m_received.size() - m_length, 0));
+        if (length < 0)
+          {
+            if (errno == EINTR) { continue; }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) { return; }
+            RTC_WARN(("recv failed: %s", strerror(errno)));
+            close();
+            return;
+          }
+        if (length == 0)
+          {
+            RTC_DEBUG(("the connection was closed by the OutPort"));
+            close();
+            return;
+          }
+        m_length += static_cast<size_t>(length);
+        total += static_cast<size_t>(length);
+        if (!deliver())
+          {
+            close();
+            return;
+          }
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 揃ったフレームを渡す
+   * @return フレームが不正な場合 false
+   * @else
+   * @brief Deliver the completed frames
+   * @return false if a frame is invalid
+   * @endif
+   */
+  bool TCPStreamInPort::deliver()
+  {
+    bool endian_type(m_connector != nullptr && m_connector->isLittleEndian());
+    size_t offset(0);
+    size_t count(0);
+    while (m_length - offset >= TCPSTREAM_HEADER_SIZE)
+      {
+        uint32_t length(getFrameHeader(&m_received[offset]));
+        if (length > m_settings.max_frame_size)
+          {
+            RTC_ERROR(("frame of %u bytes exceeds max_frame_size", length));
+            m_length = 0;
+            return false;
+          }
+        if (m_length - offset - TCPSTREAM_HEADER_SIZE < length) { break; }
+
+        if (m_batch.size() <= count) { m_batch.resize(count + 1); }
+        ByteData& data(m_batch[count]);
+        if (length == 0)
+          {
+            // writeData() and setDataLength() ignore the zero length
+            data = ByteData();
+          }
+        else
+          {
+            data.writeData(&m_received[offset + TCPSTREAM_HEADER_SIZE],
+                           length);
+          }
+        data.isLittleEndian(endian_type);
+        ++count;
+        offset += TCPSTREAM_HEADER_SIZE + length;
+      }
+
+    if (offset > 0)
+      {
+        memmove(m_received.data(), &m_received[offset], m_length - offset);
+        m_length -= offset;
+      }
+    queue(count);
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief 揃ったフレームを書き込みスレッドに渡す
+   *
+   * 渡したデータが READ_LIMIT を超えると、書き込みスレッドが受け取る
+   * までソケットの読み出しを止める。
+   *
+   * @else
+   * @brief Hand the completed frames to the writer thread
+   *
+   * When the data handed exceed READ_LIMIT, the socket is not read
+   * until the writer thread takes them.
+   *
+   * @endif
+   */
+  void TCPStreamInPort::queue(size_t count)
+  {
+    if (count == 0) { return; }
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (m_queue.size() < m_queued + count) { m_queue.resize(m_queued + count); }
+    for (size_t i(0); i < count; ++i)
+      {
+        m_queuedSize += m_batch[i].getDataLength();
+        std::swap(m_queue[m_queued++], m_batch[i]);
+      }
+    m_cond.notify_one();
+    if (m_queuedSize >= READ_LIMIT && m_socket >= 0)
+      {
+        m_paused = true;
+        TCPStreamReactor::instance().modify(m_socket, 0);
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 書き込みスレッド
+   *
+   * バッファへの書き込みはブロックしうるため、リアクタのスレッドでは
+   * 行わない。
+   *
+   * @else
+   * @brief Writer thread
+   *
+   * Writing into the buffer may block, so it is not done in the thread
+   * of the reactor.
+   *
+   * @endif
+   */
+  void TCPStreamInPort::svc()
+  {
+    std::vector<ByteData> batch;
+    std::unique_lock<std::mutex> guard(m_mutex);
+    while (true)
+      {
+        m_cond.wait(guard, [this] { return m_queued > 0 || !m_running; });
+        if (!m_running) { return; }
+
+        size_t count(m_queued);
+        std::swap(batch, m_queue);
+        m_queued = 0;
+        m_queuedSize = 0;
+        if (m_paused)
+          {
+            m_paused = false;
+            if (m_socket >= 0)
+              {
+                TCPStreamReactor::instance().modify(m_socket,
+                                                    EPOLLIN | EPOLLRDHUP);
+              }
+          }
+
+        guard.unlock();
+        write(batch.data(), count);
+        guard.lock();
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 受信データをバッファに書き込む
+   *
+   * 書き込みに失敗したサンプルは捨て、残りの書き込みを続ける。
+   *
+   * @else
+   * @brief Write the received data into the buffer
+   *
+   * A sample failed to be written is dropped, and the rest are
+   * written.
+   *
+   * @endif
+   */
+  void TCPStreamInPort::write(ByteData* data, size_t count)
+  {
+    if (count == 0) { return; }
+    RTC_PARANOID(("TCPStreamInPort::write(%d)", count));
+    if (m_connector == nullptr)
+      {
+        for (size_t i(0); i < count; ++i) { onReceiverError(data[i]); }
+        return;
+      }
+
+    for (size_t i(0); i < count; ++i) { onReceived(data[i]); }
+    size_t done(0);
+    while (done < count)
+      {
+        size_t written(0);
+        BufferStatus ret(m_connector->writeBatch(&data[done],
+                                                 count - done, written));
+        for (size_t i(done); i < done + written; ++i)
+          {
+            onBufferWrite(data[i]);
+          }
+        done += written;
+        if (done < count)
+          {
+            convertReturn(ret, data[done]);
+            ++done;
+          }
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 接続を閉じる
+   * @else
+   * @brief Close the connection
+   * @endif
+   */
+  void TCPStreamInPort::close()
+  {
+    if (m_socket < 0) { return; }
+    TCPStreamReactor::instance().remove(m_socket);
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      closeTCPStreamSocket(m_socket);
+      m_socket = -1;
+      m_paused = false;
+    }
+    m_length = 0;
+  }
+
+  /*!
+   * @if jp
+   * @brief リターンコード変換
+   * @else
+   * @brief Return codes conversion
+   * @endif
+   */
+  void TCPStreamInPort::convertReturn(BufferStatus status, ByteData& data)
+  {
+    switch (status)
+      {
+      case BufferStatus::OK:
+        onBufferWrite(data);
+        return;
+
+      case BufferStatus::BUFFER_ERROR:
+        onReceiverError(data);
+        return;
+
+      case BufferStatus::FULL:
+        onBufferFull(data);
+        onReceiverFull(data);
+        return;
+
+      case BufferStatus::EMPTY:
+        // never come here
+        return;
+
+      case BufferStatus::PRECONDITION_NOT_MET:
+        onReceiverError(data);
+        return;
+
+      case BufferStatus::TIMEOUT:
+        onBufferWriteTimeout(data);
+        onReceiverTimeout(data);
+        return;
+
+      case BufferStatus::NOT_SUPPORTED:
+
+      default:
+        onReceiverError(data);
+        return;
+      }
+  }
+} // namespace RTC
@@ -0,0 +1,216 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  TCPStreamInPort.h
+ * @brief TCPStreamInPort class
+ * @date  $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *
+ *     All rights reserved.
+ *
+ *
+ */
+
+#ifndef RTC_TCPSTREAMINPORT_H
+#define RTC_TCPSTREAMINPORT_H
+
+#include <rtm/BufferBase.h>
+#include <rtm/InPortProvider.h>
+#include <rtm/ConnectorListener.h>
+#include <rtm/ConnectorBase.h>
+#include "TCPStreamChannel.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class TCPStreamInPort
+   * @brief TCPStreamInPort クラス
+   *
+   * InPortProvider
+   *
+   * 長さを前置したフレームの TCP ストリームでデータを受信する InPort
+   * プロバイダ。接続時に待ち受けソケットを開き、そのアドレスを
+   * dataport.tcp_stream.endpoints としてコネクタプロファイルで公開する。
+   * ソケットはプロセスで共有するリアクタのスレッドで読み出し、揃った
+   * フレームはプロバイダ自身の書き込みスレッドがまとめてバッファに書
+   * き込む。このため、full_policy が block のバッファが一杯になっても
+   * 他のコネクタは止まらない。書き込みが追いつかない間は読み出しを止
+   * め、TCP のフロー制御で OutPort を待たせる。
+   *
+   * @else
+   * @class TCPStreamInPort
+   * @brief TCPStreamInPort class
+   *
+   * InPortProvider
+   *
+   * The InPort provider receiving the data on a TCP stream of length
+   * prefixed frames. On connection it opens a listening socket, and
+   * publishes its address as dataport.tcp_stream.endpoints in the
+   * connector profile. The socket is read in the thread of the reactor
+   * shared in the process, and the completed frames are written into
+   * the buffer together by the writer thread of the provider. So a full
+   * buffer with full_policy block does not stall the other connectors.
+   * While the writer lags behind, the socket is not read, and the TCP
+   * flow control holds back the OutPort.
+   *
+   * @endif
+   */
+  class TCPStreamInPort
+    : public InPortProvider
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @else
+     * @brief Constructor
+     * @endif
+     */
+    TCPStreamInPort();
+
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     *
+     * リアクタからソケットの登録を解除し、ソケットを閉じる。
+     *
+     * @else
+     * @brief Destructor
+     *
+     * Unregisters the sockets from the reactor and closes them.
+     *
+     * @endif
+     */
+    ~TCPStreamInPort() override;
+
+    void init(coil::Properties& prop) override;
+
+    void setBuffer(BufferBase<ByteData>* buffer) override;
+
+    void setListener(ConnectorInfo& info,
+                     ConnectorListenersBase* listeners) override;
+
+    /*!
+     * @if jp
+     * @brief Connectorを設定する。
+     *
+     * 書き込みスレッドを開始し、接続の受け付けを開始する。
+     *
+     * @else
+     * @brief set Connector
+     *
+     * Starts the writer thread and accepting the connection.
+     *
+     * @endif
+     */
+    void setConnector(InPortConnector* connector) override;
+
+    /*!
+     * @if jp
+     * @brief Interface情報を公開する
+     *
+     * コネクタプロファイルの dataport.tcp_stream 以下の設定で待ち受け
+     * ソケットを開き、dataport.tcp_stream.endpoints を公開する。開けな
+     * い場合は接続を失敗させる。
+     *
+     * @else
+     * @brief Publish Interface information
+     *
+     * Opens the listening socket with dataport.tcp_stream of the
+     * connector profile, and publishes dataport.tcp_stream.endpoints.
+     * The connection fails if the socket cannot be opened.
+     *
+     * @endif
+     */
+    bool publishInterface(SDOPackage::NVList& properties) override;
+
+  private:
+    void accept();
+    void receive(uint32_t events);
+    bool deliver();
+    void queue(size_t count);
+    void svc();
+    void write(ByteData* data, size_t count);
+    void close();
+    void convertReturn(BufferStatus status, ByteData& data);
+
+    inline void onBufferWrite(ByteData& data)
+    {
+      m_listeners->notifyIn(ConnectorDataListenerType::ON_BUFFER_WRITE,
+                            m_profile, data);
+    }
+
+    inline void onBufferFull(ByteData& data)
+    {
+      m_listeners->notifyIn(ConnectorDataListenerType::ON_BUFFER_FULL,
+                            m_profile, data);
+    }
+
+    inline void onBufferWriteTimeout(ByteData& data)
+    {
+      m_listeners->notifyIn(ConnectorDataListenerType::ON_BUFFER_WRITE_TIMEOUT,
+                            m_profile, data);
+    }
+
+    inline void onReceived(ByteData& data)
+    {
+      m_listeners->notifyIn(ConnectorDataListenerType::ON_RECEIVED,
+                            m_profile, data);
+    }
+
+    inline void onReceiverFull(ByteData& data)
+    {
+      m_listeners->notifyIn(ConnectorDataListenerType::ON_RECEIVER_FULL,
+                            m_profile, data);
+    }
+
+    inline void onReceiverTimeout(ByteData& data)
+    {
+      m_listeners->notifyIn(ConnectorDataListenerType::ON_RECEIVER_TIMEOUT,
+                            m_profile, data);
+    }
+
+    inline void onReceiverError(ByteData& data)
+    {
+      m_listeners->notifyIn(ConnectorDataListenerType::ON_RECEIVER_ERROR,
+                            m_profile, data);
+    }
+
+    CdrBufferBase* m_buffer{nullptr};
+    ConnectorListenersBase* m_listeners{nullptr};
+    ConnectorInfo m_profile;
+    InPortConnector* m_connector{nullptr};
+
+    TCPStreamSettings m_settings;
+    int m_listener{-1};
+    bool m_accepting{false};
+    int m_socket{-1};
+    std::vector<unsigned char> m_received;
+    size_t m_length{0};
+    std::vector<ByteData> m_batch;
+
+    // handed from the reactor to the writer thread
+    std::vector<ByteData> m_queue;
+    size_t m_queued{0};
+    size_t m_queuedSize{0};
+    // set while the socket is not read, since the queue is full
+    std::atomic<bool> m_paused{false};
+    bool m_running{false};
+    std::thread m_writer;
+    // guards the queue, m_running, and the changes of m_socket
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+  };
+} // namespace RTC
+
+#endif // RTC_TCPSTREAMINPORT_H
@@ -0,0 +1,421 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  TCPStreamOutPort.cpp
+ * @brief TCPStreamOutPort class
+ * @date  $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *
+ *     All rights reserved.
+ *
+ *
+ */
+
+#include "TCPStreamOutPort.h"
+#include "TCPStreamReactor.h"
+#include <rtm/NVUtil.h>
+
+#include <sys/epoll.h>
+#include <sys/socket.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+namespace
+{
+  // two iovecs per frame within IOV_MAX (1024 on Linux)
+  const size_t MAX_FRAMES_PER_WRITE = 512;
+  const uint32_t IDLE_EVENTS = EPOLLIN | EPOLLRDHUP;
+  const uint32_t WRITING_EVENTS = EPOLLIN | EPOLLRDHUP | EPOLLOUT;
+} // namespace
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @brief コンストラクタ
+   * @else
+   * @brief Constructor
+   * @endif
+   */
+  TCPStreamOutPort::TCPStreamOutPort()
+    : rtclog("TCPStreamOutPort")
+  {
+  }
+
+  /*!
+   * @if jp
+   * @brief デストラクタ
+   * @else
+   * @brief Destructor
+   * @endif
+   */
+  TCPStreamOutPort::~TCPStreamOutPort()
+  {
+    RTC_PARANOID(("~TCPStreamOutPort()"));
+    disconnect();
+  }
+
+  /*!
+   * @if jp
+   * @brief 設定初期化
+   * @else
+   * @brief Initializing configuration
+   * @endif
+   */
+  void TCPStreamOutPort::init(coil::Properties& /*prop*/)
+  {
+  }
+
+  /*!
+   * @if jp
+   * @brief データの送信
+   * @else
+   * @brief Send the data
+   * @endif
+   */
+  DataPortStatus TCPStreamOutPort::put(ByteData& data)
+  {
+    RTC_PARANOID(("put()"));
+    RTC_VERBOSE(("Data size:%d", data.getDataLength()));
+    ByteData* frames[] = {&data};
+    size_t sent(0);
+    return send(frames, 1, sent);
+  }
+
+  /*!
+   * @if jp
+   * @brief 複数のデータの送信
+   * @else
+   * @brief Send multiple data
+   * @endif
+   */
+  DataPortStatus TCPStreamOutPort::putBatch(const std::vector<ByteData*>& data,
+                                            size_t& sent)
+  {
+    RTC_PARANOID(("putBatch(%d)", data.size()));
+    return send(data.data(), data.size(), sent);
+  }
+
+  /*!
+   * @if jp
+   * @brief InterfaceProfile情報を公開する
+   * @else
+   * @brief Publish InterfaceProfile information
+   * @endif
+   */
+  void TCPStreamOutPort::
+  publishInterfaceProfile(SDOPackage::NVList& /*properties*/)
+  {
+  }
+
+  /*!
+   * @if jp
+   * @brief データ送信通知への登録
+   * @else
+   * @brief Subscribe to the data sending notification
+   * @endif
+   */
+  bool TCPStreamOutPort::
+  subscribeInterface(const SDOPackage::NVList& properties)
+  {
+    RTC_TRACE(("subscribeInterface()"));
+    RTC_DEBUG_STR((NVUtil::toString(properties)));
+
+    coil::Properties prop;
+    NVUtil::copyToProperties(prop, properties);
+    std::string endpoints(prop.getProperty("dataport.tcp_stream.endpoints"));
+    if (endpoints.empty())
+      {
+        RTC_ERROR(("dataport.tcp_stream.endpoints not found"));
+        return false;
+      }
+
+    disconnect();
+    TCPStreamSettings settings(prop.getNode("dataport"));
+    int sock(connectTCPStream(endpoints, settings));
+    if (sock < 0)
+      {
+        RTC_ERROR(("cannot connect to %s", endpoints.c_str()));
+        return false;
+      }
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      m_settings = settings;
+      m_socket = sock;
+      m_lost = false;
+    }
+
+    // the InPort never sends, so a readable socket means it has closed
+    if (!TCPStreamReactor::instance().add(sock, IDLE_EVENTS,
+                                          [this](uint32_t events)
+                                          {
+                                            onEvent(events);
+                                          }))
+      {
+        RTC_ERROR(("cannot register the socket to the reactor"));
+        disconnect();
+        return false;
+      }
+    RTC_DEBUG(("connected to %s", endpoints.c_str()));
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief データ送信通知からの登録解除
+   * @else
+   * @brief Unsubscribe the data send notification
+   * @endif
+   */
+  void TCPStreamOutPort::
+  unsubscribeInterface(const SDOPackage::NVList& properties)
+  {
+    RTC_TRACE(("unsubscribeInterface()"));
+    RTC_DEBUG_STR((NVUtil::toString(properties)));
+    disconnect();
+  }
+
+  /*!
+   * @if jp
+   * @brief フレームを送信する
+   * @else
+   * @brief Send the frames
+   * @endif
+   */
+  DataPortStatus TCPStreamOutPort::send(ByteData* const* data, size_t n,
+                                        size_t& sent)
+  {
+    sent = 0;
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (m_socket < 0)
+      {
+        return DataPortStatus::PRECONDITION_NOT_MET;
+      }
+    if (m_lost)
+      {
+        return DataPortStatus::CONNECTION_LOST;
+      }
+
+    // the rest of the previous frame goes first to keep the stream framed
+    DataPortStatus ret(flush());
+    if (ret != DataPortStatus::PORT_OK) { return ret; }
+    if (m_settings.send_queue > 0 &&
+        queuedTCPStreamBytes(m_socket) >= m_settings.send_queue)
+      {
+        return DataPortStatus::SEND_FULL;
+      }
+
+    while (sent < n)
+      {
+        size_t count(std::min(n - sent, MAX_FRAMES_PER_WRITE));
+        m_headers.resize(count * TCPSTREAM_HEADER_SIZE);
+        m_iov.clear();
+        for (size_t i(0); i < count; ++i)
+          {
+            const ByteData& frame(*data[sent + i]);
+            unsigned char* header(&m_headers[i * TCPSTREAM_HEADER_SIZE]);
+            putFrameHeader(header,
+                           static_cast<uint32_t>(frame.getDataLength()));
+            m_iov.push_back({header, TCPSTREAM_HEADER_SIZE});
+            if (frame.getDataLength() > 0)
+              {
+                // sendmsg() only reads the data
+                m_iov.push_back({const_cast<unsigned char*>(frame.getBuffer()),
+                                 frame.getDataLength()});
+              }
+          }
+
+        msghdr msg{};
+        msg.msg_iov = m_iov.data();
+        msg.msg_iovlen = m_iov.size();
+        ssize_t written(::sendmsg(m_socket, &msg, MSG_NOSIGNAL));
+        if (written < 0)
+          {
+            if (errno == EINTR) { continue; }
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+              {
+                return DataPortStatus::SEND_FULL;
+              }
+            RTC_ERROR(("send failed: %s", strerror(errno)));
+            lose();
+            return DataPortStatus::CONNECTION_LOST;
+          }
+
+        size_t rest(static_cast<size_t>(written));
+        for (size_t i(0); i < count; ++i)
+          {
+            const ByteData& frame(*data[sent]);
+            size_t length(TCPSTREAM_HEADER_SIZE + frame.getDataLength());
+            if (rest >= length)
+              {
+                rest -= length;
+                ++sent;
+                continue;
+              }
+            if (rest == 0) { return DataPortStatus::SEND_FULL; }
+
+            // a partially written frame is completed by the reactor
+            keep(&m_headers[i * TCPSTREAM_HEADER_SIZE], frame, rest);
+            ++sent;
+            return sent == n ? DataPortStatus::PORT_OK
+                             : DataPortStatus::SEND_FULL;
+          }
+      }
+    return DataPortStatus::PORT_OK;
+  }
+
+  /*!
+   * @if jp
+   * @brief 書き残したフレームの残りを送る
+   * @else
+   * @brief Send the rest of the partially written frame
+   * @endif
+   */
+  DataPortStatus TCPStreamOutPort::flush()
+  {
+    while (m_pendingOffset < m_pending.size())
+      {
+        ssize_t written(::send(m_socket, &m_pending[m_pendingOffset],
+                               m_pending.size() - m_pendingOffset,
+                               MSG_NOSIGNAL));
+        if (written < 0)
+          {
+            if (errno == EINTR) { continue; }
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+              {
+                return DataPortStatus::SEND_FULL;
+              }
+            RTC_ERROR(("send failed: %s", strerror(errno)));
+            lose();
+            return DataPortStatus::CONNECTION_LOST;
+          }
+        m_pendingOffset += static_cast<size_t>(written);
+      }
+    m_pending.clear();
+    m_pendingOffset = 0;
+    if (m_writing)
+      {
+        m_writing = false;
+        TCPStreamReactor::instance().modify(m_socket, IDLE_EVENTS);
+      }
+    return DataPortStatus::PORT_OK;
+  }
+
+  /*!
+   * @if jp
+   * @brief フレームの送れなかった部分を保持する
+   * @else
+   * @brief Keep the part of the frame not written
+   * @endif
+   */
+  void TCPStreamOutPort::keep(const unsigned char* header,
+                              const ByteData& data, size_t written)
+  {
+    m_pending.clear();
+    m_pendingOffset = 0;
+    if (written < TCPSTREAM_HEADER_SIZE)
+      {
+        m_pending.assign(header + written, header + TCPSTREAM_HEADER_SIZE);
+        written = TCPSTREAM_HEADER_SIZE;
+      }
+    const unsigned char* body(data.getBuffer());
+    m_pending.insert(m_pending.end(),
+                     body + (written - TCPSTREAM_HEADER_SIZE),
+                     body + data.getDataLength());
+    m_writing = true;
+    TCPStreamReactor::instance().modify(m_socket, WRITING_EVENTS);
+  }
+
+  /*!
+   * @if jp
+   * @brief 接続を失ったとする
+   *
+   * ソケットはリアクタの登録を解除するまで閉じない。shutdown() により
+   * リアクタに HUP が通知され、リアクタのスレッドで登録が解除される。
+   *
+   * @else
+   * @brief Mark the connection lost
+   *
+   * The socket is not closed until it is unregistered from the
+   * reactor. shutdown() makes the reactor notified of HUP, and the
+   * socket is unregistered in the thread of the reactor.
+   *
+   * @endif
+   */
+  void TCPStreamOutPort::lose()
+  {
+    m_lost = true;
+    m_pending.clear();
+    m_pendingOffset = 0;
+    ::shutdown(m_socket, SHUT_RDWR);
+  }
+
+  /*!
+   * @if jp
+   * @brief リアクタからのイベント
+   * @else
+   * @brief Event from the reactor
+   * @endif
+   */
+  void TCPStreamOutPort::onEvent(uint32_t events)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (m_socket < 0) { return; }
+
+    if ((events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) != 0)
+      {
+        char c;
+        ssize_t ret(::recv(m_socket, &c, 1, MSG_PEEK | MSG_DONTWAIT));
+        if (m_lost || ret >= 0 || (errno != EAGAIN && errno != EWOULDBLOCK))
+          {
+            if (!m_lost)
+              {
+                RTC_WARN(("the connection was closed by the InPort"));
+                lose();
+              }
+            // called in the reactor thread, which can unregister itself
+            TCPStreamReactor::instance().remove(m_socket);
+            return;
+          }
+      }
+
+    if ((events & EPOLLOUT) != 0)
+      {
+        flush();
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 切断する
+   * @else
+   * @brief Disconnect
+   * @endif
+   */
+  void TCPStreamOutPort::disconnect()
+  {
+    int sock(-1);
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      sock = m_socket;
+    }
+    if (sock < 0) { return; }
+
+    // not locking m_mutex here, since the reactor holds its lock while
+    // onEvent() waits for m_mutex
+    TCPStreamReactor::instance().remove(sock);
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    closeTCPStreamSocket(m_socket);
+    m_socket = -1;
+    m_lost = false;
+    m_writing = false;
+    m_pending.clear();
+    m_pendingOffset = 0;
+  }
+} // namespace RTC
@@ -0,0 +1,161 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  TCPStreamOutPort.h
+ * @brief TCPStreamOutPort class
+ * @date  $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *
+ *     All rights reserved.
+ *
+ *
+ */
+
+#ifndef RTC_TCPSTREAMOUTPORT_H
+#define RTC_TCPSTREAMOUTPORT_H
+
+#include <rtm/InPortConsumer.h>
+#include <rtm/SystemLogger.h>
+#include "TCPStreamChannel.h"
+
+#include <sys/uio.h>
+
+#include <mutex>
+#include <vector>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class TCPStreamOutPort
+   * @brief TCPStreamOutPort クラス
+   *
+   * InPortConsumer
+   *
+   * 長さを前置したフレームの TCP ストリームでデータを送信する InPort
+   * コンシューマ。接続先は InPort が公開する
+   * dataport.tcp_stream.endpoints から得る。データの送信は非ブロッキン
+   * グのソケットへの writev 相当の1回のシステムコールで、ORB の呼び出
+   * しや応答待ちはない。ソケットのバッファに入り切らなかったフレーム
+   * の残りは共有リアクタが送り、その間の送信は SEND_FULL となる。
+   *
+   * @else
+   * @class TCPStreamOutPort
+   * @brief TCPStreamOutPort class
+   *
+   * InPortConsumer
+   *
+   * The InPort consumer sending the data on a TCP stream of length
+   * prefixed frames. The destination is taken from
+   * dataport.tcp_stream.endpoints published by the InPort. Sending the
+   * data is one writev-like system call on a non-blocking socket,
+   * without ORB calls or waiting for replies. The rest of a frame that
+   * did not fit in the socket buffer is sent by the shared reactor, and
+   * the sends meanwhile return SEND_FULL.
+   *
+   * @endif
+   */
+  class TCPStreamOutPort
+    : public InPortConsumer
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @else
+     * @brief Constructor
+     * @endif
+     */
+    TCPStreamOutPort();
+
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     * @else
+     * @brief Destructor
+     * @endif
+     */
+    ~TCPStreamOutPort() override;
+
+    void init(coil::Properties& prop) override;
+
+    /*!
+     * @if jp
+     * @brief データの送信
+     *
+     * 送信キューが dataport.tcp_stream.send_queue 以上の場合、またはソ
+     * ケットのバッファが一杯の場合は SEND_FULL を返す。接続先が切断し
+     * た場合は CONNECTION_LOST を返す。
+     *
+     * @else
+     * @brief Send the data
+     *
+     * Returns SEND_FULL if the send queue is dataport.tcp_stream.send_queue
+     * or more, or if the socket buffer is full. Returns CONNECTION_LOST
+     * if the destination has disconnected.
+     *
+     * @endif
+     */
+    DataPortStatus put(ByteData& data) override;
+
+    /*!
+     * @if jp
+     * @brief 複数のデータの送信
+     *
+     * すべてのフレームを1回の scatter-gather 書き込みで送る。
+     *
+     * @else
+     * @brief Send multiple data
+     *
+     * Sends all the frames by one scatter-gather write.
+     *
+     * @endif
+     */
+    DataPortStatus putBatch(const std::vector<ByteData*>& data,
+                            size_t& sent) override;
+
+    void publishInterfaceProfile(SDOPackage::NVList& properties) override;
+
+    /*!
+     * @if jp
+     * @brief データ送信通知への登録
+     *
+     * dataport.tcp_stream.endpoints に接続する。
+     *
+     * @else
+     * @brief Subscribe to the data sending notification
+     *
+     * Connects to dataport.tcp_stream.endpoints.
+     *
+     * @endif
+     */
+    bool subscribeInterface(const SDOPackage::NVList& properties) override;
+
+    void unsubscribeInterface(const SDOPackage::NVList& properties) override;
+
+  private:
+    DataPortStatus send(ByteData* const* data, size_t n, size_t& sent);
+    DataPortStatus flush();
+    void keep(const unsigned char* header, const ByteData& data,
+              size_t written);
+    void lose();
+    void onEvent(uint32_t events);
+    void disconnect();
+
+    mutable Logger rtclog;
+    TCPStreamSettings m_settings;
+    int m_socket{-1};
+    bool m_lost{false};
+    bool m_writing{false};
+    std::vector<unsigned char> m_pending;
+    size_t m_pendingOffset{0};
+    std::vector<unsigned char> m_headers;
+    std::vector<iovec> m_iov;
+    std::mutex m_mutex;
+  };
+} // namespace RTC
+
+#endif // RTC_TCPSTREAMOUTPORT_H
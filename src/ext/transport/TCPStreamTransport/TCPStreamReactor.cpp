@@ -0,0 +1,161 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  TCPStreamReactor.cpp
+ * @brief Shared epoll reactor of the tcp_stream transport
+ * @date  $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *
+ *     All rights reserved.
+ *
+ *
+ */
+
+#include "TCPStreamReactor.h"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <cerrno>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @brief コンストラクタ
+   * @else
+   * @brief Constructor
+   * @endif
+   */
+  TCPStreamReactor::TCPStreamReactor()
+    : m_epoll(::epoll_create1(EPOLL_CLOEXEC)),
+      m_wakeup(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+  {
+    if (m_epoll < 0 || m_wakeup < 0) { return; }
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = m_wakeup;
+    if (::epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_wakeup, &event) != 0) { return; }
+    m_thread = std::thread([this] { svc(); });
+  }
+
+  /*!
+   * @if jp
+   * @brief デストラクタ
+   * @else
+   * @brief Destructor
+   * @endif
+   */
+  TCPStreamReactor::~TCPStreamReactor()
+  {
+    if (m_thread.joinable())
+      {
+        uint64_t one(1);
+        ssize_t ret(::write(m_wakeup, &one, sizeof(one)));
+        (void)ret;
+        m_thread.join();
+      }
+    if (m_wakeup >= 0) { ::close(m_wakeup); }
+    if (m_epoll >= 0) { ::close(m_epoll); }
+  }
+
+  /*!
+   * @if jp
+   * @brief ソケットを登録する
+   * @else
+   * @brief Register a socket
+   * @endif
+   */
+  bool TCPStreamReactor::add(int socket, uint32_t events, Handler handler)
+  {
+    if (!m_thread.joinable()) { return false; }
+    std::lock_guard<std::recursive_mutex> guard(m_mutex);
+    m_handlers[socket] = std::make_shared<Handler>(std::move(handler));
+    epoll_event event{};
+    event.events = events;
+    event.data.fd = socket;
+    if (::epoll_ctl(m_epoll, EPOLL_CTL_ADD, socket, &event) != 0)
+      {
+        m_handlers.erase(socket);
+        return false;
+      }
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief 監視するイベントを変更する
+   * @else
+   * @brief Change the events to watch
+   * @endif
+   */
+  bool TCPStreamReactor::modify(int socket, uint32_t events)
+  {
+    // epoll_ctl() is thread safe, and not locking here lets the
+    // handlers call back into their owners without lock inversions
+    epoll_event event{};
+    event.events = events;
+    event.data.fd = socket;
+    return ::epoll_ctl(m_epoll, EPOLL_CTL_MOD, socket, &event) == 0;
+  }
+
+  /*!
+   * @if jp
+   * @brief ソケットの登録を解除する
+   * @else
+   * @brief Unregister a socket
+   * @endif
+   */
+  void TCPStreamReactor::remove(int socket)
+  {
+    ::epoll_ctl(m_epoll, EPOLL_CTL_DEL, socket, nullptr);
+    std::lock_guard<std::recursive_mutex> guard(m_mutex);
+    m_handlers.erase(socket);
+  }
+
+  /*!
+   * @if jp
+   * @brief ハンドラと排他的に関数を実行する
+   * @else
+   * @brief Execute a function exclusively with the handlers
+   * @endif
+   */
+  void TCPStreamReactor::execute(const std::function<void()>& func)
+  {
+    std::lock_guard<std::recursive_mutex> guard(m_mutex);
+    func();
+  }
+
+  /*!
+   * @if jp
+   * @brief イベントを待ち、ハンドラに通知する
+   * @else
+   * @brief Wait for the events and notify the handlers
+   * @endif
+   */
+  void TCPStreamReactor::svc()
+  {
+    epoll_event events[64];
+    while (true)
+      {
+        int n(::epoll_wait(m_epoll, events, 64, -1));
+        if (n < 0 && errno != EINTR) { return; }
+        for (int i(0); i < n; ++i)
+          {
+            if (events[i].data.fd == m_wakeup) { return; }
+
+            std::lock_guard<std::recursive_mutex> guard(m_mutex);
+            auto it(m_handlers.find(events[i].data.fd));
+            // removed by a handler called before in this loop
+            if (it == m_handlers.end()) { continue; }
+            // kept alive even if the handler removes itself
+            std::shared_ptr<Handler> handler(it->second);
+            (*handler)(events[i].events);
+          }
+      }
+  }
+} // namespace RTC
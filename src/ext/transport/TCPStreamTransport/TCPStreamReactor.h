@@ -0,0 +1,152 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  TCPStreamReactor.h
+ * @brief Shared epoll reactor of the tcp_stream transport
+ * @date  $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *
+ *     All rights reserved.
+ *
+ *
+ */
+
+#ifndef RTC_TCPSTREAMREACTOR_H
+#define RTC_TCPSTREAMREACTOR_H
+
+#include <coil/Singleton.h>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class TCPStreamReactor
+   * @brief tcp_stream インターフェースの共有リアクタ
+   *
+   * プロセス内のすべての tcp_stream コネクタのソケットをひとつの epoll
+   * とひとつのスレッドで監視し、イベントをハンドラに通知する。ハンドラ
+   * はリアクタのスレッドで呼ばれる。remove() から戻った後、そのソケッ
+   * トのハンドラが呼ばれることはない。
+   *
+   * @else
+   * @class TCPStreamReactor
+   * @brief Shared reactor of the tcp_stream interface
+   *
+   * Watches the sockets of all the tcp_stream connectors in the process
+   * with one epoll and one thread, and notifies the handlers of the
+   * events. The handlers are called in the thread of the reactor. The
+   * handler of a socket is never called after remove() returns.
+   *
+   * @endif
+   */
+  class TCPStreamReactor
+    : public coil::Singleton<TCPStreamReactor>
+  {
+  public:
+    using Handler = std::function<void(uint32_t events)>;
+
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     *
+     * epoll を作成し、リアクタのスレッドを開始する。
+     *
+     * @else
+     * @brief Constructor
+     *
+     * Creates the epoll and starts the thread of the reactor.
+     *
+     * @endif
+     */
+    TCPStreamReactor();
+
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     * @else
+     * @brief Destructor
+     * @endif
+     */
+    ~TCPStreamReactor();
+
+    /*!
+     * @if jp
+     * @brief ソケットを登録する
+     * @param socket ソケット
+     * @param events 監視する epoll のイベント
+     * @param handler イベントのハンドラ
+     * @return 成功した場合 true
+     * @else
+     * @brief Register a socket
+     * @param socket Socket
+     * @param events epoll events to watch
+     * @param handler Handler of the events
+     * @return true on success
+     * @endif
+     */
+    bool add(int socket, uint32_t events, Handler handler);
+
+    /*!
+     * @if jp
+     * @brief 監視するイベントを変更する
+     * @else
+     * @brief Change the events to watch
+     * @endif
+     */
+    bool modify(int socket, uint32_t events);
+
+    /*!
+     * @if jp
+     * @brief ソケットの登録を解除する
+     *
+     * 実行中のハンドラがあれば終了を待つ。ハンドラの中から呼んでもよい。
+     *
+     * @else
+     * @brief Unregister a socket
+     *
+     * Waits for the running handler if any. May be called from within
+     * a handler.
+     *
+     * @endif
+     */
+    void remove(int socket);
+
+    /*!
+     * @if jp
+     * @brief ハンドラと排他的に関数を実行する
+     *
+     * ハンドラの状態をリアクタのスレッド以外から操作するために用いる。
+     *
+     * @else
+     * @brief Execute a function exclusively with the handlers
+     *
+     * Used to manipulate the state of the handlers from outside the
+     * thread of the reactor.
+     *
+     * @endif
+     */
+    void execute(const std::function<void()>& func);
+
+  private:
+    void svc();
+
+    int m_epoll{-1};
+    int m_wakeup{-1};
+    std::thread m_thread;
+    std::map<int, std::shared_ptr<Handler>> m_handlers;
+    // held while a handler runs, so that remove() waits for it
+    std::recursive_mutex m_mutex;
+  };
+} // namespace RTC
+
+#endif // RTC_TCPSTREAMREACTOR_H
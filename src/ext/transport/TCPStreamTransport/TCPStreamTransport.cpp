@@ -0,0 +1,50 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  TCPStreamTransport.cpp
+ * @brief TCP stream transport module
+ * @date  $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *
+ *     All rights reserved.
+ *
+ *
+ */
+
+#include "TCPStreamTransport.h"
+#include "TCPStreamOutPort.h"
+#include "TCPStreamInPort.h"
+
+extern "C"
+{
+  /*!
+   * @if jp
+   * @brief モジュール初期化関数
+   * @else
+   * @brief Module initialization
+   * @endif
+   */
+  void TCPStreamTransportInit(RTC::Manager* /*manager*/)
+  {
+    {
+      RTC::InPortProviderFactory& factory(RTC::InPortProviderFactory::instance());
+      factory.addFactory("tcp_stream",
+                        ::coil::Creator< ::RTC::InPortProvider,
+                                          ::RTC::TCPStreamInPort>,
+                        ::coil::Destructor< ::RTC::InPortProvider,
+                                            ::RTC::TCPStreamInPort>);
+    }
+
+    {
+      RTC::InPortConsumerFactory& factory(RTC::InPortConsumerFactory::instance());
+      factory.addFactory("tcp_stream",
+                        ::coil::Creator< ::RTC::InPortConsumer,
+                                          ::RTC::TCPStreamOutPort>,
+                        ::coil::Destructor< ::RTC::InPortConsumer,
+                                            ::RTC::TCPStreamOutPort>);
+    }
+  }
+}
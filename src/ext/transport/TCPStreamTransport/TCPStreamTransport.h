@@ -0,0 +1,42 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  TCPStreamTransport.h
+ * @brief TCP stream transport module
+ * @date  $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *
+ *     All rights reserved.
+ *
+ *
+ */
+
+#ifndef RTC_TCPSTREAMTRANSPORT_H
+#define RTC_TCPSTREAMTRANSPORT_H
+
+#include <rtm/Manager.h>
+
+extern "C"
+{
+  /*!
+   * @if jp
+   * @brief モジュール初期化関数
+   *
+   * TCPStreamOutPort、TCPStreamInPort のファクトリをインターフェース型
+   * tcp_stream として登録する初期化関数。
+   *
+   * @else
+   * @brief Module initialization
+   *
+   * Registers the factories of TCPStreamOutPort and TCPStreamInPort as
+   * the interface type tcp_stream.
+   *
+   * @endif
+   */
+  DLL_EXPORT void TCPStreamTransportInit(RTC::Manager* manager);
+}
+
+#endif // RTC_TCPSTREAMTRANSPORT_H
@@ -0,0 +1,198 @@
+﻿// -*- C++ -*-
+/*!
+ * @file LatencyHistogram.cpp
+ * @brief Streaming log-linear latency histogram class
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <coil/LatencyHistogram.h>
+
+#include <cmath>
+#include <limits>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace coil
+{
+  namespace
+  {
+    // Index of the most significant bit. value must not be 0.
+    int msb(uint64_t value)
+    {
+#if defined(__GNUC__)
+      return 63 - __builtin_clzll(value);
+#elif defined(_MSC_VER) && defined(_WIN64)
+      unsigned long index;
+      _BitScanReverse64(&index, value);
+      return static_cast<int>(index);
+#else
+      int index(0);
+      while ((value >>= 1) != 0) { ++index; }
+      return index;
+#endif
+    }
+  } // namespace
+
+  LatencyHistogram::LatencyHistogram()
+  {
+    reset();
+  }
+
+  /*!
+   * @if jp
+   * @brief 時間を記録する
+   * @else
+   * @brief Record a duration
+   * @endif
+   */
+  void LatencyHistogram::record(std::chrono::nanoseconds value)
+  {
+    uint64_t ns(value.count() > 0 ? static_cast<uint64_t>(value.count()) : 0);
+    add(m_buckets[bucketIndex(ns)], 1);
+    add(m_sum, ns);
+    if (ns < m_min.load(std::memory_order_relaxed))
+      {
+        m_min.store(ns, std::memory_order_relaxed);
+      }
+    if (ns > m_max.load(std::memory_order_relaxed))
+      {
+        m_max.store(ns, std::memory_order_relaxed);
+      }
+    // The buckets are complete when the count is seen.
+    m_count.store(m_count.load(std::memory_order_relaxed) + 1,
+                  std::memory_order_release);
+  }
+
+  uint64_t LatencyHistogram::count() const
+  {
+    return m_count.load(std::memory_order_acquire);
+  }
+
+  /*!
+   * @if jp
+   * @brief パーセンタイル値を取得する
+   * @else
+   * @brief Get the percentile value
+   * @endif
+   */
+  std::chrono::nanoseconds LatencyHistogram::percentile(double percent) const
+  {
+    uint64_t total(count());
+    if (total == 0) { return std::chrono::nanoseconds(0); }
+
+    if (percent < 0.0) { percent = 0.0; }
+    if (percent > 100.0) { percent = 100.0; }
+    uint64_t target(static_cast<uint64_t>(std::ceil(total * percent / 100.0)));
+    if (target == 0) { target = 1; }
+
+    uint64_t max(m_max.load(std::memory_order_relaxed));
+    uint64_t sum(0);
+    for (size_t i(0); i < BUCKETS; ++i)
+      {
+        sum += m_buckets[i].load(std::memory_order_relaxed);
+        if (sum >= target)
+          {
+            uint64_t upper(bucketUpperBound(i));
+            return std::chrono::nanoseconds(upper < max ? upper : max);
+          }
+      }
+    return std::chrono::nanoseconds(max);
+  }
+
+  /*!
+   * @if jp
+   * @brief 統計値を取得する
+   * @else
+   * @brief Get the statistics
+   * @endif
+   */
+  LatencyHistogram::Summary LatencyHistogram::getSummary() const
+  {
+    Summary summary;
+    summary.count = count();
+    if (summary.count == 0)
+      {
+        summary.min = summary.mean = summary.max = std::chrono::nanoseconds(0);
+      }
+    else
+      {
+        summary.min = std::chrono::nanoseconds(m_min.load(std::memory_order_relaxed));
+        summary.mean = std::chrono::nanoseconds(m_sum.load(std::memory_order_relaxed)
+                                                / summary.count);
+        summary.max = std::chrono::nanoseconds(m_max.load(std::memory_order_relaxed));
+      }
+    summary.p50 = percentile(50.0);
+    summary.p90 = percentile(90.0);
+    summary.p99 = percentile(99.0);
+    summary.p999 = percentile(99.9);
+    return summary;
+  }
+
+  /*!
+   * @if jp
+   * @brief 記録を消去する
+   * @else
+   * @brief Clear the records
+   * @endif
+   */
+  void LatencyHistogram::reset()
+  {
+    m_count.store(0, std::memory_order_relaxed);
+    for (auto& bucket : m_buckets)
+      {
+        bucket.store(0, std::memory_order_relaxed);
+      }
+    m_sum.store(0, std::memory_order_relaxed);
+    m_min.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_release);
+  }
+
+  /*!
+   * @if jp
+   * @brief 値を含むバケツの番号を取得する
+   *
+   * 2 * SUB_BUCKETS 未満の値は値そのもの、それ以上は 2 のべき乗ごとの
+   * 範囲を SUB_BUCKETS 個に分けた番号となる。
+   *
+   * @else
+   * @brief Get the index of the bucket including the value
+   *
+   * The index is the value itself below 2 * SUB_BUCKETS. Above that, each
+   * power of two range is divided into SUB_BUCKETS indices.
+   *
+   * @endif
+   */
+  size_t LatencyHistogram::bucketIndex(uint64_t value)
+  {
+    if (value < SUB_BUCKETS) { return static_cast<size_t>(value); }
+    int shift(msb(value) - SUB_BUCKET_BITS);
+    return static_cast<size_t>((shift + 1) * SUB_BUCKETS
+                               + ((value >> shift) & (SUB_BUCKETS - 1)));
+  }
+
+  uint64_t LatencyHistogram::bucketUpperBound(size_t index)
+  {
+    if (index < 2 * SUB_BUCKETS) { return index; }
+    int shift(static_cast<int>(index / SUB_BUCKETS) - 1);
+    uint64_t lower((SUB_BUCKETS + index % SUB_BUCKETS) << shift);
+    return lower + ((uint64_t(1) << shift) - 1);
+  }
+
+  void LatencyHistogram::add(std::atomic<uint64_t>& counter, uint64_t value)
+  {
+    // Only one thread writes, so no read-modify-write is needed.
+    counter.store(counter.load(std::memory_order_relaxed) + value,
+                  std::memory_order_relaxed);
+  }
+} // namespace coil
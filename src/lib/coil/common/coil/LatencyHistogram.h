@@ -0,0 +1,170 @@
+﻿// -*- C++ -*-
+/*!
+ * @file LatencyHistogram.h
+ * @brief Streaming log-linear latency histogram class
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef COIL_LATENCYHISTOGRAM_H
+#define COIL_LATENCYHISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace coil
+{
+  /*!
+   * @if jp
+   *
+   * @class LatencyHistogram
+   * @brief 遅延時間のヒストグラムクラス
+   *
+   * 時間をナノ秒単位の対数線形のバケツで数える、メモリ使用量が一定のヒ
+   * ストグラム。2のべき乗ごとの範囲を 16 個のバケツに分けるため、パー
+   * センタイルの相対誤差は 1/16 以下となる。
+   *
+   * record() は1つのスレッドから呼び出す。統計値は他のスレッドから
+   * record() と並行して取得できる。
+   *
+   * @else
+   *
+   * @class LatencyHistogram
+   * @brief Latency histogram class
+   *
+   * Constant memory histogram counting the durations in nanoseconds in
+   * log-linear buckets. Each power of two range is divided into 16
+   * buckets, so the relative error of the percentiles is 1/16 or less.
+   *
+   * record() is called from a single thread. The statistics can be read
+   * from the other threads concurrently with record().
+   *
+   * @endif
+   */
+  class LatencyHistogram
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief 統計値
+     * @else
+     * @brief Statistics
+     * @endif
+     */
+    struct Summary
+    {
+      uint64_t count;
+      std::chrono::nanoseconds min;
+      std::chrono::nanoseconds mean;
+      std::chrono::nanoseconds p50;
+      std::chrono::nanoseconds p90;
+      std::chrono::nanoseconds p99;
+      std::chrono::nanoseconds p999;
+      std::chrono::nanoseconds max;
+    };
+
+    LatencyHistogram();
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    /*!
+     * @if jp
+     * @brief 時間を記録する
+     *
+     * 負の値は 0 として記録する。
+     *
+     * @param value 時間
+     *
+     * @else
+     * @brief Record a duration
+     *
+     * A negative value is recorded as 0.
+     *
+     * @param value Duration
+     *
+     * @endif
+     */
+    void record(std::chrono::nanoseconds value);
+
+    /*!
+     * @if jp
+     * @brief 記録した数を取得する
+     * @else
+     * @brief Get the number of the records
+     * @endif
+     */
+    uint64_t count() const;
+
+    /*!
+     * @if jp
+     * @brief パーセンタイル値を取得する
+     *
+     * @param percent 0 から 100 までのパーセント
+     *
+     * @return 記録した値の percent % 以上が含まれるバケツの上限。記録
+     *         がない場合は 0。
+     *
+     * @else
+     * @brief Get the percentile value
+     *
+     * @param percent Percent from 0 to 100
+     *
+     * @return Upper bound of the bucket where percent % or more of the
+     *         records are included. 0 if nothing is recorded.
+     *
+     * @endif
+     */
+    std::chrono::nanoseconds percentile(double percent) const;
+
+    /*!
+     * @if jp
+     * @brief 統計値を取得する
+     * @else
+     * @brief Get the statistics
+     * @endif
+     */
+    Summary getSummary() const;
+
+    /*!
+     * @if jp
+     * @brief 記録を消去する
+     *
+     * record() と並行して呼び出した場合、その記録は失われることがある。
+     *
+     * @else
+     * @brief Clear the records
+     *
+     * A record made concurrently with this function might be lost.
+     *
+     * @endif
+     */
+    void reset();
+
+  private:
+    static const int SUB_BUCKET_BITS = 4;
+    static const uint64_t SUB_BUCKETS = 1u << SUB_BUCKET_BITS;
+    static const size_t BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    static size_t bucketIndex(uint64_t value);
+    static uint64_t bucketUpperBound(size_t index);
+    static void add(std::atomic<uint64_t>& counter, uint64_t value);
+
+    std::array<std::atomic<uint64_t>, BUCKETS> m_buckets;
+    std::atomic<uint64_t> m_count;
+    std::atomic<uint64_t> m_sum;
+    std::atomic<uint64_t> m_min;
+    std::atomic<uint64_t> m_max;
+  };
+} // namespace coil
+
+#endif  // COIL_LATENCYHISTOGRAM_H
@@ -50,37 +50,46 @@ namespace coil
 
   /*!
    * @if jp
-   * @brief ԡ󥹥ȥ饯
+   * @brief ࡼ֥󥹥ȥ饯
    * @else
-   * @brief Copy Constructor
+   * @brief Move Constructor
    * @endif
    */
-  SharedMemory::SharedMemory(const SharedMemory& rhs)
+  SharedMemory::SharedMemory(SharedMemory&& rhs) noexcept
+    : m_memory_size(rhs.m_memory_size),
+      m_shm_address(std::move(rhs.m_shm_address)),
+      m_shm(rhs.m_shm),
+      m_file_create(rhs.m_file_create),
+      m_fd(rhs.m_fd)
   {
-    m_memory_size = rhs.m_memory_size;
-    m_shm_address = rhs.m_shm_address;
-    m_shm = rhs.m_shm;
-    m_fd = rhs.m_fd;
- 
-
+    rhs.m_memory_size = 0;
+    rhs.m_shm = nullptr;
+    rhs.m_file_create = false;
+    rhs.m_fd = -1;
   }
 
   /*!
    * @if jp
-   * @brief 黻
+   * @brief ࡼ黻
    * @else
-   * @brief Assignment operator
+   * @brief Move assignment operator
    * @endif
    */
-  SharedMemory& SharedMemory::operator=(const SharedMemory& rhs)
+  SharedMemory& SharedMemory::operator=(SharedMemory&& rhs) noexcept
   {
-    SharedMemory tmp(rhs);
-    std::swap(this->m_memory_size, tmp.m_memory_size);
-    std::swap(this->m_shm_address, tmp.m_shm_address);
-    std::swap(this->m_shm, tmp.m_shm);
-    std::swap(this->m_fd, tmp.m_fd);
-    std::swap(this->m_file_create, tmp.m_file_create);
-
+    if (this != &rhs)
+      {
+        close();
+        m_memory_size = rhs.m_memory_size;
+        m_shm_address = std::move(rhs.m_shm_address);
+        m_shm = rhs.m_shm;
+        m_file_create = rhs.m_file_create;
+        m_fd = rhs.m_fd;
+        rhs.m_memory_size = 0;
+        rhs.m_shm = nullptr;
+        rhs.m_file_create = false;
+        rhs.m_fd = -1;
+      }
     return *this;
   }
 
@@ -176,6 +185,52 @@ namespace coil
     return 0;
   }
 
+  /*!
+   * @if jp
+   *
+   * @brief ¸ζͭؤΥ
+   *
+   * @else
+   *
+   * @brief Open an existing Shared Memory
+   *
+   * @endif
+   */
+  int SharedMemory::open_existing(std::string shm_address,
+                                  unsigned long long memory_size)
+  {
+    m_shm_address = std::move(shm_address);
+    m_memory_size = memory_size;
+
+    m_fd = shm_open(m_shm_address.c_str(), O_RDWR, 0);
+    if(m_fd < 0)
+    {
+        return -1;
+    }
+    struct stat st;
+    if (fstat(m_fd, &st) != 0 ||
+        static_cast<unsigned long long>(st.st_size) < m_memory_size)
+    {
+        ::close(m_fd);
+        m_fd = -1;
+        return -1;
+    }
+    m_shm = static_cast<char*>(mmap(nullptr,
+            m_memory_size,
+            PROT_READ|PROT_WRITE,
+            MAP_SHARED,
+            m_fd,
+            0));
+    if (m_shm == MAP_FAILED)
+    {
+        m_shm = nullptr;
+        ::close(m_fd);
+        m_fd = -1;
+        return -1;
+    }
+    return 0;
+  }
+
   /*!
    * @if jp
    *
@@ -266,7 +321,13 @@ namespace coil
     
     if (created())
     {
+        if (m_shm != nullptr && m_shm != MAP_FAILED)
+        {
+            munmap(m_shm, static_cast<size_t>(m_memory_size));
+        }
+        m_shm = nullptr;
         ::close(m_fd);
+        m_fd = -1;
     }
     else
     {
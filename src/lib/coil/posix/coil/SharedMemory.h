@@ -95,48 +95,68 @@ namespace coil
     /*!
      * @if jp
      *
-     * @brief ԡ󥹥ȥ饯
+     * @brief ԡ϶ػ
      *
-     * ԡ󥹥ȥ饯
+     * close() ȥǥȥ饯ϥޥåԥ󥰤뤿ᡢƱޥåԥ
+     * ͭ륳ԡϺʤ
      *
-     * @param rhs ԡͭꥪ֥
+     * @else
+     *
+     * @brief Copying is prohibited
+     *
+     * Since close() and the destructor release the mapping, no copy
+     * sharing the same mapping is made.
+     *
+     * @endif
+     */
+    SharedMemory(const SharedMemory& rhs) = delete;
+    SharedMemory& operator=(const SharedMemory& rhs) = delete;
+
+    /*!
+     * @if jp
+     *
+     * @brief ࡼ֥󥹥ȥ饯
+     *
+     * ޥåԥ󥰤νͭܤrhs ̤ξ֤ˤʤ롣
+     *
+     * @param rhs ࡼָζͭꥪ֥
      *
      * @else
      *
-     * @brief Copy Constructor
+     * @brief Move Constructor
      *
-     * Copy Constructor
+     * Transfers the ownership of the mapping. rhs is left not created.
      *
-     * @param rhs shared memory object of copy source.
+     * @param rhs shared memory object of move source.
      *
      * @endif
      */
-    SharedMemory(const SharedMemory& rhs);
+    SharedMemory(SharedMemory&& rhs) noexcept;
 
     /*!
      * @if jp
      *
-     * @brief 黻
+     * @brief ࡼ黻
      *
-     * ͭꥪ֥Ȥ򥳥ԡ롣
+     * ȤΥޥåԥ󥰤Ƥ rhs νͭܤ
      *
-     * @param rhs ưŪͭꥪ֥
+     * @param rhs ࡼָζͭꥪ֥
      *
      * @return 
      *
      * @else
      *
-     * @brief Assignment operator
+     * @brief Move assignment operator
      *
-     * Copy a shared memory object.
+     * Releases the own mapping and transfers the ownership of rhs.
      *
-     * @param rhs shared memory object of assignment source.
+     * @param rhs shared memory object of move source.
      *
      * @return Assignment result.
      *
      * @endif
      */
-    SharedMemory& operator=(const SharedMemory& rhs);
+    SharedMemory& operator=(SharedMemory&& rhs) noexcept;
 
 
     /*!
@@ -192,6 +212,37 @@ namespace coil
                      unsigned long long memory_size = DEFAULT_MEMORY_SIZE);
 
 
+    /*!
+     * @if jp
+     *
+     * @brief ¸ζͭؤΥ
+     *
+     * open() Ȱۤʤꡢ꤬ͭ¸ߤʤ memory_size 꾮
+     * Ϻĥ򤻤˼Ԥ롣
+     *
+     * @param shm_address ͭμ̻
+     * @param memory_size ͭΥ
+     *
+     * @return 0: , -1: 
+     *
+     * @else
+     *
+     * @brief Open an existing Shared Memory
+     *
+     * Unlike open(), fails without creating or extending the shared
+     * memory if it does not exist or is smaller than memory_size.
+     *
+     * @param shm_address
+     * @param memory_size
+     *
+     * @return 0: successful, -1: failed
+     *
+     * @endif
+     */
+    virtual int open_existing(std::string shm_address,
+                              unsigned long long memory_size);
+
+
     /*!
      * @if jp
      *
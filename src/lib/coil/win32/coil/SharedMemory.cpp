@@ -53,33 +53,42 @@ namespace coil
 
   /*!
    * @if jp
-   * @brief コピーコンストラクタ
+   * @brief ムーブコンストラクタ
    * @else
-   * @brief Copy Constructor
+   * @brief Move Constructor
    * @endif
    */
-  SharedMemory::SharedMemory(const SharedMemory& rhs)
+  SharedMemory::SharedMemory(SharedMemory&& rhs) noexcept
+    : m_memory_size(rhs.m_memory_size),
+      m_shm_address(std::move(rhs.m_shm_address)),
+      m_shm(rhs.m_shm),
+      m_handle(rhs.m_handle)
   {
-    m_memory_size = rhs.m_memory_size;
-    m_shm_address = rhs.m_shm_address;
-    m_shm = rhs.m_shm;
-    m_handle = rhs.m_handle;
+    rhs.m_memory_size = 0;
+    rhs.m_shm = nullptr;
+    rhs.m_handle = nullptr;
   }
 
   /*!
    * @if jp
-   * @brief 代入演算子
+   * @brief ムーブ代入演算子
    * @else
-   * @brief Assignment operator
+   * @brief Move assignment operator
    * @endif
    */
-  SharedMemory& SharedMemory::operator=(const SharedMemory& rhs)
+  SharedMemory& SharedMemory::operator=(SharedMemory&& rhs) noexcept
   {
-    SharedMemory tmp(rhs);
-    std::swap(this->m_memory_size, tmp.m_memory_size);
-    std::swap(this->m_shm_address, tmp.m_shm_address);
-    std::swap(this->m_shm, tmp.m_shm);
-    std::swap(this->m_handle, tmp.m_handle);
+    if (this != &rhs)
+      {
+        close();
+        m_memory_size = rhs.m_memory_size;
+        m_shm_address = std::move(rhs.m_shm_address);
+        m_shm = rhs.m_shm;
+        m_handle = rhs.m_handle;
+        rhs.m_memory_size = 0;
+        rhs.m_shm = nullptr;
+        rhs.m_handle = nullptr;
+      }
     return *this;
   }
 
@@ -156,6 +165,41 @@ namespace coil
     return 0;
   }
 
+  /*!
+   * @if jp
+   * @brief 既存の共有メモリへのアクセス
+   * @else
+   * @brief Open an existing Shared Memory
+   * @endif
+   */
+  int SharedMemory::open_existing(std::string shm_address,
+                                  unsigned long long memory_size)
+  {
+    m_shm_address = std::move(shm_address);
+    m_memory_size = memory_size;
+    m_handle = OpenFileMapping(FILE_MAP_ALL_ACCESS, FALSE, m_shm_address.c_str());
+    if (m_handle == nullptr)
+    {
+      return -1;
+    }
+    m_shm = static_cast<char *>(MapViewOfFile(m_handle, FILE_MAP_ALL_ACCESS, 0, 0, 0));
+    MEMORY_BASIC_INFORMATION info;
+    if (m_shm == nullptr ||
+        VirtualQuery(m_shm, &info, sizeof(info)) == 0 ||
+        info.RegionSize < m_memory_size)
+    {
+      if (m_shm != nullptr)
+      {
+        UnmapViewOfFile(m_shm);
+        m_shm = nullptr;
+      }
+      CloseHandle(m_handle);
+      m_handle = nullptr;
+      return -1;
+    }
+    return 0;
+  }
+
   /*!
    * @if jp
    *
@@ -249,6 +293,7 @@ namespace coil
     if (created())
     {
       UnmapViewOfFile(m_shm);
+      m_shm = nullptr;
     }
     else
     {
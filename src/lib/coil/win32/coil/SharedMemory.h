@@ -88,48 +88,68 @@ namespace coil
     /*!
      * @if jp
      *
-     * @brief コピーコンストラクタ
+     * @brief コピーは禁止
      *
-     * コピーコンストラクタ。
+     * close() とデストラクタはマッピングを解放するため、同じマッピング
+     * を共有するコピーは作らない。
      *
-     * @param rhs コピー元共有メモリオブジェクト
+     * @else
+     *
+     * @brief Copying is prohibited
+     *
+     * Since close() and the destructor release the mapping, no copy
+     * sharing the same mapping is made.
+     *
+     * @endif
+     */
+    SharedMemory(const SharedMemory& rhs) = delete;
+    SharedMemory& operator=(const SharedMemory& rhs) = delete;
+
+    /*!
+     * @if jp
+     *
+     * @brief ムーブコンストラクタ
+     *
+     * マッピングの所有権を移す。rhs は未作成の状態になる。
+     *
+     * @param rhs ムーブ元の共有メモリオブジェクト
      *
      * @else
      *
-     * @brief Copy Constructor
+     * @brief Move Constructor
      *
-     * Copy Constructor
+     * Transfers the ownership of the mapping. rhs is left not created.
      *
-     * @param rhs shared memory object of copy source.
+     * @param rhs shared memory object of move source.
      *
      * @endif
      */
-    SharedMemory(const SharedMemory& rhs);
+    SharedMemory(SharedMemory&& rhs) noexcept;
 
     /*!
      * @if jp
      *
-     * @brief 代入演算子
+     * @brief ムーブ代入演算子
      *
-     * 共有メモリオブジェクトをコピーする。
+     * 自身のマッピングを解放してから rhs の所有権を移す。
      *
-     * @param rhs 代入元動的共有メモリオブジェクト
+     * @param rhs ムーブ元の共有メモリオブジェクト
      *
      * @return 代入結果
      *
      * @else
      *
-     * @brief Assignment operator
+     * @brief Move assignment operator
      *
-     * Copy a shared memory object.
+     * Releases the own mapping and transfers the ownership of rhs.
      *
-     * @param rhs shared memory object of assignment source.
+     * @param rhs shared memory object of move source.
      *
      * @return Assignment result.
      *
      * @endif
      */
-    SharedMemory& operator=(const SharedMemory& rhs);
+    SharedMemory& operator=(SharedMemory&& rhs) noexcept;
 
 
     /*!
@@ -185,6 +205,37 @@ namespace coil
         unsigned long long memory_size = DEFAULT_MEMORY_SIZE);
 
 
+    /*!
+     * @if jp
+     *
+     * @brief 既存の共有メモリへのアクセス
+     *
+     * open() と異なり、共有メモリが存在しない場合や memory_size より小
+     * さい場合は作成や拡張をせずに失敗する。
+     *
+     * @param shm_address 共有メモリの識別子
+     * @param memory_size 共有メモリのサイズ
+     *
+     * @return 0: 成功, -1: 失敗
+     *
+     * @else
+     *
+     * @brief Open an existing Shared Memory
+     *
+     * Unlike open(), fails without creating or extending the shared
+     * memory if it does not exist or is smaller than memory_size.
+     *
+     * @param shm_address
+     * @param memory_size
+     *
+     * @return 0: successful, -1: failed
+     *
+     * @endif
+     */
+    virtual int open_existing(std::string shm_address,
+                              unsigned long long memory_size);
+
+
     /*!
      * @if jp
      *
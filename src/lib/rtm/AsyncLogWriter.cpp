@@ -0,0 +1,349 @@
+// -*- C++ -*-
+/*!
+ * @file AsyncLogWriter.cpp
+ * @brief Asynchronous log record writer
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <rtm/AsyncLogWriter.h>
+
+#include <utility>
+
+namespace
+{
+  // true on the background thread, whose own logs are written directly
+  thread_local bool t_writerThread(false);
+} // namespace
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @brief ログレコード
+   * @else
+   * @brief Log record
+   * @endif
+   */
+  struct AsyncLogWriter::Record
+  {
+    coil::LogStreamBuffer* stream{nullptr};
+    int level{0};
+    std::chrono::nanoseconds time{0};
+    std::shared_ptr<const Logger::DateFormat> format;
+    std::string name;
+    std::string message;
+  };
+
+  /*!
+   * @if jp
+   * @brief スレッドごとのレコードキュー
+   *
+   * ログを出力するスレッドが唯一の書き込み側、AsyncLogWriter のスレッド
+   * が唯一の読み出し側となる固定長のリングバッファ。読み出したレコード
+   * はスロットと交換するため、文字列の領域は再利用される。
+   *
+   * @else
+   * @brief Per-thread record queue
+   *
+   * Fixed length ring buffer whose only writer is the logging thread and
+   * whose only reader is the thread of AsyncLogWriter. A record is read
+   * by swapping it with the slot, so the string storage is reused.
+   *
+   * @endif
+   */
+  class AsyncLogWriter::RecordQueue
+  {
+  public:
+    explicit RecordQueue(size_t length)
+      : m_records(length)
+    {
+    }
+
+    bool push(coil::LogStreamBuffer* stream, int level,
+              const std::string& name,
+              const std::shared_ptr<const Logger::DateFormat>& format,
+              std::chrono::nanoseconds time, const std::string& mes)
+    {
+      size_t w(m_wcount.load(std::memory_order_relaxed));
+      if (w - m_rcount.load(std::memory_order_acquire) >= m_records.size())
+        {
+          return false;
+        }
+      Record& rec(m_records[w % m_records.size()]);
+      rec.stream = stream;
+      rec.level = level;
+      rec.time = time;
+      rec.format = format;
+      rec.name.assign(name);
+      rec.message.assign(mes);
+      m_wcount.store(w + 1, std::memory_order_release);
+      return true;
+    }
+
+    bool pop(Record& rec)
+    {
+      size_t r(m_rcount.load(std::memory_order_relaxed));
+      if (r == m_wcount.load(std::memory_order_acquire))
+        {
+          return false;
+        }
+      std::swap(rec, m_records[r % m_records.size()]);
+      m_rcount.store(r + 1, std::memory_order_release);
+      return true;
+    }
+
+    void close()
+    {
+      m_closed.store(true, std::memory_order_release);
+    }
+
+    bool closed() const
+    {
+      return m_closed.load(std::memory_order_acquire);
+    }
+
+  private:
+    std::vector<Record> m_records;
+    std::atomic<size_t> m_wcount{0};
+    std::atomic<size_t> m_rcount{0};
+    std::atomic<bool> m_closed{false};
+  };
+
+  AsyncLogWriter& AsyncLogWriter::instance()
+  {
+    static AsyncLogWriter writer;
+    return writer;
+  }
+
+  AsyncLogWriter::~AsyncLogWriter()
+  {
+    stop();
+  }
+
+  /*!
+   * @if jp
+   * @brief バックグラウンドスレッドを開始する
+   * @else
+   * @brief Start the background thread
+   * @endif
+   */
+  void AsyncLogWriter::start(size_t length)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (m_thread.joinable()) { return; }
+    m_length = length > 0 ? length : 1;
+    m_running.store(true, std::memory_order_release);
+    m_thread = std::thread([this] { svc(); });
+  }
+
+  /*!
+   * @if jp
+   * @brief バックグラウンドスレッドを停止する
+   * @else
+   * @brief Stop the background thread
+   * @endif
+   */
+  void AsyncLogWriter::stop()
+  {
+    std::thread thread;
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      m_running.store(false, std::memory_order_release);
+      thread.swap(m_thread);
+    }
+    m_cond.notify_all();
+    if (thread.joinable()) { thread.join(); }
+  }
+
+  /*!
+   * @if jp
+   * @brief ログレコードをキューに追加する
+   * @else
+   * @brief Add a log record to the queue
+   * @endif
+   */
+  bool AsyncLogWriter::push(coil::LogStreamBuffer* stream, int level,
+                            const std::string& name,
+                            const std::shared_ptr<const Logger::DateFormat>& format,
+                            std::chrono::nanoseconds time,
+                            const std::string& mes)
+  {
+    if (t_writerThread) { return false; }
+
+    // Counted before m_running is checked, so that the background thread
+    // waits for this record before its final drain.
+    m_pushing.fetch_add(1);
+    if (!m_running.load())
+      {
+        m_pushing.fetch_sub(1);
+        return false;
+      }
+
+    if (!localQueue()->push(stream, level, name, format, time, mes))
+      {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+      }
+    m_pushing.fetch_sub(1, std::memory_order_release);
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief 破棄したレコードの数を取得する
+   * @else
+   * @brief Get the number of dropped records
+   * @endif
+   */
+  uint64_t AsyncLogWriter::getDropCount() const
+  {
+    return m_dropped.load(std::memory_order_relaxed);
+  }
+
+  /*!
+   * @if jp
+   * @brief 呼び出しスレッドのキューを取得する
+   *
+   * 最初の呼び出しでキューを生成して登録する。m_mutex は登録時のみ取
+   * 得し、その間にバックグラウンドスレッドが I/O を行うことはない。ス
+   * レッドの終了時にキューは閉じられ、残りのレコードを出力した後に登
+   * 録が解除される。
+   *
+   * @else
+   * @brief Get the queue of the calling thread
+   *
+   * The queue is created and registered on the first call. m_mutex is
+   * taken only to register it, and the background thread does no I/O
+   * while holding it. The queue is closed when the thread exits and
+   * unregistered after the remaining records are written.
+   *
+   * @endif
+   */
+  AsyncLogWriter::RecordQueue* AsyncLogWriter::localQueue()
+  {
+    struct Holder
+    {
+      ~Holder()
+      {
+        if (queue) { queue->close(); }
+      }
+      std::shared_ptr<RecordQueue> queue;
+    };
+    static thread_local Holder holder;
+
+    if (!holder.queue)
+      {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        holder.queue = std::make_shared<RecordQueue>(m_length);
+        m_newQueues.push_back(holder.queue);
+      }
+    return holder.queue.get();
+  }
+
+  /*!
+   * @if jp
+   * @brief バックグラウンドスレッドの処理
+   * @else
+   * @brief Background thread
+   * @endif
+   */
+  void AsyncLogWriter::svc()
+  {
+    t_writerThread = true;
+    while (m_running.load(std::memory_order_acquire))
+      {
+        if (drain() == 0)
+          {
+            std::unique_lock<std::mutex> guard(m_mutex);
+            m_cond.wait_for(guard, std::chrono::milliseconds(10), [this] {
+                return !m_running.load(std::memory_order_acquire);
+              });
+          }
+      }
+    // push() called after this point sees !m_running and the record is
+    // written synchronously by Logger. Wait for the ones already past
+    // the check so that none is left in the queues.
+    while (m_pushing.load() != 0)
+      {
+        std::this_thread::yield();
+      }
+    while (drain() != 0) {}
+  }
+
+  /*!
+   * @if jp
+   * @brief すべてのキューのレコードを出力する
+   *
+   * 新たに登録されたキューを m_mutex を保持して取り出し、出力はロック
+   * を保持せずに行う。バックグラウンドスレッドから呼び出す。
+   *
+   * @return 出力したレコードの数
+   *
+   * @else
+   * @brief Write the records of all the queues
+   *
+   * The newly registered queues are taken out with m_mutex held, and
+   * the records are written without holding the lock. Called from the
+   * background thread.
+   *
+   * @return Number of the written records
+   *
+   * @endif
+   */
+  size_t AsyncLogWriter::drain()
+  {
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      if (!m_newQueues.empty())
+        {
+          m_queues.insert(m_queues.end(), m_newQueues.begin(),
+                          m_newQueues.end());
+          m_newQueues.clear();
+        }
+    }
+
+    size_t count(0);
+    Record rec;
+    for (auto it = m_queues.begin(); it != m_queues.end();)
+      {
+        // The records pushed before close() are visible once it is seen.
+        bool closed((*it)->closed());
+        while ((*it)->pop(rec))
+          {
+            rec.stream->write(rec.level, rec.name,
+                              rec.format->format(rec.time), rec.message);
+            m_lastStream = rec.stream;
+            m_lastFormat = rec.format;
+            m_lastTime = rec.time;
+            ++count;
+          }
+        if (closed)
+          {
+            it = m_queues.erase(it);
+          }
+        else
+          {
+            ++it;
+          }
+      }
+
+    uint64_t dropped(m_dropped.load(std::memory_order_relaxed));
+    if (dropped != m_reported && m_lastStream != nullptr)
+      {
+        m_lastStream->write(Logger::RTL_WARN, "logger",
+                            m_lastFormat->format(m_lastTime),
+                            coil::sprintf("%llu log records were dropped.",
+                              static_cast<unsigned long long>(dropped - m_reported)));
+        m_reported = dropped;
+      }
+    return count;
+  }
+} // namespace RTC
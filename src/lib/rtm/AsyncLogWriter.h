@@ -0,0 +1,189 @@
+// -*- C++ -*-
+/*!
+ * @file AsyncLogWriter.h
+ * @brief Asynchronous log record writer
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_ASYNCLOGWRITER_H
+#define RTC_ASYNCLOGWRITER_H
+
+#include <rtm/SystemLogger.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class AsyncLogWriter
+   * @brief ログレコードを別スレッドで出力するライタ
+   *
+   * Logger::write() から渡されたログレコード (ログレベル、時刻、名前、
+   * 整形済みメッセージ) をスレッドごとのロックフリーなキューに格納し、
+   * バックグラウンドスレッドで日時の整形とログストリームへの出力を行う。
+   * ログを出力するスレッドは日時の整形、ファイル等への I/O、ストリーム
+   * のロックを行わない。
+   *
+   * キューは有限長で、満杯の場合レコードは破棄され、破棄数が計上される。
+   * 破棄が発生した場合はバックグラウンドスレッドが WARN レベルのログで
+   * 破棄数を出力する。
+   *
+   * Manager の設定 logger.async が YES の場合に Manager が start() を
+   * 呼び出す。
+   *
+   * @else
+   * @class AsyncLogWriter
+   * @brief Writer outputting log records on a background thread
+   *
+   * Log records (log level, time, name and formatted message) given by
+   * Logger::write() are stored in a per-thread lock-free queue, and a
+   * background thread formats the date and writes them to the log
+   * streams. The logging thread does no date formatting, no I/O to
+   * files and so on, and takes no stream lock.
+   *
+   * The queues are bounded. A record is dropped when the queue is full
+   * and the number of dropped records is counted. The background thread
+   * reports the number of dropped records by a WARN level log.
+   *
+   * Manager calls start() when the configuration logger.async is YES.
+   *
+   * @endif
+   */
+  class AsyncLogWriter
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief インスタンスの取得
+     * @else
+     * @brief Get the instance
+     * @endif
+     */
+    static AsyncLogWriter& instance();
+
+    /*!
+     * @if jp
+     * @brief バックグラウンドスレッドを開始する
+     *
+     * @param length スレッドごとのキューの長さ
+     *
+     * @else
+     * @brief Start the background thread
+     *
+     * @param length Length of the queue of each thread
+     *
+     * @endif
+     */
+    void start(size_t length);
+
+    /*!
+     * @if jp
+     * @brief バックグラウンドスレッドを停止する
+     *
+     * キューに残っているレコードをすべて出力してから停止する。停止処
+     * 理中に追加中だったレコードも出力される。停止後のログは Logger が
+     * 同期的に出力する。
+     *
+     * @else
+     * @brief Stop the background thread
+     *
+     * Stops after writing all the records left in the queues, including
+     * those being added while stopping. Logs after the stop are written
+     * synchronously by Logger.
+     *
+     * @endif
+     */
+    void stop();
+
+    /*!
+     * @if jp
+     * @brief ログレコードをキューに追加する
+     *
+     * @param stream 出力先のログストリーム
+     * @param level ログレベル
+     * @param name ロガー名
+     * @param format 日時のフォーマット
+     * @param time 時刻
+     * @param mes メッセージ
+     * @return true: 追加した、またはキューが満杯のため破棄した
+     *         false: 停止中のため追加しなかった
+     *
+     * @else
+     * @brief Add a log record to the queue
+     *
+     * @param stream Log stream to be written
+     * @param level Log level
+     * @param name Logger name
+     * @param format Date format
+     * @param time Time
+     * @param mes Message
+     * @return true: added, or dropped since the queue is full
+     *         false: not added since the writer is stopped
+     *
+     * @endif
+     */
+    bool push(coil::LogStreamBuffer* stream, int level,
+              const std::string& name,
+              const std::shared_ptr<const Logger::DateFormat>& format,
+              std::chrono::nanoseconds time, const std::string& mes);
+
+    /*!
+     * @if jp
+     * @brief 破棄したレコードの数を取得する
+     * @else
+     * @brief Get the number of dropped records
+     * @endif
+     */
+    uint64_t getDropCount() const;
+
+    AsyncLogWriter(const AsyncLogWriter&) = delete;
+    AsyncLogWriter& operator=(const AsyncLogWriter&) = delete;
+
+  private:
+    struct Record;
+    class RecordQueue;
+
+    AsyncLogWriter() = default;
+    ~AsyncLogWriter();
+
+    void svc();
+    size_t drain();
+    RecordQueue* localQueue();
+
+    std::atomic<bool> m_running{false};
+    std::atomic<size_t> m_pushing{0};
+    std::atomic<uint64_t> m_dropped{0};
+    uint64_t m_reported{0};
+    size_t m_length{0};
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    // registered by localQueue() under m_mutex, moved to m_queues by drain()
+    std::vector<std::shared_ptr<RecordQueue>> m_newQueues;
+    // accessed only by the background thread
+    std::vector<std::shared_ptr<RecordQueue>> m_queues;
+    std::thread m_thread;
+    coil::LogStreamBuffer* m_lastStream{nullptr};
+    std::shared_ptr<const Logger::DateFormat> m_lastFormat;
+    std::chrono::nanoseconds m_lastTime{0};
+  };
+} // namespace RTC
+
+#endif  // RTC_ASYNCLOGWRITER_H
@@ -41,6 +41,27 @@
  */
 namespace RTC
 {
+  /*!
+   * @if jp
+   * @brief バッファへの書き込みの結果
+   *
+   * バッファが書き込みの処理中に得た値を返すために用いる。
+   *
+   * @else
+   * @brief Result of a write into the buffer
+   *
+   * Used to return the values that the buffer obtained while writing.
+   *
+   * @endif
+   */
+  struct BufferWriteInfo
+  {
+    /*! Number of the data overwritten */
+    size_t overwritten{0};
+    /*! Readable number of the buffer after the write */
+    size_t readable{0};
+  };
+
   /*!
    * @if jp
    * @class BufferBase
@@ -309,6 +330,148 @@ namespace RTC
                                std::chrono::nanoseconds timeout
                                = std::chrono::nanoseconds(-1)) = 0;
 
+    /*!
+     * @if jp
+     *
+     * @brief バッファにデータを書き込み、上書き数と読み出し可能数を返す
+     *
+     * write(value, timeout) と同じくデータを書き込み、上書きしたデータ
+     * の数と書き込み後の読み出し可能数を info に格納する。デフォルト実
+     * 装は書き込みの前後に full() と readable() を呼び出すため、読み出
+     * しと並行する場合は正確でない。具象クラスは書き込みの処理中に得た
+     * 値を返すよう再定義すべきである。
+     *
+     * @param value 書き込み対象データ
+     * @param timeout タイムアウト時間 nsec (-1: 無効)
+     * @param info 上書き数と読み出し可能数を格納する
+     *
+     * @return write(value, timeout) と同じ
+     *
+     * @else
+     *
+     * @brief Write data into the buffer and return the overwritten and
+     *        readable numbers
+     *
+     * Writes the data as write(value, timeout) does, and stores the
+     * number of the data overwritten and the readable number after the
+     * write into info. The default implementation calls full() and
+     * readable() around the write, so it is not exact when a reader runs
+     * concurrently. Concrete classes should override it to return the
+     * values obtained while writing.
+     *
+     * @param value Target data to write
+     * @param timeout Timeout in nsec (-1: disabled)
+     * @param info The overwritten and readable numbers are stored
+     *
+     * @return The same as write(value, timeout)
+     *
+     * @endif
+     */
+    virtual BufferStatus write(const DataType& value,
+                               std::chrono::nanoseconds timeout,
+                               BufferWriteInfo& info)
+    {
+      bool full_(full());
+      BufferStatus ret(write(value, timeout));
+      info.overwritten = (ret == BufferStatus::OK && full_) ? 1 : 0;
+      info.readable = readable();
+      return ret;
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief バッファに複数のデータを書き込む
+     *
+     * values[0] から順に n 個のデータをバッファに書き込み、書き込みに
+     * 失敗した時点で終了する。デフォルト実装は write() を n 回呼び出す。
+     *
+     * @param values 書き込み対象データの配列
+     * @param n データの数
+     * @param written 書き込んだデータの数
+     *
+     * @return すべて書き込めた場合は OK、それ以外は失敗した write() の
+     *         戻り値
+     *
+     * @else
+     *
+     * @brief Write multiple data into the buffer
+     *
+     * Writes n data from values[0] in order into the buffer, and stops
+     * at the first failure. The default implementation calls write() n
+     * times.
+     *
+     * @param values Array of the data to write
+     * @param n Number of the data
+     * @param written Number of the data written
+     *
+     * @return OK if all the data were written, otherwise the return
+     *         value of the failed write()
+     *
+     * @endif
+     */
+    virtual BufferStatus writeBatch(const DataType* values, size_t n,
+                                    size_t& written)
+    {
+      for (written = 0; written < n; ++written)
+        {
+          BufferStatus ret(write(values[written]));
+          if (ret != BufferStatus::OK) { return ret; }
+        }
+      return BufferStatus::OK;
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief バッファに複数のデータを書き込み、上書き数と読み出し可能数を返す
+     *
+     * writeBatch(values, n, written) と同じくデータを書き込み、上書きし
+     * たデータの数の合計と書き込み後の読み出し可能数を info に格納する。
+     * デフォルト実装は write(value, timeout, info) を n 回呼び出す。
+     *
+     * @param values 書き込み対象データの配列
+     * @param n データの数
+     * @param written 書き込んだデータの数
+     * @param info 上書き数と読み出し可能数を格納する
+     *
+     * @return writeBatch(values, n, written) と同じ
+     *
+     * @else
+     *
+     * @brief Write multiple data into the buffer and return the
+     *        overwritten and readable numbers
+     *
+     * Writes the data as writeBatch(values, n, written) does, and stores
+     * the total number of the data overwritten and the readable number
+     * after the write into info. The default implementation calls
+     * write(value, timeout, info) n times.
+     *
+     * @param values Array of the data to write
+     * @param n Number of the data
+     * @param written Number of the data written
+     * @param info The overwritten and readable numbers are stored
+     *
+     * @return The same as writeBatch(values, n, written)
+     *
+     * @endif
+     */
+    virtual BufferStatus writeBatch(const DataType* values, size_t n,
+                                    size_t& written, BufferWriteInfo& info)
+    {
+      info = BufferWriteInfo();
+      for (written = 0; written < n; ++written)
+        {
+          BufferWriteInfo one;
+          BufferStatus ret(write(values[written],
+                                 std::chrono::nanoseconds(-1), one));
+          if (ret != BufferStatus::OK) { return ret; }
+          info.overwritten += one.overwritten;
+          info.readable = one.readable;
+        }
+      return BufferStatus::OK;
+    }
+
     /*!
      * @if jp
      *
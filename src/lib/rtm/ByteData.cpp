@@ -1,9 +1,172 @@
 ﻿#include "ByteData.h"
 #include "ByteDataStreamBase.h"
+#include <atomic>
 #include <cstring>
+#include <mutex>
+#include <new>
+#include <vector>
 
 namespace RTC
 {
+    /*!
+     * @if jp
+     * @brief 参照カウント付きのバッファブロック
+     *
+     * ブロックの直後にデータ領域が続く。
+     *
+     * @else
+     * @brief Reference counted buffer block
+     *
+     * The data area follows the block header.
+     *
+     * @endif
+     */
+    struct alignas(16) ByteData::Block
+    {
+        std::atomic<long> refcount{1};
+        unsigned long capacity{0};
+        int sizeclass{-1};
+
+        unsigned char* data()
+        {
+            return reinterpret_cast<unsigned char*>(this + 1);
+        }
+    };
+
+    namespace
+    {
+        /*!
+         * @if jp
+         * @brief サイズクラスごとのフリーリストを持つメモリプール
+         *
+         * 64 byte から 16 MB までの2のべき乗のサイズクラスを持ち、それ
+         * を超えるバッファはプールせずにヒープから直接確保する。各サイズ
+         * クラスに保持するブロックの総量は s_maxCachedBytes までとする。
+         *
+         * @else
+         * @brief Memory pool with a free list for each size class
+         *
+         * Size classes are powers of two from 64 bytes to 16 MB. Larger
+         * buffers are not pooled and are allocated from the heap
+         * directly. Each size class caches at most s_maxCachedBytes.
+         *
+         * @endif
+         */
+        class ByteDataPool
+        {
+        public:
+            using Block = ByteData::Block;
+            static const int s_minClassBits = 6;
+            static const int s_maxClassBits = 24;
+            static const int s_numClasses = s_maxClassBits - s_minClassBits + 1;
+            static const unsigned long s_maxCachedBytes = 32UL * 1024 * 1024;
+
+            ~ByteDataPool()
+            {
+                for (auto& sc : m_classes)
+                {
+                    for (auto* block : sc.freelist)
+                    {
+                        block->~Block();
+                        ::operator delete(block);
+                    }
+                    sc.freelist.clear();
+                }
+                s_destroyed = true;
+            }
+
+            static ByteDataPool& instance()
+            {
+                static ByteDataPool pool;
+                return pool;
+            }
+
+            static Block* allocate(unsigned long length)
+            {
+                int sc(sizeClass(length));
+                if (sc >= 0 && s_enabled && !s_destroyed)
+                {
+                    Block* block(instance().pop(sc));
+                    if (block != nullptr)
+                    {
+                        s_stats.pool_allocations.fetch_add(1, std::memory_order_relaxed);
+                        block->refcount.store(1, std::memory_order_relaxed);
+                        return block;
+                    }
+                }
+                unsigned long capacity(sc >= 0 ? (1UL << (sc + s_minClassBits)) : length);
+                void* mem(::operator new(sizeof(Block) + capacity));
+                Block* block(new (mem) Block());
+                block->capacity = capacity;
+                block->sizeclass = sc;
+                s_stats.heap_allocations.fetch_add(1, std::memory_order_relaxed);
+                return block;
+            }
+
+            static void deallocate(Block* block)
+            {
+                if (block->sizeclass >= 0 && s_enabled && !s_destroyed)
+                {
+                    if (instance().push(block)) { return; }
+                }
+                block->~Block();
+                ::operator delete(block);
+            }
+
+            static int sizeClass(unsigned long length)
+            {
+                if (length > (1UL << s_maxClassBits)) { return -1; }
+                int bits(s_minClassBits);
+                while ((1UL << bits) < length) { ++bits; }
+                return bits - s_minClassBits;
+            }
+
+            struct Counters
+            {
+                std::atomic<uint64_t> heap_allocations{0};
+                std::atomic<uint64_t> pool_allocations{0};
+                std::atomic<uint64_t> shared_copies{0};
+                std::atomic<uint64_t> copied_bytes{0};
+            };
+            static Counters s_stats;
+            static std::atomic<bool> s_enabled;
+            static bool s_destroyed;
+
+        private:
+            struct SizeClass
+            {
+                std::mutex mutex;
+                std::vector<Block*> freelist;
+            };
+
+            Block* pop(int sc)
+            {
+                std::lock_guard<std::mutex> guard(m_classes[sc].mutex);
+                if (m_classes[sc].freelist.empty()) { return nullptr; }
+                Block* block(m_classes[sc].freelist.back());
+                m_classes[sc].freelist.pop_back();
+                return block;
+            }
+
+            bool push(Block* block)
+            {
+                SizeClass& sc(m_classes[block->sizeclass]);
+                size_t limit(s_maxCachedBytes / block->capacity);
+                if (limit < 2) { limit = 2; }
+                std::lock_guard<std::mutex> guard(sc.mutex);
+                if (sc.freelist.size() >= limit) { return false; }
+                sc.freelist.push_back(block);
+                return true;
+            }
+
+            SizeClass m_classes[s_numClasses];
+        };
+
+        ByteDataPool::Counters ByteDataPool::s_stats;
+        std::atomic<bool> ByteDataPool::s_enabled{true};
+        bool ByteDataPool::s_destroyed{false};
+    } // namespace
+
     /*!
      * @if jp
      *
@@ -39,7 +202,7 @@ namespace RTC
      */
     ByteData::~ByteData()
     {
-        delete[] m_buf;
+        release();
     }
 
     /*!
@@ -61,9 +224,29 @@ namespace RTC
      */
     ByteData::ByteData(const ByteData &rhs)
     {
-        m_len = rhs.m_len;
-        m_buf = new unsigned char[m_len];
-        memcpy(m_buf, rhs.m_buf, m_len);
+        *this = rhs;
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief ムーブコンストラクタ
+     *
+     * @param rhs
+     *
+     * @else
+     *
+     * @brief Move Constructor
+     *
+     * @param rhs
+     *
+     * @endif
+     */
+    ByteData::ByteData(ByteData &&rhs) noexcept
+      : m_block(rhs.m_block), m_len(rhs.m_len)
+    {
+        rhs.m_block = nullptr;
+        rhs.m_len = 0;
     }
 
 
@@ -85,9 +268,7 @@ namespace RTC
      */
     ByteData::ByteData(const ByteDataStreamBase &rhs)
     {
-        m_len = rhs.getDataLength();
-        m_buf = new unsigned char[m_len];
-        rhs.readData(m_buf, m_len);
+        *this = rhs;
     }
     /*!
      * @if jp
@@ -109,13 +290,61 @@ namespace RTC
      */
     ByteData& ByteData::operator= (const ByteData &rhs)
     {
-        if(m_len != rhs.m_len)
+        if (this == &rhs)
+        {
+            return *this;
+        }
+        if (!ByteDataPool::s_enabled.load(std::memory_order_relaxed))
         {
+            assign(rhs.m_len);
+            if (m_len > 0)
+            {
+                memcpy(m_block->data(), rhs.getBuffer(), m_len);
+                ByteDataPool::s_stats.copied_bytes.fetch_add(m_len, std::memory_order_relaxed);
+            }
+            return *this;
+        }
+        if (m_block != rhs.m_block)
+        {
+            if (rhs.m_block != nullptr)
+            {
+                rhs.m_block->refcount.fetch_add(1, std::memory_order_relaxed);
+                ByteDataPool::s_stats.shared_copies.fetch_add(1, std::memory_order_relaxed);
+            }
+            release();
+            m_block = rhs.m_block;
+        }
+        m_len = rhs.m_len;
+        return *this;
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief ムーブ代入演算子
+     *
+     * @param rhs
+     * @return
+     *
+     * @else
+     *
+     * @brief Move assignment operator
+     *
+     * @param rhs
+     * @return
+     *
+     * @endif
+     */
+    ByteData& ByteData::operator= (ByteData &&rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            release();
+            m_block = rhs.m_block;
             m_len = rhs.m_len;
-            delete[] m_buf;
-            m_buf = new unsigned char[m_len];
+            rhs.m_block = nullptr;
+            rhs.m_len = 0;
         }
-        memcpy(m_buf, rhs.m_buf, m_len);
         return *this;
     }
     /*!
@@ -138,13 +367,15 @@ namespace RTC
      */
     ByteData& ByteData::operator= (const ByteDataStreamBase &rhs)
     {
-        if(m_len != rhs.getDataLength())
+        // the data already held in a ByteData is shared, not copied
+        const SharedByteDataStream* shared(
+            dynamic_cast<const SharedByteDataStream*>(&rhs));
+        if (shared != nullptr)
         {
-            m_len = rhs.getDataLength();
-            delete[] m_buf;
-            m_buf = new unsigned char[m_len];
+            return *this = shared->data();
         }
-        rhs.readData(m_buf, m_len);
+        assign(rhs.getDataLength());
+        rhs.readData(mutableBuffer(), m_len);
         return *this;
     }
     /*!
@@ -163,9 +394,41 @@ namespace RTC
      *
      * @endif
      */
-    unsigned char* ByteData::getBuffer() const
+    const unsigned char* ByteData::getBuffer() const
+    {
+        return m_block != nullptr ? m_block->data() : nullptr;
+    }
+    /*!
+     * @if jp
+     *
+     * @brief 書き込み可能なバッファのポインタを取得
+     *
+     * @return バッファのポインタ
+     *
+     * @else
+     *
+     * @brief Get the writable pointer of the buffer
+     *
+     * @return Pointer of the buffer
+     *
+     * @endif
+     */
+    unsigned char* ByteData::mutableBuffer()
     {
-        return m_buf;
+        if (m_block == nullptr)
+        {
+            return nullptr;
+        }
+        if (m_block->refcount.load(std::memory_order_acquire) > 1)
+        {
+            // keep the contents as the unshared buffer of the same length
+            Block* block(ByteDataPool::allocate(m_len));
+            memcpy(block->data(), m_block->data(), m_len);
+            ByteDataPool::s_stats.copied_bytes.fetch_add(m_len, std::memory_order_relaxed);
+            release();
+            m_block = block;
+        }
+        return m_block->data();
     }
     /*!
      * @if jp
@@ -217,7 +480,7 @@ namespace RTC
         {
             return;
         }
-        memcpy(data, m_buf, length);
+        memcpy(data, getBuffer(), length);
     }
 
     /*!
@@ -247,13 +510,9 @@ namespace RTC
             return;
         }
 
-        if(m_len != length)
-        {
-            delete[] m_buf;
-            m_len = length;
-            m_buf = new unsigned char[length];
-        }
-        memcpy(m_buf, data, length);
+        assign(length);
+        memcpy(m_block->data(), data, length);
+        ByteDataPool::s_stats.copied_bytes.fetch_add(length, std::memory_order_relaxed);
     }
     /*!
      * @if jp
@@ -295,14 +554,16 @@ namespace RTC
      */
     void ByteData::setDataLength(unsigned long length)
     {
-        if (length <= 0 || m_len == length)
+        if (length <= 0)
         {
             return;
         }
-        delete[] m_buf;
-
-        m_len = length;
-        m_buf = new unsigned char[m_len];
+        if (m_len == length)
+        {
+            mutableBuffer();
+            return;
+        }
+        assign(length);
     }
     /*!
      * @if jp
@@ -325,4 +586,111 @@ namespace RTC
     {
         return m_little_endian;
     }
+
+    /*!
+     * @if jp
+     *
+     * @brief メモリプールの有効/無効の設定
+     *
+     * @param enabled 有効(True)、無効(False)
+     *
+     * @else
+     *
+     * @brief Enable or disable the memory pool
+     *
+     * @param enabled Enabled(True), disabled(False)
+     *
+     * @endif
+     */
+    void ByteData::setPoolEnabled(bool enabled)
+    {
+        ByteDataPool::s_enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief メモリプールの統計情報の取得
+     *
+     * @return プロセス全体の統計情報
+     *
+     * @else
+     *
+     * @brief Get statistics of the memory pool
+     *
+     * @return Process-wide statistics
+     *
+     * @endif
+     */
+    ByteDataPoolStatistics ByteData::getPoolStatistics()
+    {
+        ByteDataPoolStatistics stats;
+        stats.heap_allocations =
+          ByteDataPool::s_stats.heap_allocations.load(std::memory_order_relaxed);
+        stats.pool_allocations =
+          ByteDataPool::s_stats.pool_allocations.load(std::memory_order_relaxed);
+        stats.shared_copies =
+          ByteDataPool::s_stats.shared_copies.load(std::memory_order_relaxed);
+        stats.copied_bytes =
+          ByteDataPool::s_stats.copied_bytes.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief 書き込み可能な length バイトのバッファを確保する
+     *
+     * 他の ByteData と共有しておらず容量が足りている場合は現在のバッファ
+     * をそのまま使用する。内容は保持されない場合がある。
+     *
+     * @param length データの長さ
+     *
+     * @else
+     *
+     * @brief Prepare a writable buffer of length bytes
+     *
+     * The current buffer is reused if it is not shared and large
+     * enough. The contents may not be kept.
+     *
+     * @param length Data length
+     *
+     * @endif
+     */
+    void ByteData::assign(unsigned long length)
+    {
+        if (m_block != nullptr && m_block->capacity >= length &&
+            m_block->refcount.load(std::memory_order_acquire) == 1)
+        {
+            m_len = length;
+            return;
+        }
+        release();
+        if (length > 0)
+        {
+            m_block = ByteDataPool::allocate(length);
+        }
+        m_len = length;
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief バッファの参照を解放する
+     *
+     * @else
+     *
+     * @brief Release the reference to the buffer
+     *
+     * @endif
+     */
+    void ByteData::release()
+    {
+        if (m_block != nullptr &&
+            m_block->refcount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            ByteDataPool::deallocate(m_block);
+        }
+        m_block = nullptr;
+    }
 } // namespace RTC
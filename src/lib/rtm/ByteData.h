@@ -1,17 +1,51 @@
 ﻿#ifndef RTC_BYTEDATA_H
 #define RTC_BYTEDATA_H
 
-
+#include <cstdint>
 
 namespace RTC
 {
     class ByteDataStreamBase;
+    /*!
+     * @if jp
+     * @brief ByteData のメモリプールの統計情報
+     *
+     * - heap_allocations: ヒープから確保したバッファの数
+     * - pool_allocations: プールから再利用したバッファの数
+     * - shared_copies:    バッファを共有してコピーを省略した回数
+     * - copied_bytes:     データのコピーに要したバイト数
+     *
+     * @since 2.1.0
+     *
+     * @else
+     * @brief Statistics of the memory pool of ByteData
+     *
+     * - heap_allocations: Number of buffers allocated from the heap
+     * - pool_allocations: Number of buffers reused from the pool
+     * - shared_copies:    Number of copies omitted by sharing the buffer
+     * - copied_bytes:     Number of bytes copied
+     *
+     * @since 2.1.0
+     *
+     * @endif
+     */
+    struct ByteDataPoolStatistics
+    {
+        uint64_t heap_allocations{0};
+        uint64_t pool_allocations{0};
+        uint64_t shared_copies{0};
+        uint64_t copied_bytes{0};
+    };
+
     /*!
      * @if jp
      * @class ByteData
      * @brief シリアライズ後のバイト列を操作するクラス
      * 
-     *
+     * バイト列はサイズクラスごとのメモリプールから確保され、参照カウン
+     * トにより複数の ByteData 間で共有される(コピーオンライト)。
+     * getBuffer() は読み出し専用のポインタを返す。書き込む場合は共有
+     * を解除する mutableBuffer() を用いる。
      *
      * @param
      *
@@ -21,6 +55,11 @@ namespace RTC
      * @class ByteData
      * @brief
      *
+     * The byte sequence is allocated from a size-class memory pool and
+     * shared among ByteData objects by reference counting
+     * (copy-on-write). getBuffer() returns a read-only pointer, and
+     * mutableBuffer(), which unshares the buffer, is used to write into
+     * it.
      *
      * @since 2.0.0
      *
@@ -77,6 +116,22 @@ namespace RTC
          * @endif
          */
         ByteData(const ByteData &rhs);
+        /*!
+         * @if jp
+         *
+         * @brief ムーブコンストラクタ
+         *
+         * @param rhs
+         *
+         * @else
+         *
+         * @brief Move Constructor
+         *
+         * @param rhs
+         *
+         * @endif
+         */
+        ByteData(ByteData &&rhs) noexcept;
         /*!
          * @if jp
          *
@@ -113,6 +168,24 @@ namespace RTC
          * @endif
          */
         ByteData& operator= (const ByteData &rhs);
+        /*!
+         * @if jp
+         *
+         * @brief ムーブ代入演算子
+         *
+         * @param rhs
+         * @return
+         *
+         * @else
+         *
+         * @brief Move assignment operator
+         *
+         * @param rhs
+         * @return
+         *
+         * @endif
+         */
+        ByteData& operator= (ByteData &&rhs) noexcept;
         /*!
          * @if jp
          *
@@ -190,7 +263,29 @@ namespace RTC
          *
          * @endif
          */
-        unsigned char* getBuffer() const;
+        const unsigned char* getBuffer() const;
+        /*!
+         * @if jp
+         *
+         * @brief 書き込み可能なバッファのポインタを取得
+         *
+         * バッファが他の ByteData と共有されている場合は、内容をコピー
+         * して共有を解除する。
+         *
+         * @return バッファのポインタ
+         *
+         * @else
+         *
+         * @brief Get the writable pointer of the buffer
+         *
+         * If the buffer is shared with other ByteData objects, its
+         * contents are copied to unshare it.
+         *
+         * @return Pointer of the buffer
+         *
+         * @endif
+         */
+        unsigned char* mutableBuffer();
         /*!
          * @if jp
          *
@@ -262,8 +357,52 @@ namespace RTC
          * @endif
          */
         bool getEndian();
+        /*!
+         * @if jp
+         *
+         * @brief メモリプールの有効/無効の設定
+         *
+         * 無効にした場合、バッファは共有されずコピーの度にヒープから確保
+         * される。性能比較のために使用する。デフォルトは有効。
+         *
+         * @param enabled 有効(True)、無効(False)
+         *
+         * @else
+         *
+         * @brief Enable or disable the memory pool
+         *
+         * If disabled, buffers are not shared and every copy allocates
+         * from the heap. This is intended for performance comparison.
+         * Enabled by default.
+         *
+         * @param enabled Enabled(True), disabled(False)
+         *
+         * @endif
+         */
+        static void setPoolEnabled(bool enabled);
+        /*!
+         * @if jp
+         *
+         * @brief メモリプールの統計情報の取得
+         *
+         * @return プロセス全体の統計情報
+         *
+         * @else
+         *
+         * @brief Get statistics of the memory pool
+         *
+         * @return Process-wide statistics
+         *
+         * @endif
+         */
+        static ByteDataPoolStatistics getPoolStatistics();
+
+        struct Block;
     private:
-        unsigned char* m_buf{nullptr};
+        void assign(unsigned long length);
+        void release();
+
+        Block* m_block{nullptr};
         unsigned long m_len{0};
         bool m_little_endian{true};
     };
@@ -271,4 +410,4 @@ namespace RTC
 } // namespace RTC
 
 
-#endif  // RTC_BYTEDATA_H
+#endif  // RTC_BYTEDATA_H
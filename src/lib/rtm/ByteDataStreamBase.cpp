@@ -57,14 +57,14 @@ namespace RTC
 
     /*!
      * @if jp
-     * @brief 初期化関数(未使用)
+     * @brief 初期化関数
      *
      * @param prop プロパティ(コネクタプロファイルから取得)
      *
      * @else
-     * @brief
+     * @brief Initialize
      *
-     * @param prop
+     * @param prop Properties (taken from the connector profile)
      *
      * @endif
      */
@@ -73,6 +73,18 @@ namespace RTC
 
     }
 
+    /*!
+     * @if jp
+     * @brief コネクタの転送統計の設定
+     * @else
+     * @brief Set the transfer statistics of the connector
+     * @endif
+     */
+    void ByteDataStreamBase::setStatistics(ConnectorStatistics* /*statistics*/)
+    {
+
+    }
+
 
     /*!
      * @if jp
@@ -92,5 +104,22 @@ namespace RTC
 
     }
 
+    void SharedByteDataStream::writeData(const unsigned char* buffer,
+                                         unsigned long length)
+    {
+        m_data.writeData(buffer, length);
+    }
+
+    void SharedByteDataStream::readData(unsigned char* buffer,
+                                        unsigned long length) const
+    {
+        m_data.readData(buffer, length);
+    }
+
+    unsigned long SharedByteDataStream::getDataLength() const
+    {
+        return m_data.getDataLength();
+    }
+
 
 } // namespace RTC
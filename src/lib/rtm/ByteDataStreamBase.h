@@ -23,6 +23,7 @@
 #include <coil/Properties.h>
 #include <coil/Factory.h>
 #include <rtm/Typename.h>
+#include <rtm/ByteData.h>
 
 /*!
  * @if jp
@@ -40,6 +41,8 @@
  */
 namespace RTC
 {
+  struct ConnectorStatistics;
+
 /*!
    * @if jp
    * @class ByteDataStreamBase
@@ -97,18 +100,42 @@ namespace RTC
 
      /*!
       * @if jp
-      * @brief 初期化関数(未使用)
+      * @brief 初期化関数
+      *
+      * コネクタがシリアライザを生成した際に呼び出す。
       *
       * @param prop プロパティ(コネクタプロファイルから取得)
       *
       * @else
-      * @brief
+      * @brief Initialize
+      *
+      * Called when the connector creates the serializer.
       *
-      * @param prop
+      * @param prop Properties (taken from the connector profile)
       *
       * @endif
       */
      virtual void init(const coil::Properties &prop);
+     /*!
+      * @if jp
+      * @brief コネクタの転送統計の設定
+      *
+      * コネクタがシリアライザを生成した際に呼び出す。圧縮などの統計を記
+      * 録するシリアライザがオーバーライドする。
+      *
+      * @param statistics コネクタの転送統計
+      *
+      * @else
+      * @brief Set the transfer statistics of the connector
+      *
+      * Called when the connector creates the serializer. Overridden by
+      * the serializers recording statistics such as the compression.
+      *
+      * @param statistics Transfer statistics of the connector
+      *
+      * @endif
+      */
+     virtual void setStatistics(ConnectorStatistics* statistics);
      /*!
       * @if jp
       * @brief 保持しているバッファにデータを書き込む
@@ -173,6 +200,37 @@ namespace RTC
      virtual void isLittleEndian(bool little_endian);
   };
 
+  /*!
+   * @if jp
+   * @class SharedByteDataStream
+   * @brief ByteData を内容とするストリーム
+   *
+   * シリアライズ済みのデータを ByteData のまま受け渡すためのストリー
+   * ム。ByteData へのコピーや代入はバイト列をコピーせず、参照カウント
+   * により共有する。
+   *
+   * @else
+   * @class SharedByteDataStream
+   * @brief Stream whose contents are a ByteData
+   *
+   * The stream to pass serialized data as a ByteData. Copying or
+   * assigning it to a ByteData does not copy the bytes, but shares them
+   * by reference counting.
+   *
+   * @endif
+   */
+  class SharedByteDataStream : public ByteDataStreamBase
+  {
+  public:
+    void writeData(const unsigned char* buffer, unsigned long length) override;
+    void readData(unsigned char* buffer, unsigned long length) const override;
+    unsigned long getDataLength() const override;
+    ByteData& data() { return m_data; }
+    const ByteData& data() const { return m_data; }
+  private:
+    ByteData m_data;
+  };
+
   /*!
    * @if jp
    * @class ByteDataStream
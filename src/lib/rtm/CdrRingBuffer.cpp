@@ -31,5 +31,9 @@ extern "C"
       addFactory("ring_buffer",
                  coil::Creator<RTC::CdrBufferBase, RTC::CdrRingBuffer>,
                  coil::Destructor<RTC::CdrBufferBase, RTC::CdrRingBuffer>);
+    RTC::CdrBufferFactory::instance().
+      addFactory("spsc_ring_buffer",
+                 coil::Creator<RTC::CdrBufferBase, RTC::CdrSpscRingBuffer>,
+                 coil::Destructor<RTC::CdrBufferBase, RTC::CdrSpscRingBuffer>);
   }
 }
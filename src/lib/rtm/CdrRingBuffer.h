@@ -21,12 +21,14 @@
 #define RTC_CDRRINGBUFFER_H
 
 #include <rtm/RingBuffer.h>
+#include <rtm/SpscRingBuffer.h>
 #include <rtm/CdrBufferBase.h>
 #include <rtm/ByteData.h>
 
 namespace RTC
 {
   using CdrRingBuffer = RingBuffer<ByteData>;
+  using CdrSpscRingBuffer = SpscRingBuffer<ByteData>;
 } // namespace RTC
 
 extern "C"
@@ -0,0 +1,212 @@
+// -*- C++ -*-
+/*!
+ * @file CdrViewReader.h
+ * @brief CDR reader referring to the serialized buffer
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_CDRVIEWREADER_H
+#define RTC_CDRVIEWREADER_H
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class CdrViewReader
+   * @brief シリアライズ済みバッファを参照する CDR リーダ
+   *
+   * CDR でシリアライズされたデータを先頭から順に読み出す。アライメント
+   * はバッファの先頭を基準とする。文字列とシーケンスはコピーせず、バッ
+   * ファ内の位置を返す。データ型ごとの CORBA_Util::deserializeView() が
+   * 用いる。
+   *
+   * @else
+   * @class CdrViewReader
+   * @brief CDR reader referring to the serialized buffer
+   *
+   * Reads the data serialized in CDR from the beginning. The alignment
+   * is relative to the beginning of the buffer. Strings and sequences
+   * are not copied, and their positions in the buffer are returned. Used
+   * by CORBA_Util::deserializeView() of each data type.
+   *
+   * @endif
+   */
+  class CdrViewReader
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     *
+     * @param buffer シリアライズ済みのデータ
+     * @param length データの長さ
+     * @param little_endian データのエンディアン
+     *
+     * @else
+     * @brief Constructor
+     *
+     * @param buffer Serialized data
+     * @param length Length of the data
+     * @param little_endian Endian of the data
+     *
+     * @endif
+     */
+    CdrViewReader(const unsigned char* buffer, unsigned long length,
+                  bool little_endian)
+      : m_buffer(buffer), m_length(length),
+        m_swap(little_endian != hostIsLittleEndian())
+    {
+    }
+
+    /*!
+     * @if jp
+     * @brief 基本型の値を読み出す
+     * @return false: データが足りない
+     * @else
+     * @brief Read a value of a primitive type
+     * @return false: the data is too short
+     * @endif
+     */
+    template <class T>
+    bool read(T& value)
+    {
+      static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value,
+                    "CdrViewReader::read() requires a primitive type");
+      if (!align(sizeof(T))) { return false; }
+      unsigned char bytes[sizeof(T)];
+      for (size_t i(0); i < sizeof(T); ++i)
+        {
+          bytes[i] = m_buffer[m_pos + (m_swap ? sizeof(T) - 1 - i : i)];
+        }
+      memcpy(&value, bytes, sizeof(T));
+      m_pos += sizeof(T);
+      return true;
+    }
+
+    /*!
+     * @if jp
+     * @brief 文字列を読み出す
+     *
+     * @param str バッファ内の NUL 終端文字列
+     * @return false: データが足りない、または NUL 終端でない
+     *
+     * @else
+     * @brief Read a string
+     *
+     * @param str NUL terminated string in the buffer
+     * @return false: the data is too short or not NUL terminated
+     *
+     * @endif
+     */
+    bool readString(const char*& str)
+    {
+      // The length includes the terminating NUL.
+      uint32_t length(0);
+      if (!read(length) || length == 0 || m_length - m_pos < length)
+        {
+          return false;
+        }
+      if (m_buffer[m_pos + length - 1] != '\0') { return false; }
+      str = reinterpret_cast<const char*>(m_buffer + m_pos);
+      m_pos += length;
+      return true;
+    }
+
+    /*!
+     * @if jp
+     * @brief シーケンスを読み出す
+     *
+     * 要素はバッファ内を指す。要素が2バイト以上の場合は、データのエン
+     * ディアンがホストと同じでなければならない。
+     *
+     * @param data バッファ内の先頭の要素
+     * @param length 要素数
+     * @return false: データが足りない、またはエンディアンが異なる
+     *
+     * @else
+     * @brief Read a sequence
+     *
+     * The elements point into the buffer. If an element has two bytes or
+     * more, the endian of the data must be the same as the host.
+     *
+     * @param data First element in the buffer
+     * @param length Number of the elements
+     * @return false: the data is too short or the endian differs
+     *
+     * @endif
+     */
+    template <class T>
+    bool readSequence(const T*& data, uint32_t& length)
+    {
+      static_assert(std::is_arithmetic<T>::value,
+                    "CdrViewReader::readSequence() requires a primitive type");
+      if (sizeof(T) > 1 && m_swap) { return false; }
+      if (!read(length)) { return false; }
+      if (length == 0)
+        {
+          data = nullptr;
+          return true;
+        }
+      if (!align(sizeof(T)) || (m_length - m_pos) / sizeof(T) < length)
+        {
+          return false;
+        }
+      data = reinterpret_cast<const T*>(m_buffer + m_pos);
+      m_pos += length * sizeof(T);
+      return true;
+    }
+
+    /*!
+     * @if jp
+     * @brief データのエンディアンがホストと同じか
+     * @else
+     * @brief Whether the endian of the data is the same as the host
+     * @endif
+     */
+    bool isHostEndian() const { return !m_swap; }
+
+    /*!
+     * @if jp
+     * @brief 残りのデータの長さ
+     * @else
+     * @brief Length of the remaining data
+     * @endif
+     */
+    unsigned long remaining() const { return m_length - m_pos; }
+
+  private:
+    static bool hostIsLittleEndian()
+    {
+      const uint16_t one(1);
+      return *reinterpret_cast<const unsigned char*>(&one) == 1;
+    }
+
+    bool align(unsigned long size)
+    {
+      unsigned long pos((m_pos + size - 1) / size * size);
+      if (pos > m_length || m_length - pos < size) { return false; }
+      m_pos = pos;
+      return true;
+    }
+
+    const unsigned char* m_buffer;
+    unsigned long m_length;
+    unsigned long m_pos{0};
+    bool m_swap;
+  };
+} // namespace RTC
+
+#endif  // RTC_CDRVIEWREADER_H
@@ -0,0 +1,128 @@
+// -*- C++ -*-
+/*!
+ * @file CompressionCodec.h
+ * @brief Compression codec interface of the compression serializer
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_COMPRESSIONCODEC_H
+#define RTC_COMPRESSIONCODEC_H
+
+#include <coil/Properties.h>
+#include <coil/Factory.h>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class CompressionCodec
+   * @brief 圧縮コーデックのインターフェース
+   *
+   * CompressionSerializer が用いる圧縮アルゴリズム。
+   * CompressionCodecFactory に登録した名前が、マーシャリング方式
+   * "<コーデック名>:<シリアライザ名>" の前半となる。
+   *
+   * @else
+   * @class CompressionCodec
+   * @brief Interface of the compression codecs
+   *
+   * Compression algorithm used by CompressionSerializer. The name
+   * registered to CompressionCodecFactory is the first half of the
+   * marshaling type "<codec name>:<serializer name>".
+   *
+   * @endif
+   */
+  class CompressionCodec
+  {
+  public:
+    virtual ~CompressionCodec();
+
+    /*!
+     * @if jp
+     * @brief 初期化
+     * @param prop コネクタプロファイルの serializer.<コーデック名> 以下
+     * @else
+     * @brief Initialize
+     * @param prop serializer.<codec name> of the connector profile
+     * @endif
+     */
+    virtual void init(const coil::Properties& prop);
+
+    /*!
+     * @if jp
+     * @brief 圧縮後のデータの最大長
+     * @else
+     * @brief Maximum length of the compressed data
+     * @endif
+     */
+    virtual unsigned long compressBound(unsigned long length) = 0;
+
+    /*!
+     * @if jp
+     * @brief 圧縮する
+     *
+     * @param src 圧縮するデータ
+     * @param srclen src の長さ
+     * @param dst 圧縮したデータを格納する領域
+     * @param dstlen dst の長さ。圧縮したデータの長さが格納される
+     * @return false: 圧縮に失敗
+     *
+     * @else
+     * @brief Compress
+     *
+     * @param src Data to be compressed
+     * @param srclen Length of src
+     * @param dst Area to store the compressed data
+     * @param dstlen Length of dst. The length of the compressed data is
+     *               stored
+     * @return false: failed to compress
+     *
+     * @endif
+     */
+    virtual bool compress(const unsigned char* src, unsigned long srclen,
+                          unsigned char* dst, unsigned long& dstlen) = 0;
+
+    /*!
+     * @if jp
+     * @brief 展開する
+     *
+     * @param src 圧縮したデータ
+     * @param srclen src の長さ
+     * @param dst 展開したデータを格納する領域
+     * @param dstlen 展開後のデータの長さ
+     * @return false: 展開に失敗、または長さが一致しない
+     *
+     * @else
+     * @brief Decompress
+     *
+     * @param src Compressed data
+     * @param srclen Length of src
+     * @param dst Area to store the decompressed data
+     * @param dstlen Length of the decompressed data
+     * @return false: failed to decompress or the length does not match
+     *
+     * @endif
+     */
+    virtual bool decompress(const unsigned char* src, unsigned long srclen,
+                            unsigned char* dst, unsigned long dstlen) = 0;
+  };
+
+  using CompressionCodecFactory = ::coil::GlobalFactory<CompressionCodec>;
+} // namespace RTC
+
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+EXTERN template class DLL_PLUGIN coil::GlobalFactory<RTC::CompressionCodec>;
+#elif defined(__GNUC__)
+EXTERN template class coil::GlobalFactory<RTC::CompressionCodec>;
+#endif
+
+#endif  // RTC_COMPRESSIONCODEC_H
@@ -0,0 +1,181 @@
+// -*- C++ -*-
+/*!
+ * @file CompressionSerializer.cpp
+ * @brief Serializer compressing the output of another serializer
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <rtm/CompressionSerializer.h>
+#include <rtm/ConnectorBase.h>
+
+#include <chrono>
+#include <cstring>
+
+namespace
+{
+  // flag (1 byte), reserved (3 bytes), length before the compression
+  // (little endian uint32)
+  const unsigned long HEADER_SIZE = 8;
+  const unsigned char STORED = 0;
+  const unsigned char COMPRESSED = 1;
+
+  void putHeader(unsigned char* p, unsigned char flag, unsigned long length)
+  {
+    p[0] = flag;
+    p[1] = p[2] = p[3] = 0;
+    for (size_t i(0); i < 4; ++i)
+      {
+        p[4 + i] = static_cast<unsigned char>(length >> (8 * i));
+      }
+  }
+
+  unsigned long getLength(const unsigned char* p)
+  {
+    unsigned long length(0);
+    for (size_t i(0); i < 4; ++i)
+      {
+        length |= static_cast<unsigned long>(p[4 + i]) << (8 * i);
+      }
+    return length;
+  }
+} // namespace
+
+namespace RTC
+{
+  CompressionCodec::~CompressionCodec() = default;
+
+  void CompressionCodec::init(const coil::Properties& /*prop*/)
+  {
+  }
+
+  CompressionStage::~CompressionStage()
+  {
+    if (m_codec != nullptr)
+      {
+        CompressionCodecFactory::instance().deleteObject(m_codec);
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 初期化
+   * @else
+   * @brief Initialize
+   * @endif
+   */
+  bool CompressionStage::init(const std::string& codec,
+                              const coil::Properties& prop)
+  {
+    if (m_codec == nullptr)
+      {
+        m_codec = CompressionCodecFactory::instance().createObject(codec);
+      }
+    if (m_codec == nullptr) { return false; }
+    m_codec->init(prop);
+    std::string min_size(prop.getProperty("min_size"));
+    if (!min_size.empty() && !coil::stringTo(m_minSize, min_size.c_str()))
+      {
+        m_minSize = 1024;
+      }
+    std::string max_size(prop.getProperty("max_size"));
+    if (!max_size.empty() &&
+        (!coil::stringTo(m_maxSize, max_size.c_str()) ||
+         m_maxSize > 0xffffffffUL))
+      {
+        m_maxSize = 256UL * 1024 * 1024;
+      }
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief 内側のシリアライザの出力を圧縮する
+   * @else
+   * @brief Compress the output of the inner serializer
+   * @endif
+   */
+  bool CompressionStage::compress(const ByteDataStreamBase& inner)
+  {
+    if (m_codec == nullptr) { return false; }
+    unsigned long length(inner.getDataLength());
+    if (length > m_maxSize) { return false; }
+
+    if (length >= m_minSize)
+      {
+        auto start = std::chrono::steady_clock::now();
+        m_raw.resize(length);
+        inner.readData(m_raw.data(), length);
+        unsigned long coded(m_codec->compressBound(length));
+        m_data.setDataLength(HEADER_SIZE + coded);
+        if (m_codec->compress(m_raw.data(), length,
+                              m_data.mutableBuffer() + HEADER_SIZE, coded) &&
+            coded < length)
+          {
+            putHeader(m_data.mutableBuffer(), COMPRESSED, length);
+            m_data.setDataLength(HEADER_SIZE + coded);
+            if (m_statistics != nullptr)
+              {
+                m_statistics->countCodec(length, coded,
+                                         std::chrono::steady_clock::now() - start);
+              }
+            return true;
+          }
+      }
+
+    m_data.setDataLength(HEADER_SIZE + length);
+    putHeader(m_data.mutableBuffer(), STORED, length);
+    if (length > 0)
+      {
+        inner.readData(m_data.mutableBuffer() + HEADER_SIZE, length);
+      }
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief 展開して内側のシリアライザに書き込む
+   * @else
+   * @brief Decompress into the inner serializer
+   * @endif
+   */
+  bool CompressionStage::decompress(ByteDataStreamBase& inner)
+  {
+    unsigned long total(m_data.getDataLength());
+    if (m_codec == nullptr || total < HEADER_SIZE) { return false; }
+    const unsigned char* p(m_data.getBuffer());
+    unsigned long length(getLength(p));
+    if (length > m_maxSize) { return false; }
+
+    if (p[0] == STORED)
+      {
+        if (total - HEADER_SIZE != length) { return false; }
+        inner.writeData(p + HEADER_SIZE, length);
+        return true;
+      }
+    if (p[0] != COMPRESSED) { return false; }
+
+    auto start = std::chrono::steady_clock::now();
+    m_raw.resize(length);
+    if (!m_codec->decompress(p + HEADER_SIZE, total - HEADER_SIZE,
+                             m_raw.data(), length))
+      {
+        return false;
+      }
+    inner.writeData(m_raw.data(), length);
+    if (m_statistics != nullptr)
+      {
+        m_statistics->countCodec(length, total - HEADER_SIZE,
+                                 std::chrono::steady_clock::now() - start);
+      }
+    return true;
+  }
+} // namespace RTC
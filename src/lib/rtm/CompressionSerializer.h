@@ -0,0 +1,282 @@
+// -*- C++ -*-
+/*!
+ * @file CompressionSerializer.h
+ * @brief Serializer compressing the output of another serializer
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_COMPRESSIONSERIALIZER_H
+#define RTC_COMPRESSIONSERIALIZER_H
+
+#include <rtm/ByteData.h>
+#include <rtm/ByteDataStreamBase.h>
+#include <rtm/CompressionCodec.h>
+#include <coil/stringutil.h>
+
+#include <string>
+#include <vector>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class CompressionStage
+   * @brief 圧縮シリアライザのデータ型に依存しない部分
+   *
+   * 内側のシリアライザの出力を圧縮し、8バイトのヘッダ (圧縮の有無、圧縮
+   * 前の長さ) を付加する。serializer.<コーデック名>.min_size (デフォル
+   * ト 1024) バイト未満のデータと、圧縮しても小さくならないデータは圧縮
+   * せずに送る。圧縮前の長さが serializer.<コーデック名>.max_size (デ
+   * フォルト 256 MiB) を超えるデータは送受信しない。受信側はヘッダの
+   * 長さでメモリを確保する前にこの上限を確認する。
+   *
+   * @else
+   * @class CompressionStage
+   * @brief Data type independent part of the compression serializer
+   *
+   * Compresses the output of the inner serializer and prepends a header
+   * of 8 bytes (whether compressed and the length before the
+   * compression). Data shorter than serializer.<codec name>.min_size
+   * (1024 by default) bytes and data not getting smaller are sent
+   * uncompressed. Data longer than serializer.<codec name>.max_size
+   * (256 MiB by default) before the compression are neither sent nor
+   * received. The receiver checks this limit before it allocates
+   * memory for the length in the header.
+   *
+   * @endif
+   */
+  class CompressionStage
+  {
+  public:
+    CompressionStage() = default;
+    ~CompressionStage();
+    CompressionStage(const CompressionStage&) = delete;
+    CompressionStage& operator=(const CompressionStage&) = delete;
+
+    /*!
+     * @if jp
+     * @brief 初期化
+     * @param codec コーデック名
+     * @param prop コネクタプロファイルの serializer.<コーデック名> 以下
+     * @return false: コーデックがない
+     * @else
+     * @brief Initialize
+     * @param codec Codec name
+     * @param prop serializer.<codec name> of the connector profile
+     * @return false: no such codec
+     * @endif
+     */
+    bool init(const std::string& codec, const coil::Properties& prop);
+
+    void setStatistics(ConnectorStatistics* statistics)
+    {
+      m_statistics = statistics;
+    }
+
+    /*!
+     * @if jp
+     * @brief 内側のシリアライザの出力を圧縮する
+     * @else
+     * @brief Compress the output of the inner serializer
+     * @endif
+     */
+    bool compress(const ByteDataStreamBase& inner);
+
+    /*!
+     * @if jp
+     * @brief 展開して内側のシリアライザに書き込む
+     * @else
+     * @brief Decompress into the inner serializer
+     * @endif
+     */
+    bool decompress(ByteDataStreamBase& inner);
+
+    ByteData& data() { return m_data; }
+    const ByteData& data() const { return m_data; }
+
+  private:
+    CompressionCodec* m_codec{nullptr};
+    unsigned long m_minSize{1024};
+    unsigned long m_maxSize{256UL * 1024 * 1024};
+    ByteData m_data;
+    std::vector<unsigned char> m_raw;
+    ConnectorStatistics* m_statistics{nullptr};
+  };
+
+  /*!
+   * @if jp
+   * @class CompressionSerializer
+   * @brief 他のシリアライザの出力を圧縮するシリアライザ
+   *
+   * マーシャリング方式 "<コーデック名>:<シリアライザ名>" (zlib:cdr など)
+   * として登録され、生成時の名称からコーデックと内側のシリアライザを決
+   * める。init() で内側のシリアライザを生成するため、コネクタが init()
+   * を呼び出す必要がある。
+   *
+   * @else
+   * @class CompressionSerializer
+   * @brief Serializer compressing the output of another serializer
+   *
+   * Registered as the marshaling types "<codec name>:<serializer name>"
+   * (zlib:cdr and so on), and the codec and the inner serializer are
+   * taken from the name it was created for. The inner serializer is
+   * created in init(), so the connector must call init().
+   *
+   * @endif
+   */
+  template <class DataType>
+  class CompressionSerializer : public ByteDataStream<DataType>
+  {
+  public:
+    CompressionSerializer() = default;
+
+    ~CompressionSerializer() override
+    {
+      if (m_inner != nullptr)
+        {
+          ByteDataStreamBase* inner(m_inner);
+          m_destructor(inner);
+        }
+    }
+
+    void init(const coil::Properties& prop) override
+    {
+      std::string type(marshalingType(prop));
+      std::string::size_type pos(type.find(':'));
+      if (pos == std::string::npos || m_inner != nullptr) { return; }
+
+      std::string codec(type.substr(0, pos));
+      coil::Properties* node(prop.findNode("serializer." + codec));
+      if (!m_stage.init(codec, node != nullptr ? *node : coil::Properties()))
+        {
+          return;
+        }
+      // This object is deleted while SerializerFactory is locked, so the
+      // inner serializer is created by the creator directly and is not
+      // tracked by the factory.
+      SerializerFactory& factory(SerializerFactory::instance());
+      ByteDataStreamBase* inner(createSerializer<DataType>(type.substr(pos + 1)));
+      if (inner == nullptr) { return; }
+      Creator creator(factory.objectToCreator(inner));
+      m_destructor = factory.objectToDestructor(inner);
+      factory.deleteObject(inner);
+
+      inner = creator();
+      m_inner = dynamic_cast<ByteDataStream<DataType>*>(inner);
+      if (m_inner == nullptr)
+        {
+          m_destructor(inner);
+          return;
+        }
+      m_inner->init(prop);
+    }
+
+    void setStatistics(ConnectorStatistics* statistics) override
+    {
+      m_stage.setStatistics(statistics);
+    }
+
+    void writeData(const unsigned char* buffer, unsigned long length) override
+    {
+      m_stage.data().writeData(buffer, length);
+    }
+
+    void readData(unsigned char* buffer, unsigned long length) const override
+    {
+      m_stage.data().readData(buffer, length);
+    }
+
+    unsigned long getDataLength() const override
+    {
+      return m_stage.data().getDataLength();
+    }
+
+    bool serialize(const DataType& data) override
+    {
+      return m_inner != nullptr && m_inner->serialize(data) &&
+        m_stage.compress(*m_inner);
+    }
+
+    bool deserialize(DataType& data) override
+    {
+      return m_inner != nullptr && m_stage.decompress(*m_inner) &&
+        m_inner->deserialize(data);
+    }
+
+    void isLittleEndian(bool little_endian) override
+    {
+      if (m_inner != nullptr) { m_inner->isLittleEndian(little_endian); }
+    }
+
+  private:
+    using Creator = ByteDataStreamBase* (*)();
+    using Destructor = void (*)(ByteDataStreamBase*&);
+
+    // The marshaling type this object was created for. It is taken from
+    // the factory, because inport.marshaling_type and
+    // outport.marshaling_type may differ from marshaling_type.
+    std::string marshalingType(const coil::Properties& prop)
+    {
+      std::string id;
+      ByteDataStreamBase* self(this);
+      if (SerializerFactory::instance().objectToIdentifier(self, id)
+          == coil::FactoryReturn::OK)
+        {
+          std::string prefix(addDataTypeToMarshalingType<DataType>(""));
+          if (id.compare(0, prefix.size(), prefix) == 0)
+            {
+              return id.substr(prefix.size());
+            }
+        }
+      return coil::eraseBothEndsBlank(prop.getProperty("marshaling_type"));
+    }
+
+    ByteDataStream<DataType>* m_inner{nullptr};
+    Destructor m_destructor{nullptr};
+    CompressionStage m_stage;
+  };
+
+  /*!
+   * @if jp
+   * @brief 圧縮シリアライザの登録
+   *
+   * 登録済みの各コーデックと、データ型に登録済みの各シリアライザの組
+   * み合わせを "<コーデック名>:<シリアライザ名>" として登録する。これ
+   * より後に登録されたシリアライザは対象とならない。
+   *
+   * @else
+   * @brief Register the compression serializers
+   *
+   * Registers each combination of the registered codecs and the
+   * serializers registered for the data type as "<codec
+   * name>:<serializer name>". The serializers registered after this
+   * are not included.
+   *
+   * @endif
+   */
+  template <class DataType>
+  void CompressionSerializerInit()
+  {
+    CompressionCodecFactory& codecs(CompressionCodecFactory::instance());
+    std::vector<std::string> inners(getSerializerList<DataType>());
+    for (auto& codec : codecs.getIdentifiers())
+      {
+        for (auto& inner : inners)
+          {
+            if (codecs.hasFactory(inner.substr(0, inner.find(':')))) { continue; }
+            addSerializer<DataType, CompressionSerializer<DataType>>(codec + ":" + inner);
+          }
+      }
+  }
+} // namespace RTC
+
+#endif  // RTC_COMPRESSIONSERIALIZER_H
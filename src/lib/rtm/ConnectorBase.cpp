@@ -21,6 +21,69 @@
 
 namespace RTC
 {
+  /*!
+   * @if jp
+   * @brief プロパティから設定を解析するコンストラクタ
+   * @else
+   * @brief Constructor parsing the settings from the properties
+   * @endif
+   */
+  ConnectorSettings::ConnectorSettings(const coil::Properties& prop)
+  {
+    coil::vstring endian{coil::split(coil::normalize(
+      prop.getProperty("serializer.cdr.endian", "little")), ",")};
+    little_endian = endian.empty() || endian[0] != "big";
+
+    std::string type{prop.getProperty("marshaling_type", "cdr")};
+    inport_marshaling_type = coil::eraseBothEndsBlank(
+      prop.getProperty("inport.marshaling_type", type));
+    outport_marshaling_type = coil::eraseBothEndsBlank(
+      prop.getProperty("outport.marshaling_type", type));
+
+    timestamp_policy = prop.getProperty("timestamp_policy");
+    latency_trace = coil::toBool(prop.getProperty("latency_trace"),
+                                 "YES", "NO", false);
+  }
+
+  /*!
+   * @if jp
+   * @brief 統計値をプロパティに設定する
+   * @else
+   * @brief Set the statistics to the properties
+   * @endif
+   */
+  void ConnectorStatistics::getProperties(coil::Properties& prop) const
+  {
+    const std::pair<const char*, const std::atomic<uint64_t>*> counters[] =
+      {
+        {"sent_samples", &sent_samples},
+        {"sent_bytes", &sent_bytes},
+        {"received_samples", &received_samples},
+        {"received_bytes", &received_bytes},
+        {"buffer_high_water", &buffer_high_water},
+        {"overwrite", &overwrite},
+        {"drop", &drop},
+        {"send_timeout", &send_timeout},
+        {"connection_lost", &connection_lost},
+        {"codec_raw_bytes", &codec_raw_bytes},
+        {"codec_coded_bytes", &codec_coded_bytes},
+        {"codec_time", &codec_time},
+        {"lost", &lost},
+        {"reordered", &reordered}
+      };
+    for (auto& counter : counters)
+      {
+        prop.setProperty(counter.first,
+                         coil::otos(counter.second->load(std::memory_order_relaxed)));
+      }
+    uint64_t coded(codec_coded_bytes.load(std::memory_order_relaxed));
+    if (coded > 0)
+      {
+        double raw(static_cast<double>(codec_raw_bytes.load(std::memory_order_relaxed)));
+        prop.setProperty("compression_ratio", coil::otos(raw / coded));
+      }
+  }
+
   /*!
    * @if jp
    *
@@ -40,6 +103,7 @@ namespace RTC
                 coil::vstring ports_, const coil::Properties& properties_)
     : name(name_), id(id_)
     , ports(std::move(ports_)), properties(properties_)
+    , m_settings(properties_)
   {
   }
   /*!
@@ -28,12 +28,241 @@
 #include <rtm/DataPortStatus.h>
 #include <rtm/SystemLogger.h>
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
 namespace RTC
 {
+  /*!
+   * @if jp
+   * @class ConnectorSettings
+   * @brief データ送受信ごとに参照するコネクタ設定
+   *
+   * コネクタ生成時にプロパティから一度だけ解析する。データの送受信ご
+   * とに coil::Properties を検索しないために用いる。
+   *
+   * @else
+   * @class ConnectorSettings
+   * @brief Connector settings referred to for each data transfer
+   *
+   * Parsed only once from the properties when the connector is
+   * created, so that coil::Properties is not looked up for every
+   * sample.
+   *
+   * @endif
+   */
+  struct ConnectorSettings
+  {
+    ConnectorSettings() = default;
+    /*!
+     * @if jp
+     * @brief プロパティから設定を解析するコンストラクタ
+     * @param prop コネクタのプロパティ
+     * @else
+     * @brief Constructor parsing the settings from the properties
+     * @param prop Connector properties
+     * @endif
+     */
+    explicit ConnectorSettings(const coil::Properties& prop);
+
+    /*! serializer.cdr.endian (true: little, false: big) */
+    bool little_endian{true};
+    /*! inport.marshaling_type, or marshaling_type */
+    std::string inport_marshaling_type{"cdr"};
+    /*! outport.marshaling_type, or marshaling_type */
+    std::string outport_marshaling_type{"cdr"};
+    /*! timestamp_policy */
+    std::string timestamp_policy;
+    /*! latency_trace */
+    bool latency_trace{false};
+  };
+
+  /*!
+   * @if jp
+   * @class ConnectorStatistics
+   * @brief コネクタの送受信の統計
+   *
+   * データの送受信のたびに relaxed な atomic 操作のみで更新し、ロック
+   * は取らない。送信側 (OutPort のコネクタ、Publisher、Consumer) と受
+   * 信側 (InPort のコネクタ、Provider) はそれぞれ ConnectorInfo のコピー
+   * を通じて同一のオブジェクトを共有する。
+   *
+   * - sent_samples, sent_bytes: 送信に成功したサンプル数とバイト数
+   * - received_samples, received_bytes: 受信したサンプル数とバイト数
+   * - buffer_high_water: バッファに溜まったサンプル数の最大値
+   * - overwrite: フルのバッファへの書き込みで上書きした回数
+   * - drop: バッファがフルまたはタイムアウトで書き込めなかった回数と、
+   *   受信側が長すぎるとして捨てたサンプル数
+   * - send_timeout: 送信がタイムアウトした回数
+   * - connection_lost: 接続の切断を検知した回数
+   * - codec_raw_bytes, codec_coded_bytes: 圧縮シリアライザが圧縮または
+   *   展開した、圧縮前と圧縮後のバイト数
+   * - codec_time: 圧縮と展開に要した時間 (ナノ秒)
+   * - lost: 通番の欠落から失われたと判断したサンプル数
+   * - reordered: 順序が入れ替わって到着したサンプル数
+   *
+   * @else
+   * @class ConnectorStatistics
+   * @brief Transfer statistics of a connector
+   *
+   * Updated only by relaxed atomic operations for each transfer,
+   * without any lock. The sender side (the OutPort connector, the
+   * publisher and the consumer) and the receiver side (the InPort
+   * connector and the provider) each share one object through the
+   * copies of ConnectorInfo.
+   *
+   * - sent_samples, sent_bytes: samples and bytes sent successfully
+   * - received_samples, received_bytes: samples and bytes received
+   * - buffer_high_water: maximum number of samples in the buffer
+   * - overwrite: writes into the full buffer overwriting a sample
+   * - drop: writes failed because the buffer was full or timed out,
+   *   and samples dropped by the receiver as too long
+   * - send_timeout: sends timed out
+   * - connection_lost: detections of the lost connection
+   * - codec_raw_bytes, codec_coded_bytes: bytes before and after the
+   *   compression, compressed or decompressed by a compression
+   *   serializer
+   * - codec_time: time spent compressing and decompressing
+   *   (nanoseconds)
+   * - lost: samples judged lost from the gaps of the sequence numbers
+   * - reordered: samples arrived out of order
+   *
+   * @endif
+   */
+  struct ConnectorStatistics
+  {
+    std::atomic<uint64_t> sent_samples{0};
+    std::atomic<uint64_t> sent_bytes{0};
+    std::atomic<uint64_t> received_samples{0};
+    std::atomic<uint64_t> received_bytes{0};
+    std::atomic<uint64_t> buffer_high_water{0};
+    std::atomic<uint64_t> overwrite{0};
+    std::atomic<uint64_t> drop{0};
+    std::atomic<uint64_t> send_timeout{0};
+    std::atomic<uint64_t> connection_lost{0};
+    std::atomic<uint64_t> codec_raw_bytes{0};
+    std::atomic<uint64_t> codec_coded_bytes{0};
+    std::atomic<uint64_t> codec_time{0};
+    std::atomic<uint64_t> lost{0};
+    std::atomic<uint64_t> reordered{0};
+
+    static void increment(std::atomic<uint64_t>& counter,
+                          uint64_t value = 1)
+    {
+      counter.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    void countSent(unsigned long length)
+    {
+      increment(sent_samples);
+      increment(sent_bytes, length);
+    }
+
+    void countReceived(unsigned long length)
+    {
+      increment(received_samples);
+      increment(received_bytes, length);
+    }
+
+    /*!
+     * @if jp
+     * @brief バッファへの書き込みを記録する
+     *
+     * @param status 書き込みの結果
+     * @param info バッファが返した上書き数と読み出し可能数
+     *
+     * @else
+     * @brief Record a write into the buffer
+     *
+     * @param status Result of the write
+     * @param info Overwritten and readable numbers returned by the buffer
+     *
+     * @endif
+     */
+    void countBufferWrite(BufferStatus status, const BufferWriteInfo& info)
+    {
+      if (status == BufferStatus::OK)
+        {
+          if (info.overwritten > 0) { increment(overwrite, info.overwritten); }
+          updateHighWater(info.readable);
+        }
+      else if (status == BufferStatus::FULL ||
+               status == BufferStatus::TIMEOUT)
+        {
+          increment(drop);
+        }
+    }
+
+    /*!
+     * @if jp
+     * @brief バッファへの複数のデータの書き込みを記録する
+     *
+     * @param n 書き込もうとしたデータの数
+     * @param written 書き込んだデータの数
+     * @param info バッファが返した上書き数と読み出し可能数
+     *
+     * @else
+     * @brief Record a write of multiple data into the buffer
+     *
+     * @param n Number of the data to be written
+     * @param written Number of the data written
+     * @param info Overwritten and readable numbers returned by the buffer
+     *
+     * @endif
+     */
+    void countBufferWrite(size_t n, size_t written,
+                          const BufferWriteInfo& info)
+    {
+      if (info.overwritten > 0) { increment(overwrite, info.overwritten); }
+      if (written < n) { increment(drop, n - written); }
+      updateHighWater(info.readable);
+    }
+
+    void countCodec(unsigned long raw, unsigned long coded,
+                    std::chrono::nanoseconds time)
+    {
+      increment(codec_raw_bytes, raw);
+      increment(codec_coded_bytes, coded);
+      increment(codec_time, static_cast<uint64_t>(time.count()));
+    }
+
+    void updateHighWater(size_t readable)
+    {
+      uint64_t high(buffer_high_water.load(std::memory_order_relaxed));
+      while (readable > high &&
+             !buffer_high_water.compare_exchange_weak(high, readable,
+                                                      std::memory_order_relaxed))
+        {
+        }
+    }
+
+    /*!
+     * @if jp
+     * @brief 統計値をプロパティに設定する
+     *
+     * 圧縮したデータがある場合は compression_ratio (圧縮前/圧縮後) も設
+     * 定する。
+     *
+     * @param prop 設定するプロパティ
+     *
+     * @else
+     * @brief Set the statistics to the properties
+     *
+     * compression_ratio (before/after the compression) is also set if
+     * any data was compressed.
+     *
+     * @param prop Properties to be set
+     *
+     * @endif
+     */
+    void getProperties(coil::Properties& prop) const;
+  };
+
   /*!
    * @if jp
    * @class ConnectorInfo クラス
@@ -176,6 +405,41 @@ namespace RTC
      * @endif
      */
     coil::Properties properties;
+
+    /*!
+     * @if jp
+     * @brief  コンストラクタで解析した接続設定
+     *
+     * properties をコンストラクタ以降に変更しても反映されない。
+     *
+     * @else
+     * @brief  Connection settings parsed in the constructor
+     *
+     * Changes of properties after the constructor are not reflected.
+     *
+     * @endif
+     */
+    const ConnectorSettings& settings() const { return m_settings; }
+
+    /*!
+     * @if jp
+     * @brief  接続の統計
+     *
+     * コピーした ConnectorInfo の間で共有される。
+     *
+     * @else
+     * @brief  Connection statistics
+     *
+     * Shared among the copies of ConnectorInfo.
+     *
+     * @endif
+     */
+    ConnectorStatistics& statistics() const { return *m_statistics; }
+
+  private:
+    ConnectorSettings m_settings;
+    std::shared_ptr<ConnectorStatistics> m_statistics{
+      std::make_shared<ConnectorStatistics>()};
   };
 
   using ConnectorInfoList = std::vector<ConnectorInfo>;
@@ -18,6 +18,7 @@
  */
 
 #include <rtm/ConnectorListener.h>
+#include <algorithm>
 #include <cstdint>
 
 namespace RTC
@@ -52,6 +53,15 @@ namespace RTC
    */
   ConnectorListener::~ConnectorListener() = default;
 
+  /*!
+   * @if jp
+   * @class DataArrivalListener クラス
+   * @else
+   * @class DataArrivalListener class
+   * @endif
+   */
+  DataArrivalListener::~DataArrivalListener() = default;
+
   /*!
    * @if jp
    * @class ConnectorDataListener ホルダクラス
@@ -127,18 +137,12 @@ namespace RTC
 
   ConnectorListenerHolder::ReturnCode ConnectorDataListenerHolder::notifyIn(ConnectorInfo& info, ByteData& data)
   {
-      std::string type = info.properties.getProperty("marshaling_type", "cdr");
-      std::string marshaling_type{ coil::eraseBothEndsBlank(
-        info.properties.getProperty("inport.marshaling_type", type)) };
-      return notify(info, data, marshaling_type);
+      return notify(info, data, info.settings().inport_marshaling_type);
   }
 
   ConnectorListenerHolder::ReturnCode ConnectorDataListenerHolder::notifyOut(ConnectorInfo& info, ByteData& data)
   {
-      std::string type = info.properties.getProperty("marshaling_type", "cdr");
-      std::string marshaling_type{ coil::eraseBothEndsBlank(
-        info.properties.getProperty("outport.marshaling_type", type)) };
-      return notify(info, data, marshaling_type);
+      return notify(info, data, info.settings().outport_marshaling_type);
   }
 
   /*!
@@ -474,6 +478,41 @@ namespace RTC
   */
   ConnectorListenersBase::~ConnectorListenersBase() = default;
 
+  /*!
+   * @if jp
+   * @brief データ到着リスナを追加する
+   * @else
+   * @brief Add a data arrival listener
+   * @endif
+   */
+  void ConnectorListenersBase::
+  addDataArrivalListener(DataArrivalListener* listener)
+  {
+    std::lock_guard<std::mutex> guard(m_arrivalMutex);
+    m_arrivalListeners.push_back(listener);
+    m_arrivalListenerCount.store(m_arrivalListeners.size(),
+                                 std::memory_order_release);
+  }
+
+  /*!
+   * @if jp
+   * @brief データ到着リスナを削除する
+   * @else
+   * @brief Remove a data arrival listener
+   * @endif
+   */
+  void ConnectorListenersBase::
+  removeDataArrivalListener(DataArrivalListener* listener)
+  {
+    std::lock_guard<std::mutex> guard(m_arrivalMutex);
+    auto it(std::find(m_arrivalListeners.begin(), m_arrivalListeners.end(),
+                      listener));
+    if (it == m_arrivalListeners.end()) { return; }
+    m_arrivalListeners.erase(it);
+    m_arrivalListenerCount.store(m_arrivalListeners.size(),
+                                 std::memory_order_release);
+  }
+
   /*!
    * @if jp
    *
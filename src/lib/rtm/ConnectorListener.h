@@ -18,6 +18,7 @@
 #ifndef RTC_CONNECTORLISTENER_H
 #define RTC_CONNECTORLISTENER_H
 
+#include <atomic>
 #include <mutex>
 #include <rtm/RTC.h>
 #include <rtm/ConnectorBase.h>
@@ -567,6 +568,10 @@ namespace RTC
       if(m_cdr == nullptr || m_marshalingtype != marshalingtype)
       {
         m_cdr = createSerializer<DataType>(marshalingtype);
+        if (m_cdr != nullptr)
+        {
+            m_cdr->init(info.properties);
+        }
         m_marshalingtype = marshalingtype;
       }
       ::RTC::ByteDataStream<DataType> *cdr = dynamic_cast<::RTC::ByteDataStream<DataType>*>(m_cdr);
@@ -579,18 +584,8 @@ namespace RTC
 
       
       // endian type check
-      std::string endian_type{coil::normalize(
-        info.properties.getProperty("serializer.cdr.endian", "little"))};
-      std::vector<std::string> endian(coil::split(endian_type, ","));
-
-      if (endian[0] == "little")
-      {
-          cdr->isLittleEndian(true);
-      }
-      else if (endian[0] == "big")
-      {
-          cdr->isLittleEndian(false);
-      }
+      bool endian(info.settings().little_endian);
+      cdr->isLittleEndian(endian);
 
 
       cdr->writeData(cdrdata.getBuffer(), cdrdata.getDataLength());
@@ -600,18 +595,11 @@ namespace RTC
       ReturnCode ret = this->operator()(info, data);
       if (ret == DATA_CHANGED || ret == BOTH_CHANGED)
       {
-          if (endian[0] == "little")
-          {
-              cdr->isLittleEndian(true);
-          }
-          else if (endian[0] == "big")
-          {
-              cdr->isLittleEndian(false);
-          }
+          cdr->isLittleEndian(endian);
 
           cdr->serialize(data);
           cdrdata.setDataLength(cdr->getDataLength());
-          cdr->readData(cdrdata.getBuffer(), cdrdata.getDataLength());
+          cdr->readData(cdrdata.mutableBuffer(), cdrdata.getDataLength());
       }
 
       return ret;
@@ -1107,10 +1095,7 @@ namespace RTC
     template <class DataType>
     ReturnCode notifyIn(ConnectorInfo& info, DataType& typeddata)
     {
-        std::string type = info.properties.getProperty("marshaling_type", "cdr");
-        std::string marshaling_type{coil::eraseBothEndsBlank(
-          info.properties.getProperty("inport.marshaling_type", type))};
-        return notify(info, typeddata, marshaling_type);
+        return notify(info, typeddata, info.settings().inport_marshaling_type);
     }
 
     /*!
@@ -1136,10 +1121,7 @@ namespace RTC
     template <class DataType>
     ReturnCode notifyOut(ConnectorInfo& info, DataType& typeddata)
     {
-        std::string type = info.properties.getProperty("marshaling_type", "cdr");
-        std::string marshaling_type{coil::eraseBothEndsBlank(
-          info.properties.getProperty("outport.marshaling_type", type))};
-        return notify(info, typeddata, marshaling_type);
+        return notify(info, typeddata, info.settings().outport_marshaling_type);
     }
     /*!
      * @if jp
@@ -1175,9 +1157,7 @@ namespace RTC
         return ret;
       }
 
-      std::string endian_type{coil::normalize(
-        info.properties.getProperty("serializer.cdr.endian", "little"))};
-      std::vector<std::string> endian(coil::split(endian_type, ","));
+      bool endian(info.settings().little_endian);
 
       for (auto & listener : m_listeners)
         {
@@ -1193,6 +1173,10 @@ namespace RTC
               if (m_cdr == nullptr || m_marshalingtype != marshalingtype)
               {
                   m_cdr = createSerializer<DataType>(marshalingtype);
+                  if (m_cdr != nullptr)
+                  {
+                      m_cdr->init(info.properties);
+                  }
                   m_marshalingtype = marshalingtype;
               }
               ::RTC::ByteDataStream<DataType> *cdr = dynamic_cast<::RTC::ByteDataStream<DataType>*>(m_cdr);
@@ -1202,14 +1186,7 @@ namespace RTC
                   return NO_CHANGE;
               }
 
-              if (endian[0] == "little")
-              {
-                  cdr->isLittleEndian(true);
-              }
-              else if (endian[0] == "big")
-              {
-                  cdr->isLittleEndian(false);
-              }
+              cdr->isLittleEndian(endian);
               cdr->serialize(typeddata);
               ByteData tmp = *cdr;
               ret = ret | listener.first->operator()(info, tmp, marshalingtype);
@@ -1350,6 +1327,44 @@ namespace RTC
     std::mutex m_mutex;
   };
 
+  /*!
+   * @if jp
+   * @class DataArrivalListener
+   * @brief データ到着リスナ
+   *
+   * InPort のバッファまたはダイレクト接続のチャネルにデータが格納され
+   * た後に、書き込んだスレッドから呼び出される。データの内容は渡されな
+   * いため、シリアライズは行われない。コールバックは短時間で戻り、ポー
+   * トを操作してはならない。
+   *
+   * @else
+   * @class DataArrivalListener
+   * @brief Data arrival listener
+   *
+   * Called from the writing thread after the data is stored into the
+   * buffer or the direct connection channel of the InPort. The data
+   * itself is not passed, so nothing is serialized. The callback must
+   * return quickly and must not operate the port.
+   *
+   * @endif
+   */
+  class DataArrivalListener
+  {
+  public:
+    virtual ~DataArrivalListener();
+
+    /*!
+     * @if jp
+     * @brief データが到着した
+     * @param info ConnectorInfo
+     * @else
+     * @brief Data has arrived
+     * @param info ConnectorInfo
+     * @endif
+     */
+    virtual void operator()(const ConnectorInfo& info) = 0;
+  };
+
   class ConnectorListenersBase
   {
   public:
@@ -1612,6 +1627,76 @@ namespace RTC
         }
         return ConnectorListenerStatus::NO_CHANGE;
     }
+
+    /*!
+     * @if jp
+     * @brief データ到着リスナを追加する
+     *
+     * リスナは削除されるまで呼び出し側が所有する。
+     *
+     * @param listener 追加するリスナ
+     *
+     * @else
+     * @brief Add a data arrival listener
+     *
+     * The listener is owned by the caller until it is removed.
+     *
+     * @param listener Listener to add
+     *
+     * @endif
+     */
+    void addDataArrivalListener(DataArrivalListener* listener);
+
+    /*!
+     * @if jp
+     * @brief データ到着リスナを削除する
+     *
+     * 実行中のコールバックの完了を待ってから戻る。
+     *
+     * @param listener 削除するリスナ
+     *
+     * @else
+     * @brief Remove a data arrival listener
+     *
+     * Returns after the running callback completes.
+     *
+     * @param listener Listener to remove
+     *
+     * @endif
+     */
+    void removeDataArrivalListener(DataArrivalListener* listener);
+
+    /*!
+     * @if jp
+     * @brief データの到着を通知する
+     *
+     * リスナが登録されていない場合はロックを取得しない。
+     *
+     * @param info ConnectorInfo
+     *
+     * @else
+     * @brief Notify the data arrival
+     *
+     * No lock is taken if no listener is registered.
+     *
+     * @param info ConnectorInfo
+     *
+     * @endif
+     */
+    void notifyDataArrival(const ConnectorInfo& info)
+    {
+      if (m_arrivalListenerCount.load(std::memory_order_acquire) == 0)
+        {
+          return;
+        }
+      std::lock_guard<std::mutex> guard(m_arrivalMutex);
+      for (auto* listener : m_arrivalListeners) { (*listener)(info); }
+    }
+
+  private:
+    std::vector<DataArrivalListener*> m_arrivalListeners;
+    std::atomic<size_t> m_arrivalListenerCount{0};
+    std::mutex m_arrivalMutex;
   };
 
   /*!
@@ -1933,7 +2018,7 @@ namespace RTC
       {
           std::lock_guard<std::mutex> guard(m_mutex);
           ConnectorListenerHolder::ReturnCode ret(NO_CHANGE);
-          bool endian = true;
+          bool endian(info.settings().little_endian);
 
           if(m_listeners.empty())
           {
@@ -1945,6 +2030,10 @@ namespace RTC
           if (m_cdr == nullptr || m_marshalingtype != marshalingtype)
           {
               m_cdr = createSerializer<DataType>(marshalingtype);
+              if (m_cdr != nullptr)
+              {
+                  m_cdr->init(info.properties);
+              }
               m_marshalingtype = marshalingtype;
           }
           ::RTC::ByteDataStream<DataType> *cdr = dynamic_cast<::RTC::ByteDataStream<DataType>*>(m_cdr);
@@ -1956,20 +2045,6 @@ namespace RTC
           }
 
 
-          // endian type check
-          std::string endian_type{ coil::normalize(
-            info.properties.getProperty("serializer.cdr.endian", "little")) };
-          std::vector<std::string> endian_str(coil::split(endian_type, ","));
-
-          if (endian_str[0] == "little")
-          {
-              endian = true;
-          }
-          else if (endian_str[0] == "big")
-          {
-              endian = false;
-          }
-
           cdr->isLittleEndian(endian);
           cdr->writeData(cdrdata.getBuffer(), cdrdata.getDataLength());
           cdr->deserialize(data);
@@ -1988,7 +2063,7 @@ namespace RTC
                       cdr->isLittleEndian(endian);
                       cdr->serialize(data);
                       cdrdata.setDataLength(cdr->getDataLength());
-                      cdr->readData(cdrdata.getBuffer(), cdrdata.getDataLength());
+                      cdr->readData(cdrdata.mutableBuffer(), cdrdata.getDataLength());
                   }
                   ret = ret | linstener_ret;
               }
@@ -2031,10 +2106,7 @@ namespace RTC
        */
       ReturnCode notifyIn(ConnectorInfo& info, ByteData& data) override
       {
-          std::string type = info.properties.getProperty("marshaling_type", "cdr");
-          std::string marshaling_type{ coil::eraseBothEndsBlank(
-            info.properties.getProperty("inport.marshaling_type", type)) };
-          return notify(info, data, marshaling_type);
+          return notify(info, data, info.settings().inport_marshaling_type);
       }
 
       /*!
@@ -2059,10 +2131,7 @@ namespace RTC
        */
       ReturnCode notifyOut(ConnectorInfo& info, ByteData& data) override
       {
-          std::string type = info.properties.getProperty("marshaling_type", "cdr");
-          std::string marshaling_type{ coil::eraseBothEndsBlank(
-            info.properties.getProperty("outport.marshaling_type", type)) };
-          return notify(info, data, marshaling_type);
+          return notify(info, data, info.settings().outport_marshaling_type);
       }
 
   };
@@ -20,6 +20,11 @@
 #ifndef RTC_DATATYPEUTIL_H
 #define RTC_DATATYPEUTIL_H
 
+namespace RTC
+{
+  class CdrViewReader;
+} // namespace RTC
+
 namespace CORBA_Util
 {
   /*!
@@ -44,6 +49,36 @@ namespace CORBA_Util
   {
      data1 = data2;
   }
+
+  /*!
+   * @if jp
+   * @brief シーケンスをコピーせずに CDR からデシリアライズする
+   * 大きなシーケンスを持つデータ型について特殊化し、シーケンスのメンバは
+   * バッファを解放しない設定でシリアライズ済みデータを直接参照させる。
+   * 特殊化されていない型は false を返し、通常のデシリアライズが行われる。
+   *
+   * @param cdr シリアライズ済みデータのリーダ
+   * @param data デシリアライズ先の変数
+   * @return false: 未対応、またはデータが不正
+   *
+   * @else
+   * @brief Deserialize from CDR without copying the sequences
+   * Specialized for the data types with large sequences, and the
+   * sequence members refer to the serialized data directly without
+   * releasing the buffer. The other types return false and the usual
+   * deserialization is used.
+   *
+   * @param cdr Reader of the serialized data
+   * @param data Variable to deserialize into
+   * @return false: not supported or invalid data
+   *
+   * @endif
+   */
+  template <class T>
+  bool deserializeView(RTC::CdrViewReader& /*cdr*/, T& /*data*/)
+  {
+     return false;
+  }
 } // namespace CORBA_Util
 
 
@@ -0,0 +1,109 @@
+// -*- C++ -*-
+/*!
+ * @file DataView.h
+ * @brief Read-only view of data received by InPort
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_DATAVIEW_H
+#define RTC_DATAVIEW_H
+
+#include <rtm/ByteData.h>
+
+#include <memory>
+
+namespace RTC
+{
+  class InPortConnector;
+  template <class DataType> class InPort;
+
+  /*!
+   * @if jp
+   * @class DataView
+   * @brief InPort で受信したデータの読み出し専用ビュー
+   *
+   * InPort::readView() で読み出したデータを保持する。データ型が
+   * CORBA_Util::deserializeView() を持ち、接続の marshaling_type が
+   * cdr の場合、シーケンスのメンバはコピーされず、受信したシリアライ
+   * ズ済みデータを直接参照する。参照先の ByteData はビューが共有して
+   * 保持するため、次にこのビューに読み出すまで有効である。それ以外の
+   * 場合は通常どおりデシリアライズされる。
+   *
+   * @else
+   * @class DataView
+   * @brief Read-only view of data received by InPort
+   *
+   * Holds the data read by InPort::readView(). If the data type has
+   * CORBA_Util::deserializeView() and the marshaling_type of the
+   * connection is cdr, the sequence members are not copied and refer to
+   * the received serialized data directly. The view shares the
+   * referred ByteData, so it is valid until the next read into this
+   * view. Otherwise the data is deserialized as usual.
+   *
+   * @endif
+   */
+  template <class DataType>
+  class DataView
+  {
+  public:
+    DataView() : m_value(new DataType()) {}
+    DataView(const DataView&) = delete;
+    DataView& operator=(const DataView&) = delete;
+
+    const DataType& operator*() const { return *m_value; }
+    const DataType* operator->() const { return m_value.get(); }
+    const DataType& get() const { return *m_value; }
+
+    /*!
+     * @if jp
+     * @brief 参照しているシリアライズ済みデータ
+     * @else
+     * @brief Serialized data referred to
+     * @endif
+     */
+    const ByteData& data() const { return m_data; }
+
+    /*!
+     * @if jp
+     * @brief メンバがシリアライズ済みデータを参照しているか
+     * @else
+     * @brief Whether the members refer to the serialized data
+     * @endif
+     */
+    bool isAliased() const { return m_aliased; }
+
+  private:
+    friend class InPortConnector;
+    friend class InPort<DataType>;
+
+    /*
+     * The sequences referring to the old data do not own their buffers
+     * and would be filled in place by an assignment, so the value is
+     * created again instead.
+     */
+    DataType& reset()
+    {
+      if (m_aliased)
+        {
+          m_value.reset(new DataType());
+          m_aliased = false;
+        }
+      return *m_value;
+    }
+
+    std::unique_ptr<DataType> m_value;
+    ByteData m_data;
+    bool m_aliased{false};
+  };
+} // namespace RTC
+
+#endif  // RTC_DATAVIEW_H
@@ -57,6 +57,8 @@ namespace RTC {
     "logger.date_format",                    "%b %d %H:%M:%S.%Q",
     "logger.log_level",                      "INFO",
     "logger.stream_lock",                    "NO",
+    "logger.async",                          "NO",
+    "logger.async_queue_length",             "1024",
     "logger.master_logger",                  "",
     "logger.escape_sequence_enable",         "NO",
     "module.conf_path",                      "",
@@ -94,6 +96,7 @@ namespace RTC {
     "manager.shutdown_auto",                 "YES",
     "manager.auto_shutdown_duration",        "20.0",
     "manager.termination_waittime",          "0.5",
+    "manager.thread_pool.size",              "0",
     "manager.name",                          "manager",
     "manager.components.naming_policy",      "process_unique",
     "manager.command",                       "rtcd2",
@@ -0,0 +1,273 @@
+// -*- C++ -*-
+/*!
+ * @file DirectChannel.h
+ * @brief Lock-free data channel of direct connections
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_DIRECTCHANNEL_H
+#define RTC_DIRECTCHANNEL_H
+
+#include <coil/Properties.h>
+#include <coil/stringutil.h>
+
+#include <rtm/BufferStatus.h>
+#include <rtm/DataTypeUtil.h>
+#include <rtm/SpscRingBuffer.h>
+
+#include <atomic>
+#include <memory>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class DirectChannelBase
+   * @brief ダイレクト接続のチャネルの基底クラス
+   *
+   * データ型に依存しない部分。チャネルは InPort とコネクタで共有され、
+   * 切断時にコネクタが close() する。InPort は閉じられたチャネルを未読
+   * のデータがなくなってから取り除く。
+   *
+   * @else
+   * @class DirectChannelBase
+   * @brief Base class of the channels of direct connections
+   *
+   * The part independent of the data type. A channel is shared by the
+   * InPort and the connector, and the connector close()s it on
+   * disconnection. The InPort removes a closed channel once it has no
+   * unread data.
+   *
+   * @endif
+   */
+  class DirectChannelBase
+  {
+  public:
+    virtual ~DirectChannelBase() = default;
+
+    /*!
+     * @if jp
+     * @brief チャネルを閉じる
+     * @else
+     * @brief Close the channel
+     * @endif
+     */
+    void close() { m_closed.store(true, std::memory_order_release); }
+
+    /*!
+     * @if jp
+     * @brief チャネルが閉じられたか
+     * @else
+     * @brief Whether the channel is closed
+     * @endif
+     */
+    bool isClosed() const { return m_closed.load(std::memory_order_acquire); }
+
+  private:
+    std::atomic<bool> m_closed{false};
+  };
+
+  /*!
+   * @if jp
+   * @class DirectChannel
+   * @brief ダイレクト接続のチャネル
+   *
+   * 同一プロセス内の OutPort から InPort へデータを渡す、1つの書き込み
+   * スレッドと1つの読み出しスレッドのためのチャネル。書き込みと読み出し
+   * はロックを取得しない。
+   *
+   * - buffer.length が 1 以下 (既定): トリプルバッファ。書き込みは常に
+   *   成功し、読み出しは最新の値を得る。未読の値は上書きされる。
+   * - buffer.length が 2 以上: SpscRingBuffer によるキュー。フル時の扱い
+   *   は buffer.write.full_policy に従う。
+   *
+   * @else
+   * @class DirectChannel
+   * @brief Channel of direct connections
+   *
+   * The channel passing the data from an OutPort to an InPort in the
+   * same process, for one writer thread and one reader thread. Neither
+   * writing nor reading takes a lock.
+   *
+   * - buffer.length of 1 or less (default): A triple buffer. Writing
+   *   always succeeds and reading gets the latest value. The unread
+   *   value is overwritten.
+   * - buffer.length of 2 or more: A queue of SpscRingBuffer. A full
+   *   queue is handled by buffer.write.full_policy.
+   *
+   * @endif
+   */
+  template <class DataType>
+  class DirectChannel
+    : public DirectChannelBase
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @param prop バッファのプロパティ (コネクタプロファイルの buffer 以下)
+     * @else
+     * @brief Constructor
+     * @param prop Buffer properties (buffer of the connector profile)
+     * @endif
+     */
+    explicit DirectChannel(const coil::Properties& prop)
+    {
+      size_t length(1);
+      if (!prop["length"].empty() &&
+          coil::stringTo(length, prop["length"].c_str()) && length > 1)
+        {
+          m_queue.reset(new SpscRingBuffer<DataType>());
+          m_queue->init(prop);
+        }
+    }
+
+    ~DirectChannel() override = default;
+
+    /*!
+     * @if jp
+     * @brief データを書き込む
+     *
+     * 書き込みスレッドからのみ呼び出すこと。
+     *
+     * @param data 書き込むデータ
+     * @param info 上書きした未読のデータの数と書き込み後の未読のデータの数
+     * @return OK: 正常終了、FULL/TIMEOUT: キューがフル
+     *
+     * @else
+     * @brief Write the data
+     *
+     * Must be called only from the writer thread.
+     *
+     * @param data Data to write
+     * @param info Number of the unread data overwritten and number of
+     *             the unread data after the write
+     * @return OK: Successful, FULL/TIMEOUT: The queue is full
+     *
+     * @endif
+     */
+    BufferStatus write(const DataType& data, BufferWriteInfo& info)
+    {
+      if (m_queue)
+        {
+          return m_queue->write(data, std::chrono::nanoseconds(-1), info);
+        }
+      CORBA_Util::copyData<DataType>(m_slots[m_back], data);
+      unsigned int prev(m_middle.exchange(m_back | NEW_DATA,
+                                          std::memory_order_acq_rel));
+      m_back = prev & SLOT_MASK;
+      info.overwritten = (prev & NEW_DATA) != 0 ? 1 : 0;
+      info.readable = 1;
+      return BufferStatus::OK;
+    }
+
+    /*!
+     * @if jp
+     * @brief データを読み出す
+     *
+     * 読み出しスレッドからのみ呼び出すこと。
+     *
+     * @param data 読み出したデータを格納する変数
+     * @return 未読のデータがなかった場合 false
+     *
+     * @else
+     * @brief Read the data
+     *
+     * Must be called only from the reader thread.
+     *
+     * @param data Variable to store the data
+     * @return false if there was no unread data
+     *
+     * @endif
+     */
+    bool read(DataType& data)
+    {
+      if (m_queue)
+        {
+          // the read policy would return the last data of an empty queue
+          if (m_queue->empty()) { return false; }
+          return m_queue->read(data) == BufferStatus::OK;
+        }
+      if ((m_middle.load(std::memory_order_acquire) & NEW_DATA) == 0)
+        {
+          return false;
+        }
+      unsigned int prev(m_middle.exchange(m_front,
+                                          std::memory_order_acq_rel));
+      m_front = prev & SLOT_MASK;
+      CORBA_Util::copyData<DataType>(data, m_slots[m_front]);
+      return true;
+    }
+
+    /*!
+     * @if jp
+     * @brief 未読のデータがあるか
+     * @else
+     * @brief Whether there is unread data
+     * @endif
+     */
+    bool isNew() const
+    {
+      if (m_queue) { return !m_queue->empty(); }
+      return (m_middle.load(std::memory_order_acquire) & NEW_DATA) != 0;
+    }
+
+    /*!
+     * @if jp
+     * @brief 未読のデータの数
+     * @else
+     * @brief Number of the unread data
+     * @endif
+     */
+    size_t readable() const
+    {
+      if (m_queue) { return m_queue->readable(); }
+      return isNew() ? 1 : 0;
+    }
+
+  private:
+    static const unsigned int SLOT_MASK = 0x3;
+    static const unsigned int NEW_DATA = 0x4;
+
+    /*!
+     * @if jp
+     * @brief トリプルバッファ
+     *
+     * m_back は書き込みスレッド、m_front は読み出しスレッドが所有し、
+     * 残りの1つ (m_middle) を交換して受け渡す。
+     *
+     * @else
+     * @brief Triple buffer
+     *
+     * m_back is owned by the writer thread and m_front by the reader
+     * thread, and the remaining one (m_middle) is exchanged to pass
+     * the data.
+     *
+     * @endif
+     */
+    DataType m_slots[3];
+    std::atomic<unsigned int> m_middle{0};
+    unsigned int m_back{1};
+    unsigned int m_front{2};
+
+    /*!
+     * @if jp
+     * @brief buffer.length が 2 以上の場合のキュー
+     * @else
+     * @brief Queue for buffer.length of 2 or more
+     * @endif
+     */
+    std::unique_ptr<SpscRingBuffer<DataType>> m_queue;
+  };
+} // namespace RTC
+
+#endif // RTC_DIRECTCHANNEL_H
@@ -17,7 +17,9 @@
 #ifndef RTC_DIRECTPORTBASE_H
 #define RTC_DIRECTPORTBASE_H
 
+#include <coil/Properties.h>
 
+#include <memory>
 
 
 
@@ -25,6 +27,8 @@
 
 namespace RTC
 {
+  class DirectChannelBase;
+
   /*!
    * @if jp
    * @class DirectPortBase
@@ -59,8 +63,34 @@ namespace RTC
       */
      virtual ~DirectPortBase() = default;
 
-
-
+     /*!
+      * @if jp
+      * @brief ダイレクト接続のチャネルを開く
+      *
+      * 接続時に OutPort 側のコネクタから呼び出される。チャネルに対応
+      * しないポートは nullptr を返し、データは DirectInPortBase::write()
+      * で書き込まれる。
+      *
+      * @param prop バッファのプロパティ (コネクタプロファイルの buffer 以下)
+      * @return チャネル
+      *
+      * @else
+      * @brief Open a channel of a direct connection
+      *
+      * Called by the connector of the OutPort on connection. The ports
+      * not supporting channels return nullptr, and the data is written
+      * by DirectInPortBase::write().
+      *
+      * @param prop Buffer properties (buffer of the connector profile)
+      * @return Channel
+      *
+      * @endif
+      */
+     virtual std::shared_ptr<DirectChannelBase>
+     openDirectChannel(const coil::Properties& /*prop*/)
+     {
+       return nullptr;
+     }
   };
 } // namespace RTC
 
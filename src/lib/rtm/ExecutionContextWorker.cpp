@@ -19,9 +19,12 @@
 #include <rtm/RTObject.h>
 #include <rtm/RTObjectStateMachine.h>
 #include <rtm/ExecutionContextWorker.h>
+#include <rtm/NVUtil.h>
+#include <rtm/PortBase.h>
 
 #include <algorithm>
 #include <iostream>
+#include <map>
 
 #define DEEFAULT_PERIOD 0.000001
 namespace RTC_impl
@@ -48,6 +51,7 @@ namespace RTC_impl
   ExecutionContextWorker::~ExecutionContextWorker()
   {
     RTC_TRACE(("~ExecutionContextWorker()"));
+    stopRefresher();
   }
 
   //============================================================
@@ -95,11 +99,12 @@ namespace RTC_impl
         return RTC::PRECONDITION_NOT_MET;
       }
     // invoke ComponentAction::on_startup for each comps.
-    for (auto & comp : m_comps)
+    std::shared_ptr<const CompList> comps(components());
+    for (auto & comp : *comps)
       {
         comp->onStartup();
       }
-    RTC_DEBUG(("%d components started.", m_comps.size()));
+    RTC_DEBUG(("%d components started.", comps->size()));
     // change EC thread state
     m_running = true;
 
@@ -126,7 +131,8 @@ namespace RTC_impl
     m_running = false;
 
     // invoke on_shutdown for each comps.
-    for (auto & comp : m_comps)
+    std::shared_ptr<const CompList> comps(components());
+    for (auto & comp : *comps)
       {
         comp->onShutdown();
       }
@@ -145,7 +151,8 @@ namespace RTC_impl
     RTC_TRACE(("rateChanged()"));
     // invoke on_shutdown for each comps.
     RTC::ReturnCode_t ret(RTC::RTC_OK);
-    for (auto & comp : m_comps)
+    std::shared_ptr<const CompList> comps(components());
+    for (auto & comp : *comps)
       {
         RTC::ReturnCode_t tmp = comp->onRateChanged();
         if (tmp != RTC::RTC_OK) { ret = tmp; }
@@ -179,6 +186,8 @@ namespace RTC_impl
         return RTC::PRECONDITION_NOT_MET;
       }
     RTC_DEBUG(("Component is in INACTIVE state. Going to ACTIVE state."));
+    // collected here so that the EC thread makes no remote call for it
+    if (m_executor.size() > 1 && m_groups.empty()) { refreshConnections(); }
     rtobj = obj;
     RTC_DEBUG(("activateComponent() done."));
     return RTC::RTC_OK;
@@ -284,6 +293,7 @@ namespace RTC_impl
         RTC::ExecutionContextService_var ec = getECRef();
         RTC::ExecutionContextHandle_t id = comp->attach_context(ec);
         m_addedComps.emplace_back(new RTObjectStateMachine(id, comp));
+        m_listChanged.store(true, std::memory_order_release);
       }
     catch (CORBA::Exception& e)
       {
@@ -294,7 +304,6 @@ namespace RTC_impl
     RTC_DEBUG(("addComponent() succeeded."));
 
     // if EC is stopping, update component list immediately.
-    std::lock_guard<std::mutex> guard(m_mutex);
     if (!m_running) { updateComponentList(); }
 
     return RTC::RTC_OK;
@@ -329,7 +338,9 @@ namespace RTC_impl
 
     // rtc is owner of this EC
     RTC::LightweightRTObject_var comp = rtc->getObjRef();
-    m_comps.emplace_back(new RTObjectStateMachine(id, comp));
+    std::shared_ptr<CompList> comps(std::make_shared<CompList>(*m_comps));
+    comps->emplace_back(new RTObjectStateMachine(id, comp));
+    std::atomic_store(&m_comps, std::shared_ptr<const CompList>(std::move(comps)));
     RTC_DEBUG(("bindComponent() succeeded."));
 
     return RTC::RTC_OK;
@@ -362,23 +373,43 @@ namespace RTC_impl
     {
       std::lock_guard<std::mutex> removeGuard(m_removedMutex);
       m_removedComps.emplace_back(rtobj);
+      m_listChanged.store(true, std::memory_order_release);
     }
     // if EC is stopping, update component list immediately.
-    {
-      std::lock_guard<std::mutex> guard(m_mutex);
-      if (!m_running) { updateComponentList(); }
-    }
+    if (!m_running) { updateComponentList(); }
 
     return RTC::RTC_OK;
   }
 
+  /*!
+   * @if jp
+   * @brief コンポーネントリストの更新
+   *
+   * 追加・削除要求がない場合はロックを取らずに戻る。要求がある場合は
+   * 新しいスナップショットを作成して公開する。削除されたコンポーネン
+   * トは古いスナップショットの参照がなくなった時点で解放される。
+   *
+   * @else
+   * @brief Updating component list
+   *
+   * Returns without a lock when no addition or removal is requested.
+   * Otherwise a new snapshot is built and published. A removed
+   * component is freed when the old snapshots are no longer referenced.
+   *
+   * @endif
+   */
   void ExecutionContextWorker::updateComponentList()
   {
+    if (!m_listChanged.load(std::memory_order_acquire)) { return; }
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_listChanged.store(false, std::memory_order_release);
+    std::shared_ptr<CompList> comps(std::make_shared<CompList>(*m_comps));
     {    // adding component
       std::lock_guard<std::mutex> addedGuard(m_addedMutex);
       for (auto & m_addedComp : m_addedComps)
         {
-          m_comps.emplace_back(std::move(m_addedComp));
+          comps->emplace_back(m_addedComp);
           RTC_TRACE(("Component added."));
         }
       m_addedComps.clear();
@@ -387,28 +418,35 @@ namespace RTC_impl
       std::lock_guard<std::mutex> removedGuard(m_removedMutex);
       for (auto rtobj : m_removedComps)
         {
+          CompItr it = std::find_if(comps->begin(), comps->end(),
+                                    [rtobj](const CompList::value_type& c)
+                                    { return c.get() == rtobj; });
+          if (it == comps->end()) { continue; }
           RTC::LightweightRTObject_var lwrtobj = rtobj->getRTObject();
           lwrtobj->detach_context(rtobj->getExecutionContextHandle());
-          CompItr it;
-          it = std::find(m_comps.begin(), m_comps.end(), rtobj);
-          assert(*it == rtobj);
-          m_comps.erase(it);
-          delete rtobj;
+          comps->erase(it);
           RTC_TRACE(("Component deleted."));
         }
       m_removedComps.clear();
     }
+    std::atomic_store(&m_comps, std::shared_ptr<const CompList>(std::move(comps)));
+  }
+
+  std::shared_ptr<const ExecutionContextWorker::CompList>
+  ExecutionContextWorker::components() const
+  {
+    return std::atomic_load(&m_comps);
   }
 
   RTObjectStateMachine*
   ExecutionContextWorker::findComponent(RTC::LightweightRTObject_ptr comp)
   {
-    std::lock_guard<std::mutex> guard(m_mutex);
-    for (auto & rtobj : m_comps)
+    std::shared_ptr<const CompList> comps(components());
+    for (auto & rtobj : *comps)
       {
         if (rtobj->isEquivalent(comp))
           {
-            return rtobj;
+            return rtobj.get();
           }
       }
     return nullptr;
@@ -417,8 +455,8 @@ namespace RTC_impl
   bool ExecutionContextWorker::
   isAllCurrentState(ExecContextState state)
   {
-    std::lock_guard<std::mutex> guard(m_mutex);
-    for (auto & comp : m_comps)
+    std::shared_ptr<const CompList> comps(components());
+    for (auto & comp : *comps)
       {
         if (!comp->isCurrentState(state)) { return false; }
       }
@@ -428,8 +466,8 @@ namespace RTC_impl
   bool ExecutionContextWorker::
   isAllNextState(ExecContextState state)
   {
-    std::lock_guard<std::mutex> guard(m_mutex);
-    for (auto & comp : m_comps)
+    std::shared_ptr<const CompList> comps(components());
+    for (auto & comp : *comps)
       {
         if (!comp->isNextState(state)) { return false; }
       }
@@ -439,8 +477,8 @@ namespace RTC_impl
   bool ExecutionContextWorker::
   isOneOfCurrentState(ExecContextState state)
   {
-    std::lock_guard<std::mutex> guard(m_mutex);
-    for (auto & comp : m_comps)
+    std::shared_ptr<const CompList> comps(components());
+    for (auto & comp : *comps)
       {
         if (comp->isCurrentState(state)) { return true; }
       }
@@ -450,8 +488,8 @@ namespace RTC_impl
   bool ExecutionContextWorker::
   isOneOfNextState(ExecContextState state)
   {
-    std::lock_guard<std::mutex> guard(m_mutex);
-    for (auto & comp : m_comps)
+    std::shared_ptr<const CompList> comps(components());
+    for (auto & comp : *comps)
       {
         if (comp->isNextState(state)) { return true; }
       }
@@ -461,25 +499,24 @@ namespace RTC_impl
   void ExecutionContextWorker::invokeWorker()
   {
     RTC_PARANOID(("invokeWorker()"));
-    // m_comps never changes its size here
-    for (auto & comp : m_comps) { 
+    // the snapshot never changes here
+    std::shared_ptr<const CompList> comps(components());
+    for (auto & comp : *comps) { 
         comp->workerPreDo();  
     }
-    for (auto & comp : m_comps) { 
-        comp->workerDo();     
-    }
-    for (auto & comp : m_comps) { 
+    doComponents(comps);
+    for (auto & comp : *comps) { 
         comp->workerPostDo(); 
     }
-    std::lock_guard<std::mutex> guard(m_mutex);
     updateComponentList();
   }
 
   void ExecutionContextWorker::invokeWorkerPreDo()
   {
     RTC_PARANOID(("invokeWorkerPreDo()"));
-    // m_comps never changes its size here
-    for (auto & comp : m_comps) { 
+    // the snapshot never changes here
+    std::shared_ptr<const CompList> comps(components());
+    for (auto & comp : *comps) { 
         comp->workerPreDo();  
     }
   }
@@ -487,23 +524,523 @@ namespace RTC_impl
   void ExecutionContextWorker::invokeWorkerDo()
   {
     RTC_PARANOID(("invokeWorkerDo()"));
-    // m_comps never changes its size here
-    for (auto & comp : m_comps) { 
-        comp->workerDo();     
-    }
+    // the snapshot never changes here
+    doComponents(components());
   }
 
   void ExecutionContextWorker::invokeWorkerPostDo()
   {
     RTC_PARANOID(("invokeWorkerPostDo()"));
-    // m_comps never changes its size here
-    for (auto & comp : m_comps) { 
+    // the snapshot never changes here
+    std::shared_ptr<const CompList> comps(components());
+    for (auto & comp : *comps) { 
         comp->workerPostDo(); 
     }
-    // m_comps might be changed here
-    std::lock_guard<std::mutex> guard(m_mutex);
+    // the snapshot might be replaced here
     updateComponentList();
   }
 
+  /*!
+   * @if jp
+   * @brief コンポーネントを1つ実行する
+   * @else
+   * @brief Execute one component
+   * @endif
+   */
+  void ExecutionContextWorker::invokeComponent(RTObjectStateMachine& comp)
+  {
+    RTC_PARANOID(("invokeComponent()"));
+    comp.workerPreDo();
+    execute(comp);
+    comp.workerPostDo();
+  }
+
+  /*!
+   * @if jp
+   * @brief コンポーネントの並列実行を設定する
+   * @else
+   * @brief Set the parallel execution of the components
+   * @endif
+   */
+  void ExecutionContextWorker::
+  setParallelExecution(size_t threads, const std::vector<coil::vstring>& groups)
+  {
+    RTC_TRACE(("setParallelExecution(%d)", threads));
+    m_groups = groups;
+    m_graphComps.reset();
+    if (threads > 1)
+      {
+        m_executor.start(threads);
+      }
+    else
+      {
+        m_executor.stop();
+      }
+    if (threads > 1 && groups.empty())
+      {
+        startRefresher();
+      }
+    else
+      {
+        stopRefresher();
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief コンポーネントの workerDo() を実行する
+   * @else
+   * @brief Execute workerDo() of the components
+   * @endif
+   */
+  void ExecutionContextWorker::
+  doComponents(const std::shared_ptr<const CompList>& comps)
+  {
+    if (m_executor.size() < 2 || comps->size() < 2)
+      {
+        for (auto & comp : *comps) { 
+            execute(*comp);
+        }
+        return;
+      }
+    updateExecutionGraph(comps);
+    const CompList& list(*comps);
+    m_executor.run(m_graph, [this, &list](size_t i) { execute(*list[i]); });
+  }
+
+  /*!
+   * @if jp
+   * @brief コンポーネントの workerDo() を実行し、統計を記録する
+   * @else
+   * @brief Execute workerDo() of a component and record the statistics
+   * @endif
+   */
+  void ExecutionContextWorker::execute(RTObjectStateMachine& comp)
+  {
+    if (!m_statistics || !comp.isCurrentState(RTC::ACTIVE_STATE))
+      {
+        comp.workerDo();
+        return;
+      }
+    auto t0 = std::chrono::steady_clock::now();
+    comp.workerDo();
+    auto t1 = std::chrono::steady_clock::now();
+
+    ComponentStatistics& stat(comp.statistics());
+    stat.exec_time.record(t1 - t0);
+    if (t1 > m_deadline)
+      {
+        stat.deadline_miss.fetch_add(1, std::memory_order_relaxed);
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 実行時間の統計を有効または無効にする
+   * @else
+   * @brief Enable or disable the execution time statistics
+   * @endif
+   */
+  void ExecutionContextWorker::setStatistics(bool enable)
+  {
+    RTC_TRACE(("setStatistics(%s)", enable ? "true" : "false"));
+    m_statistics = enable;
+  }
+
+  void ExecutionContextWorker::
+  setDeadline(std::chrono::steady_clock::time_point deadline)
+  {
+    m_deadline = deadline;
+  }
+
+  /*!
+   * @if jp
+   * @brief コンポーネントごとの統計値を取得する
+   * @else
+   * @brief Get the statistics of each component
+   * @endif
+   */
+  void ExecutionContextWorker::getStatistics(coil::Properties& prop)
+  {
+    RTC_TRACE(("getStatistics()"));
+    std::shared_ptr<const CompList> comps(components());
+    for (auto & comp : *comps)
+      {
+        std::string name(componentName(*comp));
+        if (name.empty()) { continue; }
+        ComponentStatistics& stat(comp->statistics());
+        ExecutionStatistics::setSummary(prop, name + ".exec_time",
+                                        stat.exec_time);
+        prop.setProperty(name + ".deadline_miss",
+                         coil::otos(stat.deadline_miss.load(std::memory_order_relaxed)));
+        if (stat.release_jitter.count() > 0)
+          {
+            ExecutionStatistics::setSummary(prop, name + ".release_jitter",
+                                            stat.release_jitter);
+            prop.setProperty(name + ".skipped",
+                             coil::otos(stat.skipped.load(std::memory_order_relaxed)));
+          }
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief コンポーネントのインスタンス名を取得する
+   *
+   * 参加時に取得したインスタンス名を返す。CORBA の呼び出しは行わない。
+   *
+   * @return インスタンス名。取得できない場合は空文字列。
+   *
+   * @else
+   * @brief Get the instance name of a component
+   *
+   * Returns the instance name obtained when it joined. No CORBA call
+   * is made.
+   *
+   * @return Instance name. An empty string if it is unknown.
+   *
+   * @endif
+   */
+  std::string ExecutionContextWorker::componentName(RTObjectStateMachine& comp)
+  {
+    return comp.getInstanceName();
+  }
+
+  /*!
+   * @if jp
+   * @brief 必要であれば依存グラフを再構築する
+   * @else
+   * @brief Rebuild the dependency graph if needed
+   * @endif
+   */
+  void ExecutionContextWorker::
+  updateExecutionGraph(const std::shared_ptr<const CompList>& comps)
+  {
+    m_active.clear();
+    for (auto & comp : *comps)
+      {
+        m_active.push_back(comp->isCurrentState(RTC::ACTIVE_STATE));
+      }
+    std::shared_ptr<const Connections> conns(std::atomic_load(&m_connections));
+    // If the connections changed since they were obtained, all the
+    // components are ordered until the refresher obtains them again.
+    bool current(true);
+    if (m_groups.empty())
+      {
+        uint64_t generation(RTC::PortBase::connectionGeneration());
+        current = conns && conns->generation == generation;
+        if (!current) { requestRefresh(generation); }
+      }
+    if (comps == m_graphComps && m_active == m_graphActive &&
+        conns == m_graphConnections && current == m_graphCurrent) { return; }
+
+    RTC_DEBUG(("Rebuilding the execution graph of %d components.",
+               comps->size()));
+    m_graph = m_groups.empty() ?
+      connectionGraph(*comps, current ? conns.get() : nullptr) :
+      groupGraph(*comps);
+    m_graphComps = comps;
+    m_graphActive = m_active;
+    m_graphConnections = conns;
+    m_graphCurrent = current;
+  }
+
+  /*!
+   * @if jp
+   * @brief データポートの接続を取得する
+   *
+   * 参加しているコンポーネントのデータポートの接続先を CORBA 経由で取
+   * 得し、m_connections を置き換える。EC のスレッドからは呼び出さない。
+   * 取得を始めた時の接続の変更回数を記録するため、取得中の変更は次の
+   * 取得で反映される。
+   *
+   * @else
+   * @brief Obtain the data port connections
+   *
+   * Obtains the peers of the data ports of the participating components
+   * via CORBA and replaces m_connections. Not called from the EC thread.
+   * The number of the connection changes is recorded when it starts,
+   * so a change during it is reflected by the next one.
+   *
+   * @endif
+   */
+  void ExecutionContextWorker::refreshConnections()
+  {
+    RTC_TRACE(("refreshConnections()"));
+    // an older result must not replace a newer one
+    std::lock_guard<std::mutex> guard(m_connectionsMutex);
+    std::shared_ptr<Connections> conns(std::make_shared<Connections>());
+    conns->generation = RTC::PortBase::connectionGeneration();
+    conns->comps = components();
+    const CompList& comps(*conns->comps);
+    conns->peers.resize(comps.size());
+    conns->known.assign(comps.size(), true);
+
+    for (size_t i(0); i < comps.size(); ++i)
+      {
+        try
+          {
+            RTC::LightweightRTObject_var lwobj = comps[i]->getRTObject();
+            RTC::RTObject_var rtobj = RTC::RTObject::_narrow(lwobj);
+            if (CORBA::is_nil(rtobj)) { continue; }
+            RTC::PortServiceList_var ports = rtobj->get_ports();
+            for (CORBA::ULong p(0); p < ports->length(); ++p)
+              {
+                RTC::PortProfile_var pp = ports[p]->get_port_profile();
+                coil::Properties prop;
+                NVUtil::copyToProperties(prop, pp->properties);
+                if (prop["port.port_type"] != "DataOutPort" &&
+                    prop["port.port_type"] != "DataInPort") { continue; }
+
+                for (CORBA::ULong c(0); c < pp->connector_profiles.length(); ++c)
+                  {
+                    const RTC::PortServiceList& peers =
+                      pp->connector_profiles[c].ports;
+                    for (CORBA::ULong q(0); q < peers.length(); ++q)
+                      {
+                        if (peers[q]->_is_equivalent(ports[p])) { continue; }
+                        RTC::PortProfile_var peer = peers[q]->get_port_profile();
+                        for (size_t j(0); j < comps.size(); ++j)
+                          {
+                            if (j != i && comps[j]->isEquivalent(peer->owner))
+                              {
+                                conns->peers[i].push_back(comps[j].get());
+                              }
+                          }
+                      }
+                  }
+              }
+          }
+        catch (CORBA::SystemException&)
+          {
+            RTC_WARN(("Connections of a component are unknown. "
+                      "It is executed sequentially."));
+            conns->known[i] = false;
+          }
+      }
+    std::atomic_store(&m_connections,
+                      std::shared_ptr<const Connections>(std::move(conns)));
+  }
+
+  /*!
+   * @if jp
+   * @brief 接続の再取得を要求する
+   *
+   * EC のスレッドから呼び出す。同じ変更回数に対しては一度だけ要求す
+   * る。
+   *
+   * @param generation 現在の接続の変更回数
+   *
+   * @else
+   * @brief Request to obtain the connections again
+   *
+   * Called from the EC thread. It is requested only once for the same
+   * number of the connection changes.
+   *
+   * @param generation Current number of the connection changes
+   *
+   * @endif
+   */
+  void ExecutionContextWorker::requestRefresh(uint64_t generation)
+  {
+    if (generation == m_requestedGeneration) { return; }
+    m_requestedGeneration = generation;
+    {
+      std::lock_guard<std::mutex> guard(m_refresherMutex);
+      m_refreshRequested = true;
+    }
+    m_refresherCond.notify_one();
+  }
+
+  /*!
+   * @if jp
+   * @brief 接続を取得するスレッドを開始する
+   * @else
+   * @brief Start the thread obtaining the connections
+   * @endif
+   */
+  void ExecutionContextWorker::startRefresher()
+  {
+    if (m_refresher.joinable()) { return; }
+    {
+      std::lock_guard<std::mutex> guard(m_refresherMutex);
+      m_refresherExit = false;
+      m_refreshRequested = false;
+    }
+    m_refresher = std::thread([this] { refresherSvc(); });
+  }
+
+  /*!
+   * @if jp
+   * @brief 接続を取得するスレッドを停止する
+   * @else
+   * @brief Stop the thread obtaining the connections
+   * @endif
+   */
+  void ExecutionContextWorker::stopRefresher()
+  {
+    if (!m_refresher.joinable()) { return; }
+    {
+      std::lock_guard<std::mutex> guard(m_refresherMutex);
+      m_refresherExit = true;
+    }
+    m_refresherCond.notify_all();
+    m_refresher.join();
+  }
+
+  void ExecutionContextWorker::refresherSvc()
+  {
+    std::unique_lock<std::mutex> guard(m_refresherMutex);
+    for (;;)
+      {
+        m_refresherCond.wait(guard, [this]
+                             { return m_refreshRequested || m_refresherExit; });
+        if (m_refresherExit) { return; }
+        m_refreshRequested = false;
+        guard.unlock();
+        refreshConnections();
+        guard.lock();
+      }
+  }
+
+  namespace
+  {
+    void addEdge(ParallelExecutor::Graph& graph, size_t from, size_t to)
+    {
+      std::vector<size_t>& succ(graph.successors[from]);
+      if (std::find(succ.begin(), succ.end(), to) != succ.end()) { return; }
+      succ.push_back(to);
+      ++graph.indegree[to];
+    }
+  } // namespace
+
+  /*!
+   * @if jp
+   * @brief データポートの接続から依存グラフを作成する
+   *
+   * refreshConnections() が取得した接続を用いる。接続されたコンポーネ
+   * ントの組は、接続の向きによらず参加者リストで前にあるものから後に
+   * あるものへの依存とするため、グラフは巡回しない。接続の情報がない
+   * コンポーネント、及びともにプロセス外のコンポーネントの組は順に実
+   * 行する。CORBA の呼び出しは行わない。
+   *
+   * @param comps 参加者リスト
+   * @param conns 最新の接続。古い場合は nullptr
+   *
+   * @else
+   * @brief Build the dependency graph from the data port connections
+   *
+   * Uses the connections obtained by refreshConnections(). A pair of
+   * connected components is a dependency from the earlier one to the
+   * later one in the participant list, whichever the direction of the
+   * connection is, so the graph has no cycle. A component without the
+   * connection information, and a pair of components both outside
+   * this process, are ordered. No CORBA call is made.
+   *
+   * @param comps Participant list
+   * @param conns Current connections, or nullptr if they are stale
+   *
+   * @endif
+   */
+  ParallelExecutor::Graph
+  ExecutionContextWorker::connectionGraph(const CompList& comps,
+                                          const Connections* conns)
+  {
+    ParallelExecutor::Graph graph;
+    graph.successors.resize(comps.size());
+    graph.indegree.assign(comps.size(), 0);
+
+    std::map<const RTObjectStateMachine*, size_t> index;
+    for (size_t i(0); i < comps.size(); ++i) { index[comps[i].get()] = i; }
+
+    std::vector<bool> known(comps.size(), false);
+    if (conns != nullptr)
+      {
+        for (size_t k(0); k < conns->comps->size(); ++k)
+          {
+            auto i = index.find((*conns->comps)[k].get());
+            if (i == index.end() || !conns->known[k]) { continue; }
+            known[i->second] = true;
+            for (auto peer : conns->peers[k])
+              {
+                auto j = index.find(peer);
+                if (j == index.end()) { continue; }
+                addEdge(graph, std::min(i->second, j->second),
+                        std::max(i->second, j->second));
+              }
+          }
+      }
+
+    // The connections of a component outside this process change
+    // without PortBase::connectionGeneration() unless the other end is
+    // in this process.
+    std::vector<bool> local(comps.size());
+    for (size_t i(0); i < comps.size(); ++i)
+      {
+        local[i] = comps[i]->getServant() != nullptr;
+      }
+    for (size_t i(0); i < comps.size(); ++i)
+      {
+        for (size_t j(i + 1); j < comps.size(); ++j)
+          {
+            if (!known[i] || !known[j] || (!local[i] && !local[j]))
+              {
+                addEdge(graph, i, j);
+              }
+          }
+      }
+    return graph;
+  }
+
+  /*!
+   * @if jp
+   * @brief グループの指定から依存グラフを作成する
+   * @else
+   * @brief Build the dependency graph from the groups
+   * @endif
+   */
+  ParallelExecutor::Graph
+  ExecutionContextWorker::groupGraph(const CompList& comps)
+  {
+    std::vector<std::vector<size_t>> stages(m_groups.size());
+    for (size_t i(0); i < comps.size(); ++i)
+      {
+        std::string name(componentName(*comps[i]));
+        size_t s(0);
+        for (; s < m_groups.size(); ++s)
+          {
+            if (std::find(m_groups[s].begin(), m_groups[s].end(), name)
+                != m_groups[s].end()) { break; }
+          }
+        if (s == m_groups.size())
+          {
+            // not in the groups: executed alone after the groups
+            stages.emplace_back(1, i);
+          }
+        else
+          {
+            stages[s].push_back(i);
+          }
+      }
+
+    ParallelExecutor::Graph graph;
+    graph.successors.resize(comps.size());
+    graph.indegree.assign(comps.size(), 0);
+    const std::vector<size_t>* prev(nullptr);
+    for (auto& stage : stages)
+      {
+        if (stage.empty()) { continue; }
+        if (prev != nullptr)
+          {
+            for (auto from : *prev)
+              {
+                for (auto to : stage) { addEdge(graph, from, to); }
+              }
+          }
+        prev = &stage;
+      }
+    return graph;
+  }
+
 } // namespace RTC_impl
 
@@ -23,6 +23,15 @@
 
 #include <rtm/idl/RTCSkel.h>
 #include <rtm/SystemLogger.h>
+#include <rtm/ParallelExecutor.h>
+#include <coil/stringutil.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
 #include <vector>
 
 #define NUM_OF_LIFECYCLESTATE 4
@@ -94,6 +103,7 @@ namespace RTC_impl
    *   - void invokeWorkerPreDo();
    *   - void invokeWorkerDo();
    *   - void invokeWorkerPostDo();
+   *   - void invokeComponent(RTObjectStateMachine& comp);
    *
    * @since 1.2
    *
@@ -554,6 +564,193 @@ namespace RTC_impl
      */
     void updateComponentList();
 
+    /*!
+     * @if jp
+     * @brief コンポーネントの並列実行を設定する
+     *
+     * threads が2以上の場合、invokeWorkerDo() は互いに依存しないコン
+     * ポーネントを threads 個のスレッドで並列に実行し、すべての終了を
+     * 待ってから戻る。依存関係は以下のように決める。
+     *
+     * - groups が空の場合、データポートで接続された2つのコンポーネン
+     *   トは、接続の向きによらず参加者リストの順に実行される。順次実行
+     *   と同じデータの流れとなる。
+     * - groups を指定した場合、各グループのコンポーネントは並列に、グ
+     *   ループは順に実行される。指定のないコンポーネントは最後に1つずつ
+     *   実行される。
+     *
+     * 依存関係は参加者リスト、Active なコンポーネントの組、または接続
+     * の情報が変わった時に再構築される。接続の情報はコンポーネントの
+     * アクティブ化の際にはアクティブ化を要求したスレッドで、ポートの接
+     * 続が変わった際には専用のスレッドで取得する。取得し直すまでの間、
+     * 及び接続の情報がないコンポーネントは他のすべてのコンポーネントと
+     * 順に実行される。ともにこのプロセス外にあるコンポーネントの組も、
+     * その間の接続の変化を検知できないため順に実行される。
+     *
+     * @param threads EC のスレッドを含むスレッド数。1以下で順次実行。
+     * @param groups インスタンス名のグループのリスト
+     *
+     * @else
+     * @brief Set the parallel execution of the components
+     *
+     * If threads is 2 or more, invokeWorkerDo() executes the components
+     * independent of each other in parallel on threads threads and
+     * returns after all of them finish. The dependency is decided as
+     * follows.
+     *
+     * - If groups is empty, two components connected by data ports are
+     *   executed in the order of the participant list, whichever the
+     *   direction of the connection is. The data flow is the same as
+     *   the sequential execution.
+     * - If groups is given, the components of each group are executed
+     *   in parallel and the groups one after another. The components
+     *   not in groups are executed one by one at the end.
+     *
+     * The dependency is rebuilt when the participant list, the set of
+     * the active components or the connection information changes. The
+     * connection information is obtained on the thread requesting the
+     * activation when a component is activated, and on a dedicated
+     * thread when the port connections change. Until it is obtained
+     * again, and for a component without the connection information,
+     * the components are ordered with all the other components. A pair
+     * of components both outside this process is ordered as well, since
+     * the changes of the connections between them are not noticed.
+     *
+     * @param threads Number of threads including the EC thread. 1 or
+     *                less means sequential execution.
+     * @param groups List of the groups of instance names
+     *
+     * @endif
+     */
+    void setParallelExecution(size_t threads,
+                              const std::vector<coil::vstring>& groups);
+
+    /*!
+     * @if jp
+     * @brief 実行時間の統計を有効または無効にする
+     *
+     * 有効な場合、invokeWorkerDo() は Active なコンポーネントの実行時間
+     * と、setDeadline() で設定した時刻までに終了しなかった回数を各コン
+     * ポーネントの ComponentStatistics に記録する。
+     *
+     * @param enable true: 有効、false: 無効
+     *
+     * @else
+     * @brief Enable or disable the execution time statistics
+     *
+     * If enabled, invokeWorkerDo() records the execution time of the
+     * active components and the number of times they did not finish by
+     * the time set by setDeadline() into ComponentStatistics of each
+     * component.
+     *
+     * @param enable true: enabled, false: disabled
+     *
+     * @endif
+     */
+    void setStatistics(bool enable);
+
+    /*!
+     * @if jp
+     * @brief 次の invokeWorkerDo() の期限を設定する
+     * @else
+     * @brief Set the deadline of the next invokeWorkerDo()
+     * @endif
+     */
+    void setDeadline(std::chrono::steady_clock::time_point deadline);
+
+    /*!
+     * @if jp
+     * @brief コンポーネントごとの統計値を取得する
+     *
+     * 各コンポーネントについて <インスタンス名>.exec_time.* と
+     * <インスタンス名>.deadline_miss を設定する。リリースの遅れが記録さ
+     * れている場合は <インスタンス名>.release_jitter.* と
+     * <インスタンス名>.skipped も設定する。
+     *
+     * @param prop 設定するプロパティ
+     *
+     * @else
+     * @brief Get the statistics of each component
+     *
+     * Sets <instance name>.exec_time.* and <instance name>.deadline_miss
+     * for each component, and also <instance name>.release_jitter.* and
+     * <instance name>.skipped if the release delays are recorded.
+     *
+     * @param prop Properties to be set
+     *
+     * @endif
+     */
+    void getStatistics(coil::Properties& prop);
+
+    using CompList =
+      std::vector<std::shared_ptr<RTC_impl::RTObjectStateMachine>>;
+    using CompItr = CompList::iterator;
+
+    /*!
+     * @if jp
+     * @brief コンポーネントの参加者リストのスナップショットを取得する
+     *
+     * スナップショットは変更されず、参加者の追加・削除時には新しいスナッ
+     * プショットに置き換えられる。取得したスナップショットとその要素は
+     * 参照している間は解放されないため、ロックを保持せずに走査できる。
+     *
+     * @else
+     * @brief Get the snapshot of the participant list
+     *
+     * A snapshot is never modified and is replaced by a new one when a
+     * participant is added or removed. The snapshot and its elements are
+     * kept alive while referenced, so it can be iterated without a lock.
+     *
+     * @endif
+     */
+    std::shared_ptr<const CompList> components() const;
+
+    /*!
+     * @if jp
+     * @brief コンポーネントを1つ実行する
+     *
+     * 指定したコンポーネントの workerPreDo(), workerDo(), workerPostDo()
+     * を順に呼び出す。統計が有効な場合は invokeWorkerDo() と同様に実行
+     * 時間と期限超過を記録する。コンポーネントごとに異なる周期で実行す
+     * る EC が使用する。
+     *
+     * @param comp コンポーネント
+     *
+     * @else
+     * @brief Execute one component
+     *
+     * Calls workerPreDo(), workerDo() and workerPostDo() of the given
+     * component in order. If the statistics are enabled, the execution
+     * time and the deadline miss are recorded as invokeWorkerDo() does.
+     * Used by the ECs executing each component at its own period.
+     *
+     * @param comp Component
+     *
+     * @endif
+     */
+    void invokeComponent(RTObjectStateMachine& comp);
+
+    /*!
+     * @if jp
+     * @brief コンポーネントのインスタンス名を取得する
+     *
+     * 参加時に取得したインスタンス名を返す。CORBA の呼び出しは行わない
+     * ため、EC のスレッドから呼び出せる。
+     *
+     * @return インスタンス名。取得できない場合は空文字列。
+     *
+     * @else
+     * @brief Get the instance name of a component
+     *
+     * Returns the instance name obtained when it joined. No CORBA call
+     * is made, so it can be called from the EC thread.
+     *
+     * @return Instance name. An empty string if it is unknown.
+     *
+     * @endif
+     */
+    std::string componentName(RTObjectStateMachine& comp);
+
     //------------------------------------------------------------
     // member variables
   protected:
@@ -577,22 +774,90 @@ namespace RTC_impl
      * true: running, false: stopped
      * @endif
      */
-    bool m_running{false};
+    std::atomic<bool> m_running{false};
 
     /*!
      * @if jp
      * @brief コンポーネントの参加者リスト
+     *
+     * std::atomic_load() / std::atomic_store() でアクセスする。置き換え
+     * は m_mutex を保持して行う。
+     *
      * @else
      * @brief List of the participating component
+     *
+     * Accessed by std::atomic_load() / std::atomic_store(). It is
+     * replaced with m_mutex held.
+     *
      * @endif
      */
-    std::vector<RTC_impl::RTObjectStateMachine*> m_comps;
+    std::shared_ptr<const CompList> m_comps{std::make_shared<const CompList>()};
     mutable std::mutex m_mutex;
     std::vector<RTC_impl::RTObjectStateMachine*> m_addedComps;
     mutable std::mutex m_addedMutex;
     std::vector<RTC_impl::RTObjectStateMachine*> m_removedComps;
     mutable std::mutex m_removedMutex;
-    using CompItr = std::vector<RTC_impl::RTObjectStateMachine*>::iterator;
+    std::atomic<bool> m_listChanged{false};
+
+  private:
+    /*!
+     * @if jp
+     * @brief データポートで接続されたコンポーネントの組
+     *
+     * peers[i] は comps[i] とデータポートで接続されている comps の要素。
+     * 接続を取得できなかったコンポーネントは known[i] が false。
+     * generation は取得を始めた時の PortBase::connectionGeneration()。
+     *
+     * @else
+     * @brief Pairs of the components connected by data ports
+     *
+     * peers[i] is the elements of comps connected to comps[i] by data
+     * ports. known[i] is false for a component whose connections could
+     * not be obtained. generation is PortBase::connectionGeneration()
+     * when they started to be obtained.
+     *
+     * @endif
+     */
+    struct Connections
+    {
+      std::shared_ptr<const CompList> comps;
+      std::vector<std::vector<const RTObjectStateMachine*>> peers;
+      std::vector<bool> known;
+      uint64_t generation{0};
+    };
+
+    void refreshConnections();
+    void requestRefresh(uint64_t generation);
+    void startRefresher();
+    void stopRefresher();
+    void refresherSvc();
+    void doComponents(const std::shared_ptr<const CompList>& comps);
+    void updateExecutionGraph(const std::shared_ptr<const CompList>& comps);
+    ParallelExecutor::Graph connectionGraph(const CompList& comps,
+                                            const Connections* conns);
+    ParallelExecutor::Graph groupGraph(const CompList& comps);
+    void execute(RTObjectStateMachine& comp);
+
+    ParallelExecutor m_executor;
+    std::vector<coil::vstring> m_groups;
+    ParallelExecutor::Graph m_graph;
+    std::shared_ptr<const CompList> m_graphComps;
+    std::shared_ptr<const Connections> m_graphConnections;
+    // Accessed by std::atomic_load() / std::atomic_store()
+    std::shared_ptr<const Connections> m_connections;
+    // Serializes refreshConnections() on the calling threads
+    std::mutex m_connectionsMutex;
+    bool m_graphCurrent{false};
+    uint64_t m_requestedGeneration{UINT64_MAX};
+    std::thread m_refresher;
+    std::mutex m_refresherMutex;
+    std::condition_variable m_refresherCond;
+    bool m_refreshRequested{false};
+    bool m_refresherExit{false};
+    std::vector<bool> m_graphActive;
+    std::vector<bool> m_active;
+    bool m_statistics{false};
+    std::chrono::steady_clock::time_point m_deadline;
 
   };  // class PeriodicExecutionContext
 } // namespace RTC_impl
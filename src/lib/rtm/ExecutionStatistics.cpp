@@ -0,0 +1,61 @@
+// -*- C++ -*-
+/*!
+ * @file ExecutionStatistics.cpp
+ * @brief Execution time statistics of ExecutionContext
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <rtm/ExecutionStatistics.h>
+#include <coil/stringutil.h>
+
+namespace RTC_impl
+{
+  /*!
+   * @if jp
+   * @brief 統計値をプロパティに設定する
+   * @else
+   * @brief Set the statistics to the properties
+   * @endif
+   */
+  void ExecutionStatistics::getProperties(coil::Properties& prop) const
+  {
+    prop.setProperty("cycles", coil::otos(cycles.load(std::memory_order_relaxed)));
+    prop.setProperty("overrun", coil::otos(overrun.load(std::memory_order_relaxed)));
+    setSummary(prop, "pre_do", pre_do);
+    setSummary(prop, "exec_time", exec_time);
+    setSummary(prop, "post_do", post_do);
+    setSummary(prop, "sleep_error", sleep_error);
+  }
+
+  /*!
+   * @if jp
+   * @brief ヒストグラムの統計値をプロパティに設定する
+   * @else
+   * @brief Set the statistics of a histogram to the properties
+   * @endif
+   */
+  void ExecutionStatistics::setSummary(coil::Properties& prop,
+                                       const std::string& key,
+                                       const coil::LatencyHistogram& hist)
+  {
+    coil::LatencyHistogram::Summary summary(hist.getSummary());
+    coil::Properties& node(prop.getNode(key));
+    node.setProperty("count", coil::otos(summary.count));
+    node.setProperty("min", coil::otos(summary.min.count()));
+    node.setProperty("mean", coil::otos(summary.mean.count()));
+    node.setProperty("p50", coil::otos(summary.p50.count()));
+    node.setProperty("p90", coil::otos(summary.p90.count()));
+    node.setProperty("p99", coil::otos(summary.p99.count()));
+    node.setProperty("p999", coil::otos(summary.p999.count()));
+    node.setProperty("max", coil::otos(summary.max.count()));
+  }
+} // namespace RTC_impl
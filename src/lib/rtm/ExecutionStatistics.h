@@ -0,0 +1,138 @@
+// -*- C++ -*-
+/*!
+ * @file ExecutionStatistics.h
+ * @brief Execution time statistics of ExecutionContext
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_EXECUTIONSTATISTICS_H
+#define RTC_EXECUTIONSTATISTICS_H
+
+#include <coil/LatencyHistogram.h>
+#include <coil/Properties.h>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace RTC_impl
+{
+  /*!
+   * @if jp
+   * @brief コンポーネントごとの実行時間の統計
+   *
+   * exec_time は Active 状態の workerDo() (on_execute() など) の実行時
+   * 間、deadline_miss は実行ステージの開始から1周期以内に終了しなかっ
+   * た回数。
+   * release_jitter と skipped はコンポーネントごとの周期でリリースす
+   * る EC が記録する、リリース時刻から実行開始までの遅れと、前回の
+   * リリースを実行する前に次のリリースが来て飛ばした回数。
+   *
+   * @else
+   * @brief Execution time statistics of a component
+   *
+   * exec_time is the execution time of workerDo() (on_execute() and so
+   * on) in the active state, and deadline_miss is the number of times
+   * it did not finish within one period from the start of the execution
+   * stage.
+   * release_jitter and skipped are recorded by the ECs releasing each
+   * component at its own period: the delay from the release time to
+   * the start of the execution, and the number of the releases skipped
+   * because the next one came before they were executed.
+   *
+   * @endif
+   */
+  struct ComponentStatistics
+  {
+    coil::LatencyHistogram exec_time;
+    std::atomic<uint64_t> deadline_miss{0};
+    coil::LatencyHistogram release_jitter;
+    std::atomic<uint64_t> skipped{0};
+  };
+
+  /*!
+   * @if jp
+   * @brief ExecutionContext の周期ごとの統計
+   *
+   * pre_do, exec_time, post_do はそれぞれ invokeWorkerPreDo(),
+   * invokeWorkerDo(), invokeWorkerPostDo() の実行時間、sleep_error は
+   * 指定した待ち時間に対する実際の待ち時間の超過分、overrun は実行時間
+   * が周期以上となり待たなかった回数。
+   *
+   * @else
+   * @brief Per-cycle statistics of ExecutionContext
+   *
+   * pre_do, exec_time and post_do are the execution times of
+   * invokeWorkerPreDo(), invokeWorkerDo() and invokeWorkerPostDo(),
+   * sleep_error is the excess of the actual sleep over the requested
+   * one, and overrun is the number of the cycles not sleeping because
+   * they took the period or more.
+   *
+   * @endif
+   */
+  struct ExecutionStatistics
+  {
+    coil::LatencyHistogram pre_do;
+    coil::LatencyHistogram exec_time;
+    coil::LatencyHistogram post_do;
+    coil::LatencyHistogram sleep_error;
+    std::atomic<uint64_t> cycles{0};
+    std::atomic<uint64_t> overrun{0};
+
+    /*!
+     * @if jp
+     * @brief 統計値をプロパティに設定する
+     *
+     * cycles, overrun と各ヒストグラムの統計値を設定する。
+     *
+     * @param prop 設定するプロパティ
+     *
+     * @else
+     * @brief Set the statistics to the properties
+     *
+     * Sets cycles, overrun and the statistics of the histograms.
+     *
+     * @param prop Properties to be set
+     *
+     * @endif
+     */
+    void getProperties(coil::Properties& prop) const;
+
+    /*!
+     * @if jp
+     * @brief ヒストグラムの統計値をプロパティに設定する
+     *
+     * key.count, key.min, key.mean, key.p50, key.p90, key.p99, key.p999,
+     * key.max を設定する。時間の単位はナノ秒。
+     *
+     * @param prop 設定するプロパティ
+     * @param key キー
+     * @param hist ヒストグラム
+     *
+     * @else
+     * @brief Set the statistics of a histogram to the properties
+     *
+     * Sets key.count, key.min, key.mean, key.p50, key.p90, key.p99,
+     * key.p999 and key.max. The times are in nanoseconds.
+     *
+     * @param prop Properties to be set
+     * @param key Key
+     * @param hist Histogram
+     *
+     * @endif
+     */
+    static void setSummary(coil::Properties& prop, const std::string& key,
+                           const coil::LatencyHistogram& hist);
+  };
+} // namespace RTC_impl
+
+#endif  // RTC_EXECUTIONSTATISTICS_H
@@ -24,6 +24,7 @@
 
 // Threads
 #include <rtm/DefaultPeriodicTask.h>
+#include <rtm/PooledPeriodicTask.h>
 
 // default Publishers
 #include <rtm/PublisherFlush.h>
@@ -63,6 +64,11 @@
 #include <ext/sdo/observer/ComponentObserverConsumer.h>
 #endif
 
+// Compression codecs
+#ifdef ENABLE_ZLIB
+#include <rtm/ZlibCodec.h>
+#endif
+
 namespace RTM
 {
   void FactoryInit()
@@ -75,6 +81,7 @@ namespace RTM
 
     // Threads
     DefaultPeriodicTaskInit();
+    PooledPeriodicTaskInit();
 
     // Publishers
     PublisherFlushInit();
@@ -114,5 +121,10 @@ namespace RTM
 #ifdef ENABLE_OBSERVER
     ComponentObserverConsumerInit();
 #endif
+
+    // Compression codecs
+#ifdef ENABLE_ZLIB
+    ZlibCodecInit();
+#endif
   }
 } // namespace RTM
@@ -0,0 +1,246 @@
+// -*- C++ -*-
+/*!
+ * @file FixedLayoutSerializer.h
+ * @brief Serializer copying fixed layout data types with memcpy
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_FIXEDLAYOUTSERIALIZER_H
+#define RTC_FIXEDLAYOUTSERIALIZER_H
+
+#include <rtm/CORBA_CdrMemoryStream.h>
+#include <rtm/ByteData.h>
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @brief 固定レイアウトのデータ型の判定
+   *
+   * トリビアルコピー可能かつ標準レイアウトの型 (文字列やシーケンスを
+   * 含まない IDL の構造体) の場合に true となる。
+   *
+   * @else
+   * @brief Detection of fixed layout data types
+   *
+   * True for the trivially copyable standard layout types, that is the
+   * IDL structs without strings and sequences.
+   *
+   * @endif
+   */
+  template <class DataType>
+  struct is_fixed_layout
+    : std::integral_constant<bool,
+                             std::is_trivially_copyable<DataType>::value &&
+                             std::is_standard_layout<DataType>::value>
+  {
+  };
+
+  /*!
+   * @if jp
+   * @class FixedLayoutSerializer
+   * @brief 固定レイアウトのデータ型の memcpy シリアライザ
+   *
+   * マーシャリング方式 "fixed_cdr" として登録される。出力は CDR と同じ
+   * であるが、メモリ上のレイアウトが CDR のレイアウトと一致するデータ型
+   * は、コネクタのエンディアンがホストと同じ場合に1回の memcpy でシリ
+   * アライズ、デシリアライズする。レイアウトの一致はデータ型ごとに最初
+   * の1回だけ検査する。一致しない場合とエンディアンが異なる場合はバイト
+   * 順の変換を含む CDR のシリアライズを行う。
+   *
+   * @else
+   * @class FixedLayoutSerializer
+   * @brief memcpy serializer of fixed layout data types
+   *
+   * Registered as the marshaling type "fixed_cdr". The output is the
+   * same as CDR, but the data types whose memory layout matches the CDR
+   * layout are serialized and deserialized with a single memcpy when the
+   * endian of the connector is the same as the host. The layout is
+   * checked only once for each data type. If it does not match or the
+   * endian differs, the CDR serialization with the byte swapping is
+   * used.
+   *
+   * @endif
+   */
+  template <class DataType>
+  class FixedLayoutSerializer : public CORBA_CdrSerializer<DataType>
+  {
+    static_assert(is_fixed_layout<DataType>::value,
+                  "FixedLayoutSerializer requires a fixed layout data type");
+  public:
+    FixedLayoutSerializer() = default;
+    ~FixedLayoutSerializer() override = default;
+
+    void writeData(const unsigned char* buffer, unsigned long length) override
+    {
+      if (m_copy)
+        {
+          m_data.writeData(buffer, length);
+        }
+      else
+        {
+          CORBA_CdrSerializer<DataType>::writeData(buffer, length);
+        }
+    }
+
+    void readData(unsigned char* buffer, unsigned long length) const override
+    {
+      if (m_copy)
+        {
+          m_data.readData(buffer, length);
+        }
+      else
+        {
+          CORBA_CdrSerializer<DataType>::readData(buffer, length);
+        }
+    }
+
+    unsigned long getDataLength() const override
+    {
+      if (m_copy)
+        {
+          return m_data.getDataLength();
+        }
+      return CORBA_CdrSerializer<DataType>::getDataLength();
+    }
+
+    bool serialize(const DataType& data) override
+    {
+      if (m_copy)
+        {
+          m_data.writeData(reinterpret_cast<const unsigned char*>(&data),
+                           cdrLength());
+          return true;
+        }
+      return CORBA_CdrSerializer<DataType>::serialize(data);
+    }
+
+    bool deserialize(DataType& data) override
+    {
+      if (m_copy)
+        {
+          if (m_data.getDataLength() != cdrLength()) { return false; }
+          m_data.readData(reinterpret_cast<unsigned char*>(&data),
+                          cdrLength());
+          return true;
+        }
+      return CORBA_CdrSerializer<DataType>::deserialize(data);
+    }
+
+    /*!
+     * @if jp
+     * @brief エンディアンの設定
+     *
+     * ホストと同じエンディアンで、レイアウトが一致する場合に memcpy を
+     * 用いる。
+     *
+     * @param little_endian リトルエンディアン(True)、ビッグエンディアン(False)
+     *
+     * @else
+     * @brief Set the endian
+     *
+     * memcpy is used if the endian is the same as the host and the
+     * layout matches.
+     *
+     * @param little_endian little endian(True), big endian(False)
+     *
+     * @endif
+     */
+    void isLittleEndian(bool little_endian) override
+    {
+      CORBA_CdrSerializer<DataType>::isLittleEndian(little_endian);
+      m_copy = little_endian == hostIsLittleEndian() && cdrLength() != 0;
+    }
+
+    /*!
+     * @if jp
+     * @brief メモリ上のレイアウトが CDR と一致する場合の CDR の長さ
+     *
+     * 一致しない場合は 0 を返す。
+     *
+     * @else
+     * @brief Length of CDR if the memory layout matches CDR
+     *
+     * Returns 0 if it does not match.
+     *
+     * @endif
+     */
+    static unsigned long cdrLength()
+    {
+      static const unsigned long length(checkLayout());
+      return length;
+    }
+
+  private:
+    static bool hostIsLittleEndian()
+    {
+      const uint16_t one(1);
+      return *reinterpret_cast<const unsigned char*>(&one) == 1;
+    }
+
+    /*
+     * A byte pattern is copied into a value-initialized object and also
+     * decoded by CDR into another one. Both are the same only if every
+     * byte of the CDR data lands on the same offset in memory and the
+     * CDR padding is the trailing padding of the struct, so a mismatch
+     * just disables the copy.
+     */
+    static unsigned long checkLayout()
+    {
+      CORBA_CdrSerializer<DataType> out;
+      out.isLittleEndian(hostIsLittleEndian());
+      DataType zero{};
+      if (!out.serialize(zero)) { return 0; }
+      unsigned long length(out.getDataLength());
+      if (length == 0 || length > sizeof(DataType)) { return 0; }
+
+      std::vector<unsigned char> pattern(length);
+      for (unsigned long i(0); i < length; ++i)
+        {
+          pattern[i] = static_cast<unsigned char>(i % 251 + 1);
+        }
+      DataType copied{};
+      memcpy(&copied, pattern.data(), length);
+
+      CORBA_CdrSerializer<DataType> in;
+      in.isLittleEndian(hostIsLittleEndian());
+      in.writeData(pattern.data(), length);
+      DataType decoded{};
+      if (!in.deserialize(decoded)) { return 0; }
+      if (memcmp(&copied, &decoded, sizeof(DataType)) != 0) { return 0; }
+      return length;
+    }
+
+    ByteData m_data;
+    bool m_copy{false};
+  };
+
+  template <class DataType>
+  typename std::enable_if<is_fixed_layout<DataType>::value>::type
+  FixedLayoutSerializerInit()
+  {
+    addSerializer<DataType, FixedLayoutSerializer<DataType>>("fixed_cdr");
+  }
+
+  template <class DataType>
+  typename std::enable_if<!is_fixed_layout<DataType>::value>::type
+  FixedLayoutSerializerInit()
+  {
+  }
+} // namespace RTC
+
+#endif  // RTC_FIXEDLAYOUTSERIALIZER_H
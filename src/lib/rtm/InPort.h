@@ -21,7 +21,10 @@
 #define RTC_INPORT_H
 
 #include <coil/OS.h>
+#include <atomic>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 #include <rtm/RTC.h>
 #include <rtm/Typename.h>
@@ -29,9 +32,13 @@
 #include <rtm/CdrBufferBase.h>
 #include <rtm/PortCallback.h>
 #include <rtm/InPortConnector.h>
+#include <rtm/DataView.h>
 #include <rtm/Timestamp.h>
 #include <rtm/DirectInPortBase.h>
+#include <rtm/DirectChannel.h>
 #include <rtm/CORBA_CdrMemoryStream.h>
+#include <rtm/FixedLayoutSerializer.h>
+#include <rtm/CompressionSerializer.h>
 #include <rtm/DataTypeUtil.h>
 
 
@@ -128,6 +135,8 @@ namespace RTC
       m_directport = this;
 
       CdrMemoryStreamInit<DataType>();
+      FixedLayoutSerializerInit<DataType>();
+      CompressionSerializerInit<DataType>();
 
       std::string marshaling_types{coil::eraseBlank(coil::flatten(
         getSerializerList<DataType>()))};
@@ -282,6 +291,11 @@ namespace RTC
             return true;
           }
       }
+      if (hasDirectData())
+        {
+          RTC_DEBUG(("isNew() returns true because of direct write."));
+          return true;
+        }
       size_t r(0);
       {
         std::lock_guard<std::mutex> guard(m_connectorsMutex);
@@ -394,7 +408,7 @@ namespace RTC
     bool isEmpty() override
     {
       RTC_TRACE(("isEmpty()"));
-      if (m_directNewData == true) { return false; }
+      if (m_directNewData == true || hasDirectData()) { return false; }
       size_t r(0);
 
       {
@@ -427,6 +441,39 @@ namespace RTC
       m_directNewData = true;
     }
 
+    /*!
+     * @if jp
+     * @brief ダイレクト接続のチャネルを開く
+     *
+     * 接続ごとにチャネルを作成する。OutPort からの書き込みと read() は
+     * m_valueMutex を取得せず、チャネルを介してデータを受け渡す。
+     *
+     * @param prop バッファのプロパティ
+     * @return チャネル
+     *
+     * @else
+     * @brief Open a channel of a direct connection
+     *
+     * A channel is created for each connection. Writing from the OutPort
+     * and read() pass the data through the channel without taking
+     * m_valueMutex.
+     *
+     * @param prop Buffer properties
+     * @return Channel
+     *
+     * @endif
+     */
+    std::shared_ptr<DirectChannelBase>
+    openDirectChannel(const coil::Properties& prop) override
+    {
+      std::shared_ptr<DirectChannel<DataType>>
+        channel(std::make_shared<DirectChannel<DataType>>(prop));
+      std::lock_guard<std::mutex> guard(m_directChannelsMutex);
+      m_directChannels.emplace_back(channel);
+      m_directChannelCount = m_directChannels.size();
+      return channel;
+    }
+
     /*!
      * @if jp
      *
@@ -525,6 +572,17 @@ namespace RTC
             m_directNewData = false;
             return true;
           }
+        // m_value is also written by DirectInPortBase::write()
+        if (readDirectChannel(m_value))
+          {
+            RTC_DEBUG(("Direct data transfer"));
+            if (m_OnReadConvert != nullptr)
+              {
+                m_value = (*m_OnReadConvert)(m_value);
+                RTC_DEBUG(("OnReadConvert for direct data called"));
+              }
+            return true;
+          }
       }
       // 2) network connection
       
@@ -605,6 +663,168 @@ namespace RTC
       return false;
     }
 
+    /*!
+     * @if jp
+     *
+     * @brief シリアライズ済みデータの借用
+     *
+     * InPort のバッファから次のデータをデシリアライズせずに取り出す。
+     * data はバッファが保持する領域を共有するため、データはコピーされ
+     * ない。大きなデータの一部のみを参照する場合や、コンポーネント側で
+     * その場でデシリアライズする場合に用いる。データの形式は接続の
+     * marshaling_type、エンディアンは serializer.cdr.endian に従う。
+     * バインドされた変数、OnRead/OnReadConvert コールバック、ダイレク
+     * ト接続は扱わない。
+     *
+     * @param data 取り出したデータを格納する ByteData
+     * @param name 読み込むコネクタ名。空の場合は先頭のコネクタ
+     *
+     * @return 読み込み結果(読み込み成功:true, 読み込み失敗:false)
+     *
+     * @else
+     *
+     * @brief Borrow serialized data
+     *
+     * Takes the next data from the buffer of the InPort without
+     * deserializing it. The data shares the area held by the buffer, so
+     * no data is copied. This is for referring to a part of large data
+     * or for deserializing in place in the component. The format of the
+     * data follows the marshaling_type of the connection and its endian
+     * follows serializer.cdr.endian. The bound variable, the
+     * OnRead/OnReadConvert callbacks and direct connections are not
+     * handled.
+     *
+     * @param data ByteData to store the taken data
+     * @param name Name of the connector to read. The first connector
+     *             if empty
+     *
+     * @return Reading result (Successful:true, Failed:false)
+     *
+     * @endif
+     */
+    bool borrow(ByteData& data, const std::string& name = "")
+    {
+      RTC_TRACE(("borrow()"));
+      std::lock_guard<std::mutex> guard(m_connectorsMutex);
+      if (m_connectors.empty())
+        {
+          RTC_DEBUG(("no connectors"));
+          return false;
+        }
+      InPortConnector* connector = nullptr;
+      if (name.empty())
+        {
+          connector = m_connectors[0];
+        }
+      else
+        {
+          for(auto & con : m_connectors)
+            {
+              if (std::string(con->name()) == name)
+                {
+                  connector = con;
+                }
+            }
+        }
+      if (connector == nullptr)
+        {
+          RTC_ERROR(("can not find %s", name.c_str()));
+          return false;
+        }
+      DataPortStatus ret = connector->borrow(data);
+      m_status[0] = ret;
+      return ret == DataPortStatus::PORT_OK;
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief データをビューに読み出す
+     *
+     * InPort のバッファから次のデータを読み出し、view に格納する。
+     * TimedOctetSeq や CameraImage など CORBA_Util::deserializeView() が
+     * 特殊化されたデータ型で接続の marshaling_type が cdr の場合、シーケ
+     * ンスのメンバ (pixels, raw_data など) はコピーされず、バッファが保持
+     * するシリアライズ済みデータを参照する。ビューは次に同じビューへ読み
+     * 出すまで有効である。それ以外のデータ型は通常どおりデシリアライズさ
+     * れる。バインドされた変数と OnRead/OnReadConvert コールバックは扱わ
+     * ない。
+     *
+     * @param view データを格納するビュー
+     * @param name 読み込むコネクタ名。空の場合は先頭のコネクタ
+     *
+     * @return 読み込み結果(読み込み成功:true, 読み込み失敗:false)
+     *
+     * @else
+     *
+     * @brief Read data into a view
+     *
+     * Reads the next data from the buffer of the InPort into the view.
+     * For the data types specializing CORBA_Util::deserializeView(), such
+     * as TimedOctetSeq and CameraImage, with the marshaling_type cdr, the
+     * sequence members (pixels, raw_data and so on) are not copied and
+     * refer to the serialized data held by the buffer. The view is valid
+     * until the next read into the same view. The other data types are
+     * deserialized as usual. The bound variable and the
+     * OnRead/OnReadConvert callbacks are not handled.
+     *
+     * @param view View to store the data
+     * @param name Name of the connector to read. The first connector
+     *             if empty
+     *
+     * @return Reading result (Successful:true, Failed:false)
+     *
+     * @endif
+     */
+    bool readView(DataView<DataType>& view, const std::string& name = "")
+    {
+      RTC_TRACE(("readView()"));
+      {
+        std::lock_guard<std::mutex> guard(m_valueMutex);
+        if (m_directNewData == true)
+          {
+            RTC_DEBUG(("Direct data transfer"));
+            CORBA_Util::copyData<DataType>(view.reset(), m_value);
+            m_directNewData = false;
+            return true;
+          }
+      }
+      if (hasDirectData() && readDirectChannel(view.reset()))
+        {
+          RTC_DEBUG(("Direct data transfer"));
+          return true;
+        }
+      std::lock_guard<std::mutex> guard(m_connectorsMutex);
+      if (m_connectors.empty())
+        {
+          RTC_DEBUG(("no connectors"));
+          return false;
+        }
+      InPortConnector* connector = nullptr;
+      if (name.empty())
+        {
+          connector = m_connectors[0];
+        }
+      else
+        {
+          for(auto & con : m_connectors)
+            {
+              if (std::string(con->name()) == name)
+                {
+                  connector = con;
+                }
+            }
+        }
+      if (connector == nullptr)
+        {
+          RTC_ERROR(("can not find %s", name.c_str()));
+          return false;
+        }
+      DataPortStatus ret = connector->readView(view);
+      m_status[0] = ret;
+      return ret == DataPortStatus::PORT_OK;
+    }
+
 
     /*!
      * @if jp
@@ -804,6 +1024,66 @@ namespace RTC
       delete m_listeners;
       m_listeners = new ConnectorListenersT<DataType>();
     }
+
+    /*!
+     * @if jp
+     * @brief ダイレクト接続のチャネルに未読のデータがあるか
+     * @else
+     * @brief Whether the channels of direct connections have unread data
+     * @endif
+     */
+    bool hasDirectData()
+    {
+      if (m_directChannelCount == 0) { return false; }
+      std::lock_guard<std::mutex> guard(m_directChannelsMutex);
+      for (auto& channel : m_directChannels)
+        {
+          if (channel->isNew()) { return true; }
+        }
+      return false;
+    }
+
+    /*!
+     * @if jp
+     * @brief ダイレクト接続のチャネルから読み出す
+     *
+     * 未読のデータがある最初のチャネルから読み出す。閉じられ、未読のデー
+     * タがなくなったチャネルは取り除く。
+     *
+     * @param data 読み出したデータを格納する変数
+     * @return 読み出した場合 true
+     *
+     * @else
+     * @brief Read from the channels of direct connections
+     *
+     * Reads from the first channel having unread data. The channels
+     * closed and having no unread data are removed.
+     *
+     * @param data Variable to store the data
+     * @return true if the data was read
+     *
+     * @endif
+     */
+    bool readDirectChannel(DataType& data)
+    {
+      if (m_directChannelCount == 0) { return false; }
+      std::lock_guard<std::mutex> guard(m_directChannelsMutex);
+      bool ret(false);
+      auto it(m_directChannels.begin());
+      while (it != m_directChannels.end())
+        {
+          if (!ret && (*it)->read(data)) { ret = true; }
+          // isClosed() first, since the data is written before closing
+          if ((*it)->isClosed() && !(*it)->isNew())
+            {
+              it = m_directChannels.erase(it);
+              continue;
+            }
+          ++it;
+        }
+      m_directChannelCount = m_directChannels.size();
+      return ret;
+    }
   private:
     std::string m_typename;
     /*!
@@ -825,6 +1105,28 @@ namespace RTC
     DataType& m_value;
     mutable std::mutex m_valueMutex;
 
+    /*!
+     * @if jp
+     * @brief ダイレクト接続のチャネル
+     *
+     * 接続・切断と読み出しの間でのみ m_directChannelsMutex で保護する。
+     * OutPort からの書き込みはロックを取得しない。ダイレクト接続がない
+     * 場合、読み出しは m_directChannelCount を見てロックを取得しない。
+     *
+     * @else
+     * @brief Channels of direct connections
+     *
+     * Guarded by m_directChannelsMutex only between connection,
+     * disconnection and reading. Writing from the OutPort takes no
+     * lock. Without direct connections, reading checks
+     * m_directChannelCount and takes no lock.
+     *
+     * @endif
+     */
+    std::vector<std::shared_ptr<DirectChannel<DataType>>> m_directChannels;
+    std::mutex m_directChannelsMutex;
+    std::atomic<size_t> m_directChannelCount{0};
+
     /*!
      * @if jp
      * @brief OnRead コールバックファンクタへのポインタ
@@ -615,6 +615,11 @@ namespace RTC
             return RTC::RTC_ERROR;
           }
         conn->setEndian(littleEndian);
+        if (!conn->subscribeInterface(cprof.properties))
+          {
+            RTC_ERROR(("the provider rejected the connector profile"));
+            return RTC::RTC_ERROR;
+          }
 
         RTC_DEBUG(("subscribeInterfaces() successfully finished."));
         return RTC::RTC_OK;
@@ -35,6 +35,10 @@ namespace RTC
     : rtclog("InPortConnector"), m_profile(info),
       m_listeners(listeners), m_buffer(buffer), m_littleEndian(true), m_outPortListeners(nullptr), m_directOutPort(nullptr), m_marshaling_type("cdr"), m_cdr(nullptr)
   {
+    if (m_profile.settings().latency_trace)
+      {
+        m_traceEntry = LatencyTraceCollector::instance().entry(m_profile);
+      }
   }
 
   /*!
@@ -174,9 +178,44 @@ namespace RTC
       return BufferStatus::OK;
   }
 
+  /*!
+   * @if jp
+   * @brief 複数のデータをバッファに書き込む
+   * @else
+   * @brief Write multiple data into the buffer
+   * @endif
+   */
+  BufferStatus InPortConnector::writeBatch(ByteData* data, size_t n,
+                                           size_t& written)
+  {
+    for (written = 0; written < n; ++written)
+      {
+        BufferStatus ret(write(data[written]));
+        if (ret != BufferStatus::OK) { return ret; }
+      }
+    return BufferStatus::OK;
+  }
+
+  /*!
+   * @if jp
+   * @brief シリアライズ済みデータの借用
+   * @else
+   * @brief Borrow serialized data
+   * @endif
+   */
+  DataPortStatus InPortConnector::borrow(ByteData& /*data*/)
+  {
+      return DataPortStatus::PRECONDITION_NOT_MET;
+  }
+
   void InPortConnector::unsubscribeInterface(const coil::Properties& /*prop*/)
   {
 
   }
 
+  bool InPortConnector::subscribeInterface(const SDOPackage::NVList& /*prop*/)
+  {
+    return true;
+  }
+
 } // namespace RTC
@@ -25,6 +25,10 @@
 #include <rtm/DirectOutPortBase.h>
 #include <rtm/PortBase.h>
 #include <rtm/ByteData.h>
+#include <rtm/LatencyTrace.h>
+#include <rtm/DataView.h>
+#include <rtm/CdrViewReader.h>
+#include <rtm/DataTypeUtil.h>
 
 
 namespace RTC
@@ -198,6 +202,31 @@ namespace RTC
      */
     virtual DataPortStatus read(ByteDataStreamBase* data) = 0;
 
+    /*!
+     * @if jp
+     * @brief シリアライズ済みデータの借用
+     *
+     * 次のデータをデシリアライズせずに取り出す。ByteData はバッファが
+     * 保持する領域を共有するため、データはコピーされない。デフォルト
+     * 実装は PRECONDITION_NOT_MET を返す。
+     *
+     * @param data 取り出したデータを格納する ByteData
+     * @return ReturnCode
+     *
+     * @else
+     * @brief Borrow serialized data
+     *
+     * Takes the next data without deserializing it. The ByteData shares
+     * the area held by the buffer, so the data is not copied. The
+     * default implementation returns PRECONDITION_NOT_MET.
+     *
+     * @param data ByteData to store the taken data
+     * @return ReturnCode
+     *
+     * @endif
+     */
+    virtual DataPortStatus borrow(ByteData& data);
+
 
     /*!
      * @if jp
@@ -220,11 +249,7 @@ namespace RTC
     template<class DataType>
     DataPortStatus read(DataType& data)
     {
-      if(m_cdr == nullptr)
-      {
-        m_cdr = createSerializer<DataType>(m_marshaling_type);
-      }
-      ::RTC::ByteDataStream<DataType> *cdr = dynamic_cast<::RTC::ByteDataStream<DataType>*>(m_cdr);
+      ::RTC::ByteDataStream<DataType> *cdr = getSerializer<DataType>();
         
         if (!cdr)
         {
@@ -237,9 +262,89 @@ namespace RTC
         {
             cdr->deserialize(data);
         }
+        if (m_traced)
+        {
+            m_traced = false;
+            m_traceTimes[LatencyTrace::READ] = LatencyTrace::now();
+            LatencyTraceCollector::instance().record(m_traceEntry, m_traceTimes);
+        }
         return ret;
     }
 
+    /*!
+     * @if jp
+     * @brief データをビューに読み出す
+     *
+     * borrow() で取り出したデータをビューが共有して保持し、marshaling_type
+     * が cdr の場合は CORBA_Util::deserializeView() でシーケンスのメンバ
+     * がデータを参照するようにデシリアライズする。対応していないデータ型
+     * とマーシャリング方式では、シリアライザでデシリアライズする。ダイレ
+     * クト接続ではピアの OutPort のデータをコピーする。
+     *
+     * @param view データを格納するビュー
+     * @return ReturnCode
+     *
+     * @else
+     * @brief Read data into a view
+     *
+     * The view shares the data taken by borrow(). If the marshaling_type
+     * is cdr, the data is deserialized by CORBA_Util::deserializeView()
+     * so that the sequence members refer to the data. For the data types
+     * and the marshaling types not supported, it is deserialized by the
+     * serializer. For direct connections the data of the peer OutPort is
+     * copied.
+     *
+     * @param view View to store the data
+     * @return ReturnCode
+     *
+     * @endif
+     */
+    template<class DataType>
+    DataPortStatus readView(DataView<DataType>& view)
+    {
+      if (getDirectData(view.reset()))
+        {
+          return DataPortStatus::PORT_OK;
+        }
+      DataPortStatus ret = borrow(view.m_data);
+      if (ret != DataPortStatus::PORT_OK)
+        {
+          return ret;
+        }
+      // the trailer of the latency trace is not deserialized
+      unsigned long length(view.m_data.getDataLength()
+                           - (m_traced ? LatencyTrace::TRAILER_SIZE : 0));
+      if (m_marshaling_type == "cdr")
+        {
+          CdrViewReader reader(view.m_data.getBuffer(), length,
+                               isLittleEndian());
+          view.m_aliased = true;
+          if (!CORBA_Util::deserializeView(reader, *view.m_value))
+            {
+              view.reset();
+            }
+        }
+      if (!view.m_aliased)
+        {
+          ::RTC::ByteDataStream<DataType> *cdr = getSerializer<DataType>();
+          if (!cdr)
+            {
+              RTC_ERROR(("Can not find Marshalizer: %s", m_marshaling_type.c_str()));
+              return DataPortStatus::PORT_ERROR;
+            }
+          cdr->isLittleEndian(isLittleEndian());
+          cdr->writeData(view.m_data.getBuffer(), length);
+          cdr->deserialize(*view.m_value);
+        }
+      if (m_traced)
+        {
+          m_traced = false;
+          m_traceTimes[LatencyTrace::READ] = LatencyTrace::now();
+          LatencyTraceCollector::instance().record(m_traceEntry, m_traceTimes);
+        }
+      return ret;
+    }
+
     /*!
      * @if jp
      * @brief endianタイプ設定
@@ -280,6 +385,35 @@ namespace RTC
 
     virtual BufferStatus write(ByteData &cdr);
 
+    /*!
+     * @if jp
+     * @brief 複数のデータをバッファに書き込む
+     *
+     * data[0] から順に n 個のデータを書き込み、失敗した時点で終了する。
+     * デフォルト実装は write() を n 回呼び出す。
+     *
+     * @param data 書き込むデータの配列
+     * @param n データの数
+     * @param written 書き込んだデータの数
+     * @return すべて書き込めた場合は OK、それ以外は失敗した書き込みの
+     *         戻り値
+     *
+     * @else
+     * @brief Write multiple data into the buffer
+     *
+     * Writes n data from data[0] in order, and stops at the first
+     * failure. The default implementation calls write() n times.
+     *
+     * @param data Array of the data to write
+     * @param n Number of the data
+     * @param written Number of the data written
+     * @return OK if all the data were written, otherwise the return
+     *         value of the failed write
+     *
+     * @endif
+     */
+    virtual BufferStatus writeBatch(ByteData* data, size_t n, size_t& written);
+
 
     /*!
     * @if jp
@@ -380,7 +514,64 @@ namespace RTC
      */
     virtual void unsubscribeInterface(const coil::Properties& prop);
 
+    /*!
+     * @if jp
+     * @brief 接続先の Interface 情報を受け取る
+     *
+     * InPortBase::subscribeInterfaces() から呼ばれる。
+     *
+     * @param prop コネクタプロファイルのプロパティ
+     * @return true: 正常終了
+     *
+     * @else
+     * @brief Receive the interface information of the peer
+     *
+     * Called from InPortBase::subscribeInterfaces().
+     *
+     * @param prop Properties of the connector profile
+     * @return true: normal return
+     *
+     * @endif
+     */
+    virtual bool subscribeInterface(const SDOPackage::NVList& prop);
+
   protected:
+    /*!
+     * @if jp
+     * @brief シリアライザの取得
+     *
+     * 初回はシリアライザを生成し、コネクタプロファイルのプロパティと
+     * 転送統計を設定する。
+     *
+     * @return シリアライザ。marshaling_type のシリアライザがない場合は
+     *         nullptr
+     *
+     * @else
+     * @brief Get the serializer
+     *
+     * Creates the serializer at the first call, and sets the properties
+     * of the connector profile and the transfer statistics.
+     *
+     * @return Serializer, or nullptr if there is no serializer of the
+     *         marshaling_type
+     *
+     * @endif
+     */
+    template<class DataType>
+    ::RTC::ByteDataStream<DataType>* getSerializer()
+    {
+      if (m_cdr == nullptr)
+        {
+          m_cdr = createSerializer<DataType>(m_marshaling_type);
+          if (m_cdr != nullptr)
+            {
+              m_cdr->init(m_profile.properties);
+              m_cdr->setStatistics(&m_profile.statistics());
+            }
+        }
+      return dynamic_cast<::RTC::ByteDataStream<DataType>*>(m_cdr);
+    }
+
     /*!
      * @if jp
      * @brief ロガーストリーム
@@ -438,6 +629,25 @@ namespace RTC
      */
     PortBase* m_directOutPort;
 
+    /*!
+     * @if jp
+     * @brief 読み出したデータの遅延時間トレース
+     *
+     * m_traced が true の場合、m_traceTimes は最後に読み出したデータの
+     * BUFFER_READ までの時刻を保持する。
+     *
+     * @else
+     * @brief Latency trace of the read data
+     *
+     * If m_traced is true, m_traceTimes holds the times up to
+     * BUFFER_READ of the last read data.
+     *
+     * @endif
+     */
+    LatencyTrace::Times m_traceTimes{};
+    bool m_traced{false};
+    LatencyTraceCollector::Entry* m_traceEntry{nullptr};
+
     /*!
      * @if jp
      * @brief シリアライザの名前
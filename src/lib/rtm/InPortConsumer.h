@@ -24,6 +24,8 @@
 #include <rtm/DataPortStatus.h>
 #include <rtm/ByteData.h>
 
+#include <vector>
+
 namespace coil
 {
   class Properties;
@@ -145,6 +147,100 @@ namespace RTC
      */
     virtual DataPortStatus put(ByteData& data) = 0;
 
+    /*!
+     * @if jp
+     * @brief 複数のデータの送信
+     *
+     * data[0] から順にデータを送信し、失敗した時点で終了する。まとめ
+     * て送信できないコンシューマのために、デフォルト実装は put() を繰り
+     * 返す。
+     *
+     * @param data 送信するデータの配列
+     * @param sent 接続先が受け取ったデータの数
+     * @return すべて送信できた場合は PORT_OK、それ以外のリターンコード
+     *         は put() と同じ
+     *
+     * @else
+     * @brief Send multiple data
+     *
+     * Sends the data from data[0] in order, and stops at the first
+     * failure. The default implementation repeats put() for consumers
+     * that cannot send them together.
+     *
+     * @param data Array of the data to send
+     * @param sent Number of the data accepted by the destination
+     * @return PORT_OK if all the data were sent, otherwise the same
+     *         return codes as put()
+     *
+     * @endif
+     */
+    virtual DataPortStatus putBatch(const std::vector<ByteData*>& data,
+                                    size_t& sent)
+    {
+      for (sent = 0; sent < data.size(); ++sent)
+        {
+          DataPortStatus ret(put(*data[sent]));
+          if (ret != DataPortStatus::PORT_OK) { return ret; }
+        }
+      return DataPortStatus::PORT_OK;
+    }
+
+    /*!
+     * @if jp
+     * @brief 送信バッファの貸し出し
+     *
+     * シリアライズ済みのデータを直接書き込める送信領域を返す。書き込
+     * んだデータは commit() で送信する。送信領域を貸し出せないコンシュー
+     * マは nullptr を返す。デフォルト実装は nullptr を返す。
+     *
+     * @param size 書き込むデータのサイズ
+     * @return 送信領域。貸し出せない場合は nullptr
+     *
+     * @else
+     * @brief Loan a send buffer
+     *
+     * Returns a send area into which serialized data can be written
+     * directly. The written data is sent by commit(). Consumers that
+     * cannot loan a send area return nullptr, which is the default.
+     *
+     * @param size Size of the data to be written
+     * @return Send area, or nullptr if it cannot be loaned
+     *
+     * @endif
+     */
+    virtual unsigned char* loan(unsigned long  /*size*/)
+    {
+      return nullptr;
+    }
+
+    /*!
+     * @if jp
+     * @brief 貸し出した送信バッファのデータ送信
+     *
+     * loan() で貸し出した送信領域に書き込んだデータを送信する。リター
+     * ンコードは put() と同じ。デフォルト実装は PRECONDITION_NOT_MET
+     * を返す。
+     *
+     * @param length 書き込んだデータのサイズ
+     * @return リターンコード
+     *
+     * @else
+     * @brief Send the data in the loaned send buffer
+     *
+     * Sends the data written into the send area loaned by loan(). The
+     * return codes are the same as put(). The default implementation
+     * returns PRECONDITION_NOT_MET.
+     *
+     * @param length Size of the written data
+     * @return Return code
+     *
+     * @endif
+     */
+    virtual DataPortStatus commit(unsigned long  /*length*/)
+    {
+      return DataPortStatus::PRECONDITION_NOT_MET;
+    }
+
     /*!
      * @if jp
      * @brief InterfaceProfile情報を公開する
@@ -89,6 +89,96 @@ namespace RTC
       }
   }
 
+#ifndef ORB_IS_RTORB
+  /*!
+   * @if jp
+   * @brief 複数のデータの送信
+   * @else
+   * @brief Send multiple data
+   * @endif
+   */
+  DataPortStatus InPortCorbaCdrConsumer::
+  putBatch(const std::vector<ByteData*>& data, size_t& sent)
+  {
+    RTC_PARANOID(("putBatch(%d)", data.size()));
+    if (!m_batchChecked)
+      {
+        // Checked only once, since _narrow() may call _is_a() remotely.
+        m_batchChecked = true;
+        try
+          {
+            m_batch = ::OpenRTM::InPortCdrBatch::_narrow(_ptr());
+          }
+        catch (...)
+          {
+            m_batch = ::OpenRTM::InPortCdrBatch::_nil();
+          }
+        RTC_DEBUG(("put_batch() is %s.",
+                   CORBA::is_nil(m_batch) ? "not supported" : "supported"));
+      }
+    if (CORBA::is_nil(m_batch))
+      {
+        return InPortConsumer::putBatch(data, sent);
+      }
+
+    sent = 0;
+    CORBA::ULong n(static_cast<CORBA::ULong>(data.size()));
+    m_batchData.length(n);
+    for (CORBA::ULong i(0); i < n; ++i)
+      {
+        CORBA::ULong len(static_cast<CORBA::ULong>(data[i]->getDataLength()));
+        m_batchData[i].length(len);
+        data[i]->readData(static_cast<unsigned char*>(m_batchData[i].get_buffer()), len);
+      }
+    try
+      {
+        CORBA::ULong written(0);
+        DataPortStatus ret(convertReturnCode(m_batch->put_batch(m_batchData,
+                                                                written)));
+        sent = written;
+        return ret;
+      }
+    catch (...)
+      {
+        return DataPortStatus::CONNECTION_LOST;
+      }
+  }
+#endif  // ORB_IS_RTORB
+
+  /*!
+   * @if jp
+   * @brief オブジェクトの設定
+   *
+   * put_batch() に対応しているかどうかは次の putBatch() で確認する。
+   *
+   * @else
+   * @brief Set the object
+   *
+   * Whether put_batch() is supported is checked in the next putBatch().
+   *
+   * @endif
+   */
+  bool InPortCorbaCdrConsumer::setObject(CORBA::Object_ptr obj)
+  {
+    m_batch = ::OpenRTM::InPortCdrBatch::_nil();
+    m_batchChecked = false;
+    return CorbaConsumer< ::OpenRTM::InPortCdr >::setObject(obj);
+  }
+
+  /*!
+   * @if jp
+   * @brief オブジェクトの解放
+   * @else
+   * @brief Release the object
+   * @endif
+   */
+  void InPortCorbaCdrConsumer::releaseObject()
+  {
+    m_batch = ::OpenRTM::InPortCdrBatch::_nil();
+    m_batchChecked = false;
+    CorbaConsumer< ::OpenRTM::InPortCdr >::releaseObject();
+  }
+
   /*!
    * @if jp
    * @brief InterfaceProfile情報を公開する
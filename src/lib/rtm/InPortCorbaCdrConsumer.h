@@ -155,6 +155,32 @@ namespace RTC
      */
     DataPortStatus put(ByteData& data) override;
 
+#ifndef ORB_IS_RTORB
+    /*!
+     * @if jp
+     * @brief 複数のデータの送信
+     *
+     * 接続先が OpenRTM::InPortCdrBatch を実装している場合、
+     * put_batch() で1回の呼び出しにまとめて送信する。実装していない場
+     * 合は put() を繰り返す。
+     *
+     * @else
+     * @brief Send multiple data
+     *
+     * If the destination implements OpenRTM::InPortCdrBatch, the data
+     * are sent together in one put_batch() call. Otherwise put() is
+     * repeated.
+     *
+     * @endif
+     */
+    DataPortStatus putBatch(const std::vector<ByteData*>& data,
+                            size_t& sent) override;
+#endif  // ORB_IS_RTORB
+
+    bool setObject(CORBA::Object_ptr obj) override;
+
+    void releaseObject() override;
+
     /*!
      * @if jp
      * @brief InterfaceProfile情報を公開する
@@ -297,6 +323,9 @@ namespace RTC
     mutable Logger rtclog;
     coil::Properties m_properties;
     ::OpenRTM::CdrData m_data;
+    ::OpenRTM::InPortCdrBatch_var m_batch;
+    bool m_batchChecked{false};
+    ::OpenRTM::CdrDataSeq m_batchData;
   };
 } // namespace RTC
 
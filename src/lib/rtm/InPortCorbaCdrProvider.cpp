@@ -181,6 +181,51 @@ namespace RTC
     return convertReturn(ret, m_cdr);
   }
 
+  /*!
+   * @if jp
+   * @brief バッファに複数のデータを書き込む
+   * @else
+   * @brief Write multiple data into the buffer
+   * @endif
+   */
+  ::OpenRTM::PortStatus
+  InPortCorbaCdrProvider::put_batch(const ::OpenRTM::CdrDataSeq& data,
+                                    CORBA::ULong_out written)
+  {
+    RTC_PARANOID(("InPortCorbaCdrProvider::put_batch(%d)", data.length()));
+    written = 0;
+
+    CORBA::ULong n(data.length());
+    if (m_batch.size() < n) { m_batch.resize(n); }
+    bool endian_type(m_connector != nullptr && m_connector->isLittleEndian());
+    for (CORBA::ULong i(0); i < n; ++i)
+      {
+        m_batch[i].isLittleEndian(endian_type);
+#ifndef ORB_IS_RTORB
+        m_batch[i].writeData(const_cast<unsigned char*>(data[i].get_buffer()),
+                             static_cast<CORBA::ULong>(data[i].length()));
+#else
+        m_batch[i].writeData(reinterpret_cast<unsigned char*>(&data[i][0]),
+                             static_cast<CORBA::ULong>(data[i].length()));
+#endif
+      }
+
+    if (m_connector == nullptr)
+      {
+        for (CORBA::ULong i(0); i < n; ++i) { onReceiverError(m_batch[i]); }
+        return ::OpenRTM::PORT_ERROR;
+      }
+
+    for (CORBA::ULong i(0); i < n; ++i) { onReceived(m_batch[i]); }
+    size_t count(0);
+    BufferStatus ret(m_connector->writeBatch(m_batch.data(), n, count));
+    written = static_cast<CORBA::ULong>(count);
+
+    for (size_t i(0); i < count; ++i) { onBufferWrite(m_batch[i]); }
+    if (count == n) { return ::OpenRTM::PORT_OK; }
+    return convertReturn(ret, m_batch[count]);
+  }
+
   /*!
    * @if jp
    * @brief リターンコード変換
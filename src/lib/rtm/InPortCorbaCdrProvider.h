@@ -28,6 +28,8 @@
 #include <rtm/ConnectorListener.h>
 #include <rtm/ConnectorBase.h>
 
+#include <vector>
+
 namespace RTC
 {
   /*!
@@ -56,7 +58,7 @@ namespace RTC
    */
   class InPortCorbaCdrProvider
     : public InPortProvider,
-      public virtual POA_OpenRTM::InPortCdr,
+      public virtual POA_OpenRTM::InPortCdrBatch,
       public virtual PortableServer::RefCountServantBase
   {
   public:
@@ -242,6 +244,30 @@ namespace RTC
      */
     ::OpenRTM::PortStatus put(const ::OpenRTM::CdrData& data) override;
 
+    /*!
+     * @if jp
+     * @brief [CORBA interface] バッファに複数のデータを書き込む
+     *
+     * 受信したデータをまとめてバッファに書き込む。リスナへの通知はデー
+     * タごとに行う。
+     *
+     * @param data 書込対象データの列
+     * @param written 書き込んだデータの数
+     *
+     * @else
+     * @brief [CORBA interface] Write multiple data into the buffer
+     *
+     * Writes the received data together into the buffer. The listeners
+     * are notified for each data.
+     *
+     * @param data Sequence of the target data for writing
+     * @param written Number of the data written
+     *
+     * @endif
+     */
+    ::OpenRTM::PortStatus put_batch(const ::OpenRTM::CdrDataSeq& data,
+                                    CORBA::ULong_out written) override;
+
   private:
     /*!
      * @if jp
@@ -370,6 +396,7 @@ namespace RTC
     ConnectorInfo m_profile;
     InPortConnector* m_connector{nullptr};
     ByteData m_cdr;
+    std::vector<ByteData> m_batch;
 
   };  // class InPortCorbaCdrProvider
 } // namespace RTC
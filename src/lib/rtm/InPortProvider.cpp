@@ -86,6 +86,18 @@ namespace RTC
     return true;
   }
 
+  /*!
+   * @if jp
+   * @brief 接続先の Interface 情報を受け取る
+   * @else
+   * @brief Receive the interface information of the peer
+   * @endif
+   */
+  bool InPortProvider::subscribeInterface(const SDOPackage::NVList& /*prop*/)
+  {
+    return true;
+  }
+
   //----------------------------------------------------------------------
   // protected functions
 
@@ -389,6 +389,34 @@ namespace RTC
      */
     virtual bool publishInterface(SDOPackage::NVList& prop);
 
+    /*!
+     * @if jp
+     * @brief 接続先の Interface 情報を受け取る
+     *
+     * 接続の全てのポートが Interface 情報を公開した後に呼ばれる。
+     * publishInterface() の時点ではまだ含まれていない OutPort 側の情報
+     * (dataport.outport.stream_id など) を必要とするプロバイダがオーバー
+     * ライドする。デフォルト実装は何もしない。
+     *
+     * @param prop 接続のプロパティ
+     * @return true: 正常終了
+     *
+     * @else
+     * @brief Receive the interface information of the peer
+     *
+     * Called after all the ports of the connection have published their
+     * interface information. Overridden by the providers needing the
+     * information of the OutPort side which publishInterface() may not
+     * get yet (dataport.outport.stream_id and so on). The default
+     * implementation does nothing.
+     *
+     * @param prop Properties of the connection
+     * @return true: normal return
+     *
+     * @endif
+     */
+    virtual bool subscribeInterface(const SDOPackage::NVList& prop);
+
   protected:
     /*!
      * @if jp
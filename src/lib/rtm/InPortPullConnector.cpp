@@ -88,10 +88,37 @@ namespace RTC
       }
     
     DataPortStatus ret = m_consumer->get(m_data);
+    if (ret == DataPortStatus::PORT_OK)
+      {
+        m_profile.statistics().countReceived(m_data.getDataLength());
+      }
     data->writeData(m_data.getBuffer(), m_data.getDataLength());
     return ret;
   }
 
+  /*!
+   * @if jp
+   * @brief シリアライズ済みデータの借用
+   * @else
+   * @brief Borrow serialized data
+   * @endif
+   */
+  DataPortStatus
+  InPortPullConnector::borrow(ByteData& data)
+  {
+    RTC_TRACE(("InPortPullConnector::borrow()"));
+    if (m_consumer == nullptr)
+      {
+        return DataPortStatus::PORT_ERROR;
+      }
+    DataPortStatus ret = m_consumer->get(data);
+    if (ret == DataPortStatus::PORT_OK)
+      {
+        m_profile.statistics().countReceived(data.getDataLength());
+      }
+    return ret;
+  }
+
   /*!
    * @if jp
    * @brief 接続解除関数
@@ -184,6 +184,23 @@ namespace RTC
      */
     DataPortStatus read(ByteDataStreamBase* data) override;
 
+    /*!
+     * @if jp
+     * @brief シリアライズ済みデータの借用
+     *
+     * @param data 取り出したデータを格納する ByteData
+     * @return ReturnCode
+     *
+     * @else
+     * @brief Borrow serialized data
+     *
+     * @param data ByteData to store the taken data
+     * @return ReturnCode
+     *
+     * @endif
+     */
+    DataPortStatus borrow(ByteData& data) override;
+
     /*!
      * @if jp
      * @brief 接続解除関数
@@ -88,6 +88,28 @@ namespace RTC
   InPortPushConnector::read(ByteDataStreamBase* data)
   {
     RTC_TRACE(("read()"));
+    DataPortStatus ret = borrow(m_data);
+    if (ret != DataPortStatus::PRECONDITION_NOT_MET)
+      {
+        // the trailer of the latency trace is not deserialized
+        data->writeData(m_data.getBuffer(), m_data.getDataLength()
+                        - (m_traced ? LatencyTrace::TRAILER_SIZE : 0));
+      }
+    return ret;
+  }
+
+  /*!
+   * @if jp
+   * @brief シリアライズ済みデータの借用
+   * @else
+   * @brief Borrow serialized data
+   * @endif
+   */
+  DataPortStatus
+  InPortPushConnector::borrow(ByteData& data)
+  {
+    RTC_TRACE(("borrow()"));
+    m_traced = false;
     /*
      * buffer returns
      *   BUFFER_OK
@@ -121,8 +143,7 @@ namespace RTC
         }
     }
     
-    BufferStatus ret = m_buffer->read(m_data);
-    data->writeData(m_data.getBuffer(), m_data.getDataLength());
+    BufferStatus ret = m_buffer->read(data);
 
     if (m_sync_readwrite)
     {
@@ -141,15 +162,15 @@ namespace RTC
     switch (ret)
       {
       case BufferStatus::OK:
-        onBufferRead(m_data);
+        onBufferRead(data);
         return DataPortStatus::PORT_OK;
         break;
       case BufferStatus::EMPTY:
-        onBufferEmpty(m_data);
+        onBufferEmpty(data);
         return DataPortStatus::BUFFER_EMPTY;
         break;
       case BufferStatus::TIMEOUT:
-        onBufferReadTimeout(m_data);
+        onBufferReadTimeout(data);
         return DataPortStatus::BUFFER_TIMEOUT;
         break;
       case BufferStatus::PRECONDITION_NOT_MET:
@@ -233,6 +254,10 @@ namespace RTC
 
   BufferStatus InPortPushConnector::write(ByteData &cdr)
   {
+      if (m_profile.settings().latency_trace)
+      {
+          LatencyTrace::stamp(cdr, LatencyTrace::RECEIVED);
+      }
       if (m_sync_readwrite)
       {
           {
@@ -244,9 +269,16 @@ namespace RTC
           }
       }
 
-      
+      ConnectorStatistics& statistics(m_profile.statistics());
+      statistics.countReceived(cdr.getDataLength());
 
-      BufferStatus ret = m_buffer->write(cdr);
+      BufferWriteInfo info;
+      BufferStatus ret = m_buffer->write(cdr, std::chrono::nanoseconds(-1), info);
+      statistics.countBufferWrite(ret, info);
+      if (ret == BufferStatus::OK)
+      {
+          m_listeners->notifyDataArrival(m_profile);
+      }
 
       if (m_sync_readwrite)
       {
@@ -274,5 +306,52 @@ namespace RTC
       return ret;
   }
 
+  /*!
+   * @if jp
+   * @brief 複数のデータをバッファに書き込む
+   * @else
+   * @brief Write multiple data into the buffer
+   * @endif
+   */
+  BufferStatus InPortPushConnector::writeBatch(ByteData* data, size_t n,
+                                               size_t& written)
+  {
+    if (m_sync_readwrite)
+      {
+        return InPortConnector::writeBatch(data, n, written);
+      }
+
+    ConnectorStatistics& statistics(m_profile.statistics());
+    for (size_t i(0); i < n; ++i)
+      {
+        if (m_profile.settings().latency_trace)
+          {
+            LatencyTrace::stamp(data[i], LatencyTrace::RECEIVED);
+          }
+        statistics.countReceived(data[i].getDataLength());
+      }
+
+    BufferWriteInfo info;
+    BufferStatus ret(m_buffer->writeBatch(data, n, written, info));
+    statistics.countBufferWrite(n, written, info);
+    if (written > 0)
+      {
+        m_listeners->notifyDataArrival(m_profile);
+      }
+    return ret;
+  }
+
+  /*!
+   * @if jp
+   * @brief 接続先の Interface 情報をプロバイダに渡す
+   * @else
+   * @brief Pass the interface information of the peer to the provider
+   * @endif
+   */
+  bool InPortPushConnector::subscribeInterface(const SDOPackage::NVList& prop)
+  {
+    return m_provider == nullptr || m_provider->subscribeInterface(prop);
+  }
+
 } // namespace RTC
 
@@ -178,6 +178,23 @@ namespace RTC
      */
     DataPortStatus read(ByteDataStreamBase* data) override;
 
+    /*!
+     * @if jp
+     * @brief シリアライズ済みデータの借用
+     *
+     * @param data 取り出したデータを格納する ByteData
+     * @return ReturnCode
+     *
+     * @else
+     * @brief Borrow serialized data
+     *
+     * @param data ByteData to store the taken data
+     * @return ReturnCode
+     *
+     * @endif
+     */
+    DataPortStatus borrow(ByteData& data) override;
+
     /*!
      * @if jp
      * @brief 接続解除
@@ -255,6 +272,32 @@ namespace RTC
 
     BufferStatus write(ByteData &cdr) override;
 
+    /*!
+     * @if jp
+     * @brief 複数のデータをバッファに書き込む
+     *
+     * バッファの writeBatch() で一度に書き込む。読み書きを同期する場
+     * 合は write() を繰り返す。
+     *
+     * @else
+     * @brief Write multiple data into the buffer
+     *
+     * Writes them at once by writeBatch() of the buffer. If reads and
+     * writes are synchronized, write() is repeated.
+     *
+     * @endif
+     */
+    BufferStatus writeBatch(ByteData* data, size_t n, size_t& written) override;
+
+    /*!
+     * @if jp
+     * @brief 接続先の Interface 情報をプロバイダに渡す
+     * @else
+     * @brief Pass the interface information of the peer to the provider
+     * @endif
+     */
+    bool subscribeInterface(const SDOPackage::NVList& prop) override;
+
     /*!
      * @if jp
      * @brief 接続確立時にコールバックを呼ぶ
@@ -275,6 +318,12 @@ namespace RTC
     
     inline void onBufferRead(ByteData& data)
     {
+      if (m_profile.settings().latency_trace &&
+          LatencyTrace::extract(data, m_traceTimes))
+        {
+          m_traceTimes[LatencyTrace::BUFFER_READ] = LatencyTrace::now();
+          m_traced = true;
+        }
       m_listeners->notifyIn(ConnectorDataListenerType::ON_BUFFER_READ,
                             m_profile, data);
 
@@ -65,6 +65,18 @@ namespace RTC
     std::string ds = m_properties["shem_default_size"];
     m_memory_size = m_shmem.string_to_MemorySize(ds);
 
+    if (coil::normalize(m_properties.getProperty("shem_protocol", "")) == "ring")
+      {
+        unsigned long length(0);
+        if (!coil::stringTo(length, m_properties["buffer.length"].c_str()) ||
+            length < 2)
+          {
+            length = 8;
+          }
+        m_ring = true;
+        m_shmem.setRingLength(length);
+      }
+
     if (m_properties.hasKey("serializer") == nullptr)
       {
         m_endian = true;
@@ -114,9 +126,64 @@ namespace RTC
         std::lock_guard<std::mutex> guard(m_mutex);
         m_shmem.setEndian(m_endian);
         m_shmem.create_memory(m_memory_size, m_shm_address.c_str());
-        m_shmem.write(data);
+        if (!m_shmem.write(data))
+          {
+            if (!m_ring) { return DataPortStatus::SEND_FULL; }
+            // The ring is full of samples the provider could not hand to
+            // its buffer. Let it drain them once before giving up.
+            DataPortStatus ret(convertReturnCode(_ptr()->put()));
+            if (ret != DataPortStatus::PORT_OK || !m_shmem.write(data))
+              {
+                return DataPortStatus::SEND_FULL;
+              }
+          }
+
+        return notifyPut();
+      }
+    catch (...)
+      {
+        return DataPortStatus::CONNECTION_LOST;
+      }
+  }
+
+  /*!
+  * @if jp
+  * @brief 送信バッファの貸し出し
+  * @else
+  * @brief Loan a send buffer
+  * @endif
+  */
+  unsigned char* InPortSHMConsumer::loan(unsigned long size)
+  {
+    RTC_PARANOID(("loan()"));
+    if (!m_ring) { return nullptr; }
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_shmem.setEndian(m_endian);
+    m_shmem.create_memory(m_memory_size, m_shm_address.c_str());
+    return m_shmem.loan(size);
+  }
 
-        return convertReturnCode(_ptr()->put());
+  /*!
+  * @if jp
+  * @brief 貸し出した送信バッファのデータ送信
+  * @else
+  * @brief Send the data in the loaned send buffer
+  * @endif
+  */
+  DataPortStatus InPortSHMConsumer::commit(unsigned long length)
+  {
+    RTC_PARANOID(("commit()"));
+
+    try
+      {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        if (!m_shmem.commit(length))
+          {
+            return DataPortStatus::PRECONDITION_NOT_MET;
+          }
+
+        return notifyPut();
       }
     catch (...)
       {
@@ -124,6 +191,26 @@ namespace RTC
       }
   }
 
+  /*!
+  * @if jp
+  * @brief 共有メモリへの書き込みを接続先に通知する
+  * @else
+  * @brief Notify the destination of the data in the shared memory
+  * @endif
+  */
+  DataPortStatus InPortSHMConsumer::notifyPut()
+  {
+    DataPortStatus ret(convertReturnCode(_ptr()->put()));
+    // With the ring protocol a sample the provider could not hand to
+    // its buffer stays in the ring and is delivered with the next put().
+    if (m_ring && (ret == DataPortStatus::SEND_FULL ||
+                   ret == DataPortStatus::SEND_TIMEOUT))
+      {
+        return DataPortStatus::PORT_OK;
+      }
+    return ret;
+  }
+
   void InPortSHMConsumer::
   publishInterfaceProfile(SDOPackage::NVList&  /*properties*/)
   {
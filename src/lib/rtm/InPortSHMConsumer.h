@@ -114,8 +114,12 @@ namespace RTC
      * @brief 接続先へのデータ送信
      *
      * 接続先のポートへデータを送信するための純粋仮想関数。
-     * 
-     * 
+     *
+     * リングプロトコルの場合、接続先がバッファに書き込めなかったデータ
+     * はリングに残り、次の put() で InPort に届く。そのため、そのデータ
+     * の遅延は OutPort の書き込み周期1回分増える。リングがフルの場合は
+     * 一度接続先に残りのデータを読み込ませてから書き込みを再試行し、
+     * それでも空きがなければ SEND_FULL を返す。
      *
      * @param data 送信するデータ
      * @return リターンコード
@@ -123,11 +127,57 @@ namespace RTC
      * @else
      * @brief Send data to the destination port
      *
-     * 
+     * With the ring protocol, data the destination could not write into
+     * its buffer stays in the ring and reaches the InPort with the next
+     * put(), so its latency grows by one write period of the OutPort.
+     * If the ring is full, the destination is made to read the remaining
+     * data once and the write is retried, and SEND_FULL is returned if
+     * there is still no free slot.
+     *
+     * @param data Data to send
+     * @return Return code
      *
      * @endif
      */
     DataPortStatus put(ByteData& data) override;
+    /*!
+     * @if jp
+     * @brief 送信バッファの貸し出し
+     *
+     * リングプロトコル (shem_protocol=ring) の場合、共有メモリの空き
+     * スロットを直接貸し出す。
+     *
+     * @param size 書き込むデータのサイズ
+     * @return スロットのデータ領域。貸し出せない場合は nullptr
+     *
+     * @else
+     * @brief Loan a send buffer
+     *
+     * With the ring protocol (shem_protocol=ring) a free slot of the
+     * shared memory is loaned directly.
+     *
+     * @param size Size of the data to be written
+     * @return Data area of the slot, or nullptr if it cannot be loaned
+     *
+     * @endif
+     */
+    unsigned char* loan(unsigned long size) override;
+    /*!
+     * @if jp
+     * @brief 貸し出した送信バッファのデータ送信
+     *
+     * @param length 書き込んだデータのサイズ
+     * @return リターンコード
+     *
+     * @else
+     * @brief Send the data in the loaned send buffer
+     *
+     * @param length Size of the written data
+     * @return Return code
+     *
+     * @endif
+     */
+    DataPortStatus commit(unsigned long length) override;
     /*!
      * @if jp
      * @brief 
@@ -155,6 +205,8 @@ private:
     bool unsubscribeFromIor(const SDOPackage::NVList& properties);
     bool unsubscribeFromRef(const SDOPackage::NVList& properties);
 
+    DataPortStatus notifyPut();
+
 protected:
     static DataPortStatus convertReturnCode(OpenRTM::PortStatus ret);
 
@@ -164,6 +216,7 @@ protected:
    SharedMemoryPort m_shmem;
    int m_memory_size{0};
    bool m_endian{true};
+   bool m_ring{false};
    mutable Logger rtclog{"InPortSHMConsumer"};
   };
 } // namespace RTC
@@ -123,6 +123,10 @@ namespace RTC
     try
     {
       setEndian(endian_type);
+      if (isRingProtocol())
+      {
+        return readRing();
+      }
       read(m_cdr);
 
       RTC_PARANOID(("received data size: %d", m_cdr.getDataLength()));
@@ -141,6 +145,32 @@ namespace RTC
     return convertReturn(ret, m_cdr);
   }
 
+  /*!
+   * @if jp
+   * @brief リングプロトコルの共有メモリから未読データを全て読み込む
+   * @else
+   * @brief Read all unread data from the shared memory of the ring protocol
+   * @endif
+   */
+  ::OpenRTM::PortStatus InPortSHMProvider::readRing()
+  {
+    ::OpenRTM::PortStatus ret(::OpenRTM::PORT_OK);
+    while (hasUnreadData())
+    {
+      read(m_cdr);
+      RTC_PARANOID(("received data size: %d", m_cdr.getDataLength()));
+
+      onReceived(m_cdr);
+      ret = convertReturn(m_connector->write(m_cdr), m_cdr);
+      if (ret != ::OpenRTM::PORT_OK)
+      {
+        break;
+      }
+      advance();
+    }
+    return ret;
+  }
+
   /*!
    * @if jp
    * @brief リターンコード変換
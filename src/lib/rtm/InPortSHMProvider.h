@@ -185,6 +185,29 @@ namespace RTC
     convertReturn(BufferStatus status,
                   ByteData& data);
 
+    /*!
+     * @if jp
+     * @brief リングプロトコルの共有メモリから未読データを全て読み込む
+     *
+     * バッファへの書き込みに失敗したデータは共有メモリに残し、次回の
+     * put() で再度書き込む。その間、そのデータとそれ以降のデータは
+     * InPort に届かない。
+     *
+     * @return 最後に書き込んだデータのリターンコード
+     *
+     * @else
+     * @brief Read all unread data from the shared memory of the ring protocol
+     *
+     * Data that could not be written into the buffer is left in the
+     * shared memory and written again by the next put(). Until then
+     * neither it nor the data after it reaches the InPort.
+     *
+     * @return Return code of the last data written
+     *
+     * @endif
+     */
+    ::OpenRTM::PortStatus readRing();
+
     
     inline void onBufferWrite(ByteData& data)
     {
@@ -0,0 +1,421 @@
+// -*- C++ -*-
+/*!
+ * @file LatencyTrace.cpp
+ * @brief End-to-end latency tracing of data port samples
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <rtm/LatencyTrace.h>
+#include <rtm/ConnectorBase.h>
+#include <rtm/ExecutionStatistics.h>
+
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+  const uint32_t TRACE_MAGIC = 0x52545452;  // "RTTR"
+  const uint32_t TRACE_VERSION = 1;
+
+  // Names of the intervals ending at each stage, the first one is total.
+  const char* const INTERVAL_NAMES[] =
+    {
+      "total",
+      "serialize",
+      "queue",
+      "transport",
+      "buffer",
+      "deserialize"
+    };
+
+  void putUInt(unsigned char* p, uint64_t value, size_t size)
+  {
+    for (size_t i(0); i < size; ++i)
+      {
+        p[i] = static_cast<unsigned char>(value >> (8 * i));
+      }
+  }
+
+  uint64_t getUInt(const unsigned char* p, size_t size)
+  {
+    uint64_t value(0);
+    for (size_t i(0); i < size; ++i)
+      {
+        value |= static_cast<uint64_t>(p[i]) << (8 * i);
+      }
+    return value;
+  }
+
+  // Trailer of the data, or nullptr if it has none.
+  const unsigned char* trailer(const RTC::ByteData& data)
+  {
+    unsigned long length(data.getDataLength());
+    if (length < RTC::LatencyTrace::TRAILER_SIZE) { return nullptr; }
+    const unsigned char* p(data.getBuffer() + length - RTC::LatencyTrace::TRAILER_SIZE);
+    if (getUInt(p + 32, 4) != TRACE_MAGIC ||
+        getUInt(p + 36, 4) != TRACE_VERSION) { return nullptr; }
+    return p;
+  }
+
+  // Microseconds with one decimal place
+  std::string toMicroseconds(int64_t ns)
+  {
+    if (ns < 0) { ns = 0; }
+    return std::to_string(ns / 1000) + "." + std::to_string(ns / 100 % 10);
+  }
+
+  std::string escapeJson(const std::string& str)
+  {
+    std::string ret;
+    for (auto c : str)
+      {
+        if (c == '"' || c == '\\') { ret.push_back('\\'); }
+        if (static_cast<unsigned char>(c) >= 0x20) { ret.push_back(c); }
+      }
+    return ret;
+  }
+} // namespace
+
+namespace RTC
+{
+  const unsigned long LatencyTrace::TRAILER_SIZE;
+  const size_t LatencyTraceCollector::Entry::PENDING_LENGTH;
+
+  int64_t LatencyTrace::now()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::system_clock::now().time_since_epoch()).count();
+  }
+
+  /*!
+   * @if jp
+   * @brief トレーラを付加する
+   * @else
+   * @brief Append the trailer
+   * @endif
+   */
+  void LatencyTrace::append(ByteData& data, const Times& times)
+  {
+    unsigned long length(data.getDataLength());
+    ByteData traced;
+    traced.setDataLength(length + TRAILER_SIZE);
+    unsigned char* p(traced.mutableBuffer());
+    if (length > 0) { memcpy(p, data.getBuffer(), length); }
+    p += length;
+    for (size_t i(WRITE); i <= RECEIVED; ++i)
+      {
+        putUInt(p + 8 * i, static_cast<uint64_t>(times[i]), 8);
+      }
+    putUInt(p + 32, TRACE_MAGIC, 4);
+    putUInt(p + 36, TRACE_VERSION, 4);
+    data = std::move(traced);
+  }
+
+  /*!
+   * @if jp
+   * @brief トレーラに現在時刻を記録する
+   * @else
+   * @brief Record the current time into the trailer
+   * @endif
+   */
+  bool LatencyTrace::stamp(ByteData& data, Stage stage)
+  {
+    if (trailer(data) == nullptr || stage > RECEIVED) { return false; }
+    unsigned char* p(data.mutableBuffer() + data.getDataLength()
+                     - TRAILER_SIZE);
+    putUInt(p + 8 * stage, static_cast<uint64_t>(now()), 8);
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief トレーラの時刻を取り出す
+   * @else
+   * @brief Extract the times from the trailer
+   * @endif
+   */
+  bool LatencyTrace::extract(const ByteData& data, Times& times)
+  {
+    const unsigned char* p(trailer(data));
+    if (p == nullptr) { return false; }
+    times.fill(0);
+    for (size_t i(WRITE); i <= RECEIVED; ++i)
+      {
+        times[i] = static_cast<int64_t>(getUInt(p + 8 * i, 8));
+      }
+    return true;
+  }
+
+  LatencyTraceCollector& LatencyTraceCollector::instance()
+  {
+    static LatencyTraceCollector collector;
+    return collector;
+  }
+
+  LatencyTraceCollector::~LatencyTraceCollector()
+  {
+    stopWriter();
+  }
+
+  /*!
+   * @if jp
+   * @brief 初期化する
+   * @else
+   * @brief Initialize
+   * @endif
+   */
+  void LatencyTraceCollector::init(const coil::Properties& prop)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_statisticsFile = prop.getProperty("statistics_file");
+    std::string chrome(prop.getProperty("chrome_file"));
+    if (!chrome.empty())
+      {
+        // The closing bracket is optional in the Chrome trace format.
+        m_chrome.open(chrome.c_str(), std::ios::out | std::ios::trunc);
+        m_chrome << "[\n";
+        m_stop = false;
+        m_writer = std::thread([this] { svc(); });
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 集計結果を出力し、ファイルを閉じる
+   * @else
+   * @brief Write the aggregated results and close the files
+   * @endif
+   */
+  void LatencyTraceCollector::shutdown()
+  {
+    stopWriter();
+    std::string file;
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      if (m_chrome.is_open()) { m_chrome.close(); }
+      file.swap(m_statisticsFile);
+    }
+    if (file.empty()) { return; }
+    std::ofstream ofs(file.c_str(), std::ios::out | std::ios::trunc);
+    if (ofs)
+      {
+        getStatistics().store(ofs, "Data port latency statistics");
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief コネクタを登録する
+   * @else
+   * @brief Register a connector
+   * @endif
+   */
+  LatencyTraceCollector::Entry*
+  LatencyTraceCollector::entry(const ConnectorInfo& info)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    std::unique_ptr<Entry>& entry(m_connectors[info.id]);
+    if (!entry)
+      {
+        entry.reset(new Entry());
+        entry->name = info.name;
+        entry->index = m_connectors.size();
+        if (m_writer.joinable())
+          {
+            entry->pending.reset(new LatencyTrace::Times[Entry::PENDING_LENGTH]);
+          }
+      }
+    return entry.get();
+  }
+
+  /*!
+   * @if jp
+   * @brief サンプルの時刻を集計する
+   *
+   * 各区間は、記録された直前の時刻からの時間とする。Chrome trace の出
+   * 力待ちのリングが一杯の場合、そのサンプルは出力せずに dropped を数
+   * える。
+   *
+   * @else
+   * @brief Aggregate the times of a sample
+   *
+   * Each interval is measured from the last recorded time before it.
+   * If the ring waiting for the Chrome trace output is full, the
+   * sample is not written and counted in dropped.
+   *
+   * @endif
+   */
+  void LatencyTraceCollector::record(Entry* entry,
+                                     const LatencyTrace::Times& times)
+  {
+    if (entry == nullptr || times[LatencyTrace::WRITE] == 0) { return; }
+
+    size_t prev(LatencyTrace::WRITE);
+    for (size_t i(LatencyTrace::SERIALIZED); i < LatencyTrace::STAGE_NUM; ++i)
+      {
+        if (times[i] == 0) { continue; }
+        entry->intervals[i].record(std::chrono::nanoseconds(times[i] - times[prev]));
+        prev = i;
+      }
+    entry->intervals[0].record(std::chrono::nanoseconds(times[prev]
+                                                        - times[LatencyTrace::WRITE]));
+    if (!entry->pending) { return; }
+
+    size_t head(entry->head.load(std::memory_order_relaxed));
+    if (head - entry->tail.load(std::memory_order_acquire)
+        >= Entry::PENDING_LENGTH)
+      {
+        entry->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+    entry->pending[head % Entry::PENDING_LENGTH] = times;
+    entry->head.store(head + 1, std::memory_order_release);
+  }
+
+  /*!
+   * @if jp
+   * @brief 集計結果を取得する
+   * @else
+   * @brief Get the aggregated results
+   * @endif
+   */
+  coil::Properties LatencyTraceCollector::getStatistics() const
+  {
+    coil::Properties prop;
+    std::lock_guard<std::mutex> guard(m_mutex);
+    for (auto& conn : m_connectors)
+      {
+        for (size_t i(0); i < LatencyTrace::STAGE_NUM; ++i)
+          {
+            if (conn.second->intervals[i].count() == 0) { continue; }
+            RTC_impl::ExecutionStatistics::
+              setSummary(prop, conn.second->name + "." + INTERVAL_NAMES[i],
+                         conn.second->intervals[i]);
+          }
+        uint64_t dropped(conn.second->dropped.load(std::memory_order_relaxed));
+        if (dropped != 0)
+          {
+            prop.setProperty(conn.second->name + ".trace_dropped",
+                             std::to_string(dropped));
+          }
+      }
+    return prop;
+  }
+
+  /*!
+   * @if jp
+   * @brief Chrome trace の書き込みスレッドを停止する
+   *
+   * 停止前に出力待ちのサンプルをすべて書き込む。
+   *
+   * @else
+   * @brief Stop the writer thread of the Chrome trace
+   *
+   * The pending samples are all written before it stops.
+   *
+   * @endif
+   */
+  void LatencyTraceCollector::stopWriter()
+  {
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      m_stop = true;
+    }
+    m_cond.notify_all();
+    if (m_writer.joinable()) { m_writer.join(); }
+  }
+
+  /*!
+   * @if jp
+   * @brief Chrome trace の書き込みスレッド
+   *
+   * 一定周期で各コネクタの出力待ちのサンプルを書き込む。m_mutex はコ
+   * ネクタの一覧を得る間だけ保持する。
+   *
+   * @else
+   * @brief Writer thread of the Chrome trace
+   *
+   * Writes the pending samples of each connector periodically. m_mutex
+   * is held only while getting the list of the connectors.
+   *
+   * @endif
+   */
+  void LatencyTraceCollector::svc()
+  {
+    std::vector<Entry*> entries;
+    std::unique_lock<std::mutex> guard(m_mutex);
+    bool stop(false);
+    while (!stop)
+      {
+        stop = m_cond.wait_for(guard, std::chrono::milliseconds(100),
+                               [this] { return m_stop; });
+        entries.clear();
+        for (auto& conn : m_connectors)
+          {
+            entries.push_back(conn.second.get());
+          }
+        guard.unlock();
+        for (auto entry : entries)
+          {
+            writeChromeTrace(*entry);
+          }
+        m_chrome.flush();
+        guard.lock();
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 出力待ちのサンプルの各区間を Chrome trace のイベントとして出力する
+   *
+   * 書き込みスレッドから呼び出す。コネクタごとに1つのスレッドとして表
+   * 示される。
+   *
+   * @else
+   * @brief Write the intervals of the pending samples as Chrome trace events
+   *
+   * Called from the writer thread. Each connector is shown as a thread.
+   *
+   * @endif
+   */
+  void LatencyTraceCollector::writeChromeTrace(Entry& entry)
+  {
+    if (!entry.pending) { return; }
+    size_t tail(entry.tail.load(std::memory_order_relaxed));
+    size_t head(entry.head.load(std::memory_order_acquire));
+    if (tail == head) { return; }
+    if (!entry.named)
+      {
+        entry.named = true;
+        m_chrome << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":"
+                 << entry.index << ",\"args\":{\"name\":\""
+                 << escapeJson(entry.name) << "\"}},\n";
+      }
+    for (; tail != head; ++tail)
+      {
+        const LatencyTrace::Times& times(entry.pending[tail % Entry::PENDING_LENGTH]);
+        size_t prev(LatencyTrace::WRITE);
+        for (size_t i(LatencyTrace::SERIALIZED); i < LatencyTrace::STAGE_NUM; ++i)
+          {
+            if (times[i] == 0) { continue; }
+            m_chrome << "{\"name\":\"" << INTERVAL_NAMES[i]
+                     << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << entry.index
+                     << ",\"ts\":" << toMicroseconds(times[prev])
+                     << ",\"dur\":" << toMicroseconds(times[i] - times[prev])
+                     << "},\n";
+            prev = i;
+          }
+      }
+    entry.tail.store(tail, std::memory_order_release);
+  }
+} // namespace RTC
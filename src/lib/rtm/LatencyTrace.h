@@ -0,0 +1,348 @@
+// -*- C++ -*-
+/*!
+ * @file LatencyTrace.h
+ * @brief End-to-end latency tracing of data port samples
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_LATENCYTRACE_H
+#define RTC_LATENCYTRACE_H
+
+#include <rtm/ByteData.h>
+#include <rtm/ByteDataStreamBase.h>
+#include <coil/LatencyHistogram.h>
+#include <coil/Properties.h>
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace RTC
+{
+  class ConnectorInfo;
+
+  /*!
+   * @if jp
+   * @class LatencyTrace
+   * @brief サンプルの遅延時間トレース
+   *
+   * コネクタの latency_trace が YES の場合、送信側はシリアライズした
+   * データの末尾に TRAILER_SIZE バイトのトレーラを付加し、OutPort::write()
+   * の呼び出し、シリアライズの終了、送信 (ON_SEND)、受信 (ON_RECEIVED)
+   * の時刻を記録する。受信側はバッファからの読み出し (ON_BUFFER_READ)
+   * とデシリアライズの終了の時刻を加え、トレーラを除いてデシリアライズ
+   * する。時刻は system_clock のエポックからのナノ秒で、0 は未記録を表
+   * す。
+   *
+   * @else
+   * @class LatencyTrace
+   * @brief Latency trace of samples
+   *
+   * If latency_trace of the connector is YES, the sender appends a
+   * trailer of TRAILER_SIZE bytes to the serialized data and records
+   * the times of the OutPort::write() call, the end of the
+   * serialization, the send (ON_SEND) and the receipt (ON_RECEIVED).
+   * The receiver adds the times of the read from the buffer
+   * (ON_BUFFER_READ) and of the end of the deserialization, and
+   * deserializes the data without the trailer. The times are in
+   * nanoseconds from the epoch of system_clock, and 0 means not
+   * recorded.
+   *
+   * @endif
+   */
+  class LatencyTrace
+  {
+  public:
+    enum Stage
+      {
+        WRITE,
+        SERIALIZED,
+        SEND,
+        RECEIVED,
+        BUFFER_READ,
+        READ,
+        STAGE_NUM
+      };
+    using Times = std::array<int64_t, STAGE_NUM>;
+
+    /*!
+     * @if jp
+     * @brief トレーラのサイズ
+     *
+     * WRITE から RECEIVED までの時刻 (リトルエンディアンの int64) の後
+     * に、マジックナンバーとバージョン (uint32) が続く。
+     *
+     * @else
+     * @brief Size of the trailer
+     *
+     * The times from WRITE to RECEIVED (little endian int64) are
+     * followed by a magic number and a version (uint32).
+     *
+     * @endif
+     */
+    static const unsigned long TRAILER_SIZE = 4 * 8 + 4 + 4;
+
+    /*!
+     * @if jp
+     * @brief 現在時刻を取得する
+     * @else
+     * @brief Get the current time
+     * @endif
+     */
+    static int64_t now();
+
+    /*!
+     * @if jp
+     * @brief トレーラを付加する
+     *
+     * @param data シリアライズしたデータ
+     * @param times WRITE から RECEIVED までの時刻
+     *
+     * @else
+     * @brief Append the trailer
+     *
+     * @param data Serialized data
+     * @param times Times from WRITE to RECEIVED
+     *
+     * @endif
+     */
+    static void append(ByteData& data, const Times& times);
+
+    /*!
+     * @if jp
+     * @brief トレーラに現在時刻を記録する
+     *
+     * @param data トレーラ付きのデータ
+     * @param stage SEND または RECEIVED
+     *
+     * @return false: トレーラがない
+     *
+     * @else
+     * @brief Record the current time into the trailer
+     *
+     * @param data Data with the trailer
+     * @param stage SEND or RECEIVED
+     *
+     * @return false: no trailer
+     *
+     * @endif
+     */
+    static bool stamp(ByteData& data, Stage stage);
+
+    /*!
+     * @if jp
+     * @brief トレーラの時刻を取り出す
+     *
+     * @param data トレーラ付きのデータ
+     * @param times WRITE から RECEIVED までの時刻を格納する
+     *
+     * @return false: トレーラがない
+     *
+     * @else
+     * @brief Extract the times from the trailer
+     *
+     * @param data Data with the trailer
+     * @param times The times from WRITE to RECEIVED are stored
+     *
+     * @return false: no trailer
+     *
+     * @endif
+     */
+    static bool extract(const ByteData& data, Times& times);
+
+    /*!
+     * @if jp
+     * @brief トレーラを付加したデータを送信するためのストリーム
+     * @else
+     * @brief Stream to send the data with the trailer
+     * @endif
+     */
+    using Stream = SharedByteDataStream;
+  };
+
+  /*!
+   * @if jp
+   * @class LatencyTraceCollector
+   * @brief 遅延時間トレースの集計
+   *
+   * コネクタごとに各区間 (serialize, queue, transport, buffer,
+   * deserialize, total) の遅延時間のヒストグラムを集計する。Manager
+   * の設定 latency_trace.chrome_file を指定すると各サンプルを Chrome
+   * trace 形式の JSON で出力し、latency_trace.statistics_file を指定す
+   * ると終了時に集計結果を出力する。
+   *
+   * コネクタは entry() で一度だけ登録し、以後の record() はロックを取
+   * らない。Chrome trace のファイルへの書き込みは専用のスレッドが行う。
+   *
+   * @else
+   * @class LatencyTraceCollector
+   * @brief Aggregation of the latency traces
+   *
+   * Aggregates the histograms of the latency of each interval
+   * (serialize, queue, transport, buffer, deserialize and total) for
+   * each connector. If latency_trace.chrome_file of the Manager
+   * configuration is given, each sample is written in the Chrome trace
+   * JSON format, and if latency_trace.statistics_file is given, the
+   * aggregated results are written at the shutdown.
+   *
+   * A connector is registered once by entry(), and record() takes no
+   * lock after that. The Chrome trace file is written by a dedicated
+   * thread.
+   *
+   * @endif
+   */
+  class LatencyTraceCollector
+  {
+  public:
+    struct Entry;
+
+    static LatencyTraceCollector& instance();
+
+    /*!
+     * @if jp
+     * @brief 初期化する
+     * @param prop Manager の設定の latency_trace 以下のプロパティ
+     * @else
+     * @brief Initialize
+     * @param prop Properties under latency_trace of the Manager configuration
+     * @endif
+     */
+    void init(const coil::Properties& prop);
+
+    /*!
+     * @if jp
+     * @brief 集計結果を出力し、ファイルを閉じる
+     * @else
+     * @brief Write the aggregated results and close the files
+     * @endif
+     */
+    void shutdown();
+
+    /*!
+     * @if jp
+     * @brief コネクタを登録する
+     *
+     * 同じ ID のコネクタには同じエントリを返す。エントリはプロセスの終
+     * 了まで有効である。
+     *
+     * @param info コネクタ情報
+     * @return エントリ
+     *
+     * @else
+     * @brief Register a connector
+     *
+     * The same entry is returned for the connectors of the same ID. The
+     * entry is valid until the process exits.
+     *
+     * @param info Connector information
+     * @return Entry
+     *
+     * @endif
+     */
+    Entry* entry(const ConnectorInfo& info);
+
+    /*!
+     * @if jp
+     * @brief サンプルの時刻を集計する
+     *
+     * ロックを取らない。1つのエントリに対して同時に呼び出せるのは1つの
+     * スレッドのみである。
+     *
+     * @param entry entry() で取得したエントリ、nullptr の場合は何もしない
+     * @param times サンプルの時刻
+     *
+     * @else
+     * @brief Aggregate the times of a sample
+     *
+     * Takes no lock. Only one thread at a time may call this for an
+     * entry.
+     *
+     * @param entry Entry obtained by entry(), nothing is done if nullptr
+     * @param times Times of the sample
+     *
+     * @endif
+     */
+    void record(Entry* entry, const LatencyTrace::Times& times);
+
+    /*!
+     * @if jp
+     * @brief 集計結果を取得する
+     *
+     * 各コネクタについて <コネクタ名>.<区間>.count, min, mean, p50, p90,
+     * p99, p999, max を設定する。時間の単位はナノ秒。
+     *
+     * @else
+     * @brief Get the aggregated results
+     *
+     * Sets <connector name>.<interval>.count, min, mean, p50, p90, p99,
+     * p999 and max for each connector. The times are in nanoseconds.
+     *
+     * @endif
+     */
+    coil::Properties getStatistics() const;
+
+    /*!
+     * @if jp
+     * @brief コネクタごとの集計
+     *
+     * pending は Chrome trace の出力を待つサンプルのリングで、record()
+     * を呼ぶスレッドが head を、書き込みスレッドが tail を進める。
+     * Chrome trace を出力しない場合は nullptr。
+     *
+     * @else
+     * @brief Aggregation of a connector
+     *
+     * pending is the ring of the samples waiting for the Chrome trace
+     * output. The thread calling record() advances head and the writer
+     * thread advances tail. nullptr if no Chrome trace is written.
+     *
+     * @endif
+     */
+    struct Entry
+    {
+      static const size_t PENDING_LENGTH = 1024;
+      std::string name;
+      size_t index{0};
+      std::array<coil::LatencyHistogram, LatencyTrace::STAGE_NUM> intervals;
+      std::unique_ptr<LatencyTrace::Times[]> pending;
+      std::atomic<size_t> head{0};
+      std::atomic<size_t> tail{0};
+      std::atomic<uint64_t> dropped{0};
+      bool named{false};
+    };
+
+  private:
+    LatencyTraceCollector() = default;
+    ~LatencyTraceCollector();
+
+    void svc();
+    void stopWriter();
+    void writeChromeTrace(Entry& entry);
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cond;
+    std::map<std::string, std::unique_ptr<Entry>> m_connectors;
+    std::ofstream m_chrome;
+    std::thread m_writer;
+    bool m_stop{false};
+    std::string m_statisticsFile;
+  };
+} // namespace RTC
+
+#endif  // RTC_LATENCYTRACE_H
@@ -42,6 +42,8 @@
 #include <rtm/SdoServiceConsumerBase.h>
 #include <rtm/LocalServiceAdmin.h>
 #include <rtm/SystemLogger.h>
+#include <rtm/AsyncLogWriter.h>
+#include <rtm/LatencyTrace.h>
 #include <rtm/LogstreamBase.h>
 #include <rtm/NumberingPolicyBase.h>
 
@@ -172,6 +174,7 @@ namespace RTC
     // 終了待ち合わせ
     m_threadOrb.join();
     m_listeners.manager_.postShutdown();
+    LatencyTraceCollector::instance().shutdown();
     shutdownLogger();
   }
 
@@ -1246,6 +1249,8 @@ std::vector<coil::Properties> Manager::getLoadableModules()
         }, std::chrono::seconds(1));
       }
 
+    LatencyTraceCollector::instance().init(m_config.getNode("latency_trace"));
+
     for (auto const& itr : coil::split(m_config["manager.preload.modules"], ","))
       {
         std::string mpm_{coil::eraseBothEndsBlank(itr)};
@@ -1437,6 +1442,19 @@ std::vector<coil::Properties> Manager::getLoadableModules()
     // Log stream mutex locking mode
     coil::toBool(m_config["logger.stream_lock"], "enable", "disable", false) ?
       RTC::Logger::enableLock() : RTC::Logger::disableLock();
+    // Asynchronous log output
+    if (coil::toBool(m_config["logger.async"], "YES", "NO", false))
+      {
+        size_t length(0);
+        if (!coil::stringTo(length,
+                            m_config["logger.async_queue_length"].c_str()))
+          {
+            std::cerr << "invalid logger.async_queue_length: "
+                      << m_config["logger.async_queue_length"] << std::endl;
+            length = 1024;
+          }
+        AsyncLogWriter::instance().start(length);
+      }
 
     // File Logstream init
     initLogstreamFile();
@@ -1467,6 +1485,7 @@ std::vector<coil::Properties> Manager::getLoadableModules()
   void Manager::shutdownLogger()
   {
     RTC_TRACE(("Manager::shutdownLogger()"));
+    AsyncLogWriter::instance().stop();
     rtclog.flush();
 
     for (auto & m_logfile : m_logfiles)
@@ -31,10 +31,15 @@
 #include <rtm/OutPortConnector.h>
 #include <rtm/Timestamp.h>
 #include <rtm/DirectOutPortBase.h>
+#include <rtm/FixedLayoutSerializer.h>
+#include <rtm/CompressionSerializer.h>
 #include <rtm/DataTypeUtil.h>
 
+#include <atomic>
+#include <cassert>
 #include <functional>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace RTC
@@ -116,6 +121,8 @@ namespace RTC
       m_directport = this;
 
       CdrMemoryStreamInit<DataType>();
+      FixedLayoutSerializerInit<DataType>();
+      CompressionSerializerInit<DataType>();
 
       std::string marshaling_types{coil::eraseBlank(coil::flatten(
         getSerializerList<DataType>()))};
@@ -187,6 +194,13 @@ namespace RTC
     {
       RTC_TRACE(("DataType write()"));
 
+      if (loanedByThisThread())
+        {
+          RTC_ERROR(("write() while a send area is loaned to this thread"));
+          assert(false && "write() while a send area is loaned");
+          return false;
+        }
+
       if (m_onWrite != nullptr)
         {
           (*m_onWrite)(value);
@@ -204,6 +218,15 @@ namespace RTC
 
         m_status.resize(conn_size);
 
+        // OnWriteConvert may convert differently for each connector, so
+        // the serialized data is shared only without it
+        SerializedDataCache* cache(nullptr);
+        if (conn_size > 1 && m_onWriteConvert == nullptr)
+          {
+            m_serialized.clear();
+            cache = &m_serialized;
+          }
+
         for (size_t i(0), len(conn_size); i < len; ++i)
           {
 
@@ -219,7 +242,7 @@ namespace RTC
                 else
                   {
                     RTC_DEBUG(("m_connectors.write called"));
-                    ret = m_connectors[i]->write(value);
+                    ret = m_connectors[i]->write(value, cache);
                   }
               }
             else
@@ -255,6 +278,8 @@ namespace RTC
                 disconnect_ids.emplace_back(id);
               }
           }
+        // releases the samples not taken by the connectors
+        m_serialized.clear();
       }
       std::for_each(disconnect_ids.begin(), disconnect_ids.end(),
                     [this](const char * id){this->disconnect(id);});
@@ -317,6 +342,150 @@ namespace RTC
       return write(value);
     }
 
+    /*!
+     * @if jp
+     *
+     * @brief 送信バッファの貸し出し
+     *
+     * 接続先へ直接送信できる送信領域を貸し出す。コンポーネントはシリア
+     * ライズ済みのデータ (コネクタの marshaling_type 形式、エンディア
+     * ンは OutPortLoan::isLittleEndian()) を送信領域に書き込み、
+     * commit() で送信する。同一ホスト内の shared_memory 接続
+     * (shem_protocol=ring, subscription_type=flush) では共有メモリの
+     * スロットが直接貸し出されるため、データのコピーが発生しない。
+     *
+     * 貸し出しはコネクタが1つで、そのコネクタが送信領域を貸し出せる場
+     * 合のみ可能である。貸し出せない場合は空の OutPortLoan を返すので、
+     * 呼び出し側は write() を用いること。バッファとコネクタリスナは経
+     * 由しない。受信側の InPortSHMProvider はスロットから ByteData へ
+     * 1回コピーする。
+     *
+     * 貸し出し中はコネクタリストをロックするため、他のスレッドからの
+     * write()、loan()、コネクタの接続・切断はブロックされる。貸し出し
+     * たスレッドが commit() 前に write() や loan() を呼ぶとデッドロッ
+     * クするため、これらは失敗する (デバッグビルドでは assert)。同じ
+     * スレッドからコネクタの接続・切断を行ってはならない。
+     *
+     * @param size 書き込むデータのサイズ
+     *
+     * @return 送信領域
+     *
+     * @else
+     *
+     * @brief Loan a send buffer
+     *
+     * Loans a send area that is sent to the destination directly. The
+     * component writes serialized data (in the marshaling_type of the
+     * connector, with the endian of OutPortLoan::isLittleEndian()) into
+     * it and sends it by commit(). With a shared_memory connection
+     * within a host (shem_protocol=ring, subscription_type=flush) the
+     * slot of the shared memory itself is loaned, so the sender copies
+     * nothing. The receiving InPortSHMProvider still copies the slot
+     * into a ByteData once.
+     *
+     * A loan is possible only with a single connector that can loan a
+     * send area. Otherwise an empty OutPortLoan is returned and the
+     * caller should use write(). The buffer and the connector listeners
+     * are bypassed.
+     *
+     * The connector list is locked while loaned, so write(), loan(),
+     * connecting and disconnecting from other threads block. Since
+     * write() or loan() on the loaning thread before commit() would
+     * deadlock, they fail instead (assert in debug builds). Connecting
+     * or disconnecting must not be done from the loaning thread.
+     *
+     * @param size Size of the data to be written
+     *
+     * @return Send area
+     *
+     * @endif
+     */
+    OutPortLoan loan(unsigned long size)
+    {
+      RTC_TRACE(("loan(%d)", size));
+      if (loanedByThisThread())
+        {
+          RTC_ERROR(("loan() while a send area is loaned to this thread"));
+          assert(false && "loan() while a send area is loaned");
+          return OutPortLoan();
+        }
+      std::unique_lock<std::mutex> con_guard(m_connectorsMutex);
+      if (m_connectors.size() != 1 || m_connectors[0]->pullDirectMode())
+        {
+          return OutPortLoan();
+        }
+      unsigned char* data(m_connectors[0]->loan(size));
+      if (data == nullptr)
+        {
+          return OutPortLoan();
+        }
+      m_loanThread.store(std::this_thread::get_id(), std::memory_order_release);
+      return OutPortLoan(std::move(con_guard), &m_loanThread,
+                         m_connectors[0], data, size);
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief 貸し出した送信バッファのデータ送信
+     *
+     * loan() で貸し出した送信領域に書き込んだデータを送信する。
+     *
+     * @param loan 送信領域
+     * @param length 書き込んだデータのサイズ
+     *
+     * @return 送信結果(送信成功:true、送信失敗:false)
+     *
+     * @else
+     *
+     * @brief Send the data in the loaned send buffer
+     *
+     * Sends the data written into the send area loaned by loan().
+     *
+     * @param loan Send area
+     * @param length Size of the written data
+     *
+     * @return Sending result (Successful:true, Failed:false)
+     *
+     * @endif
+     */
+    bool commit(OutPortLoan& loan, unsigned long length)
+    {
+      RTC_TRACE(("commit(%d)", length));
+      if (!loan) { return false; }
+
+      std::string id(loan.connector()->id());
+      // m_status is updated under the lock held by the loan, as write()
+      // does
+      DataPortStatus ret(loan.commit(length, &m_status));
+      if (ret == DataPortStatus::PORT_OK) { return true; }
+
+      if (ret == DataPortStatus::CONNECTION_LOST)
+        {
+          RTC_WARN(("connection_lost id: %s", id.c_str()));
+          if (m_onConnectionLost != nullptr)
+            {
+              RTC::ConnectorProfile prof(findConnProfile(id.c_str()));
+              (*m_onConnectionLost)(prof);
+            }
+          this->disconnect(id.c_str());
+        }
+      return false;
+    }
+
+    /*!
+     * @if jp
+     * @brief 呼び出したスレッドに送信領域を貸し出しているか
+     * @else
+     * @brief Whether a send area is loaned to the calling thread
+     * @endif
+     */
+    bool loanedByThisThread() const
+    {
+      return m_loanThread.load(std::memory_order_acquire) ==
+        std::this_thread::get_id();
+    }
+
     /*!
      * @if jp
      *
@@ -546,6 +715,39 @@ namespace RTC
 
     DataPortStatusList m_status;
 
+    /*!
+     * @if jp
+     * @brief 書き込み中のサンプルのシリアライズ結果
+     *
+     * 複数のコネクタに書き込む際、同じシリアライズキーのコネクタの間で
+     * シリアライズ結果を共有する。m_connectorsMutex で保護する。
+     *
+     * @else
+     * @brief Serialized results of the sample being written
+     *
+     * When writing to several connectors, the serialized result is
+     * shared among the connectors of the same serialization key.
+     * Guarded by m_connectorsMutex.
+     *
+     * @endif
+     */
+    SerializedDataCache m_serialized;
+
+    /*!
+     * @if jp
+     * @brief 送信領域を貸し出しているスレッド
+     *
+     * 貸し出していない場合は std::thread::id()。
+     *
+     * @else
+     * @brief Thread to which a send area is loaned
+     *
+     * std::thread::id() if nothing is loaned.
+     *
+     * @endif
+     */
+    std::atomic<std::thread::id> m_loanThread{std::thread::id()};
+
     CORBA::Long m_propValueIndex;
 
     std::mutex m_valueMutex;
@@ -28,6 +28,7 @@
 #include <algorithm>
 #include <functional>
 #include <iterator>
+#include <random>
 
 #include <rtm/InPortBase.h>
 
@@ -100,6 +101,11 @@ namespace RTC
 
     m_properties["data_type"] = data_type;
 
+    std::random_device random;
+    uint32_t stream_id(0);
+    while (stream_id == 0) { stream_id = random(); }
+    m_streamId = coil::otos(stream_id);
+
     initConnectorListeners();
 
   }
@@ -526,6 +532,20 @@ namespace RTC
         return returnvalue;
       }
 
+    // All the ports publish before any of them subscribes, so the
+    // InPort gets the stream ID at the latest in subscribeInterfaces().
+    CORBA::Long index(NVUtil::find_index(cprof.properties,
+                                         "dataport.outport.stream_id"));
+    if (index < 0)
+      {
+        CORBA_SeqUtil::push_back(cprof.properties,
+            NVUtil::newNV("dataport.outport.stream_id", m_streamId.c_str()));
+      }
+    else
+      {
+        cprof.properties[index].value <<= m_streamId.c_str();
+      }
+
     // prop: [port.outport].
     coil::Properties prop(m_properties);
     {
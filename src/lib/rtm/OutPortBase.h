@@ -140,6 +140,12 @@ namespace RTC
    *      publisher.skip_count = n<br>
    *      n: n要素毎にひとつ送信
    *
+   * - publisher.batch.max_samples, publisher.batch.max_bytes,
+   *   publisher.batch.max_delay: <br>
+   *      push_policy が all, fifo のとき、バッファ内のデータを最大
+   *      max_samples 個、max_bytes バイトまで1回の送信にまとめる。
+   *      データが揃うまで最大 max_delay [sec] 待つ (new Publisher のみ)
+   *
    * - publisher.push_rate:
    *
    * - publisher.thread.type: <br>
@@ -1096,6 +1102,27 @@ namespace RTC
      * @endif
      */
     ConnectorListenersBase* m_listeners;
+    /*!
+     * @if jp
+     * @brief ストリーム ID
+     *
+     * この OutPort を識別する乱数で、publishInterfaces() でコネクタプ
+     * ロファイルの dataport.outport.stream_id に設定する。全コネクタで
+     * ひとつのストリームを共有するトランスポートが、受信側で他の
+     * OutPort のデータと区別するために用いる。
+     *
+     * @else
+     * @brief Stream ID
+     *
+     * A random number identifying this OutPort, set to
+     * dataport.outport.stream_id of the connector profile in
+     * publishInterfaces(). The transports sharing one stream among all
+     * the connectors use it to distinguish the data from the other
+     * OutPorts on the receiver.
+     *
+     * @endif
+     */
+    std::string m_streamId;
 
     /*!
      * @if jp
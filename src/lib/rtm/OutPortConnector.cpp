@@ -34,6 +34,11 @@ namespace RTC
     : rtclog("OutPortConnector"), m_profile(info), m_littleEndian(true),
       m_directInPort(nullptr), m_listeners(listeners), m_directMode(false), m_marshaling_type("cdr"), m_cdr(nullptr)
   {
+    m_latencyTrace = m_profile.settings().latency_trace;
+    if (m_latencyTrace)
+      {
+        m_traceEntry = LatencyTraceCollector::instance().entry(m_profile);
+      }
   }
 
   /*!
@@ -45,6 +50,7 @@ namespace RTC
    */
   OutPortConnector::~OutPortConnector()
   {
+    if (m_directChannel) { m_directChannel->close(); }
     SerializerFactory::instance().deleteObject(m_cdr);
   }
   /*!
@@ -121,6 +127,7 @@ namespace RTC
   {
     RTC_TRACE(("setEndian() = %s", endian_type ? "little":"big"));
     m_littleEndian = endian_type;
+    m_serializationKey.clear();
   }
 
   /*!
@@ -135,6 +142,32 @@ namespace RTC
     return m_littleEndian;
   }
 
+  /*!
+   * @if jp
+   * @brief シリアライズキーを取得する
+   * @else
+   * @brief Get the serialization key
+   * @endif
+   */
+  const std::string& OutPortConnector::serializationKey()
+  {
+    if (m_serializationKey.empty())
+      {
+        m_serializationKey = m_marshaling_type;
+        m_serializationKey += isLittleEndian() ? "|little" : "|big";
+        coil::Properties* node(m_profile.properties.findNode("serializer"));
+        if (node != nullptr)
+          {
+            for (auto& name : node->propertyNames())
+              {
+                m_serializationKey += "|" + name + "=" +
+                  node->getProperty(name);
+              }
+          }
+      }
+    return m_serializationKey;
+  }
+
   /*!
   * @if jp
   * @brief ダイレクト接続モードに設定
@@ -176,6 +209,16 @@ namespace RTC
     }
     m_directInPort = directInPort;
     m_inPortListeners = directInPort->getListeners();
+    // the InPort removes the closed channel once it is drained
+    if (m_directChannel) { m_directChannel->close(); }
+    m_directChannel.reset();
+    m_directChannelChecked = false;
+    DirectPortBase* port(directInPort->getDirectPort());
+    if (port != nullptr)
+      {
+        m_directChannel =
+          port->openDirectChannel(m_profile.properties.getNode("buffer"));
+      }
     return true;
   }
 
@@ -184,6 +227,30 @@ namespace RTC
     return BufferStatus::OK;
   }
 
+  /*!
+  * @if jp
+  * @brief 送信バッファの貸し出し
+  * @else
+  * @brief Loan a send buffer
+  * @endif
+  */
+  unsigned char* OutPortConnector::loan(unsigned long  /*size*/)
+  {
+    return nullptr;
+  }
+
+  /*!
+  * @if jp
+  * @brief 貸し出した送信バッファのデータ送信
+  * @else
+  * @brief Send the data in the loaned send buffer
+  * @endif
+  */
+  DataPortStatus OutPortConnector::commit(unsigned long  /*length*/)
+  {
+    return DataPortStatus::PRECONDITION_NOT_MET;
+  }
+
   void OutPortConnector::unsubscribeInterface(const coil::Properties& /*prop*/)
   {
 
@@ -24,15 +24,73 @@
 #include <rtm/ConnectorBase.h>
 #include <rtm/ConnectorListener.h>
 #include <rtm/DirectInPortBase.h>
+#include <rtm/DirectChannel.h>
 #include <rtm/PortBase.h>
 #include <rtm/CORBA_CdrMemoryStream.h>
 #include <rtm/ByteData.h>
+#include <rtm/LatencyTrace.h>
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 
 namespace RTC
 {
   class InPortBase;
+
+  /*!
+   * @if jp
+   * @class SerializedDataCache
+   * @brief 1回の書き込みでシリアライズしたデータ
+   *
+   * OutPort が複数のコネクタに同じサンプルを書き込む際に、シリアライ
+   * ズの結果をコネクタのシリアライズキー (マーシャリング型、エンディア
+   * ン、シリアライザの設定) ごとに保持する。同じキーのコネクタはシリア
+   * ライズせずに参照カウントでデータを共有する。キーはコネクタが保持す
+   * るため、キャッシュは書き込み中のみ有効である。
+   *
+   * @else
+   * @class SerializedDataCache
+   * @brief Data serialized in one write
+   *
+   * When an OutPort writes the same sample to several connectors, this
+   * holds the serialized result for each serialization key (the
+   * marshaling type, the endian and the serializer settings) of the
+   * connectors. The connectors with the same key share the data by
+   * reference counting without serializing it. The keys are owned by
+   * the connectors, so the cache is valid only during the write.
+   *
+   * @endif
+   */
+  class SerializedDataCache
+  {
+  public:
+    void clear() { m_entries.clear(); }
+
+    ByteData* find(const std::string& key)
+    {
+      for (auto& entry : m_entries)
+        {
+          if (*entry.first == key) { return &entry.second; }
+        }
+      return nullptr;
+    }
+
+    ByteData& add(const std::string& key, const ByteDataStreamBase& data)
+    {
+      m_entries.emplace_back(&key, ByteData(data));
+      return m_entries.back().second;
+    }
+
+  private:
+    std::vector<std::pair<const std::string*, ByteData>> m_entries;
+  };
+
   /*!
    * @if jp
    * @class OutPortConnector
@@ -165,6 +223,51 @@ namespace RTC
      */
     virtual DataPortStatus write(ByteDataStreamBase* data) = 0;
 
+    /*!
+     * @if jp
+     * @brief 送信バッファの貸し出し
+     *
+     * シリアライズ済みのデータを直接書き込める送信領域を返す。書き込
+     * んだデータは commit() で送信する。Publisher とバッファを経由しな
+     * いため、同期送信が可能なコネクタのみが対応する。デフォルト実装は
+     * nullptr を返す。
+     *
+     * @param size 書き込むデータのサイズ
+     * @return 送信領域。貸し出せない場合は nullptr
+     *
+     * @else
+     * @brief Loan a send buffer
+     *
+     * Returns a send area into which serialized data can be written
+     * directly. The written data is sent by commit(). Since the
+     * publisher and the buffer are bypassed, only connectors that can
+     * send synchronously support it. The default implementation returns
+     * nullptr.
+     *
+     * @param size Size of the data to be written
+     * @return Send area, or nullptr if it cannot be loaned
+     *
+     * @endif
+     */
+    virtual unsigned char* loan(unsigned long size);
+
+    /*!
+     * @if jp
+     * @brief 貸し出した送信バッファのデータ送信
+     *
+     * @param length 書き込んだデータのサイズ
+     * @return リターンコード
+     *
+     * @else
+     * @brief Send the data in the loaned send buffer
+     *
+     * @param length Size of the written data
+     * @return Return code
+     *
+     * @endif
+     */
+    virtual DataPortStatus commit(unsigned long length);
+
     /*!
      * @if jp
      * @brief endianタイプ設定
@@ -215,14 +318,58 @@ namespace RTC
     template <class DataType>
     DataPortStatus write(DataType& data)
     {
+      return write(data, nullptr);
+    }
+
+    /*!
+     * @if jp
+     * @brief シリアライズ済みのデータを共有する書き込み
+     *
+     * cache にこのコネクタと同じシリアライズキーのデータがあれば、シリ
+     * アライズせずにそのデータを書き込む。なければシリアライズして
+     * cache に追加する。cache が nullptr の場合は write(data) と同じ。
+     * シリアライザの統計 (codec_time など) はシリアライズしたコネクタに
+     * のみ数えられる。
+     *
+     * @param data 書き込むデータ
+     * @param cache 同じサンプルを書き込むコネクタで共有するキャッシュ
+     *
+     * @else
+     * @brief Write sharing the serialized data
+     *
+     * If cache has the data of the same serialization key as this
+     * connector, the data is written without serializing. Otherwise the
+     * data is serialized and added to cache. The same as write(data)
+     * if cache is nullptr. The serializer statistics (codec_time and so
+     * on) are counted only in the connector that serialized.
+     *
+     * @param data Data to write
+     * @param cache Cache shared by the connectors writing the same sample
+     *
+     * @endif
+     */
+    template <class DataType>
+    DataPortStatus write(DataType& data, SerializedDataCache* cache)
+    {
+      LatencyTrace::Times times{};
+      if (m_latencyTrace)
+        {
+          times[LatencyTrace::WRITE] = LatencyTrace::now();
+        }
 
       if (m_directInPort != nullptr)
         {
+          DirectChannel<DataType>* channel(directChannel<DataType>());
+          if (channel != nullptr)
+            {
+              return writeDirect(*channel, data, times);
+            }
           DirectInPortBase<DataType>* inport = dynamic_cast<DirectInPortBase<DataType>*>(m_directInPort->getDirectPort());
           if(inport)
             {
               if (inport->isNew())
                 {
+                  ConnectorStatistics::increment(m_profile.statistics().overwrite);
                   // ON_BUFFER_OVERWRITE(In,Out), ON_RECEIVER_FULL(In,Out) callback
                   m_listeners->notifyOut(ConnectorDataListenerType::ON_BUFFER_OVERWRITE, m_profile, data);
                   m_inPortListeners->notifyIn(ConnectorDataListenerType::ON_BUFFER_OVERWRITE, m_profile, data);
@@ -238,6 +385,13 @@ namespace RTC
               RTC_PARANOID(("ON_BUFFER_WRITE(InPort,OutPort), "
                                 "callback called in direct mode."));
               inport->write(data);  // write to InPort variable!!
+              m_inPortListeners->notifyDataArrival(m_profile);
+              m_profile.statistics().countSent(0);
+              if (m_latencyTrace)
+                {
+                  times[LatencyTrace::RECEIVED] = LatencyTrace::now();
+                  LatencyTraceCollector::instance().record(m_traceEntry, times);
+                }
               // ON_RECEIVED(In,Out) callback
               m_listeners->notifyOut(ConnectorDataListenerType::ON_RECEIVED, m_profile, data);
               m_inPortListeners->notifyIn(ConnectorDataListenerType::ON_RECEIVED, m_profile, data);
@@ -248,19 +402,33 @@ namespace RTC
             }
         }
       // normal case
-      if(m_cdr == nullptr)
-      {
-          m_cdr = createSerializer<DataType>(m_marshaling_type);
-      }
-      ::RTC::ByteDataStream<DataType> *cdr = dynamic_cast<::RTC::ByteDataStream<DataType>*>(m_cdr);
-      if (!cdr)
-      {
-          RTC_ERROR(("Can not find Marshalizer: %s", m_marshaling_type.c_str()));
-          return DataPortStatus::PORT_ERROR;
-      }
-      cdr->isLittleEndian(isLittleEndian());
-      cdr->serialize(data);
-      RTC_TRACE(("connector endian: %s", isLittleEndian() ? "little":"big"));
+      ByteDataStreamBase* cdr(nullptr);
+      if (cache != nullptr)
+        {
+          const std::string& key(serializationKey());
+          ByteData* serialized(cache->find(key));
+          if (serialized == nullptr)
+            {
+              ByteDataStreamBase* own(serialize(data));
+              if (own == nullptr) { return DataPortStatus::PORT_ERROR; }
+              serialized = &cache->add(key, *own);
+            }
+          m_sharedStream.data() = *serialized;
+          cdr = &m_sharedStream;
+        }
+      else
+        {
+          cdr = serialize(data);
+          if (cdr == nullptr) { return DataPortStatus::PORT_ERROR; }
+        }
+
+      if (m_latencyTrace)
+        {
+          times[LatencyTrace::SERIALIZED] = LatencyTrace::now();
+          m_traceStream.data() = *cdr;
+          LatencyTrace::append(m_traceStream.data(), times);
+          return write(static_cast<ByteDataStreamBase*>(&m_traceStream));
+        }
       
       // NOTE: need cast to ByteDataStreamBase* to call the another write()
       DataPortStatus ret = write((ByteDataStreamBase*)cdr);
@@ -268,6 +436,25 @@ namespace RTC
       return ret;
     }
 
+    /*!
+     * @if jp
+     * @brief シリアライズキーを取得する
+     *
+     * マーシャリング型、エンディアン、コネクタプロファイルの
+     * serializer 以下の設定からなる文字列。キーが同じコネクタはシリアラ
+     * イズ結果を共有できる。
+     *
+     * @else
+     * @brief Get the serialization key
+     *
+     * The string of the marshaling type, the endian and the settings
+     * under serializer of the connector profile. The connectors with
+     * the same key can share the serialized data.
+     *
+     * @endif
+     */
+    const std::string& serializationKey();
+
     virtual BufferStatus read(ByteData &data);
 
     bool setInPort(InPortBase* directInPort);
@@ -311,6 +498,141 @@ namespace RTC
      */
     virtual void unsubscribeInterface(const coil::Properties& prop);
   protected:
+    /*!
+     * @if jp
+     * @brief ダイレクト接続のチャネルを取得する
+     *
+     * 接続時に開いたチャネルの型を最初の書き込みで一度だけ確認する。型
+     * が異なる場合はチャネルを閉じ、以降は nullptr を返す。
+     *
+     * @else
+     * @brief Get the channel of the direct connection
+     *
+     * The type of the channel opened on connection is checked only
+     * once on the first write. If the type differs, the channel is
+     * closed and nullptr is returned afterwards.
+     *
+     * @endif
+     */
+    template <class DataType>
+    DirectChannel<DataType>* directChannel()
+    {
+      if (!m_directChannelChecked)
+        {
+          m_directChannelChecked = true;
+          if (m_directChannel &&
+              dynamic_cast<DirectChannel<DataType>*>(m_directChannel.get())
+              == nullptr)
+            {
+              RTC_WARN(("data type mismatch, the direct channel is closed"));
+              m_directChannel->close();
+              m_directChannel.reset();
+            }
+        }
+      return static_cast<DirectChannel<DataType>*>(m_directChannel.get());
+    }
+
+    /*!
+     * @if jp
+     * @brief ダイレクト接続のチャネルに書き込む
+     *
+     * コールバックは InPort::write() を使う場合と同じく呼び出される。キュー
+     * がフルの場合は ON_BUFFER_FULL, ON_RECEIVER_FULL を呼び出し
+     * SEND_FULL を返す。
+     *
+     * @else
+     * @brief Write into the channel of the direct connection
+     *
+     * The callbacks are called as with InPort::write(). If the queue is
+     * full, ON_BUFFER_FULL and ON_RECEIVER_FULL are called and
+     * SEND_FULL is returned.
+     *
+     * @endif
+     */
+    template <class DataType>
+    DataPortStatus writeDirect(DirectChannel<DataType>& channel,
+                               DataType& data, LatencyTrace::Times& times)
+    {
+      // ON_BUFFER_WRITE(In,Out) callback
+      m_listeners->notifyOut(ConnectorDataListenerType::ON_BUFFER_WRITE, m_profile, data);
+      m_inPortListeners->notifyIn(ConnectorDataListenerType::ON_BUFFER_WRITE, m_profile, data);
+      RTC_PARANOID(("ON_BUFFER_WRITE(InPort,OutPort), "
+                    "callback called in direct mode."));
+
+      BufferWriteInfo info;
+      BufferStatus ret(channel.write(data, info));
+      m_profile.statistics().countBufferWrite(ret, info);
+      if (ret != BufferStatus::OK)
+        {
+          // ON_BUFFER_FULL(In,Out), ON_RECEIVER_FULL(In,Out) callback
+          m_listeners->notifyOut(ConnectorDataListenerType::ON_BUFFER_FULL, m_profile, data);
+          m_inPortListeners->notifyIn(ConnectorDataListenerType::ON_BUFFER_FULL, m_profile, data);
+          m_listeners->notifyOut(ConnectorDataListenerType::ON_RECEIVER_FULL, m_profile, data);
+          m_inPortListeners->notifyIn(ConnectorDataListenerType::ON_RECEIVER_FULL, m_profile, data);
+          RTC_PARANOID(("ON_BUFFER_FULL(InPort,OutPort), "
+                        "ON_RECEIVER_FULL(InPort,OutPort) "
+                        "callback called in direct mode."));
+          return DataPortStatus::SEND_FULL;
+        }
+      if (info.overwritten > 0)
+        {
+          // ON_BUFFER_OVERWRITE(In,Out), ON_RECEIVER_FULL(In,Out) callback
+          m_listeners->notifyOut(ConnectorDataListenerType::ON_BUFFER_OVERWRITE, m_profile, data);
+          m_inPortListeners->notifyIn(ConnectorDataListenerType::ON_BUFFER_OVERWRITE, m_profile, data);
+          m_listeners->notifyOut(ConnectorDataListenerType::ON_RECEIVER_FULL, m_profile, data);
+          m_inPortListeners->notifyIn(ConnectorDataListenerType::ON_RECEIVER_FULL, m_profile, data);
+          RTC_PARANOID(("ON_BUFFER_OVERWRITE(InPort,OutPort), "
+                        "ON_RECEIVER_FULL(InPort,OutPort) "
+                        "callback called in direct mode."));
+        }
+      m_inPortListeners->notifyDataArrival(m_profile);
+      m_profile.statistics().countSent(0);
+      if (m_latencyTrace)
+        {
+          times[LatencyTrace::RECEIVED] = LatencyTrace::now();
+          LatencyTraceCollector::instance().record(m_traceEntry, times);
+        }
+      // ON_RECEIVED(In,Out) callback
+      m_listeners->notifyOut(ConnectorDataListenerType::ON_RECEIVED, m_profile, data);
+      m_inPortListeners->notifyIn(ConnectorDataListenerType::ON_RECEIVED, m_profile, data);
+      RTC_PARANOID(("ON_RECEIVED(InPort,OutPort), "
+                    "callback called in direct mode."));
+      return DataPortStatus::PORT_OK;
+    }
+
+    /*!
+     * @if jp
+     * @brief データをシリアライズする
+     * @return シリアライズしたストリーム。シリアライザがない場合は nullptr
+     * @else
+     * @brief Serialize the data
+     * @return The serialized stream. nullptr if no serializer is found.
+     * @endif
+     */
+    template <class DataType>
+    ByteDataStreamBase* serialize(DataType& data)
+    {
+      if(m_cdr == nullptr)
+      {
+          m_cdr = createSerializer<DataType>(m_marshaling_type);
+          if (m_cdr != nullptr)
+          {
+              m_cdr->init(m_profile.properties);
+              m_cdr->setStatistics(&m_profile.statistics());
+          }
+      }
+      ::RTC::ByteDataStream<DataType> *cdr = dynamic_cast<::RTC::ByteDataStream<DataType>*>(m_cdr);
+      if (!cdr)
+      {
+          RTC_ERROR(("Can not find Marshalizer: %s", m_marshaling_type.c_str()));
+          return nullptr;
+      }
+      cdr->isLittleEndian(isLittleEndian());
+      cdr->serialize(data);
+      RTC_TRACE(("connector endian: %s", isLittleEndian() ? "little":"big"));
+      return cdr;
+    }
+
     /*!
      * @if jp
      * @brief ロガーストリーム
@@ -347,6 +669,69 @@ namespace RTC
      */
     PortBase* m_directInPort;
 
+    /*!
+     * @if jp
+     * @brief ピアInPortとのダイレクト接続のチャネル
+     * @else
+     * @brief Channel of the direct connection to the peer InPort
+     * @endif
+     */
+    std::shared_ptr<DirectChannelBase> m_directChannel;
+
+    /*!
+     * @if jp
+     * @brief チャネルの型を確認したか
+     * @else
+     * @brief Whether the type of the channel has been checked
+     * @endif
+     */
+    bool m_directChannelChecked{false};
+
+    /*!
+     * @if jp
+     * @brief 遅延時間トレースを行うか
+     *
+     * 受信側の InPortPullConnector はトレーラを取り除かないため、
+     * OutPortPullConnector では false とする。
+     *
+     * @else
+     * @brief Whether the latency is traced
+     *
+     * false in OutPortPullConnector because InPortPullConnector on the
+     * receiver does not strip the trailer.
+     *
+     * @endif
+     */
+    bool m_latencyTrace{false};
+    LatencyTraceCollector::Entry* m_traceEntry{nullptr};
+
+    /*!
+     * @if jp
+     * @brief 遅延時間トレースのトレーラを付加したデータ
+     * @else
+     * @brief Data with the trailer of the latency trace
+     * @endif
+     */
+    LatencyTrace::Stream m_traceStream;
+
+    /*!
+     * @if jp
+     * @brief 他のコネクタがシリアライズしたデータ
+     * @else
+     * @brief Data serialized by another connector
+     * @endif
+     */
+    SharedByteDataStream m_sharedStream;
+
+    /*!
+     * @if jp
+     * @brief シリアライズキー
+     * @else
+     * @brief Serialization key
+     * @endif
+     */
+    std::string m_serializationKey;
+
     /*!
      * @if jp
      * @brief ConnectorListenrs への参照
@@ -386,6 +771,206 @@ namespace RTC
     ByteDataStreamBase* m_cdr;
 
   };
+
+  /*!
+   * @if jp
+   * @class OutPortLoan
+   * @brief OutPort の送信バッファの貸し出し
+   *
+   * OutPort<T>::loan() が返す送信領域。貸し出し中は OutPort のコネク
+   * タリストをロックし、コネクタが削除されないようにする。commit()
+   * せずに破棄した場合、書き込んだデータは送信されない。貸し出した
+   * スレッドで commit() または破棄すること。
+   *
+   * @else
+   * @class OutPortLoan
+   * @brief Send buffer loaned by an OutPort
+   *
+   * The send area returned by OutPort<T>::loan(). The connector list
+   * of the OutPort is locked while loaned so that the connector is not
+   * deleted. If it is destroyed without commit(), the written data is
+   * not sent. It must be committed or destroyed on the thread that
+   * loaned it.
+   *
+   * @endif
+   */
+  class OutPortLoan
+  {
+  public:
+    OutPortLoan() = default;
+
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     *
+     * @param guard OutPort のコネクタリストのロック
+     * @param owner 貸し出したスレッドを記録する OutPort の変数。
+     *              貸し出しの終了時にクリアする
+     * @param connector 送信領域を貸し出したコネクタ
+     * @param data 送信領域の先頭
+     * @param size 送信領域のサイズ
+     *
+     * @else
+     * @brief Constructor
+     *
+     * @param guard Lock of the connector list of the OutPort
+     * @param owner Variable of the OutPort recording the loaning
+     *              thread, cleared at the end of the loan
+     * @param connector Connector that loaned the send area
+     * @param data Head of the send area
+     * @param size Size of the send area
+     *
+     * @endif
+     */
+    OutPortLoan(std::unique_lock<std::mutex>&& guard,
+                std::atomic<std::thread::id>* owner,
+                OutPortConnector* connector,
+                unsigned char* data, unsigned long size)
+      : m_guard(std::move(guard)), m_owner(owner), m_connector(connector),
+        m_data(data), m_size(size)
+    {
+    }
+
+    OutPortLoan(OutPortLoan&& rhs) noexcept
+      : m_guard(std::move(rhs.m_guard)), m_owner(rhs.m_owner),
+        m_connector(rhs.m_connector), m_data(rhs.m_data), m_size(rhs.m_size)
+    {
+      rhs.m_owner = nullptr;
+      rhs.m_connector = nullptr;
+      rhs.m_data = nullptr;
+      rhs.m_size = 0;
+    }
+
+    OutPortLoan& operator=(OutPortLoan&& rhs) noexcept
+    {
+      if (this != &rhs)
+        {
+          release();
+          m_guard = std::move(rhs.m_guard);
+          m_owner = rhs.m_owner;
+          m_connector = rhs.m_connector;
+          m_data = rhs.m_data;
+          m_size = rhs.m_size;
+          rhs.m_owner = nullptr;
+          rhs.m_connector = nullptr;
+          rhs.m_data = nullptr;
+          rhs.m_size = 0;
+        }
+      return *this;
+    }
+
+    ~OutPortLoan()
+    {
+      release();
+    }
+
+    OutPortLoan(const OutPortLoan&) = delete;
+    OutPortLoan& operator=(const OutPortLoan&) = delete;
+
+    /*!
+     * @if jp
+     * @brief 送信領域を貸し出しているか
+     * @else
+     * @brief Whether a send area is loaned
+     * @endif
+     */
+    explicit operator bool() const { return m_data != nullptr; }
+
+    /*!
+     * @if jp
+     * @brief 送信領域の先頭
+     * @else
+     * @brief Head of the send area
+     * @endif
+     */
+    unsigned char* data() const { return m_data; }
+
+    /*!
+     * @if jp
+     * @brief 送信領域のサイズ
+     * @else
+     * @brief Size of the send area
+     * @endif
+     */
+    unsigned long size() const { return m_size; }
+
+    /*!
+     * @if jp
+     * @brief 書き込むデータのエンディアン
+     * @else
+     * @brief Endian of the data to be written
+     * @endif
+     */
+    bool isLittleEndian() const
+    {
+      return m_connector != nullptr && m_connector->isLittleEndian();
+    }
+
+    /*!
+     * @if jp
+     * @brief 貸し出したコネクタ
+     * @else
+     * @brief Connector that loaned the send area
+     * @endif
+     */
+    OutPortConnector* connector() const { return m_connector; }
+
+    /*!
+     * @if jp
+     * @brief 書き込んだデータを送信し、貸し出しを終了する
+     *
+     * @param length 書き込んだデータのサイズ
+     * @param status 結果を格納する OutPort のステータスリスト。コネク
+     *               タリストのロックを解放する前に更新する
+     * @return リターンコード
+     *
+     * @else
+     * @brief Send the written data and end the loan
+     *
+     * @param length Size of the written data
+     * @param status Status list of the OutPort to store the result in,
+     *               updated before the lock of the connector list is
+     *               released
+     * @return Return code
+     *
+     * @endif
+     */
+    DataPortStatus commit(unsigned long length,
+                          DataPortStatusList* status = nullptr)
+    {
+      if (m_data == nullptr)
+        {
+          return DataPortStatus::PRECONDITION_NOT_MET;
+        }
+      DataPortStatus ret(m_connector->commit(length));
+      if (status != nullptr)
+        {
+          status->resize(1);
+          (*status)[0] = ret;
+        }
+      release();
+      return ret;
+    }
+
+  private:
+    void release()
+    {
+      m_data = nullptr;
+      m_size = 0;
+      if (m_owner != nullptr)
+        {
+          m_owner->store(std::thread::id(), std::memory_order_release);
+          m_owner = nullptr;
+        }
+      if (m_guard.owns_lock()) { m_guard.unlock(); }
+    }
+
+    std::unique_lock<std::mutex> m_guard;
+    std::atomic<std::thread::id>* m_owner{nullptr};
+    OutPortConnector* m_connector{nullptr};
+    unsigned char* m_data{nullptr};
+    unsigned long m_size{0};
+  };
 } // namespace RTC
 
 #endif  // RTC_CONNECTORBASE_H
@@ -41,6 +41,8 @@ namespace RTC
       m_buffer(buffer),
       m_sync_readwrite(false)
   {
+    // InPortPullConnector does not strip the latency trace trailer.
+    m_latencyTrace = false;
     // create buffer
     if (m_buffer == nullptr)
       {
@@ -106,7 +108,9 @@ namespace RTC
         }
     }
 
-    m_buffer->write(*data);
+    BufferWriteInfo info;
+    BufferStatus ret(m_buffer->write(*data, std::chrono::nanoseconds(-1), info));
+    m_profile.statistics().countBufferWrite(ret, info);
 
     if (m_sync_readwrite)
     {
@@ -164,6 +168,10 @@ namespace RTC
       }
 
       BufferStatus ret = m_buffer->read(data);
+      if (ret == BufferStatus::OK)
+        {
+          m_profile.statistics().countSent(data.getDataLength());
+        }
 
       if (m_sync_readwrite)
       {
@@ -21,6 +21,7 @@
 
 #include <rtm/OutPortPushConnector.h>
 #include <rtm/ConnectorListener.h>
+#include <rtm/PublisherFlush.h>
 
 #include <string>
 
@@ -94,6 +95,43 @@ namespace RTC
     return m_publisher->write(data, std::chrono::seconds::zero());
   }
 
+  /*!
+   * @if jp
+   * @brief 送信バッファの貸し出し
+   * @else
+   * @brief Loan a send buffer
+   * @endif
+   */
+  unsigned char* OutPortPushConnector::loan(unsigned long size)
+  {
+    RTC_TRACE(("loan(%d)", size));
+    // Only the flush publisher sends synchronously, other publishers may
+    // still hold older samples in the buffer.
+    if (m_consumer == nullptr ||
+        dynamic_cast<PublisherFlush*>(m_publisher) == nullptr)
+      {
+        return nullptr;
+      }
+    return m_consumer->loan(size);
+  }
+
+  /*!
+   * @if jp
+   * @brief 貸し出した送信バッファのデータ送信
+   * @else
+   * @brief Send the data in the loaned send buffer
+   * @endif
+   */
+  DataPortStatus OutPortPushConnector::commit(unsigned long length)
+  {
+    RTC_TRACE(("commit(%d)", length));
+    if (m_consumer == nullptr)
+      {
+        return DataPortStatus::PRECONDITION_NOT_MET;
+      }
+    return m_consumer->commit(length);
+  }
+
   /*!
    * @if jp
    * @brief 接続解除
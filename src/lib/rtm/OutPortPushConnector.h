@@ -190,6 +190,47 @@ namespace RTC
      */
     DataPortStatus write(RTC::ByteDataStreamBase* data) override;
 
+    /*!
+     * @if jp
+     * @brief 送信バッファの貸し出し
+     *
+     * Publisher が flush の場合のみ、InPortConsumer の送信領域を貸し
+     * 出す。貸し出したデータはバッファとリスナを経由せずに送信される。
+     *
+     * @param size 書き込むデータのサイズ
+     * @return 送信領域。貸し出せない場合は nullptr
+     *
+     * @else
+     * @brief Loan a send buffer
+     *
+     * The send area of the InPortConsumer is loaned only with the flush
+     * publisher. Loaned data is sent bypassing the buffer and the
+     * listeners.
+     *
+     * @param size Size of the data to be written
+     * @return Send area, or nullptr if it cannot be loaned
+     *
+     * @endif
+     */
+    unsigned char* loan(unsigned long size) override;
+
+    /*!
+     * @if jp
+     * @brief 貸し出した送信バッファのデータ送信
+     *
+     * @param length 書き込んだデータのサイズ
+     * @return リターンコード
+     *
+     * @else
+     * @brief Send the data in the loaned send buffer
+     *
+     * @param length Size of the written data
+     * @return Return code
+     *
+     * @endif
+     */
+    DataPortStatus commit(unsigned long length) override;
+
     /*!
      * @if jp
      * @brief 接続解除
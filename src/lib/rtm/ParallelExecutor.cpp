@@ -0,0 +1,169 @@
+// -*- C++ -*-
+/*!
+ * @file ParallelExecutor.cpp
+ * @brief Executor running a dependency graph on a bounded thread pool
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <rtm/ParallelExecutor.h>
+
+namespace RTC_impl
+{
+  ParallelExecutor::~ParallelExecutor()
+  {
+    stop();
+  }
+
+  /*!
+   * @if jp
+   * @brief ワーカスレッドを開始する
+   * @else
+   * @brief Start the worker threads
+   * @endif
+   */
+  void ParallelExecutor::start(size_t threads)
+  {
+    stop();
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_running = true;
+    for (size_t i(1); i < threads; ++i)
+      {
+        m_threads.emplace_back([this] { svc(); });
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief ワーカスレッドを停止する
+   * @else
+   * @brief Stop the worker threads
+   * @endif
+   */
+  void ParallelExecutor::stop()
+  {
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      m_running = false;
+    }
+    m_cond.notify_all();
+    for (auto& thread : m_threads)
+      {
+        thread.join();
+      }
+    m_threads.clear();
+  }
+
+  size_t ParallelExecutor::size() const
+  {
+    return m_threads.size() + 1;
+  }
+
+  /*!
+   * @if jp
+   * @brief 依存グラフを実行する
+   * @else
+   * @brief Execute the dependency graph
+   * @endif
+   */
+  void ParallelExecutor::run(const Graph& graph,
+                             const std::function<void(size_t)>& func)
+  {
+    std::unique_lock<std::mutex> guard(m_mutex);
+    m_graph = &graph;
+    m_func = &func;
+    m_pending = graph.indegree;
+    m_remaining = graph.indegree.size();
+    for (size_t i(0); i < graph.indegree.size(); ++i)
+      {
+        if (graph.indegree[i] == 0) { m_ready.push_back(i); }
+      }
+    m_cond.notify_all();
+
+    // The calling thread executes nodes too until all of them finish.
+    while (m_remaining != 0)
+      {
+        if (!execute(guard)) { m_cond.wait(guard); }
+      }
+    m_graph = nullptr;
+    m_func = nullptr;
+
+    if (m_error)
+      {
+        std::exception_ptr error(m_error);
+        m_error = nullptr;
+        guard.unlock();
+        std::rethrow_exception(error);
+      }
+  }
+
+  void ParallelExecutor::svc()
+  {
+    std::unique_lock<std::mutex> guard(m_mutex);
+    while (m_running)
+      {
+        if (!execute(guard)) { m_cond.wait(guard); }
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 実行可能なノードを1つ実行する
+   *
+   * m_mutex を保持した状態で呼び出す。ノードの実行中はロックを解放する。
+   *
+   * @return false: 実行可能なノードがなかった
+   *
+   * @else
+   * @brief Execute one of the ready nodes
+   *
+   * Called with m_mutex held. The lock is released while the node is
+   * executed.
+   *
+   * @return false: no node was ready
+   *
+   * @endif
+   */
+  bool ParallelExecutor::execute(std::unique_lock<std::mutex>& guard)
+  {
+    if (m_ready.empty()) { return false; }
+    size_t node(m_ready.front());
+    m_ready.pop_front();
+    // Valid until m_remaining reaches 0, which needs this node to finish.
+    const Graph& graph(*m_graph);
+    const std::function<void(size_t)>& func(*m_func);
+
+    guard.unlock();
+    std::exception_ptr error;
+    try
+      {
+        func(node);
+      }
+    catch (...)
+      {
+        error = std::current_exception();
+      }
+    guard.lock();
+
+    if (error && !m_error) { m_error = error; }
+    bool notify(--m_remaining == 0);
+    for (auto succ : graph.successors[node])
+      {
+        if (--m_pending[succ] == 0)
+          {
+            m_ready.push_back(succ);
+            notify = true;
+          }
+      }
+    if (notify) { m_cond.notify_all(); }
+    return true;
+  }
+} // namespace RTC_impl
@@ -0,0 +1,170 @@
+// -*- C++ -*-
+/*!
+ * @file ParallelExecutor.h
+ * @brief Executor running a dependency graph on a bounded thread pool
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_PARALLELEXECUTOR_H
+#define RTC_PARALLELEXECUTOR_H
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace RTC_impl
+{
+  /*!
+   * @if jp
+   * @class ParallelExecutor
+   * @brief 依存グラフを固定数のスレッドで実行するエグゼキュータ
+   *
+   * run() に与えた有向非巡回グラフの各ノードを、先行するノードがすべて
+   * 終了した後に、呼び出しスレッドと start() で生成したワーカスレッド
+   * のいずれかで実行する。run() はすべてのノードの実行が終了するまで
+   * 戻らない。
+   *
+   * @else
+   * @class ParallelExecutor
+   * @brief Executor running a dependency graph on a fixed number of threads
+   *
+   * Each node of the directed acyclic graph given to run() is executed,
+   * after all of its predecessors finished, by the calling thread or by
+   * one of the worker threads created by start(). run() does not return
+   * until all the nodes are executed.
+   *
+   * @endif
+   */
+  class ParallelExecutor
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief 依存グラフ
+     *
+     * successors[i] はノード i の後に実行するノード、indegree[i] はノー
+     * ド i の先行ノードの数。
+     *
+     * @else
+     * @brief Dependency graph
+     *
+     * successors[i] are the nodes executed after the node i, and
+     * indegree[i] is the number of the predecessors of the node i.
+     *
+     * @endif
+     */
+    struct Graph
+    {
+      std::vector<std::vector<size_t>> successors;
+      std::vector<size_t> indegree;
+    };
+
+    ParallelExecutor() = default;
+
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     *
+     * ワーカスレッドを停止する。
+     *
+     * @else
+     * @brief Destructor
+     *
+     * Stops the worker threads.
+     *
+     * @endif
+     */
+    ~ParallelExecutor();
+
+    ParallelExecutor(const ParallelExecutor&) = delete;
+    ParallelExecutor& operator=(const ParallelExecutor&) = delete;
+
+    /*!
+     * @if jp
+     * @brief ワーカスレッドを開始する
+     *
+     * @param threads 呼び出しスレッドを含むスレッド数。threads - 1 個の
+     *                ワーカスレッドを生成する。
+     *
+     * @else
+     * @brief Start the worker threads
+     *
+     * @param threads Number of the threads including the calling thread.
+     *                threads - 1 worker threads are created.
+     *
+     * @endif
+     */
+    void start(size_t threads);
+
+    /*!
+     * @if jp
+     * @brief ワーカスレッドを停止する
+     * @else
+     * @brief Stop the worker threads
+     * @endif
+     */
+    void stop();
+
+    /*!
+     * @if jp
+     * @brief 呼び出しスレッドを含むスレッド数を取得する
+     * @else
+     * @brief Get the number of the threads including the calling thread
+     * @endif
+     */
+    size_t size() const;
+
+    /*!
+     * @if jp
+     * @brief 依存グラフを実行する
+     *
+     * ノードの実行中に投げられた例外は、すべてのノードの終了後に呼び出し
+     * スレッドで再送出される。
+     *
+     * @param graph 依存グラフ
+     * @param func ノード番号を引数として呼び出す関数
+     *
+     * @else
+     * @brief Execute the dependency graph
+     *
+     * An exception thrown by a node is rethrown on the calling thread
+     * after all the nodes finished.
+     *
+     * @param graph Dependency graph
+     * @param func Function called with the node index
+     *
+     * @endif
+     */
+    void run(const Graph& graph, const std::function<void(size_t)>& func);
+
+  private:
+    void svc();
+    bool execute(std::unique_lock<std::mutex>& guard);
+
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    const Graph* m_graph{nullptr};
+    const std::function<void(size_t)>* m_func{nullptr};
+    std::vector<size_t> m_pending;
+    std::deque<size_t> m_ready;
+    size_t m_remaining{0};
+    std::exception_ptr m_error;
+    bool m_running{false};
+  };
+} // namespace RTC_impl
+
+#endif  // RTC_PARALLELEXECUTOR_H
@@ -18,9 +18,14 @@
 
 #include <rtm/PeriodicExecutionContext.h>
 #include <rtm/RTObjectStateMachine.h>
+#include <rtm/NVUtil.h>
+#include <rtm/CORBA_SeqUtil.h>
 
+#include <cerrno>
 #include <cstring>
+#include <ctime>
 #include <algorithm>
+#include <fstream>
 #include <iostream>
 #include <string>
 
@@ -60,6 +65,7 @@ namespace RTC_exp
   PeriodicExecutionContext::~PeriodicExecutionContext()
   {
     RTC_TRACE(("~PeriodicExecutionContext()"));
+    stopDumpThread();
     {
       std::lock_guard<std::mutex> guard(m_svcmutex);
       m_svc = false;
@@ -78,6 +84,9 @@ namespace RTC_exp
     ExecutionContextBase::init(props);
 
     setCpuAffinity(props);
+    setParallelExecution(props);
+    setStatistics(props);
+    setScheduling(props);
 
     RTC_DEBUG(("init() done"));
   }
@@ -115,42 +124,18 @@ namespace RTC_exp
   {
     RTC_TRACE(("svc()"));
 
-    if (!m_cpu.empty())
-    {
-        bool result = coil::setThreadCpuAffinity(m_cpu);
-
-        if (!result)
-        {
-            RTC_ERROR(("setThreadCpuAffinity():"
-                "CPU affinity mask setting failed"));
-        }
-
-        coil::CpuMask ret_cpu;
-        result = coil::getThreadCpuAffinity(ret_cpu);
-
-
-#ifdef RTM_OS_LINUX
-        std::sort(ret_cpu.begin(), ret_cpu.end());
-        std::sort(m_cpu.begin(), m_cpu.end());
-        if (result && !ret_cpu.empty() && !m_cpu.empty() && ret_cpu.size() == m_cpu.size()
-            && std::equal(ret_cpu.begin(), ret_cpu.end(), m_cpu.begin()))
-        {
-
-        }
-        else
-        {
-            RTC_ERROR(("coil::getThreadCpuAffinity(): returned error."));
-        }
-#endif
-    }
-    else
-    {
-        RTC_DEBUG(("cpu affinity is not set"));
-    }
+    applyCpuAffinity();
 
+    // the release times are aligned again when the loop (re)starts
+    bool resync(true);
     do
       {
+        auto t = std::chrono::steady_clock::now();
         ExecutionContextBase::invokeWorkerPreDo();
+        if (m_statistics)
+          {
+            m_stats.pre_do.record(std::chrono::steady_clock::now() - t);
+          }
         // Thread will stopped when all RTCs are INACTIVE.
         // Therefore WorkerPreDo(updating state) have to be invoked
         // before stopping thread.
@@ -159,18 +144,42 @@ namespace RTC_exp
           while (!m_workerthread.running_)
             {
               m_workerthread.cond_.wait(guard);
+              resync = true;
             }
         }
-        auto t0 = std::chrono::high_resolution_clock::now();
+        auto period = getPeriod();
+        auto t0 = std::chrono::steady_clock::now();
+        if (m_absolute && (resync || period != m_releasePeriod))
+          {
+            // run now as the release on the grid just passed
+            m_release = floorRelease(t0, period);
+            m_releasePeriod = period;
+            resync = false;
+          }
+        if (m_statistics) { m_worker.setDeadline(t0 + period); }
         ExecutionContextBase::invokeWorkerDo();
+        if (m_statistics)
+          {
+            t = std::chrono::steady_clock::now();
+            m_stats.exec_time.record(t - t0);
+          }
         ExecutionContextBase::invokeWorkerPostDo();
-        if (!m_nowait)
+        auto t1 = std::chrono::steady_clock::now();
+        if (m_statistics)
+          {
+            m_stats.post_do.record(t1 - t);
+            m_stats.cycles.fetch_add(1, std::memory_order_relaxed);
+          }
+        if (!m_nowait && m_absolute)
+          {
+            waitNextRelease(t1);
+          }
+        else if (!m_nowait)
           {
-            auto t1 = std::chrono::high_resolution_clock::now();
             auto exectime = t1 - t0;
             if (exectime.count() >= 0)
               {
-                auto diff = getPeriod() - exectime;
+                auto diff = period - exectime;
                 if (diff.count() > 0)
                   {
 #ifdef _WIN32
@@ -180,6 +189,15 @@ namespace RTC_exp
                     std::this_thread::sleep_for(diff);
 
 #endif
+                    if (m_statistics)
+                      {
+                        m_stats.sleep_error.record(std::chrono::steady_clock::now()
+                                                   - t1 - diff);
+                      }
+                  }
+                else if (m_statistics)
+                  {
+                    m_stats.overrun.fetch_add(1, std::memory_order_relaxed);
                   }
               }
           }
@@ -373,7 +391,32 @@ namespace RTC_exp
    */
   RTC::ExecutionContextProfile* PeriodicExecutionContext::get_profile()
   {
-    return ExecutionContextBase::getProfile();
+    RTC::ExecutionContextProfile_var prof = ExecutionContextBase::getProfile();
+    if (m_statistics)
+      {
+        // added to the copy only, the stored profile is left unchanged
+        coil::Properties prop;
+        prop.getNode("statistics") << getStatistics();
+        SDOPackage::NVList nv;
+        NVUtil::copyFromProperties(nv, prop);
+        CORBA_SeqUtil::push_back_list(prof->properties, nv);
+      }
+    return prof._retn();
+  }
+
+  /*!
+   * @if jp
+   * @brief 実行時間の統計値を取得する
+   * @else
+   * @brief Get the execution time statistics
+   * @endif
+   */
+  coil::Properties PeriodicExecutionContext::getStatistics()
+  {
+    coil::Properties prop;
+    m_stats.getProperties(prop);
+    m_worker.getStatistics(prop.getNode("rtcs"));
+    return prop;
   }
 
 
@@ -588,6 +631,49 @@ namespace RTC_exp
     return RTC::RTC_OK;
   }
 
+  /*!
+   * @if jp
+   * @brief 呼び出したスレッドに cpu_affinity を設定する
+   * @else
+   * @brief Apply cpu_affinity to the calling thread
+   * @endif
+   */
+  void PeriodicExecutionContext::applyCpuAffinity()
+  {
+    if (!m_cpu.empty())
+    {
+        bool result = coil::setThreadCpuAffinity(m_cpu);
+
+        if (!result)
+        {
+            RTC_ERROR(("setThreadCpuAffinity():"
+                "CPU affinity mask setting failed"));
+        }
+
+        coil::CpuMask ret_cpu;
+        result = coil::getThreadCpuAffinity(ret_cpu);
+
+
+#ifdef RTM_OS_LINUX
+        std::sort(ret_cpu.begin(), ret_cpu.end());
+        std::sort(m_cpu.begin(), m_cpu.end());
+        if (result && !ret_cpu.empty() && !m_cpu.empty() && ret_cpu.size() == m_cpu.size()
+            && std::equal(ret_cpu.begin(), ret_cpu.end(), m_cpu.begin()))
+        {
+
+        }
+        else
+        {
+            RTC_ERROR(("coil::getThreadCpuAffinity(): returned error."));
+        }
+#endif
+    }
+    else
+    {
+        RTC_DEBUG(("cpu affinity is not set"));
+    }
+  }
+
   void PeriodicExecutionContext::setCpuAffinity(coil::Properties& props)
   {
     RTC_TRACE(("setCpuAffinity()"));
@@ -609,6 +695,224 @@ namespace RTC_exp
       }
   }
 
+  void PeriodicExecutionContext::setParallelExecution(coil::Properties& props)
+  {
+    RTC_TRACE(("setParallelExecution()"));
+    size_t threads(0);
+    getProperty(props, "parallel_threads", threads);
+
+    std::vector<coil::vstring> groups;
+    for (auto& group : coil::split(props.getProperty("parallel_groups"), ";", true))
+      {
+        groups.emplace_back(coil::split(group, ",", true));
+      }
+    RTC_DEBUG(("parallel threads: %d, groups: %d", threads, groups.size()));
+
+    // Worker threads are created here, so they do not inherit the CPU
+    // affinity of the EC thread.
+    m_worker.setParallelExecution(threads, groups);
+  }
+
+  void PeriodicExecutionContext::setStatistics(coil::Properties& props)
+  {
+    RTC_TRACE(("setStatistics()"));
+    m_statistics = coil::toBool(props.getProperty("statistics"),
+                                "YES", "NO", false);
+    m_dumpFile = props.getProperty("statistics.dump_file");
+    double interval(1.0);
+    getProperty(props, "statistics.dump_interval", interval);
+    if (interval <= 0.0) { interval = 1.0; }
+    m_dumpInterval = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::duration<double>(interval));
+    RTC_DEBUG(("statistics: %s, dump file: %s",
+               m_statistics ? "YES" : "NO", m_dumpFile.c_str()));
+
+    m_worker.setStatistics(m_statistics);
+    stopDumpThread();
+    if (m_statistics && !m_dumpFile.empty()) { startDumpThread(); }
+  }
+
+  void PeriodicExecutionContext::setScheduling(coil::Properties& props)
+  {
+    RTC_TRACE(("setScheduling()"));
+    std::string mode(coil::normalize(props.getProperty("release_mode", "relative")));
+    m_absolute = (mode == "absolute");
+
+    std::string policy(coil::normalize(props.getProperty("overrun_policy", "skip")));
+    if (policy == "catch_up")
+      {
+        m_overrunPolicy = OverrunPolicy::CATCH_UP;
+      }
+    else if (policy == "immediate")
+      {
+        m_overrunPolicy = OverrunPolicy::IMMEDIATE;
+      }
+    else
+      {
+        if (policy != "skip")
+          {
+            RTC_WARN(("Unknown overrun policy: %s. skip is used.",
+                      policy.c_str()));
+          }
+        m_overrunPolicy = OverrunPolicy::SKIP;
+      }
+
+    double phase(0.0);
+    getProperty(props, "phase_offset", phase);
+    m_phase = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::duration<double>(phase));
+    RTC_DEBUG(("release mode: %s, overrun policy: %s, phase offset: %f",
+               mode.c_str(), policy.c_str(), phase));
+  }
+
+  /*!
+   * @if jp
+   * @brief 指定時刻以前で最後のリリース時刻を求める
+   *
+   * リリース時刻は steady_clock のエポックから phase_offset + n * 周期
+   * の時刻であり、同じ周期と位相のECは同じ時刻にリリースされる。
+   *
+   * @else
+   * @brief Get the last release time at or before the given time
+   *
+   * The release times are phase_offset + n * period from the epoch of
+   * steady_clock, so ECs with the same period and phase are released at
+   * the same times.
+   *
+   * @endif
+   */
+  std::chrono::steady_clock::time_point
+  PeriodicExecutionContext::floorRelease(std::chrono::steady_clock::time_point tm,
+                                         std::chrono::nanoseconds period)
+  {
+    if (period.count() <= 0) { return tm; }
+    auto since = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   tm.time_since_epoch()) - m_phase;
+    auto rem = since % period;
+    if (rem.count() < 0) { rem += period; }
+    return tm - rem;
+  }
+
+  /*!
+   * @if jp
+   * @brief 次のリリース時刻まで待つ
+   *
+   * 次のリリース時刻を過ぎていた場合はオーバーランとし、
+   * overrun_policy に従う。
+   *
+   * - skip: 過ぎたリリースを飛ばし、次の周期の時刻まで待つ
+   * - catch_up: 待たずに実行し、過ぎたリリースの分だけ続けて実行する
+   * - immediate: 待たずに実行し、その時刻から周期を数え直す
+   *
+   * @else
+   * @brief Wait for the next release time
+   *
+   * If the next release time has passed, it is an overrun handled
+   * according to overrun_policy.
+   *
+   * - skip: skips the missed releases and waits for the next one
+   * - catch_up: runs without waiting, as many times as the missed
+   *   releases
+   * - immediate: runs without waiting and counts the period from then
+   *
+   * @endif
+   */
+  void PeriodicExecutionContext::
+  waitNextRelease(std::chrono::steady_clock::time_point now)
+  {
+    m_release += m_releasePeriod;
+    if (m_release <= now)
+      {
+        if (m_statistics)
+          {
+            m_stats.overrun.fetch_add(1, std::memory_order_relaxed);
+          }
+        switch (m_overrunPolicy)
+          {
+          case OverrunPolicy::CATCH_UP:
+            return;
+          case OverrunPolicy::IMMEDIATE:
+            m_release = now;
+            return;
+          case OverrunPolicy::SKIP:
+          default:
+            m_release = floorRelease(now, m_releasePeriod) + m_releasePeriod;
+            break;
+          }
+      }
+
+    sleepUntil(m_release);
+    if (m_statistics)
+      {
+        m_stats.sleep_error.record(std::chrono::steady_clock::now() - m_release);
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 指定した時刻まで待つ
+   * @else
+   * @brief Sleep until the given time
+   * @endif
+   */
+  void PeriodicExecutionContext::
+  sleepUntil(std::chrono::steady_clock::time_point tm)
+  {
+#ifdef RTM_OS_LINUX
+    // steady_clock is CLOCK_MONOTONIC
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                tm.time_since_epoch()).count();
+    struct timespec ts;
+    ts.tv_sec = static_cast<time_t>(ns / 1000000000);
+    ts.tv_nsec = static_cast<long>(ns % 1000000000);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {}
+#else
+    std::this_thread::sleep_until(tm);
+#endif
+  }
+
+  void PeriodicExecutionContext::dumpStatistics()
+  {
+    std::ofstream ofs(m_dumpFile.c_str(), std::ios::out | std::ios::trunc);
+    if (!ofs)
+      {
+        RTC_WARN(("Cannot open the statistics dump file: %s",
+                  m_dumpFile.c_str()));
+        return;
+      }
+    getStatistics().store(ofs, "ExecutionContext statistics");
+  }
+
+  void PeriodicExecutionContext::startDumpThread()
+  {
+    {
+      std::lock_guard<std::mutex> guard(m_dumpMutex);
+      m_dumpStop = false;
+    }
+    // The histograms can be read concurrently with the EC thread
+    // recording them, so nothing is copied on the EC thread.
+    m_dumpThread = std::thread([this] {
+        std::unique_lock<std::mutex> guard(m_dumpMutex);
+        while (!m_dumpCond.wait_for(guard, m_dumpInterval,
+                                    [this] { return m_dumpStop; }))
+          {
+            guard.unlock();
+            dumpStatistics();
+            guard.lock();
+          }
+      });
+  }
+
+  void PeriodicExecutionContext::stopDumpThread()
+  {
+    {
+      std::lock_guard<std::mutex> guard(m_dumpMutex);
+      m_dumpStop = true;
+    }
+    m_dumpCond.notify_all();
+    if (m_dumpThread.joinable()) { m_dumpThread.join(); }
+  }
+
 } // namespace RTC_exp
 
 extern "C"
@@ -24,7 +24,9 @@
 #include <coil/Affinity.h>
 
 #include <rtm/ExecutionContextBase.h>
+#include <rtm/ExecutionStatistics.h>
 
+#include <thread>
 #include <vector>
 #include <iostream>
 
@@ -567,6 +569,35 @@ namespace RTC_exp
      */
     RTC::ExecutionContextProfile* get_profile() override;
 
+    /*!
+     * @if jp
+     * @brief 実行時間の統計値を取得する
+     *
+     * 周期ごとの統計値 (cycles, overrun, pre_do.*, exec_time.*,
+     * post_do.*, sleep_error.*) と、コンポーネントごとの統計値
+     * (rtcs.<インスタンス名>.exec_time.*,
+     * rtcs.<インスタンス名>.deadline_miss) を取得する。時間の単位はナ
+     * ノ秒。統計が有効な場合、get_profile() の properties にも
+     * statistics.* として設定される。
+     *
+     * @return 統計値
+     *
+     * @else
+     * @brief Get the execution time statistics
+     *
+     * Gets the per-cycle statistics (cycles, overrun, pre_do.*,
+     * exec_time.*, post_do.* and sleep_error.*) and the per-component
+     * ones (rtcs.<instance name>.exec_time.* and
+     * rtcs.<instance name>.deadline_miss). The times are in
+     * nanoseconds. If the statistics are enabled, they are also set as
+     * statistics.* to the properties of get_profile().
+     *
+     * @return Statistics
+     *
+     * @endif
+     */
+    coil::Properties getStatistics();
+
   protected:
     template <class T>
     void getProperty(coil::Properties& prop, const char* key, T& value)
@@ -636,6 +667,57 @@ namespace RTC_exp
      */
     virtual void setCpuAffinity(coil::Properties& props);
 
+    /*!
+     * @brief applying the CPU affinity to the calling thread
+     */
+    void applyCpuAffinity();
+
+    /*!
+     * @brief setting parallel execution of the components from given
+     *        properties
+     */
+    virtual void setParallelExecution(coil::Properties& props);
+
+    /*!
+     * @brief setting execution time statistics from given properties
+     */
+    virtual void setStatistics(coil::Properties& props);
+
+    /*!
+     * @brief setting the release mode, the overrun policy and the phase
+     *        offset from given properties
+     */
+    virtual void setScheduling(coil::Properties& props);
+
+    std::chrono::steady_clock::time_point
+    floorRelease(std::chrono::steady_clock::time_point tm,
+                 std::chrono::nanoseconds period);
+    void waitNextRelease(std::chrono::steady_clock::time_point now);
+    void sleepUntil(std::chrono::steady_clock::time_point tm);
+
+    /*!
+     * @brief writing the execution time statistics to the dump file
+     */
+    void dumpStatistics();
+
+    /*!
+     * @if jp
+     * @brief 統計値のダンプスレッドを開始・停止する
+     *
+     * ダンプは dump_interval ごとにこのスレッドで行い、EC のスレッドは
+     * ファイル I/O や統計値の整形を行わない。
+     *
+     * @else
+     * @brief Start or stop the thread dumping the statistics
+     *
+     * The statistics are dumped by this thread every dump_interval, so
+     * the EC thread does no file I/O and no formatting of them.
+     *
+     * @endif
+     */
+    void startDumpThread();
+    void stopDumpThread();
+
     bool threadRunning()
     {
       std::lock_guard<std::mutex> guard(m_svcmutex);
@@ -700,6 +782,49 @@ namespace RTC_exp
      */
     coil::CpuMask m_cpu;
 
+    /*!
+     * @if jp
+     * @brief 実行時間の統計
+     * @else
+     * @brief Execution time statistics
+     * @endif
+     */
+    bool m_statistics{false};
+    RTC_impl::ExecutionStatistics m_stats;
+    std::string m_dumpFile;
+    std::chrono::nanoseconds m_dumpInterval{std::chrono::seconds(1)};
+    std::thread m_dumpThread;
+    std::mutex m_dumpMutex;
+    std::condition_variable m_dumpCond;
+    bool m_dumpStop{false};
+
+    /*!
+     * @if jp
+     * @brief 絶対時刻によるリリース
+     *
+     * m_absolute が true の場合、周期は処理の終了時刻からではなく、
+     * m_release から数える。
+     *
+     * @else
+     * @brief Release at absolute times
+     *
+     * If m_absolute is true, the period is counted from m_release rather
+     * than from the end of the processing.
+     *
+     * @endif
+     */
+    enum class OverrunPolicy
+    {
+      SKIP,
+      CATCH_UP,
+      IMMEDIATE
+    };
+    bool m_absolute{false};
+    OverrunPolicy m_overrunPolicy{OverrunPolicy::SKIP};
+    std::chrono::nanoseconds m_phase{0};
+    std::chrono::steady_clock::time_point m_release;
+    std::chrono::nanoseconds m_releasePeriod{0};
+
   };  // class PeriodicExecutionContext
 } // namespace RTC_exp
 
@@ -0,0 +1,662 @@
+﻿// -*- C++ -*-
+/*!
+ * @file PooledPeriodicTask.cpp
+ * @brief PeriodicTask executed on a shared thread pool
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <coil/stringutil.h>
+
+#include <rtm/PooledPeriodicTask.h>
+#include <rtm/PeriodicTaskFactory.h>
+#include <rtm/Manager.h>
+
+#include <algorithm>
+
+namespace RTC
+{
+  namespace
+  {
+    // Index of the worker running on this thread, or -1 on other threads.
+    thread_local long t_worker = -1;
+  } // namespace
+
+  /*!
+   * @if jp
+   * @brief インスタンスの取得
+   * @else
+   * @brief Get the instance
+   * @endif
+   */
+  PeriodicTaskPool& PeriodicTaskPool::instance()
+  {
+    static PeriodicTaskPool pool([]
+      {
+        size_t size(0);
+        coil::stringTo(size, Manager::instance().getConfig()
+                       .getProperty("manager.thread_pool.size", "0").c_str());
+        if (size == 0)
+          {
+            size = std::max(2u, std::thread::hardware_concurrency());
+          }
+        return size;
+      }());
+    return pool;
+  }
+
+  /*!
+   * @if jp
+   * @brief コンストラクタ
+   * @else
+   * @brief Constructor
+   * @endif
+   */
+  PeriodicTaskPool::PeriodicTaskPool(size_t size)
+  {
+    for (size_t i(0); i < size; ++i)
+      {
+        m_workers.emplace_back(new Worker());
+      }
+    for (size_t i(0); i < size; ++i)
+      {
+        m_workers[i]->thread = std::thread([this, i]{ svc(i); });
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief デストラクタ
+   * @else
+   * @brief Destructor
+   * @endif
+   */
+  PeriodicTaskPool::~PeriodicTaskPool()
+  {
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      m_running = false;
+    }
+    m_cond.notify_all();
+    for (auto& worker : m_workers)
+      {
+        worker->thread.join();
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief タスクを実行キューに追加する
+   * @else
+   * @brief Enqueue a task
+   * @endif
+   */
+  void PeriodicTaskPool::push(PooledPeriodicTask* task)
+  {
+    size_t index(t_worker >= 0 ? static_cast<size_t>(t_worker)
+                 : m_next.fetch_add(1, std::memory_order_relaxed));
+    enqueue(index % m_workers.size(), task);
+    notify();
+  }
+
+  /*!
+   * @if jp
+   * @brief 指定時刻にタスクを実行キューに追加する
+   * @else
+   * @brief Enqueue a task at the given time
+   * @endif
+   */
+  void PeriodicTaskPool::pushAt(PooledPeriodicTask* task,
+                                std::chrono::steady_clock::time_point time)
+  {
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      m_timers.emplace(time, task);
+    }
+    // A sleeping worker has to recompute its wait time.
+    m_cond.notify_one();
+  }
+
+  /*!
+   * @if jp
+   * @brief タイマで待機中のタスクを取り消す
+   * @else
+   * @brief Cancel a task waiting on the timer
+   * @endif
+   */
+  bool PeriodicTaskPool::cancel(PooledPeriodicTask* task)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    for (auto it = m_timers.begin(); it != m_timers.end(); ++it)
+      {
+        if (it->second == task)
+          {
+            m_timers.erase(it);
+            return true;
+          }
+      }
+    return false;
+  }
+
+  /*!
+   * @if jp
+   * @brief ワーカごとの統計情報を取得する
+   * @else
+   * @brief Get the statistics of each worker
+   * @endif
+   */
+  std::vector<PeriodicTaskPool::WorkerStatistics>
+  PeriodicTaskPool::getStatistics()
+  {
+    std::vector<WorkerStatistics> stats;
+    stats.reserve(m_workers.size());
+    for (auto& worker : m_workers)
+      {
+        std::lock_guard<std::mutex> guard(worker->mutex);
+        stats.push_back(worker->stat);
+        stats.back().queue_depth = worker->queue.size();
+      }
+    return stats;
+  }
+
+  /*!
+   * @if jp
+   * @brief ワーカ数を取得する
+   * @else
+   * @brief Get the number of workers
+   * @endif
+   */
+  size_t PeriodicTaskPool::size() const
+  {
+    return m_workers.size();
+  }
+
+  /*!
+   * @if jp
+   * @brief ワーカスレッド実行関数
+   * @else
+   * @brief Worker thread function
+   * @endif
+   */
+  void PeriodicTaskPool::svc(size_t index)
+  {
+    t_worker = static_cast<long>(index);
+    while (true)
+      {
+        PooledPeriodicTask* task(take(index));
+        if (task != nullptr)
+          {
+            task->run();
+            continue;
+          }
+
+        std::unique_lock<std::mutex> guard(m_mutex);
+        if (!m_running) { return; }
+
+        // Move the tasks whose time has come to this worker.
+        auto now = std::chrono::steady_clock::now();
+        while (!m_timers.empty() && m_timers.begin()->first <= now)
+          {
+            enqueue(index, m_timers.begin()->second);
+            m_timers.erase(m_timers.begin());
+          }
+        if (m_pending.load(std::memory_order_acquire) > 0) { continue; }
+
+        if (m_timers.empty())
+          {
+            m_cond.wait(guard);
+          }
+        else
+          {
+            // Copied since the entry may be canceled while waiting.
+            auto next = m_timers.begin()->first;
+            m_cond.wait_until(guard, next);
+          }
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief ワーカのキューにタスクを追加する
+   * @else
+   * @brief Add a task to the queue of a worker
+   * @endif
+   */
+  void PeriodicTaskPool::enqueue(size_t index, PooledPeriodicTask* task)
+  {
+    Worker& worker(*m_workers[index]);
+    std::lock_guard<std::mutex> guard(worker.mutex);
+    worker.queue.push_back(task);
+    worker.stat.max_queue_depth = std::max(worker.stat.max_queue_depth,
+                                           worker.queue.size());
+    m_pending.fetch_add(1, std::memory_order_release);
+  }
+
+  /*!
+   * @if jp
+   * @brief 実行するタスクを取り出す
+   *
+   * 自身のキューの先頭から取り出し、空の場合は他のワーカのキューの末
+   * 尾から奪う。
+   *
+   * @else
+   * @brief Take a task to execute
+   *
+   * The task is taken from the head of the own queue, or stolen from
+   * the tail of the other workers' queues if it is empty.
+   *
+   * @endif
+   */
+  PooledPeriodicTask* PeriodicTaskPool::take(size_t index)
+  {
+    Worker& self(*m_workers[index]);
+    {
+      std::lock_guard<std::mutex> guard(self.mutex);
+      if (!self.queue.empty())
+        {
+          PooledPeriodicTask* task(self.queue.front());
+          self.queue.pop_front();
+          ++self.stat.executed;
+          m_pending.fetch_sub(1, std::memory_order_relaxed);
+          return task;
+        }
+    }
+    for (size_t i(1); i < m_workers.size(); ++i)
+      {
+        Worker& victim(*m_workers[(index + i) % m_workers.size()]);
+        PooledPeriodicTask* task(nullptr);
+        {
+          std::lock_guard<std::mutex> guard(victim.mutex);
+          if (victim.queue.empty()) { continue; }
+          task = victim.queue.back();
+          victim.queue.pop_back();
+          m_pending.fetch_sub(1, std::memory_order_relaxed);
+        }
+        std::lock_guard<std::mutex> guard(self.mutex);
+        ++self.stat.executed;
+        ++self.stat.stolen;
+        return task;
+      }
+    return nullptr;
+  }
+
+  /*!
+   * @if jp
+   * @brief 待機中のワーカを起こす
+   * @else
+   * @brief Wake up a waiting worker
+   * @endif
+   */
+  void PeriodicTaskPool::notify()
+  {
+    // Taking the mutex orders this against a worker that has checked
+    // m_pending and is about to wait.
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+    }
+    m_cond.notify_one();
+  }
+
+  /*!
+   * @if jp
+   * @brief コンストラクタ
+   * @else
+   * @brief Constructor
+   * @endif
+   */
+  PooledPeriodicTask::PooledPeriodicTask() = default;
+
+  /*!
+   * @if jp
+   * @brief デストラクタ
+   * @else
+   * @brief Destructor
+   * @endif
+   */
+  PooledPeriodicTask::~PooledPeriodicTask()
+  {
+    finalize();
+    std::unique_lock<std::mutex> guard(m_mutex);
+    while (m_scheduled || m_running)
+      {
+        // A finishing run() may still put the task on the timer after
+        // finalize(), so the timer is checked until the task is idle.
+        guard.unlock();
+        bool canceled(PeriodicTaskPool::instance().cancel(this));
+        guard.lock();
+        if (canceled) { m_scheduled = false; }
+        m_cond.wait_for(guard, std::chrono::milliseconds(10),
+                        [this]{ return !m_scheduled && !m_running; });
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief タスクの開始
+   * @else
+   * @brief Start the task
+   * @endif
+   */
+  void PooledPeriodicTask::activate()
+  {
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      if (m_func == nullptr) { return; }
+      if (m_alive) { return; }
+      m_alive = true;
+      if (m_suspend) { return; }
+    }
+    schedule();
+  }
+
+  /*!
+   * @if jp
+   * @brief タスクの終了
+   * @else
+   * @brief Finalize the task
+   * @endif
+   */
+  void PooledPeriodicTask::finalize()
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_alive = false;
+  }
+
+  /*!
+   * @if jp
+   * @brief タスクの一時停止
+   * @else
+   * @brief Suspend the task
+   * @endif
+   */
+  int PooledPeriodicTask::suspend()
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_suspend = true;
+    return 0;
+  }
+
+  /*!
+   * @if jp
+   * @brief タスクの再開
+   * @else
+   * @brief Resume the task
+   * @endif
+   */
+  int PooledPeriodicTask::resume()
+  {
+    {
+      std::lock_guard<std::mutex> guard(m_statMutex);
+      m_periodTime.reset();
+      m_execTime.reset();
+      m_periodStarted = false;
+    }
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      m_suspend = false;
+    }
+    schedule();
+    return 0;
+  }
+
+  /*!
+   * @if jp
+   * @brief タスクを1回実行する
+   * @else
+   * @brief Execute the task once
+   * @endif
+   */
+  void PooledPeriodicTask::signal()
+  {
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      m_signaled = true;
+    }
+    schedule();
+  }
+
+  /*!
+   * @if jp
+   * @brief タスク関数のセット
+   * @else
+   * @brief Set the task function
+   * @endif
+   */
+  void PooledPeriodicTask::setTask(std::function<void(void)> func)
+  {
+    m_func = std::move(func);
+  }
+
+  /*!
+   * @if jp
+   * @brief タスク実行周期のセット
+   * @else
+   * @brief Set the task execution period
+   * @endif
+   */
+  void PooledPeriodicTask::setPeriod(std::chrono::nanoseconds period)
+  {
+    m_period = period;
+  }
+
+  /*!
+   * @if jp
+   * @brief タスク関数実行時間計測を有効にするか
+   * @else
+   * @brief Validate a Task execute time measurement
+   * @endif
+   */
+  void PooledPeriodicTask::executionMeasure(bool value)
+  {
+    m_execMeasure = value;
+  }
+
+  /*!
+   * @if jp
+   * @brief タスク関数実行時間計測周期
+   * @else
+   * @brief Task execute time measurement period
+   * @endif
+   */
+  void PooledPeriodicTask::executionMeasureCount(unsigned int n)
+  {
+    m_execCountMax = n;
+  }
+
+  /*!
+   * @if jp
+   * @brief タスク周期時間計測を有効にするか
+   * @else
+   * @brief Validate a Task period time measurement
+   * @endif
+   */
+  void PooledPeriodicTask::periodicMeasure(bool value)
+  {
+    m_periodMeasure = value;
+  }
+
+  /*!
+   * @if jp
+   * @brief タスク周期時間計測周期
+   * @else
+   * @brief Task period time measurement count
+   * @endif
+   */
+  void PooledPeriodicTask::periodicMeasureCount(unsigned int n)
+  {
+    m_periodCountMax = n;
+  }
+
+  /*!
+   * @if jp
+   * @brief タスク関数実行時間計測結果を取得
+   * @else
+   * @brief Get a result in task execute time measurement
+   * @endif
+   */
+  coil::TimeMeasure::Statistics PooledPeriodicTask::getExecStat()
+  {
+    std::lock_guard<std::mutex> guard(m_statMutex);
+    return m_execStat;
+  }
+
+  /*!
+   * @if jp
+   * @brief タスク周期時間計測結果を取得
+   * @else
+   * @brief Get a result in task period time measurement
+   * @endif
+   */
+  coil::TimeMeasure::Statistics PooledPeriodicTask::getPeriodStat()
+  {
+    std::lock_guard<std::mutex> guard(m_statMutex);
+    return m_periodStat;
+  }
+
+  /*!
+   * @if jp
+   * @brief タスクを1回実行する
+   * @else
+   * @brief Execute the task once
+   * @endif
+   */
+  void PooledPeriodicTask::run()
+  {
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      m_scheduled = false;
+      bool signaled(m_signaled);
+      m_signaled = false;
+      // a periodic entry queued before suspend() must not run
+      if (!m_alive || (m_suspend && !signaled))
+        {
+          m_cond.notify_all();
+          return;
+        }
+      m_running = true;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    if (m_periodMeasure)
+      {
+        std::lock_guard<std::mutex> guard(m_statMutex);
+        if (m_periodStarted)
+          {
+            m_periodTime.tack();
+            updateStat(m_periodTime, m_periodCount, m_periodCountMax,
+                       m_periodStat);
+          }
+        m_periodTime.tick();
+        m_periodStarted = true;
+      }
+    if (m_execMeasure) { m_execTime.tick(); }
+    m_func();
+    if (m_execMeasure)
+      {
+        std::lock_guard<std::mutex> guard(m_statMutex);
+        m_execTime.tack();
+        updateStat(m_execTime, m_execCount, m_execCountMax, m_execStat);
+      }
+
+    std::unique_lock<std::mutex> guard(m_mutex);
+    m_running = false;
+    bool again(m_alive && (m_pending || !m_suspend));
+    bool periodic(!m_pending && m_period > std::chrono::nanoseconds::zero());
+    m_pending = false;
+    if (again) { m_scheduled = true; }
+    m_cond.notify_all();
+    guard.unlock();
+
+    if (!again) { return; }
+    if (periodic)
+      {
+        PeriodicTaskPool::instance().pushAt(this, start + m_period);
+      }
+    else
+      {
+        PeriodicTaskPool::instance().push(this);
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 使用しない (スレッドを持たない)
+   * @else
+   * @brief Not used (no own thread)
+   * @endif
+   */
+  int PooledPeriodicTask::svc()
+  {
+    return 0;
+  }
+
+  /*!
+   * @if jp
+   * @brief タスクを実行キューに追加する
+   *
+   * 実行中の場合は実行終了後に再度実行する。実行待ちの場合は何もしない。
+   *
+   * @else
+   * @brief Enqueue the task
+   *
+   * If the task is running it is executed again after it finishes.
+   * Nothing is done if it is already queued.
+   *
+   * @endif
+   */
+  void PooledPeriodicTask::schedule()
+  {
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      if (!m_alive || m_func == nullptr) { return; }
+      if (m_running)
+        {
+          m_pending = true;
+          return;
+        }
+      if (m_scheduled) { return; }
+      m_scheduled = true;
+    }
+    PeriodicTaskPool::instance().push(this);
+  }
+
+  /*!
+   * @if jp
+   * @brief 計測結果の更新
+   * @else
+   * @brief Update the measured statistics
+   * @endif
+   */
+  void PooledPeriodicTask::updateStat(coil::TimeMeasure& measure,
+                                      unsigned int& count, unsigned int max,
+                                      coil::TimeMeasure::Statistics& stat)
+  {
+    if (count > max)
+      {
+        stat = measure.getStatistics();
+        count = 0;
+      }
+    ++count;
+  }
+} // namespace RTC
+
+extern "C"
+{
+  void PooledPeriodicTaskInit()
+  {
+    ::RTC::PeriodicTaskFactory::
+      instance().addFactory("pool",
+                            ::coil::Creator< ::coil::PeriodicTaskBase,
+                                             ::RTC::PooledPeriodicTask >,
+                            ::coil::Destructor< ::coil::PeriodicTaskBase,
+                                                ::RTC::PooledPeriodicTask >);
+  }
+}
@@ -0,0 +1,353 @@
+﻿// -*- C++ -*-
+/*!
+ * @file PooledPeriodicTask.h
+ * @brief PeriodicTask executed on a shared thread pool
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_POOLEDPERIODICTASK_H
+#define RTC_POOLEDPERIODICTASK_H
+
+#include <coil/PeriodicTaskBase.h>
+#include <coil/TimeMeasure.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace RTC
+{
+  class PooledPeriodicTask;
+
+  /*!
+   * @if jp
+   * @class PeriodicTaskPool
+   * @brief PooledPeriodicTask を実行するワークスティーリング型スレッドプール
+   *
+   * プロセス内で共有される固定数のワーカスレッドで PooledPeriodicTask
+   * を実行する。各ワーカは自身のキューを持ち、キューが空になると他のワー
+   * カのキューの末尾からタスクを奪って実行する。周期実行の待ち時間は
+   * 共有のタイマで管理し、待機中のタスクはスレッドを占有しない。
+   *
+   * ワーカ数は Manager の設定 manager.thread_pool.size で指定する。0
+   * の場合はハードウェアスレッド数 (最低2) となる。
+   *
+   * @else
+   * @class PeriodicTaskPool
+   * @brief Work-stealing thread pool executing PooledPeriodicTask
+   *
+   * PooledPeriodicTask objects are executed by a fixed number of worker
+   * threads shared within the process. Each worker has its own queue
+   * and steals tasks from the tail of the other workers' queues when its
+   * own queue is empty. Waiting for the next period is managed by a
+   * shared timer, so a waiting task does not occupy a thread.
+   *
+   * The number of workers is given by the Manager configuration
+   * manager.thread_pool.size. 0 means the number of hardware threads
+   * (at least 2).
+   *
+   * @endif
+   */
+  class PeriodicTaskPool
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief ワーカごとの統計情報
+     * @else
+     * @brief Statistics of a worker
+     * @endif
+     */
+    struct WorkerStatistics
+    {
+      /*! Number of tasks in the queue */
+      size_t queue_depth{0};
+      /*! Maximum number of tasks ever queued */
+      size_t max_queue_depth{0};
+      /*! Number of tasks executed by the worker */
+      uint64_t executed{0};
+      /*! Number of tasks stolen from the other workers */
+      uint64_t stolen{0};
+    };
+
+    /*!
+     * @if jp
+     * @brief インスタンスの取得
+     *
+     * 最初の呼び出しでワーカスレッドを起動する。
+     *
+     * @return プロセスで唯一のスレッドプール
+     *
+     * @else
+     * @brief Get the instance
+     *
+     * The worker threads are started on the first call.
+     *
+     * @return The thread pool of the process
+     *
+     * @endif
+     */
+    static PeriodicTaskPool& instance();
+
+    /*!
+     * @if jp
+     * @brief タスクを実行キューに追加する
+     *
+     * ワーカスレッドから呼ばれた場合はそのワーカのキューに、それ以外
+     * はラウンドロビンで選んだワーカのキューに追加する。
+     *
+     * @param task タスク
+     *
+     * @else
+     * @brief Enqueue a task
+     *
+     * The task is queued to the calling worker when called from a
+     * worker thread, or to a worker chosen in round robin otherwise.
+     *
+     * @param task Task
+     *
+     * @endif
+     */
+    void push(PooledPeriodicTask* task);
+
+    /*!
+     * @if jp
+     * @brief 指定時刻にタスクを実行キューに追加する
+     *
+     * @param task タスク
+     * @param time 実行時刻
+     *
+     * @else
+     * @brief Enqueue a task at the given time
+     *
+     * @param task Task
+     * @param time Time to execute the task
+     *
+     * @endif
+     */
+    void pushAt(PooledPeriodicTask* task,
+                std::chrono::steady_clock::time_point time);
+
+    /*!
+     * @if jp
+     * @brief タイマで待機中のタスクを取り消す
+     *
+     * @param task タスク
+     * @return true: タスクが待機中だった
+     *
+     * @else
+     * @brief Cancel a task waiting on the timer
+     *
+     * @param task Task
+     * @return true: the task was waiting
+     *
+     * @endif
+     */
+    bool cancel(PooledPeriodicTask* task);
+
+    /*!
+     * @if jp
+     * @brief ワーカごとの統計情報を取得する
+     *
+     * @return ワーカ番号順の統計情報
+     *
+     * @else
+     * @brief Get the statistics of each worker
+     *
+     * @return Statistics in the order of the workers
+     *
+     * @endif
+     */
+    std::vector<WorkerStatistics> getStatistics();
+
+    /*!
+     * @if jp
+     * @brief ワーカ数を取得する
+     * @else
+     * @brief Get the number of workers
+     * @endif
+     */
+    size_t size() const;
+
+    PeriodicTaskPool(const PeriodicTaskPool&) = delete;
+    PeriodicTaskPool& operator=(const PeriodicTaskPool&) = delete;
+
+  private:
+    explicit PeriodicTaskPool(size_t size);
+    ~PeriodicTaskPool();
+
+    struct Worker
+    {
+      std::mutex mutex;
+      std::deque<PooledPeriodicTask*> queue;
+      WorkerStatistics stat;
+      std::thread thread;
+    };
+
+    void svc(size_t index);
+    void enqueue(size_t index, PooledPeriodicTask* task);
+    PooledPeriodicTask* take(size_t index);
+    void notify();
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::atomic<size_t> m_next{0};
+    std::atomic<size_t> m_pending{0};
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    std::multimap<std::chrono::steady_clock::time_point,
+                  PooledPeriodicTask*> m_timers;
+    bool m_running{true};
+  };
+
+  /*!
+   * @if jp
+   * @class PooledPeriodicTask
+   * @brief 共有スレッドプールで実行される周期タスク
+   *
+   * coil::PeriodicTask と同じインターフェースを持つが、専用のスレッド
+   * を持たず PeriodicTaskPool のワーカで実行される。PeriodicTaskFactory
+   * に "pool" という名前で登録されるため、コネクタのプロパティ
+   * thread_type に pool を指定すると PublisherNew, PublisherPeriodic
+   * がこのタスクを使用する。
+   *
+   * 同じタスクが複数のワーカで同時に実行されることはなく、実行中に
+   * signal() された場合は実行終了後に再度実行されるため、コネクタごと
+   * のデータの順序は保たれる。
+   *
+   * @else
+   * @class PooledPeriodicTask
+   * @brief Periodic task executed on the shared thread pool
+   *
+   * It has the same interface as coil::PeriodicTask but owns no thread
+   * and is executed by the workers of PeriodicTaskPool. It is registered
+   * in PeriodicTaskFactory as "pool", so PublisherNew and
+   * PublisherPeriodic use it when the connector property thread_type is
+   * pool.
+   *
+   * A task is never executed by more than one worker at a time, and a
+   * signal() during the execution runs it again after it finishes, so
+   * the order of the data of each connector is kept.
+   *
+   * @endif
+   */
+  class PooledPeriodicTask
+    : public coil::PeriodicTaskBase
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @else
+     * @brief Constructor
+     * @endif
+     */
+    PooledPeriodicTask();
+
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     *
+     * 実行中、実行待ちのタスクが終了するまで待つ。
+     *
+     * @else
+     * @brief Destructor
+     *
+     * Waits until the running or queued execution finishes.
+     *
+     * @endif
+     */
+    ~PooledPeriodicTask() override;
+
+    void activate() override;
+    void finalize() override;
+    int suspend() override;
+    int resume() override;
+    void signal() override;
+    void setTask(std::function<void(void)> func) override;
+    void setPeriod(std::chrono::nanoseconds period) override;
+    void executionMeasure(bool value) override;
+    void executionMeasureCount(unsigned int n) override;
+    void periodicMeasure(bool value) override;
+    void periodicMeasureCount(unsigned int n) override;
+    coil::TimeMeasure::Statistics getExecStat() override;
+    coil::TimeMeasure::Statistics getPeriodStat() override;
+
+    /*!
+     * @if jp
+     * @brief タスクを1回実行する
+     *
+     * PeriodicTaskPool のワーカから呼び出される。
+     *
+     * @else
+     * @brief Execute the task once
+     *
+     * Called from a worker of PeriodicTaskPool.
+     *
+     * @endif
+     */
+    void run();
+
+  protected:
+    /*!
+     * @if jp
+     * @brief 使用しない (スレッドを持たない)
+     * @else
+     * @brief Not used (no own thread)
+     * @endif
+     */
+    int svc() override;
+
+  private:
+    void schedule();
+    void updateStat(coil::TimeMeasure& measure, unsigned int& count,
+                    unsigned int max, coil::TimeMeasure::Statistics& stat);
+
+    std::function<void(void)> m_func;
+    std::chrono::nanoseconds m_period{0};
+
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    bool m_alive{false};
+    bool m_suspend{false};
+    bool m_scheduled{false};
+    bool m_running{false};
+    bool m_pending{false};
+    bool m_signaled{false};   // signal() runs once even while suspended
+
+    std::mutex m_statMutex;
+    bool m_execMeasure{true};
+    unsigned int m_execCount{0};
+    unsigned int m_execCountMax{1000};
+    coil::TimeMeasure m_execTime;
+    coil::TimeMeasure::Statistics m_execStat{};
+    bool m_periodMeasure{true};
+    unsigned int m_periodCount{0};
+    unsigned int m_periodCountMax{1000};
+    coil::TimeMeasure m_periodTime;
+    coil::TimeMeasure::Statistics m_periodStat{};
+    bool m_periodStarted{false};
+  };
+} // namespace RTC
+
+extern "C"
+{
+  void PooledPeriodicTaskInit();
+}
+
+#endif  // RTC_POOLEDPERIODICTASK_H
@@ -24,6 +24,11 @@
 #include <rtm/PortCallback.h>
 #include <rtm/CORBA_RTCUtil.h>
 
+namespace
+{
+  std::atomic<uint64_t> connection_generation(0);
+} // namespace
+
 namespace RTC
 {
   //============================================================
@@ -306,6 +311,7 @@ namespace RTC
         m_profile.connector_profiles[index] = connector_profile;
         RTC_PARANOID(("Existing connector_id. Updated."));
       }
+    connection_generation.fetch_add(1, std::memory_order_release);
 
     for (int i(0), len(sizeof(retval)/sizeof(ReturnCode_t)); i < len; ++i)
       {
@@ -463,6 +469,7 @@ namespace RTC
         m_profile.connector_profiles._length = len-1;
       }
 #endif  // ORB_IS_RTORB
+    connection_generation.fetch_add(1, std::memory_order_release);
     onDisconnected(getName(), prof, retval);
     return retval;
   }
@@ -1005,6 +1012,18 @@ namespace RTC
       return m_directport;
   }
 
+  /*!
+   * @if jp
+   * @brief 接続の変更回数を取得する
+   * @else
+   * @brief Get the number of the connection changes
+   * @endif
+   */
+  uint64_t PortBase::connectionGeneration()
+  {
+    return connection_generation.load(std::memory_order_acquire);
+  }
+
 
   /*!
    * @if jp
@@ -22,6 +22,8 @@
 
 #include <rtm/RTC.h>
 
+#include <atomic>
+#include <cstdint>
 #include <mutex>
 #include <rtm/idl/RTCSkel.h>
 #include <rtm/CORBA_SeqUtil.h>
@@ -1273,6 +1275,31 @@ namespace RTC
      * @endif
      */
     virtual DirectPortBase* getDirectPort();
+
+    /*!
+     * @if jp
+     * @brief 接続の変更回数を取得する
+     *
+     * このプロセス内のいずれかのポートの ConnectorProfile が
+     * notify_connect() または notify_disconnect() で変わるたびに増加す
+     * る。接続の情報を保持する側は、取得時の値と比べて古くなったことを
+     * 知ることができる。
+     *
+     * @return 接続の変更回数
+     *
+     * @else
+     * @brief Get the number of the connection changes
+     *
+     * Incremented each time the ConnectorProfile of any port in this
+     * process is changed by notify_connect() or notify_disconnect().
+     * Those keeping the connection information can know it is stale by
+     * comparing with the value when it was obtained.
+     *
+     * @return Number of the connection changes
+     *
+     * @endif
+     */
+    static uint64_t connectionGeneration();
     //============================================================
     // protected operations
     //============================================================
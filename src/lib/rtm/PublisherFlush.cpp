@@ -163,9 +163,11 @@ namespace RTC
         onReceiverFull(m_data);
         return ret;
       case DataPortStatus::SEND_TIMEOUT:
+        ConnectorStatistics::increment(m_profile.statistics().send_timeout);
         onReceiverTimeout(m_data);
         return ret;
       case DataPortStatus::CONNECTION_LOST:
+        ConnectorStatistics::increment(m_profile.statistics().connection_lost);
         onReceiverTimeout(m_data);
         return ret;
       case DataPortStatus::UNKNOWN_ERROR:
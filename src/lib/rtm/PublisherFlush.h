@@ -25,6 +25,7 @@
 #include <rtm/SystemLogger.h>
 #include <rtm/ConnectorBase.h>
 #include <rtm/ConnectorListener.h>
+#include <rtm/LatencyTrace.h>
 
 namespace coil
 {
@@ -357,6 +358,10 @@ namespace RTC
      */
     inline void onSend(ByteData& data)
     {
+      if (m_profile.settings().latency_trace)
+        {
+          LatencyTrace::stamp(data, LatencyTrace::SEND);
+        }
       m_listeners->notifyOut(ConnectorDataListenerType::ON_SEND, m_profile, data);
     }
 
@@ -371,6 +376,7 @@ namespace RTC
      */
     inline void onReceived(ByteData& data)
     {
+      m_profile.statistics().countSent(data.getDataLength());
       m_listeners->notifyOut(ConnectorDataListenerType::ON_RECEIVED, m_profile, data);
     }
 
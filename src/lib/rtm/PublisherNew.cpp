@@ -82,6 +82,7 @@ namespace RTC
     RTC_DEBUG_STR((prop));
 
     setPushPolicy(prop);
+    setBatch(prop);
     if (!createTask(prop))
       {
         return DataPortStatus::INVALID_ARGS;
@@ -179,7 +180,9 @@ namespace RTC
     if (m_retcode == DataPortStatus::SEND_FULL)
       {
         RTC_DEBUG(("write(): InPort buffer is full."));
-        m_buffer->write(m_data, timeout);
+        BufferWriteInfo info;
+        BufferStatus ret(m_buffer->write(m_data, timeout, info));
+        m_profile.statistics().countBufferWrite(ret, info);
         m_task->signal();
         return DataPortStatus::BUFFER_FULL;
       }
@@ -187,8 +190,15 @@ namespace RTC
     assert(m_buffer != nullptr);
 
     onBufferWrite(m_data);
-    BufferStatus ret(m_buffer->write(m_data, timeout));
+    BufferWriteInfo info;
+    BufferStatus ret(m_buffer->write(m_data, timeout, info));
+    m_profile.statistics().countBufferWrite(ret, info);
 
+    if (isBatch() && m_batchDelay > std::chrono::nanoseconds::zero())
+      {
+        std::lock_guard<std::mutex> guard(m_batchMutex);
+        m_batchCond.notify_one();
+      }
     m_task->signal();
     RTC_DEBUG(("%s = write()", toString(ret)));
 
@@ -247,10 +257,10 @@ namespace RTC
     switch (m_pushPolicy)
       {
       case PUBLISHER_POLICY_ALL:
-        m_retcode = pushAll();
+        m_retcode = isBatch() ? pushBatch(true) : pushAll();
         break;
       case PUBLISHER_POLICY_FIFO:
-        m_retcode = pushFifo();
+        m_retcode = isBatch() ? pushBatch(false) : pushFifo();
         break;
       case PUBLISHER_POLICY_SKIP:
         m_retcode = pushSkip();
@@ -305,6 +315,42 @@ namespace RTC
       }
   }
 
+  /*!
+   * @if jp
+   * @brief まとめて送信する設定
+   * @else
+   * @brief Setting the batched send
+   * @endif
+   */
+  void PublisherNew::setBatch(const coil::Properties& prop)
+  {
+    std::string max_samples(prop.getProperty("publisher.batch.max_samples", "1"));
+    if (!coil::stringTo(m_batchSamples, max_samples.c_str()) ||
+        m_batchSamples == 0)
+      {
+        RTC_ERROR(("invalid batch.max_samples value: %s", max_samples.c_str()));
+        m_batchSamples = 1;
+      }
+
+    std::string max_bytes(prop.getProperty("publisher.batch.max_bytes", "65536"));
+    if (!coil::stringTo(m_batchBytes, max_bytes.c_str()))
+      {
+        RTC_ERROR(("invalid batch.max_bytes value: %s", max_bytes.c_str()));
+        m_batchBytes = 65536;
+      }
+
+    std::string max_delay(prop.getProperty("publisher.batch.max_delay", "0"));
+    if (!coil::stringTo(m_batchDelay, max_delay.c_str()) ||
+        m_batchDelay < std::chrono::nanoseconds::zero())
+      {
+        RTC_ERROR(("invalid batch.max_delay value: %s", max_delay.c_str()));
+        m_batchDelay = std::chrono::nanoseconds::zero();
+      }
+    RTC_DEBUG(("batch: max_samples: %d, max_bytes: %d, max_delay: %s",
+               m_batchSamples, m_batchBytes, max_delay.c_str()));
+    m_batch.reserve(m_batchSamples);
+  }
+
   /*!
    * @if jp
    * @brief Task の設定
@@ -382,6 +428,93 @@ namespace RTC
     return DataPortStatus::PORT_OK;
   }
 
+  /*!
+   * @if jp
+   * @brief データをまとめて送信する
+   * @else
+   * @brief Send the data together
+   * @endif
+   */
+  DataPortStatus PublisherNew::pushBatch(bool all)
+  {
+    RTC_TRACE(("pushBatch()"));
+
+    waitBatch();
+    do
+      {
+        m_batch.clear();
+        size_t bytes(0);
+        size_t readable(m_buffer->readable());
+        for (size_t i(0); i < readable && m_batch.size() < m_batchSamples; ++i)
+          {
+            ByteData* cdr(m_buffer->rptr(static_cast<long>(i)));
+            if (!m_batch.empty() && bytes + cdr->getDataLength() > m_batchBytes)
+              {
+                break;
+              }
+            bytes += cdr->getDataLength();
+            m_batch.emplace_back(cdr);
+          }
+        if (m_batch.empty()) { break; }
+
+        for (auto cdr : m_batch)
+          {
+            onBufferRead(*cdr);
+            onSend(*cdr);
+          }
+        size_t sent(0);
+        DataPortStatus ret(m_consumer->putBatch(m_batch, sent));
+        for (size_t i(0); i < sent; ++i)
+          {
+            onReceived(*m_batch[i]);
+          }
+        m_buffer->advanceRptr(static_cast<long>(sent));
+
+        if (ret != DataPortStatus::PORT_OK)
+          {
+            RTC_DEBUG(("%s = consumer.putBatch()", toString(ret)));
+            return invokeListener(ret, *m_batch[sent < m_batch.size() ?
+                                                sent : m_batch.size() - 1]);
+          }
+      }
+    while (all);
+    return DataPortStatus::PORT_OK;
+  }
+
+  /*!
+   * @if jp
+   * @brief データが揃うまで max_delay を上限に待つ
+   *
+   * max_samples 個または max_bytes バイトのデータがバッファに溜まるか、
+   * スレッドが起床してから max_delay が経過するまで待つ。
+   *
+   * @else
+   * @brief Wait for the data to be gathered up to max_delay
+   *
+   * Waits until max_samples data or max_bytes bytes are in the buffer,
+   * or max_delay has passed since the thread was woken up.
+   *
+   * @endif
+   */
+  void PublisherNew::waitBatch()
+  {
+    if (m_batchDelay <= std::chrono::nanoseconds::zero()) { return; }
+
+    auto deadline(std::chrono::steady_clock::now() + m_batchDelay);
+    std::unique_lock<std::mutex> guard(m_batchMutex);
+    m_batchCond.wait_until(guard, deadline, [this]
+      {
+        size_t readable(m_buffer->readable());
+        if (readable >= m_batchSamples) { return true; }
+        size_t bytes(0);
+        for (size_t i(0); i < readable; ++i)
+          {
+            bytes += m_buffer->rptr(static_cast<long>(i))->getDataLength();
+          }
+        return bytes >= m_batchBytes;
+      });
+  }
+
   /*!
    * @brief push "fifo" policy
    */
@@ -556,10 +689,12 @@ namespace RTC
         return DataPortStatus::SEND_FULL;
 
       case DataPortStatus::SEND_TIMEOUT:
+        ConnectorStatistics::increment(m_profile.statistics().send_timeout);
         onReceiverTimeout(data);
         return DataPortStatus::SEND_TIMEOUT;
 
       case DataPortStatus::CONNECTION_LOST:
+        ConnectorStatistics::increment(m_profile.statistics().connection_lost);
         onReceiverError(data);
         return DataPortStatus::CONNECTION_LOST;
 
@@ -31,8 +31,11 @@
 #include <rtm/SystemLogger.h>
 #include <rtm/ConnectorBase.h>
 #include <rtm/ConnectorListener.h>
+#include <rtm/LatencyTrace.h>
 #include <rtm/ByteData.h>
 
+#include <vector>
+
 namespace coil
 {
   class Properties;
@@ -114,8 +117,16 @@ namespace RTC
      * 以下のオプションを与えることができる。
      *
      * - thread_type: スレッドのタイプ (文字列、デフォルト: default)
+     *   pool を指定すると共有スレッドプールで実行する
      * - publisher.push_policy: Pushポリシー (all, fifo, skip, new)
      * - publisher.skip_count: 上記ポリシが skip のときのスキップ数
+     * - publisher.batch.max_samples: 1回の送信にまとめるデータ数の上限
+     *   (数値, デフォルト: 1)。2 以上の場合、ポリシーが all または fifo
+     *   であればバッファ内のデータをまとめて送信する
+     * - publisher.batch.max_bytes: 1回の送信にまとめるデータのバイト数
+     *   の上限 (数値, デフォルト: 65536)
+     * - publisher.batch.max_delay: データが揃うまで送信を待つ最大時間
+     *   (秒, デフォルト: 0)
      * - measurement.exec_time: タスク実行時間計測 (enable/disable)
      * - measurement.exec_count: タスク関数実行時間計測周期 (数値, 回数)
      * - measurement.period_time: タスク周期時間計測 (enable/disable)
@@ -137,8 +148,16 @@ namespace RTC
      * The following options are available.
      *
      * - thread_type: Thread type (string, default: default)
+     *   "pool" runs the task on the shared thread pool
      * - publisher.push_policy: Push policy (all, fifo, skip, new)
      * - publisher.skip_count: The number of skip count in the "skip" policy
+     * - publisher.batch.max_samples: Maximum number of the data sent
+     *   together (number, default: 1). If 2 or more and the policy is
+     *   all or fifo, the data in the buffer are sent together
+     * - publisher.batch.max_bytes: Maximum bytes of the data sent
+     *   together (number, default: 65536)
+     * - publisher.batch.max_delay: Maximum time to wait for the data to
+     *   be gathered before sending (seconds, default: 0)
      * - measurement.exec_time: Task execution time measurement (enable/disable)
      * - measurement.exec_count: Task execution time measurement count
      *                           (numerical, number of times)
@@ -446,6 +465,15 @@ namespace RTC
      */
     bool createTask(const coil::Properties& prop);
 
+    /*!
+     * @if jp
+     * @brief まとめて送信する設定
+     * @else
+     * @brief Setting the batched send
+     * @endif
+     */
+    void setBatch(const coil::Properties& prop);
+
     /*!
      * @brief push "all" policy
      */
@@ -466,6 +494,51 @@ namespace RTC
      */
     DataPortStatus pushNew();
 
+    /*!
+     * @if jp
+     * @brief データをまとめて送信する
+     *
+     * max_samples 個または max_bytes バイトまでのデータを1回の送信にま
+     * とめる。
+     *
+     * @param all true: バッファが空になるまで送信する (all ポリシー)、
+     *            false: 1回だけ送信する (fifo ポリシー)
+     *
+     * @else
+     * @brief Send the data together
+     *
+     * Sends up to max_samples data or max_bytes bytes in one send.
+     *
+     * @param all true: send until the buffer gets empty (all policy),
+     *            false: send only once (fifo policy)
+     *
+     * @endif
+     */
+    DataPortStatus pushBatch(bool all);
+
+    /*!
+     * @if jp
+     * @brief データが揃うまで max_delay を上限に待つ
+     * @else
+     * @brief Wait for the data to be gathered up to max_delay
+     * @endif
+     */
+    void waitBatch();
+
+    /*!
+     * @if jp
+     * @brief データを揃えて送信する設定か
+     * @else
+     * @brief Whether the data are gathered before sending
+     * @endif
+     */
+    bool isBatch() const
+    {
+      return m_batchSamples > 1 &&
+        (m_pushPolicy == PUBLISHER_POLICY_ALL ||
+         m_pushPolicy == PUBLISHER_POLICY_FIFO);
+    }
+
     /*!
      * @if jp
      * @brief BufferStatus から DataPortStatus への変換
@@ -625,6 +698,10 @@ namespace RTC
      */
     inline void onSend(ByteData& data)
     {
+      if (m_profile.settings().latency_trace)
+        {
+          LatencyTrace::stamp(data, LatencyTrace::SEND);
+        }
       m_listeners->notifyOut(ConnectorDataListenerType::ON_SEND, m_profile, data);
     }
 
@@ -639,6 +716,7 @@ namespace RTC
      */
     inline void onReceived(ByteData& data)
     {
+      m_profile.statistics().countSent(data.getDataLength());
       m_listeners->notifyOut(ConnectorDataListenerType::ON_RECEIVED, m_profile, data);
     }
 
@@ -713,6 +791,12 @@ namespace RTC
     bool m_active{false};
     int m_leftskip{0};
     ByteData m_data;
+    size_t m_batchSamples{1};
+    size_t m_batchBytes{65536};
+    std::chrono::nanoseconds m_batchDelay{0};
+    std::mutex m_batchMutex;
+    std::condition_variable m_batchCond;
+    std::vector<ByteData*> m_batch;
   };
 } // namespace RTC
 
@@ -180,12 +180,16 @@ namespace RTC
     if (m_retcode == DataPortStatus::SEND_FULL)
       {
         RTC_DEBUG(("write(): InPort buffer is full."));
-        m_buffer->write(m_data, timeout);
+        BufferWriteInfo info;
+        BufferStatus ret(m_buffer->write(m_data, timeout, info));
+        m_profile.statistics().countBufferWrite(ret, info);
         return DataPortStatus::BUFFER_FULL;
       }
 
     onBufferWrite(m_data);
-    BufferStatus ret(m_buffer->write(m_data, timeout));
+    BufferWriteInfo info;
+    BufferStatus ret(m_buffer->write(m_data, timeout, info));
+    m_profile.statistics().countBufferWrite(ret, info);
     RTC_DEBUG(("%s = write()", toString(ret)));
     m_task->resume();
     return convertReturn(ret, m_data);
@@ -575,10 +579,12 @@ namespace RTC
         return DataPortStatus::SEND_FULL;
 
       case DataPortStatus::SEND_TIMEOUT:
+        ConnectorStatistics::increment(m_profile.statistics().send_timeout);
         onReceiverTimeout(data);
         return DataPortStatus::SEND_TIMEOUT;
 
       case DataPortStatus::CONNECTION_LOST:
+        ConnectorStatistics::increment(m_profile.statistics().connection_lost);
         onReceiverError(data);
         return DataPortStatus::CONNECTION_LOST;
 
@@ -30,6 +30,7 @@
 #include <rtm/SystemLogger.h>
 #include <rtm/ConnectorBase.h>
 #include <rtm/ConnectorListener.h>
+#include <rtm/LatencyTrace.h>
 
 namespace coil
 {
@@ -108,6 +109,7 @@ namespace RTC
      * 以下のオプションを与えることができる。
      *
      * - publisher.thread_type: スレッドのタイプ (文字列、デフォルト: default)
+     *   pool を指定すると共有スレッドプールで実行する
      * - publisher.push_rate: Publisherの送信周期 (数値)
      * - publisher.push_policy: Pushポリシー (all, fifo, skip, new)
      * - publisher.skip_count: 上記ポリシが skip のときのスキップ数
@@ -136,6 +138,7 @@ namespace RTC
      * The following options are available.
      *
      * - publisher.thread_type: Thread type (string, default: default)
+     *   "pool" runs the task on the shared thread pool
      * - publisher.push_rate: Publisher sending period (numberical)
      * - publisher.push_policy: Push policy (all, fifo, skip, new)
      * - publisher.skip_count: The number of skip count in the "skip" policy
@@ -612,6 +615,10 @@ namespace RTC
      */
     inline void onSend(ByteData& data)
     {
+      if (m_profile.settings().latency_trace)
+        {
+          LatencyTrace::stamp(data, LatencyTrace::SEND);
+        }
       m_listeners->notifyOut(ConnectorDataListenerType::ON_SEND, m_profile, data);
     }
 
@@ -626,6 +633,7 @@ namespace RTC
      */
     inline void onReceived(ByteData& data)
     {
+      m_profile.statistics().countSent(data.getDataLength());
       m_listeners->notifyOut(ConnectorDataListenerType::ON_RECEIVED, m_profile, data);
     }
 
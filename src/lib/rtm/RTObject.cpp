@@ -1635,6 +1635,38 @@ namespace RTC
       }
   }
 
+  /*!
+   * @if jp
+   * @brief [local interface] データポートのコネクタの統計を取得する
+   * @else
+   * @brief [local interface] Get the statistics of the data port connectors
+   * @endif
+   */
+  coil::Properties RTObject_impl::getConnectorStatistics()
+  {
+    RTC_TRACE(("getConnectorStatistics()"));
+    coil::Properties prop;
+    auto setStatistics = [&prop](const std::string& port,
+                                 const ConnectorInfoList& profiles)
+      {
+        for (auto& profile : profiles)
+          {
+            coil::Properties& node(prop.getNode(port + "." + profile.id));
+            node.setProperty("name", profile.name);
+            profile.statistics().getProperties(node);
+          }
+      };
+    for (auto& inport : m_inports)
+      {
+        setStatistics(inport->getName(), inport->getConnectorProfiles());
+      }
+    for (auto& outport : m_outports)
+      {
+        setStatistics(outport->getName(), outport->getConnectorProfiles());
+      }
+    return prop;
+  }
+
   /*!
    * @if jp
    * @brief [local interface] DataInPort を削除する
@@ -2503,6 +2503,35 @@ namespace RTC
     bool addInPort(const char* name, InPortBase& inport);
     const std::vector<InPortBase*>& getInPorts() const { return m_inports; }
     const std::vector<OutPortBase*>& getOutPorts() const { return m_outports; }
+
+    /*!
+     * @if jp
+     *
+     * @brief [local interface] データポートのコネクタの統計を取得する
+     *
+     * 登録されたすべての InPort, OutPort のコネクタについて、
+     * <ポート名>.<コネクタID>.name とConnectorStatistics の各カウンタ
+     * (sent_samples, sent_bytes, received_samples, received_bytes,
+     * buffer_high_water, overwrite, drop, send_timeout,
+     * connection_lost) を設定したプロパティを返す。
+     *
+     * @return コネクタの統計
+     *
+     * @else
+     *
+     * @brief [local interface] Get the statistics of the data port connectors
+     *
+     * Returns the properties with <port name>.<connector ID>.name and
+     * the counters of ConnectorStatistics (sent_samples, sent_bytes,
+     * received_samples, received_bytes, buffer_high_water, overwrite,
+     * drop, send_timeout and connection_lost) for the connectors of all
+     * the registered InPorts and OutPorts.
+     *
+     * @return Statistics of the connectors
+     *
+     * @endif
+     */
+    coil::Properties getConnectorStatistics();
     /*!
      * @if jp
      *
@@ -42,6 +42,8 @@ namespace RTC_impl
     setDataFlowComponentAction(comp);
     setFsmParticipantAction(comp);
     setMultiModeComponentAction(comp);
+    // The EC thread uses the cached name without a remote call
+    cacheInstanceName(comp);
     // Setting callback functions to StateMachine
     m_sm.setListener(this);
     m_sm.setEntryAction (RTC::ACTIVE_STATE,
@@ -107,6 +109,37 @@ namespace RTC_impl
     return m_id;
   }
 
+  RTC::RTObject_impl* RTObjectStateMachine::getServant()
+  {
+    return m_rtobjPtr;
+  }
+
+  const std::string& RTObjectStateMachine::getInstanceName() const
+  {
+    return m_instanceName;
+  }
+
+  void RTObjectStateMachine::
+  cacheInstanceName(RTC::LightweightRTObject_ptr comp)
+  {
+    if (m_rtobjPtr != nullptr)
+      {
+        m_instanceName = m_rtobjPtr->getInstanceName();
+        return;
+      }
+    try
+      {
+        RTC::RTObject_var rtobj = RTC::RTObject::_narrow(comp);
+        if (CORBA::is_nil(rtobj)) { return; }
+        RTC::ComponentProfile_var prof = rtobj->get_component_profile();
+        m_instanceName = static_cast<const char*>(prof->instance_name);
+      }
+    catch (CORBA::SystemException&)
+      {
+        RTC_WARN(("Instance name of a component is unknown."));
+      }
+  }
+
   void RTObjectStateMachine::
   setComponentAction(const RTC::LightweightRTObject_ptr comp)
   {
@@ -114,21 +147,59 @@ namespace RTC_impl
     if (CORBA::is_nil(m_caVar)) { return; }
 #ifndef ORB_IS_RTORB
     m_ca = true;
-    PortableServer::POA_var poa = ::RTC::Manager::instance().getPOA();
+    m_rtobjPtr = findServant(comp);
+  #endif
+  }
+
+  /*!
+   * @if jp
+   * @brief 同一プロセス内の RTObject_impl を探す
+   *
+   * Manager の POA でサーバントを検索し、見つからなければ Manager に登
+   * 録されたコンポーネントからオブジェクトリファレンスが等価なものを探す。
+   * 独自の POA で活性化されたコンポーネントも後者で見つかる。見つかっ
+   * た場合、コンポーネントアクションは CORBA を経由せず直接呼び出される。
+   *
+   * @else
+   * @brief Find the RTObject_impl in the same process
+   *
+   * The servant is looked up in the POA of the Manager first, and then
+   * in the components registered to the Manager by the equivalence of
+   * the object references. The latter finds the components activated
+   * on their own POA. If found, the component actions are called
+   * directly without CORBA.
+   *
+   * @endif
+   */
+  RTC::RTObject_impl* RTObjectStateMachine::
+  findServant(const RTC::LightweightRTObject_ptr comp)
+  {
+    ::RTC::Manager& mgr(::RTC::Manager::instance());
     try
       {
-        m_rtobjPtr =
+        PortableServer::POA_var poa = mgr.getPOA();
+        RTC::RTObject_impl* servant =
           dynamic_cast<RTC::RTObject_impl*>(poa->reference_to_servant(comp));
+        if (servant != nullptr) { return servant; }
       }
-    catch (CORBA::SystemException&)
+    catch (...)
       {
-        m_rtobjPtr = nullptr;
+        // not a servant of the manager's POA
       }
-    catch (...)
+
+    for (auto* rtobj : mgr.getComponents())
       {
-        m_rtobjPtr = nullptr;
+        try
+          {
+            RTC::RTObject_var ref = rtobj->getObjRef();
+            if (ref->_is_equivalent(comp)) { return rtobj; }
+          }
+        catch (...)
+          {
+            // the component is being finalized
+          }
       }
-  #endif
+    return nullptr;
   }
 
   void RTObjectStateMachine::
@@ -458,6 +529,18 @@ namespace RTC_impl
       return false;
   }
 
+  /*!
+   * @if jp
+   * @brief 実行時間の統計を取得する
+   * @else
+   * @brief Get the execution time statistics
+   * @endif
+   */
+  ComponentStatistics& RTObjectStateMachine::statistics()
+  {
+    return m_statistics;
+  }
+
   void RTObjectStateMachine::updateState()
   {
       if (m_activation.load())
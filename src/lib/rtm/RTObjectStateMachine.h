@@ -24,9 +24,11 @@
 #include <coil/TimeMeasure.h>
 #include <rtm/idl/RTCSkel.h>
 #include <rtm/StateMachine.h>
+#include <rtm/ExecutionStatistics.h>
 #include <cassert>
 #include <iostream>
 #include <atomic>
+#include <string>
 
 #define NUM_OF_LIFECYCLESTATE 4
 namespace RTC
@@ -53,6 +55,10 @@ namespace RTC_impl
     bool isEquivalent(RTC::LightweightRTObject_ptr comp);
 
     RTC::ExecutionContextHandle_t getExecutionContextHandle();
+    // servant in the same process, or nullptr
+    RTC::RTObject_impl* getServant();
+    // instance name obtained at construction, or empty if unknown
+    const std::string& getInstanceName() const;
 
     // RTC::ComponentAction operations
     void onStartup();
@@ -90,11 +96,16 @@ namespace RTC_impl
     bool deactivate();
     bool reset();
 
+    // Execution time statistics
+    ComponentStatistics& statistics();
+
   protected:
     void setComponentAction(RTC::LightweightRTObject_ptr comp);
     void setDataFlowComponentAction(RTC::LightweightRTObject_ptr comp);
     void setFsmParticipantAction(RTC::LightweightRTObject_ptr comp);
     void setMultiModeComponentAction(RTC::LightweightRTObject_ptr comp);
+    RTC::RTObject_impl* findServant(RTC::LightweightRTObject_ptr comp);
+    void cacheInstanceName(RTC::LightweightRTObject_ptr comp);
     void updateState();
 
   private:  // member variables
@@ -115,6 +126,7 @@ namespace RTC_impl
     RTC::FsmParticipantAction_var     m_fsmVar;
     RTC::MultiModeComponentAction_var m_modeVar;
     RTC::RTObject_impl* m_rtobjPtr;
+    std::string m_instanceName;
     bool m_measure;
     // Component action invoker
     coil::TimeMeasure m_svtMeasure;
@@ -122,6 +134,7 @@ namespace RTC_impl
     std::atomic<bool> m_activation;
     std::atomic<bool> m_deactivation;
     std::atomic<bool> m_reset;
+    ComponentStatistics m_statistics;
   };
 } // namespace RTC_impl
 
@@ -321,6 +321,14 @@ namespace RTC
      * @endif
      */
     BufferStatus advanceWptr(long int n = 1, bool unlock_enable = true) override
+    {
+      return advanceWptr(n, unlock_enable, nullptr);
+    }
+
+  protected:
+    // advanceWptr() that also returns the fill count after the advance
+    BufferStatus advanceWptr(long int n, bool unlock_enable,
+                             size_t* fillcount)
     {
       bool empty_ = false;
       bool lock_ = (unlock_enable && n > 0);
@@ -351,6 +359,7 @@ namespace RTC
           m_wpos = (m_wpos + n + m_length) % m_length;
           m_fillcount += n;
           m_wcount += n;
+          if (fillcount != nullptr) { *fillcount = m_fillcount; }
       }
 
       if(lock_)
@@ -364,6 +373,8 @@ namespace RTC
 
       return BufferStatus::OK;
     }
+
+  public:
     /*!
      * @if jp
      *
@@ -442,6 +453,44 @@ namespace RTC
                        std::chrono::nanoseconds timeout
                        = std::chrono::nanoseconds(-1)) override
     {
+      BufferWriteInfo info;
+      return write(value, timeout, info);
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief バッファに書き込み、上書き数と読み出し可能数を返す
+     *
+     * write(value, timeout) と同じ。上書きの有無と書き込み後の読み出し
+     * 可能数は、書き込みの処理中に保持しているロックの下で得る。
+     *
+     * @param value 書き込み対象データ
+     * @param timeout タイムアウト時間 nsec (-1: 無効)
+     * @param info 上書き数と読み出し可能数を格納する
+     * @return write(value, timeout) と同じ
+     *
+     * @else
+     *
+     * @brief Write into the buffer and return the overwritten and
+     *        readable numbers
+     *
+     * The same as write(value, timeout). Whether the data was
+     * overwritten and the readable number after the write are obtained
+     * under the locks already held while writing.
+     *
+     * @param value Target data for writing
+     * @param timeout Timeout in nsec (-1: disabled)
+     * @param info The overwritten and readable numbers are stored
+     * @return The same as write(value, timeout)
+     *
+     * @endif
+     */
+    BufferStatus write(const DataType& value,
+                       std::chrono::nanoseconds timeout,
+                       BufferWriteInfo& info) override
+    {
+      info = BufferWriteInfo();
       {
       std::unique_lock<std::mutex> guard(m_full.mutex);
 
@@ -460,6 +509,7 @@ namespace RTC
           if (overwrite && !timedwrite)  // "overwrite" mode
             {
               advanceRptr(1,false);
+              info.overwritten = 1;
             }
           else if (!overwrite && !timedwrite)  // "do_nothing" mode
             {
@@ -485,12 +535,121 @@ namespace RTC
 
       put(value);
 
-      advanceWptr(1);
-
+      advanceWptr(1, true, &info.readable);
 
       return BufferStatus::OK;
     }
 
+    /*!
+     * @if jp
+     *
+     * @brief バッファに複数のデータを書き込む
+     *
+     * overwrite および do_nothing モードでは、ロックを一度だけ取得して
+     * すべてのデータを書き込む。block モードでは write() を繰り返す。
+     *
+     * @param values 書き込み対象データの配列
+     * @param n データの数
+     * @param written 書き込んだデータの数
+     *
+     * @return OK            正常終了
+     *         FULL          バッファがフル状態
+     *
+     * @else
+     *
+     * @brief Write multiple data into the buffer
+     *
+     * In the overwrite and do_nothing modes, all the data are written
+     * with the lock acquired only once. In the block mode, write() is
+     * repeated.
+     *
+     * @param values Array of the data to write
+     * @param n Number of the data
+     * @param written Number of the data written
+     *
+     * @return OK            Successful
+     *         FULL          The buffer is full
+     *
+     * @endif
+     */
+    BufferStatus writeBatch(const DataType* values, size_t n,
+                            size_t& written) override
+    {
+      BufferWriteInfo info;
+      return writeBatch(values, n, written, info);
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief バッファに複数のデータを書き込み、上書き数と読み出し可能数を返す
+     *
+     * writeBatch(values, n, written) と同じ。上書き数と書き込み後の読み
+     * 出し可能数は、書き込み中に保持しているロックの下で数える。
+     *
+     * @param values 書き込み対象データの配列
+     * @param n データの数
+     * @param written 書き込んだデータの数
+     * @param info 上書き数と読み出し可能数を格納する
+     *
+     * @return writeBatch(values, n, written) と同じ
+     *
+     * @else
+     *
+     * @brief Write multiple data into the buffer and return the
+     *        overwritten and readable numbers
+     *
+     * The same as writeBatch(values, n, written). The overwritten and
+     * readable numbers are counted under the lock held while writing.
+     *
+     * @param values Array of the data to write
+     * @param n Number of the data
+     * @param written Number of the data written
+     * @param info The overwritten and readable numbers are stored
+     *
+     * @return The same as writeBatch(values, n, written)
+     *
+     * @endif
+     */
+    BufferStatus writeBatch(const DataType* values, size_t n,
+                            size_t& written, BufferWriteInfo& info) override
+    {
+      if (m_timedwrite)
+        {
+          return BufferBase<DataType>::writeBatch(values, n, written, info);
+        }
+
+      info = BufferWriteInfo();
+      bool empty_;
+      {
+        std::lock_guard<std::mutex> guard(m_full.mutex);
+        std::lock_guard<std::mutex> posguard(m_posmutex);
+        empty_ = (m_fillcount == 0);
+        for (written = 0; written < n; ++written)
+          {
+            if (m_fillcount == m_length)
+              {
+                if (!m_overwrite) { break; }
+                m_rpos = (m_rpos + 1) % m_length;
+                --m_fillcount;
+                ++info.overwritten;
+              }
+            m_buffer[m_wpos] = values[written];
+            m_wpos = (m_wpos + 1) % m_length;
+            ++m_fillcount;
+            ++m_wcount;
+          }
+        info.readable = m_fillcount;
+      }
+
+      if (empty_ && written > 0)
+        {
+          std::lock_guard<std::mutex> guard(m_empty.mutex);
+          m_empty.cond.notify_one();
+        }
+      return written == n ? BufferStatus::OK : BufferStatus::FULL;
+    }
+
     /*!
      * @if jp
      *
@@ -18,8 +18,129 @@
 #include <rtm/SharedMemoryPort.h>
 #include <rtm/Manager.h>
 
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <utility>
+
 namespace RTC
 {
+  namespace
+  {
+    /*!
+     * @if jp
+     * @brief リングプロトコルの識別子 ("RTMRING2")
+     * @else
+     * @brief Identifier of the ring protocol ("RTMRING2")
+     * @endif
+     */
+    const uint64_t RING_MAGIC = 0x32474E49524D5452ULL;
+    const uint64_t RING_HEADER_SIZE = 128;
+
+    /*!
+     * @if jp
+     * @brief リングプロトコルの共有メモリのヘッダ
+     *
+     * 同一ホスト内でのみ共有されるため、ネイティブのバイトオーダで格納
+     * する。write_seq は書き込み側のみ、read_seq は読み込み側のみが更新
+     * する。共有メモリを拡張した場合、書き込み側は next_memory_size を
+     * 書き込んだ後に next_generation を更新する。読み込み側は次の世代を
+     * マッピングした後に reader_left を設定し、書き込み側はそれを見て
+     * 古い世代を削除する。
+     *
+     * @else
+     * @brief Header of the shared memory of the ring protocol
+     *
+     * Stored in the native byte order since it is shared only within a
+     * host. write_seq is updated only by the writer and read_seq only by
+     * the reader. When the shared memory grows, the writer stores
+     * next_memory_size before publishing next_generation. The reader
+     * sets reader_left after mapping the next generation, upon which the
+     * writer removes the old one.
+     *
+     * @endif
+     */
+    struct RingHeader
+    {
+      uint64_t magic;
+      uint64_t slots;
+      uint64_t slot_size;
+      uint64_t generation;
+      std::atomic<uint64_t> write_seq;
+      std::atomic<uint64_t> read_seq;
+      std::atomic<uint64_t> next_generation;
+      uint64_t next_memory_size;
+      std::atomic<uint64_t> reader_left;
+    };
+    static_assert(sizeof(RingHeader) <= RING_HEADER_SIZE,
+                  "RingHeader does not fit in the header area");
+
+    /*!
+     * @if jp
+     * @brief スロットのヘッダ。直後にデータが続く。
+     * @else
+     * @brief Header of a slot followed by the data.
+     * @endif
+     */
+    struct RingSlot
+    {
+      std::atomic<uint64_t> seq;
+      uint64_t length;
+    };
+
+    uint64_t slotStride(uint64_t slot_size)
+    {
+      return sizeof(RingSlot) + ((slot_size + 7) & ~static_cast<uint64_t>(7));
+    }
+
+    uint64_t ringMemorySize(uint64_t slots, uint64_t slot_size)
+    {
+      return RING_HEADER_SIZE + slots * slotStride(slot_size);
+    }
+
+    RingHeader* ringHeader(coil::SharedMemory& shm)
+    {
+      return reinterpret_cast<RingHeader*>(shm.get_data());
+    }
+
+    bool isRing(coil::SharedMemory& shm)
+    {
+      return shm.created() && shm.get_data() != nullptr &&
+          shm.get_size() >= RING_HEADER_SIZE &&
+          ringHeader(shm)->magic == RING_MAGIC;
+    }
+
+    RingSlot* ringSlot(RingHeader* header, uint64_t seq)
+    {
+      char* base(reinterpret_cast<char*>(header) + RING_HEADER_SIZE);
+      return reinterpret_cast<RingSlot*>(base + (seq % header->slots)
+                                         * slotStride(header->slot_size));
+    }
+
+    void initRingHeader(char* memory, uint64_t slots, uint64_t slot_size,
+                        uint64_t generation, uint64_t seq)
+    {
+      RingHeader* header(new (memory) RingHeader());
+      header->slots = slots;
+      header->slot_size = slot_size;
+      header->generation = generation;
+      header->write_seq.store(seq);
+      header->read_seq.store(seq);
+      header->next_generation.store(0);
+      header->next_memory_size = 0;
+      header->reader_left.store(0);
+      for (uint64_t i(0); i < slots; ++i)
+        {
+          RingSlot* slot(new (ringSlot(header, i)) RingSlot());
+          slot->seq.store(UINT64_MAX);
+          slot->length = 0;
+        }
+      std::atomic_thread_fence(std::memory_order_release);
+      header->magic = RING_MAGIC;
+    }
+  } // namespace
+
   /*!
    * @if jp
    * @brief コンストラクタ
@@ -144,7 +265,15 @@ namespace RTC
   {
       if (!m_shmem.created())
       {
-      m_shmem.create(shm_address, memory_size);
+      if (m_ring_length > 1)
+      {
+          create_ring(memory_size, shm_address);
+          memory_size = m_shmem.get_size();
+      }
+      else
+      {
+          m_shmem.create(shm_address, memory_size);
+      }
       try
       {
           m_smInterface->open_memory(memory_size, CORBA::string_dup(shm_address));
@@ -173,6 +302,7 @@ namespace RTC
   */
   void SharedMemoryPort::open_memory(::CORBA::ULongLong memory_size, const char *shm_address)
   {
+      m_ring_address = shm_address;
       m_shmem.open(shm_address, memory_size);
   }
   /*!
@@ -192,6 +322,16 @@ namespace RTC
   */
   void SharedMemoryPort::close_memory(::CORBA::Boolean unlink)
   {
+      // the generations the reader has not left yet
+      while (!m_retired.empty())
+      {
+          m_retired.front().close();
+          if (unlink)
+          {
+              m_retired.front().unlink();
+          }
+          m_retired.pop_front();
+      }
       if (m_shmem.created())
       {
           m_shmem.close();
@@ -225,9 +365,19 @@ namespace RTC
   *
   * @endif
   */
-  void SharedMemoryPort::write(ByteData& data)
+  bool SharedMemoryPort::write(ByteData& data)
   {
       CORBA::ULongLong data_size = static_cast<CORBA::ULongLong>(data.getDataLength());
+      if (isRingProtocol())
+      {
+          unsigned char* buffer = loan(data_size);
+          if (buffer == nullptr)
+          {
+              return false;
+          }
+          memcpy(buffer, data.getBuffer(), static_cast<size_t>(data_size));
+          return commit(data_size);
+      }
       if (data_size + sizeof(CORBA::ULongLong) > m_shmem.get_size())
       {
           CORBA::ULongLong memory_size = data_size + static_cast<CORBA::ULongLong>(sizeof(CORBA::ULongLong));
@@ -250,7 +400,7 @@ namespace RTC
       data_size_cdr.setEndian(m_endian);
       if (!data_size_cdr.serializeCDR(data_size))
       {
-          return;
+          return true;
       }
       //シリアライズしたデータのサイズが8の場合には共有メモリにデータサイズ(CDR形式)を書き込み
       if (data_size_cdr.getCdrDataLength() == static_cast<unsigned long>(sizeof(CORBA::ULongLong)))
@@ -263,7 +413,7 @@ namespace RTC
               m_shmem.write(reinterpret_cast<const char*>(data.getBuffer()), sizeof(CORBA::ULongLong), data.getDataLength());
           }
       }
-
+      return true;
   }
   /*!
   * @if jp
@@ -282,7 +432,19 @@ namespace RTC
   */
   void SharedMemoryPort::read(ByteData& data)
   {
-      if (m_shmem.created())
+      if (hasUnreadData())
+      {
+          RingHeader* header = ringHeader(m_shmem);
+          uint64_t seq = header->read_seq.load(std::memory_order_relaxed);
+          RingSlot* slot = ringSlot(header, seq);
+          if (slot->seq.load(std::memory_order_acquire) == seq)
+          {
+              data.isLittleEndian(m_endian);
+              data.writeData(reinterpret_cast<unsigned char*>(slot + 1), static_cast<unsigned long>(slot->length));
+          }
+          return;
+      }
+      if (m_shmem.created() && !isRingProtocol())
       {
           CORBA_CdrMemoryStream data_size_cdr;
           CORBA::ULongLong data_size = 0;
@@ -296,6 +458,316 @@ namespace RTC
   }
   /*!
   * @if jp
+  * @brief リングプロトコルのスロット数を設定する
+  *
+  * @param length スロット数
+  *
+  * @else
+  * @brief Set the number of slots of the ring protocol
+  *
+  * @param length Number of slots
+  *
+  * @endif
+  */
+  void SharedMemoryPort::setRingLength(unsigned long length)
+  {
+      m_ring_length = length;
+  }
+  /*!
+  * @if jp
+  * @brief 共有メモリがリングプロトコルかを判定する
+  *
+  * @return true: リングプロトコル
+  *
+  * @else
+  * @brief Check whether the shared memory uses the ring protocol
+  *
+  * @return true: ring protocol
+  *
+  * @endif
+  */
+  bool SharedMemoryPort::isRingProtocol()
+  {
+      return isRing(m_shmem);
+  }
+  /*!
+  * @if jp
+  * @brief リングに未読データがあるかを判定する
+  *
+  * @return true: 未読データあり
+  *
+  * @else
+  * @brief Check whether the ring has unread data
+  *
+  * @return true: unread data exists
+  *
+  * @endif
+  */
+  bool SharedMemoryPort::hasUnreadData()
+  {
+      while (isRingProtocol())
+      {
+          RingHeader* header = ringHeader(m_shmem);
+          // next_generation is loaded first: all the writes into the old
+          // memory are visible once it has been published.
+          uint64_t next = header->next_generation.load(std::memory_order_acquire);
+          if (header->read_seq.load(std::memory_order_relaxed) !=
+              header->write_seq.load(std::memory_order_acquire))
+          {
+              return true;
+          }
+          if (next == 0)
+          {
+              return false;
+          }
+          // The writer keeps the next generation until reader_left is
+          // set, so it must exist. Not creating it here, since an empty
+          // ring would never advance.
+          coil::SharedMemory next_shmem;
+          if (next_shmem.open_existing(ring_address(next),
+                                       header->next_memory_size) != 0 ||
+              !isRing(next_shmem) ||
+              ringHeader(next_shmem)->generation != next)
+          {
+              if (m_failed_generation != next)
+              {
+                  // not a member: the SHM providers inherit rtclog too
+                  Logger rtclog("SharedMemoryPort");
+                  RTC_ERROR(("cannot open the generation %llu of the ring %s",
+                             static_cast<unsigned long long>(next),
+                             m_ring_address.c_str()));
+                  m_failed_generation = next;
+              }
+              return false;
+          }
+          header->reader_left.store(1, std::memory_order_release);
+          m_shmem = std::move(next_shmem);
+      }
+      return false;
+  }
+  /*!
+  * @if jp
+  * @brief リングの読み込み位置を1つ進める
+  * @else
+  * @brief Advance the read position of the ring by one
+  * @endif
+  */
+  void SharedMemoryPort::advance()
+  {
+      if (isRingProtocol())
+      {
+          RingHeader* header = ringHeader(m_shmem);
+          header->read_seq.fetch_add(1, std::memory_order_release);
+      }
+  }
+  /*!
+  * @if jp
+  * @brief 次の空きスロットを貸し出す
+  *
+  * @param size 書き込むデータのサイズ
+  * @return スロットのデータ領域。空きスロットがない場合は nullptr
+  *
+  * @else
+  * @brief Loan the next free slot
+  *
+  * @param size Size of the data to be written
+  * @return Data area of the slot, or nullptr if no slot is free
+  *
+  * @endif
+  */
+  unsigned char* SharedMemoryPort::loan(::CORBA::ULongLong size)
+  {
+      if (!isRingProtocol())
+      {
+          return nullptr;
+      }
+      release_retired();
+      if (size > ringHeader(m_shmem)->slot_size)
+      {
+          grow_ring(size);
+      }
+      RingHeader* header = ringHeader(m_shmem);
+      if (size > header->slot_size)
+      {
+          return nullptr;
+      }
+      uint64_t seq = header->write_seq.load(std::memory_order_relaxed);
+      if (seq - header->read_seq.load(std::memory_order_acquire) >= header->slots)
+      {
+          return nullptr;
+      }
+      return reinterpret_cast<unsigned char*>(ringSlot(header, seq) + 1);
+  }
+  /*!
+  * @if jp
+  * @brief 貸し出したスロットを読み込み側に公開する
+  *
+  * @param length スロットに書き込んだデータのサイズ
+  * @return false: スロットサイズを超えている
+  *
+  * @else
+  * @brief Publish the loaned slot to the reader
+  *
+  * @param length Size of the data written into the slot
+  * @return false: the length exceeds the slot size
+  *
+  * @endif
+  */
+  bool SharedMemoryPort::commit(::CORBA::ULongLong length)
+  {
+      if (!isRingProtocol())
+      {
+          return false;
+      }
+      RingHeader* header = ringHeader(m_shmem);
+      if (length > header->slot_size)
+      {
+          return false;
+      }
+      uint64_t seq = header->write_seq.load(std::memory_order_relaxed);
+      RingSlot* slot = ringSlot(header, seq);
+      slot->length = length;
+      slot->seq.store(seq, std::memory_order_release);
+      header->write_seq.store(seq + 1, std::memory_order_release);
+      return true;
+  }
+  /*!
+  * @if jp
+  * @brief リングプロトコルの共有メモリを作成する
+  *
+  * memory_size をスロット数で等分した大きさをスロットサイズとする。
+  *
+  * @param memory_size 共有メモリのサイズ
+  * @param shm_address 空間名
+  *
+  * @else
+  * @brief Create the shared memory of the ring protocol
+  *
+  * memory_size is divided equally among the slots.
+  *
+  * @param memory_size Size of the shared memory
+  * @param shm_address Name of the shared memory
+  *
+  * @endif
+  */
+  void SharedMemoryPort::create_ring(::CORBA::ULongLong memory_size, const std::string& shm_address)
+  {
+      m_ring_address = shm_address;
+      uint64_t slot_size = 0;
+      if (memory_size > RING_HEADER_SIZE)
+      {
+          slot_size = (memory_size - RING_HEADER_SIZE) / m_ring_length;
+          slot_size = slot_size > sizeof(RingSlot) ? slot_size - sizeof(RingSlot) : 0;
+          slot_size &= ~static_cast<uint64_t>(7);
+      }
+      if (slot_size < DEFAULT_DATA_SIZE)
+      {
+          slot_size = DEFAULT_DATA_SIZE;
+      }
+      m_shmem.create(shm_address, ringMemorySize(m_ring_length, slot_size));
+      if (m_shmem.created())
+      {
+          initRingHeader(m_shmem.get_data(), m_ring_length, slot_size, 0, 0);
+      }
+  }
+  /*!
+  * @if jp
+  * @brief リングプロトコルの共有メモリを拡張する
+  *
+  * スロットサイズを data_size 以上になるまで倍にした共有メモリを新た
+  * に作成し、旧領域のヘッダに世代番号とサイズを書き込む。読み込み側
+  * は旧領域の未読データを読み終えた後に新領域へ移る。旧領域は読み込
+  * み側が新領域へ移るまで保持し、release_retired() で削除する。
+  *
+  * @param data_size 書き込むデータのサイズ
+  *
+  * @else
+  * @brief Grow the shared memory of the ring protocol
+  *
+  * A new shared memory whose slot size is doubled until it fits
+  * data_size is created, and its generation and size are stored in the
+  * header of the old one. The reader moves to the new one after reading
+  * all the data left in the old one. The old one is kept until the
+  * reader has moved to the new one, and removed by release_retired().
+  *
+  * @param data_size Size of the data to be written
+  *
+  * @endif
+  */
+  void SharedMemoryPort::grow_ring(::CORBA::ULongLong data_size)
+  {
+      RingHeader* old_header = ringHeader(m_shmem);
+      uint64_t slots = old_header->slots;
+      uint64_t generation = old_header->generation + 1;
+      uint64_t seq = old_header->write_seq.load(std::memory_order_relaxed);
+      uint64_t slot_size = old_header->slot_size;
+      while (slot_size < data_size)
+      {
+          slot_size *= 2;
+      }
+      uint64_t memory_size = ringMemorySize(slots, slot_size);
+
+      coil::SharedMemory next_shmem;
+      if (next_shmem.create(ring_address(generation), memory_size) != 0 ||
+          next_shmem.get_data() == nullptr)
+      {
+          Logger rtclog("SharedMemoryPort");
+          RTC_ERROR(("cannot create the generation %llu of the ring %s",
+                     static_cast<unsigned long long>(generation),
+                     m_ring_address.c_str()));
+          next_shmem.close();
+          next_shmem.unlink();
+          return;
+      }
+      initRingHeader(next_shmem.get_data(), slots, slot_size, generation, seq);
+
+      old_header->next_memory_size = memory_size;
+      old_header->next_generation.store(generation, std::memory_order_release);
+      m_retired.push_back(std::move(m_shmem));
+      m_shmem = std::move(next_shmem);
+  }
+  /*!
+  * @if jp
+  * @brief 読み込み側が離れた古い世代を削除する
+  * @else
+  * @brief Remove the old generations the reader has left
+  * @endif
+  */
+  void SharedMemoryPort::release_retired()
+  {
+      while (!m_retired.empty() &&
+             ringHeader(m_retired.front())->reader_left.load(std::memory_order_acquire) != 0)
+      {
+          m_retired.front().close();
+          m_retired.front().unlink();
+          m_retired.pop_front();
+      }
+  }
+  /*!
+  * @if jp
+  * @brief 世代番号に対応する空間名を取得する
+  *
+  * @param generation 世代番号
+  * @return 空間名
+  *
+  * @else
+  * @brief Get the name of the shared memory of the generation
+  *
+  * @param generation Generation number
+  * @return Name of the shared memory
+  *
+  * @endif
+  */
+  std::string SharedMemoryPort::ring_address(::CORBA::ULongLong generation) const
+  {
+      if (generation == 0)
+      {
+          return m_ring_address;
+      }
+      return m_ring_address + "_" + std::to_string(generation);
+  }
+  /*!
+  * @if jp
   * @brief データを読み込む
   *
   * @return データ
@@ -24,6 +24,8 @@
 #include <rtm/CORBA_CdrMemoryStream.h>
 #include <rtm/ByteData.h>
 
+#include <deque>
+
 #define DEFAULT_DATA_SIZE 8
 #define DEFAULT_SHARED_MEMORY_SIZE 2097152
 
@@ -165,33 +167,163 @@ namespace RTC
      * 先頭8byteにデータサイズを書き込み、その後ろにデータを書き込む
      * 設定したデータサイズが共有メモリのサイズを上回った場合、共有メモリの初期化を行う
      *
-     * @param data 書き込むデータ
+     * リングプロトコルの場合は次の空きスロットに書き込む。データがスロッ
+     * トより大きい場合はスロットサイズを倍にした共有メモリを新たに作成し、
+     * 旧領域のヘッダに新領域の情報を書き込む。CORBA呼び出しは行わない。
      *
+     * @param data 書き込むデータ
+     * @return false: リングプロトコルで空きスロットがない
      *
      *
      * @else
-     * @brief 
+     * @brief Write data
+     *
+     * With the ring protocol the data is written into the next free
+     * slot. If the data is larger than a slot, a new shared memory
+     * with doubled slots is created and announced in the header of the
+     * old one without any CORBA call.
      *
-     * @param data 
+     * @param data Data to be written
+     * @return false: No free slot with the ring protocol
      *
      * @endif
      */
-    virtual void write(ByteData& data);
+    virtual bool write(ByteData& data);
      /*!
      * @if jp
      * @brief データを読み込む
+     *
+     * リングプロトコルの場合は未読の最も古いスロットを読み込む。読み
+     * 込み位置は advance() を呼ぶまで進まない。
+     *
      * @return データ
      *
      *
      *
      * @else
-     * @brief 
+     * @brief Read data
      *
-     * @return 
+     * With the ring protocol the oldest unread slot is read. The read
+     * position is not moved until advance() is called.
+     *
+     * @return data
      *
      * @endif
      */
     virtual void read(ByteData& data);
+     /*!
+     * @if jp
+     * @brief リングプロトコルのスロット数を設定する
+     *
+     * 書き込み側で create_memory() の前に呼び出す。2以上を指定すると
+     * 共有メモリをスロット単位のリングとして使用する。読み込み側は共
+     * 有メモリのヘッダからプロトコルを判別するため設定は不要。
+     *
+     * @param length スロット数 (0, 1: 単一スロットのプロトコル)
+     *
+     * @else
+     * @brief Set the number of slots of the ring protocol
+     *
+     * Called on the writer side before create_memory(). With two or
+     * more slots the shared memory is used as a ring of slots. The
+     * reader side detects the protocol from the header of the shared
+     * memory and needs no setting.
+     *
+     * @param length Number of slots (0, 1: single-slot protocol)
+     *
+     * @endif
+     */
+    void setRingLength(unsigned long length);
+     /*!
+     * @if jp
+     * @brief 共有メモリがリングプロトコルかを判定する
+     *
+     * @return true: リングプロトコル
+     *
+     * @else
+     * @brief Check whether the shared memory uses the ring protocol
+     *
+     * @return true: ring protocol
+     *
+     * @endif
+     */
+    bool isRingProtocol();
+     /*!
+     * @if jp
+     * @brief リングに未読データがあるかを判定する
+     *
+     * 書き込み側が共有メモリを拡張していた場合は、旧領域の未読データ
+     * を読み終えた時点で新領域をマッピングし直す。
+     *
+     * @return true: 未読データあり
+     *
+     * @else
+     * @brief Check whether the ring has unread data
+     *
+     * If the writer has grown the shared memory, the new one is mapped
+     * once all data in the old one has been read.
+     *
+     * @return true: unread data exists
+     *
+     * @endif
+     */
+    bool hasUnreadData();
+     /*!
+     * @if jp
+     * @brief リングの読み込み位置を1つ進める
+     * @else
+     * @brief Advance the read position of the ring by one
+     * @endif
+     */
+    void advance();
+     /*!
+     * @if jp
+     * @brief 次の空きスロットを貸し出す
+     *
+     * リングプロトコルの場合、次に書き込むスロットのデータ領域を返す。
+     * 呼び出し側はシリアライズ済みのデータを直接書き込み、commit() で
+     * 読み込み側に公開する。commit() を呼ばなかったスロットは公開さ
+     * れず、次の loan() で再び貸し出される。size がスロットより大き
+     * い場合は共有メモリを拡張する。
+     *
+     * @param size 書き込むデータのサイズ
+     * @return スロットのデータ領域。リングプロトコルでない場合、空き
+     *         スロットがない場合は nullptr
+     *
+     * @else
+     * @brief Loan the next free slot
+     *
+     * With the ring protocol the data area of the slot to be written
+     * next is returned. The caller writes the serialized data into it
+     * directly and publishes it to the reader with commit(). A slot
+     * that is not committed is not published and is loaned again by the
+     * next loan(). The shared memory grows if size exceeds a slot.
+     *
+     * @param size Size of the data to be written
+     * @return Data area of the slot, or nullptr without the ring
+     *         protocol or if no slot is free
+     *
+     * @endif
+     */
+    unsigned char* loan(::CORBA::ULongLong size);
+     /*!
+     * @if jp
+     * @brief 貸し出したスロットを読み込み側に公開する
+     *
+     * @param length スロットに書き込んだデータのサイズ
+     * @return false: リングプロトコルでない、またはスロットサイズを超
+     *         えている
+     *
+     * @else
+     * @brief Publish the loaned slot to the reader
+     *
+     * @param length Size of the data written into the slot
+     * @return false: not the ring protocol or the length exceeds the
+     *         slot size
+     *
+     * @endif
+     */
+    bool commit(::CORBA::ULongLong length);
      /*!
      * @if jp
      * @brief 通信先のCORBAインターフェースを登録する
@@ -264,7 +396,19 @@ namespace RTC
     ::OpenRTM::PortSharedMemory_var m_smInterface{OpenRTM::PortSharedMemory::_nil()};
     bool m_endian{true};
     coil::SharedMemory m_shmem;
-    
+
+ private:
+    void create_ring(::CORBA::ULongLong memory_size, const std::string& shm_address);
+    void grow_ring(::CORBA::ULongLong data_size);
+    void release_retired();
+    std::string ring_address(::CORBA::ULongLong generation) const;
+
+    unsigned long m_ring_length{0};
+    std::string m_ring_address;
+    // old generations kept by the writer until the reader leaves them
+    std::deque<coil::SharedMemory> m_retired;
+    ::CORBA::ULongLong m_failed_generation{0};
+
   };  // class SharedMemoryPort
 } // namespace RTC
 
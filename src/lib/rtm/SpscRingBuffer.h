@@ -0,0 +1,1035 @@
+﻿// -*- C++ -*-
+/*!
+ * @file SpscRingBuffer.h
+ * @brief Single-producer/single-consumer lock-free ring buffer
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ */
+
+#ifndef RTC_SPSCRINGBUFFER_H
+#define RTC_SPSCRINGBUFFER_H
+
+#include <mutex>
+#include <condition_variable>
+#include <coil/stringutil.h>
+
+#include <rtm/BufferBase.h>
+#include <rtm/BufferStatus.h>
+#include <rtm/RingBuffer.h>
+
+#include <atomic>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*!
+ * @if jp
+ * @namespace RTC
+ *
+ * @brief RTコンポーネント
+ *
+ * @else
+ *
+ * @namespace RTC
+ *
+ * @brief RT-Component
+ *
+ * @endif
+ */
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class SpscRingBuffer
+   * @brief 単一生産者/単一消費者用ロックフリーリングバッファ
+   *
+   * 書き込みスレッドと読み出しスレッドがそれぞれ1つだけであることを前提
+   * とするリングバッファ実装クラス。書き込み位置と読み出し位置を単調増加
+   * するアトミックカウンタで管理し、通常の write()/read() ではミューテッ
+   * クスを一切取得しない。buffer.write.full_policy/buffer.read.empty_policy
+   * に block が指定され、実際に待ちが発生する場合のみ条件変数を用いた
+   * 低速パスに入る。
+   *
+   * 物理的なスロット数はバッファ長 + 1 とし、overwrite ポリシーで書き込
+   * まれるデータが読み出し中のスロットを上書きしないようにしている。
+   * rptr()/get() は返した要素を次の advanceRptr() まで固定する。固定
+   * された要素を上書きすることになる overwrite の書き込みは、待たずに
+   * FULL を返して新しいデータを捨てる。
+   *
+   * 書き込み系関数 (wptr, advanceWptr, put, write) は単一のスレッドから、
+   * 読み出し系関数 (rptr, advanceRptr, get, read) は別の単一のスレッドか
+   * ら呼ばれなければならない。
+   *
+   * @param DataType バッファに格納するデータ型
+   *
+   * @since 2.1.0
+   *
+   * @else
+   * @class SpscRingBuffer
+   * @brief Single-producer/single-consumer lock-free ring buffer
+   *
+   * Ring buffer implementation for exactly one writer thread and one
+   * reader thread. The write and read positions are kept in
+   * monotonically increasing atomic counters, and write()/read() never
+   * take a mutex on the normal path. Only when "block" is given as
+   * buffer.write.full_policy/buffer.read.empty_policy and the caller
+   * actually has to wait, a slow path with a condition variable is
+   * used.
+   *
+   * The buffer holds length + 1 physical slots so that data written
+   * under the overwrite policy does not overwrite the slot that is
+   * being read. rptr()/get() pin the elements they return until the
+   * next advanceRptr(). A write under the overwrite policy which would
+   * overwrite a pinned element returns FULL without waiting, dropping
+   * the new data.
+   *
+   * Writer side functions (wptr, advanceWptr, put, write) must be called
+   * from a single thread, and reader side functions (rptr, advanceRptr,
+   * get, read) from another single thread.
+   *
+   * @param DataType Data type to store in the buffer
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  template <class DataType>
+  class SpscRingBuffer
+    : public BufferBase<DataType>
+  {
+  public:
+    /*!
+     * @if jp
+     *
+     * @brief コンストラクタ
+     *
+     * 指定されたバッファ長でバッファを初期化する。
+     *
+     * @param length バッファ長
+     *
+     * @else
+     *
+     * @brief Constructor
+     *
+     * Initialize the buffer by specified buffer length.
+     *
+     * @param length Buffer length
+     *
+     * @endif
+     */
+    explicit SpscRingBuffer(long int length = RINGBUFFER_DEFAULT_LENGTH)
+      : m_length(length), m_buffer(m_length + 1)
+    {
+      this->reset();
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief 仮想デストラクタ
+     *
+     * @else
+     *
+     * @brief Virtual destractor
+     *
+     * @endif
+     */
+    ~SpscRingBuffer() override;
+
+    /*!
+     * @if jp
+     * @brief バッファの設定
+     *
+     * coil::Properties で与えられるプロパティにより、
+     * バッファの設定を初期化する。
+     * 使用できるオプションは RingBuffer と同じ。
+     *
+     * @else
+     * @brief Set the buffer
+     *
+     * Initialize the buffer by the given coil::Properties.
+     * Available options are the same as RingBuffer.
+     *
+     * @endif
+     */
+    void init(const coil::Properties& prop) override
+    {
+      initLength(prop);
+      initWritePolicy(prop);
+      initReadPolicy(prop);
+    }
+
+    /*!
+     * @if jp
+     * @brief バッファ長を取得する
+     * @else
+     * @brief Get the buffer length
+     * @endif
+     */
+    size_t length() const override
+    {
+      return m_length;
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief バッファの長さをセットする
+     *
+     * バッファ長を設定する。読み書きのスレッドが動作していない状態で
+     * 呼び出さなければならない。
+     *
+     * @return OK: 正常終了
+     *
+     * @else
+     *
+     * @brief Set the buffer length
+     *
+     * This function must be called while no reader/writer thread is
+     * accessing the buffer.
+     *
+     * @return OK: Successful
+     *
+     * @endif
+     */
+    BufferStatus length(size_t n) override
+    {
+      m_buffer.resize(n + 1);
+      m_length = n;
+      this->reset();
+      return BufferStatus::OK;
+    }
+
+    /*!
+     * @if jp
+     * @brief バッファの状態をリセットする
+     * @else
+     * @brief Reset the buffer status
+     * @endif
+     */
+    BufferStatus reset() override
+    {
+      m_wcount.store(0);
+      m_rcount.store(0);
+      m_reading.store(npos);
+      m_peeking.store(false);
+      return BufferStatus::OK;
+    }
+
+    //----------------------------------------------------------------------
+    /*!
+     * @if jp
+     * @brief バッファの現在の書込み要素のポインタ
+     * @else
+     * @brief Get the pointer to the current writing element
+     * @endif
+     */
+    DataType* wptr(long int n = 0) override
+    {
+      return &m_buffer[slot(m_wcount.load(std::memory_order_relaxed), n)];
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief 書込みポインタを進める
+     *
+     * 現在の書き込み位置のポインタを n 個進める。書き込みスレッドからの
+     * み呼び出すことができる。
+     *
+     * @param  n 書込みポインタ + n の位置のポインタ
+     * @param  unlock_enable trueの場合にバッファエンプティのブロックを解除する
+     * @return OK:            正常終了
+     *         PRECONDITION_NOT_MET: n > writable()
+     *
+     * @else
+     *
+     * @brief Forward n writing pointers
+     *
+     * This function may be called only from the writer thread.
+     *
+     * @param  n Number of elements to forward
+     * @param  unlock_enable If true, unblock a reader waiting on empty
+     * @return OK:            Successful
+     *         PRECONDITION_NOT_MET: n > writable()
+     *
+     * @endif
+     */
+    BufferStatus advanceWptr(long int n = 1, bool unlock_enable = true) override
+    {
+      size_t r(m_rcount.load(std::memory_order_acquire));
+      size_t w(m_wcount.load(std::memory_order_relaxed));
+      long int fill(static_cast<long int>(w - r));
+      if ((n > 0 && n > static_cast<long int>(m_length) - fill) ||
+          (n < 0 && n < -fill))
+        {
+          return BufferStatus::PRECONDITION_NOT_MET;
+        }
+      m_wcount.store(w + static_cast<size_t>(n), std::memory_order_seq_cst);
+
+      if (unlock_enable && n > 0)
+        {
+          wakeup(m_empty);
+        }
+      return BufferStatus::OK;
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief バッファにデータを書き込む
+     *
+     * バッファにデータを書き込む。書き込みポインタの位置は変更されない。
+     *
+     * @param value 書き込み対象データ
+     * @return OK: 正常終了
+     *
+     * @else
+     *
+     * @brief Write data into the buffer
+     *
+     * The writing pointer is not advanced.
+     *
+     * @param value Target data to write.
+     * @return OK: Successful
+     *
+     * @endif
+     */
+    BufferStatus put(const DataType& value) override
+    {
+      size_t pos(slot(m_wcount.load(std::memory_order_relaxed)));
+      waitReader(pos);
+      m_buffer[pos] = value;
+      return BufferStatus::OK;
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief バッファに書き込む
+     *
+     * 引数で与えられたデータをバッファに書き込む。ポリシーの扱いは
+     * RingBuffer::write() と同じ。block モードで実際に待ちが必要な場合
+     * を除き、ロックは取得しない。
+     *
+     * @param value 書き込み対象データ
+     * @param timeout タイムアウト時間 nsec (default -1: 無効)
+     * @return OK            正常終了
+     *         FULL          バッファがフル状態
+     *         TIMEOUT              書込みがタイムアウトした
+     *         PRECONDITION_NOT_MET 設定異常
+     *
+     * @else
+     *
+     * @brief Write data into the buffer
+     *
+     * Write data which is given argument into the buffer. Policies are
+     * handled as RingBuffer::write() does. No lock is taken unless the
+     * caller has to block in the "block" mode.
+     *
+     * @param value Target data for writing
+     * @param timeout Timeout in nsec (default -1: disabled)
+     * @return OK            Successful
+     *         FULL          Buffer is full
+     *         TIMEOUT       Writing timed out
+     *         PRECONDITION_NOT_MET Invalid configuration
+     *
+     * @endif
+     */
+    BufferStatus write(const DataType& value,
+                       std::chrono::nanoseconds timeout
+                       = std::chrono::nanoseconds(-1)) override
+    {
+      BufferWriteInfo info;
+      return write(value, timeout, info);
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief バッファに書き込み、上書き数と読み出し可能数を返す
+     *
+     * write(value, timeout) と同じ。上書きの有無は最古の要素を捨てたか
+     * どうかで判定し、ロックは取得しない。
+     *
+     * @param value 書き込み対象データ
+     * @param timeout タイムアウト時間 nsec (-1: 無効)
+     * @param info 上書き数と読み出し可能数を格納する
+     * @return write(value, timeout) と同じ
+     *
+     * @else
+     *
+     * @brief Write into the buffer and return the overwritten and
+     *        readable numbers
+     *
+     * The same as write(value, timeout). Whether the data was
+     * overwritten is determined by whether the oldest element was
+     * dropped, and no lock is taken.
+     *
+     * @param value Target data for writing
+     * @param timeout Timeout in nsec (-1: disabled)
+     * @param info The overwritten and readable numbers are stored
+     * @return The same as write(value, timeout)
+     *
+     * @endif
+     */
+    BufferStatus write(const DataType& value,
+                       std::chrono::nanoseconds timeout,
+                       BufferWriteInfo& info) override
+    {
+      info = BufferWriteInfo();
+      if (full())
+        {
+          bool timedwrite(m_timedwrite);
+          bool overwrite(m_overwrite);
+
+          if (timeout >= std::chrono::seconds::zero())  // block mode
+            {
+              timedwrite = true;
+              overwrite  = false;
+            }
+
+          if (overwrite && !timedwrite)  // "overwrite" mode
+            {
+              BufferStatus ret(overwriteOldest(value, info.overwritten));
+              info.readable = fillcount();
+              return ret;
+            }
+          else if (!overwrite && !timedwrite)  // "do_nothing" mode
+            {
+              return BufferStatus::FULL;
+            }
+          else if (!overwrite && timedwrite)  // "block" mode
+            {
+              if (timeout < std::chrono::seconds::zero())
+                {
+                  timeout = m_wtimeout;
+                }
+              if (!waitFor(m_full, timeout, [this] { return !full(); }))
+                {
+                  return BufferStatus::TIMEOUT;
+                }
+            }
+          else                                    // unknown condition
+            {
+              return BufferStatus::PRECONDITION_NOT_MET;
+            }
+        }
+
+      put(value);
+
+      advanceWptr(1);
+      info.readable = fillcount();
+
+      return BufferStatus::OK;
+    }
+
+    /*!
+     * @if jp
+     * @brief バッファに書込み可能な要素数
+     * @else
+     * @brief Get a writable number
+     * @endif
+     */
+    size_t writable() const override
+    {
+      return m_length - fillcount();
+    }
+
+    /*!
+     * @if jp
+     * @brief バッファfullチェック
+     * @else
+     * @brief Check on whether the buffer is full.
+     * @endif
+     */
+    bool full() const override
+    {
+      return fillcount() == m_length;
+    }
+
+    //----------------------------------------------------------------------
+    /*!
+     * @if jp
+     * @brief バッファの現在の読み出し要素のポインタ
+     * @else
+     * @brief Get the pointer to the current reading element
+     * @endif
+     */
+    DataType* rptr(long int n = 0) override
+    {
+      return &(m_buffer[slot(pin(), n)]);
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief 読み出しポインタを進める
+     *
+     * 現在の読み出し位置のポインタを n 個進める。読み出しスレッドからの
+     * み呼び出すことができる。rptr()/get() で要素を固定している場合は
+     * 固定した要素から数え、固定を解除する。その間に書き込み側が捨てた
+     * 要素は二重に進めない。
+     *
+     * @param  n 読み出しポインタ + n の位置のポインタ
+     * @param  unlock_enable trueの場合にバッファフルのブロックを解除する
+     * @return OK: 正常終了
+     *         PRECONDITION_NOT_MET: n が読み出し可能な範囲外
+     *
+     * @else
+     *
+     * @brief Forward n reading pointers
+     *
+     * This function may be called only from the reader thread. If
+     * rptr()/get() have pinned an element, n is counted from it and the
+     * pin is released. The elements dropped by the writer meanwhile are
+     * not skipped twice.
+     *
+     * @param  n Number of elements to forward
+     * @param  unlock_enable If true, unblock a writer waiting on full
+     * @return OK: Successful
+     *         PRECONDITION_NOT_MET: n is out of the readable range
+     *
+     * @endif
+     */
+    BufferStatus advanceRptr(long int n = 1, bool unlock_enable = true) override
+    {
+      size_t pinned(m_reading.load(std::memory_order_relaxed));
+      size_t r(m_rcount.load(std::memory_order_acquire));
+      for (;;)
+        {
+          size_t base(pinned != npos ? pinned : r);
+          size_t w(m_wcount.load(std::memory_order_acquire));
+          long int fill(static_cast<long int>(w - base));
+          if ((n > 0 && n > fill) ||
+              (n < 0 && n < fill - static_cast<long int>(m_length)))
+            {
+              unpin();
+              return BufferStatus::PRECONDITION_NOT_MET;
+            }
+          size_t target(base + static_cast<size_t>(n));
+          // the writer may have dropped the pinned elements meanwhile
+          if (pinned != npos && static_cast<long int>(target - r) < 0)
+            {
+              target = r;
+            }
+          if (m_rcount.compare_exchange_weak(r, target))
+            {
+              break;
+            }
+        }
+      unpin();
+
+      if (unlock_enable && n > 0)
+        {
+          wakeup(m_full);
+        }
+      return BufferStatus::OK;
+    }
+
+    /*!
+     * @if jp
+     * @brief バッファからデータを読み出す
+     *
+     * 読み出しポインタの位置は変更されない。
+     *
+     * @else
+     * @brief Read data from the buffer
+     *
+     * The reading pointer is not advanced.
+     *
+     * @endif
+     */
+    BufferStatus get(DataType& value) override
+    {
+      value = m_buffer[slot(pin())];
+      return BufferStatus::OK;
+    }
+
+    /*!
+     * @if jp
+     * @brief バッファからデータを読み出す
+     * @else
+     * @brief Reading data from the buffer
+     * @endif
+     */
+    DataType& get() override
+    {
+      return m_buffer[slot(pin())];
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief バッファから読み出す
+     *
+     * バッファに格納されたデータを読み出す。ポリシーの扱いは
+     * RingBuffer::read() と同じ。block モードで実際に待ちが必要な場合
+     * を除き、ロックは取得しない。
+     *
+     * @param value 読み出し対象データ
+     * @param timeout タイムアウト時間 (default -1: 無効)
+     * @return OK            正常終了
+     *         EMPTY         バッファが空状態
+     *         TIMEOUT              読み出しがタイムアウトした
+     *         PRECONDITION_NOT_MET 設定異常
+     *
+     * @else
+     *
+     * @brief Readout data from the buffer
+     *
+     * Policies are handled as RingBuffer::read() does. No lock is taken
+     * unless the caller has to block in the "block" mode.
+     *
+     * @param value Readout data
+     * @param timeout Timeout (default -1: disabled)
+     * @return OK            Successful
+     *         EMPTY         Buffer is empty
+     *         TIMEOUT       Reading timed out
+     *         PRECONDITION_NOT_MET Invalid configuration
+     *
+     * @endif
+     */
+    BufferStatus read(DataType& value,
+                      std::chrono::nanoseconds timeout
+                      = std::chrono::nanoseconds(-1)) override
+    {
+      if (empty())
+        {
+          bool timedread(m_timedread);
+          bool readback(m_readback);
+
+          if (timeout >= std::chrono::seconds::zero()) // block mode
+            {
+              timedread = true;
+              readback  = false;
+            }
+
+          if (readback && !timedread)       // "readback" mode
+            {
+              if (!(m_wcount.load(std::memory_order_acquire) > 0))
+                {
+                  return BufferStatus::EMPTY;
+                }
+              advanceRptr(-1, false);
+            }
+          else if (!readback && !timedread)  // "do_nothing" mode
+            {
+              return BufferStatus::EMPTY;
+            }
+          else if (!readback && timedread)  // "block" mode
+            {
+              if (timeout < std::chrono::seconds::zero())
+                {
+                  timeout = m_rtimeout;
+                }
+              if (!waitFor(m_empty, timeout, [this] { return !empty(); }))
+                {
+                  return BufferStatus::TIMEOUT;
+                }
+            }
+          else                                    // unknown condition
+            {
+              return BufferStatus::PRECONDITION_NOT_MET;
+            }
+        }
+
+      unpin();
+      for (;;)
+        {
+          size_t r(m_rcount.load(std::memory_order_acquire));
+          if (m_wcount.load(std::memory_order_acquire) == r)
+            {
+              return BufferStatus::EMPTY;
+            }
+          // Announce the slot to the writer, then make sure that it has
+          // not been dropped by an overwrite in the meantime.
+          m_reading.store(r, std::memory_order_seq_cst);
+          if (m_rcount.load(std::memory_order_seq_cst) != r)
+            {
+              m_reading.store(npos, std::memory_order_release);
+              continue;
+            }
+          value = m_buffer[slot(r)];
+          m_reading.store(npos, std::memory_order_release);
+          // If the writer dropped this element while it was being
+          // copied, the copy is still consistent and the read position
+          // has already moved past it.
+          m_rcount.compare_exchange_strong(r, r + 1);
+          break;
+        }
+
+      wakeup(m_full);
+
+      return BufferStatus::OK;
+    }
+
+    /*!
+     * @if jp
+     * @brief バッファから読み出し可能な要素数
+     * @else
+     * @brief Get a readable number
+     * @endif
+     */
+    size_t readable() const override
+    {
+      return fillcount();
+    }
+
+    /*!
+     * @if jp
+     * @brief バッファemptyチェック
+     * @else
+     * @brief Check on whether the buffer is empty.
+     * @endif
+     */
+    bool empty() const override
+    {
+      return fillcount() == 0;
+    }
+
+  private:
+    /*!
+     * @if jp
+     * @brief 条件変数構造体
+     *
+     * block ポリシーの低速パスでのみ使用される。
+     *
+     * @else
+     * @brief struct for condition variable
+     *
+     * Used only in the slow path of the block policy.
+     *
+     * @endif
+     */
+    struct condition
+    {
+      condition() {}
+      std::condition_variable cond;
+      std::mutex mutex;
+      std::atomic<int> waiters{0};
+    };
+
+    size_t slot(size_t count, long int n = 0) const
+    {
+      const size_t len(m_length + 1);
+      const long int off(n % static_cast<long int>(len));
+      return (count % len + static_cast<size_t>(off + static_cast<long int>(len))) % len;
+    }
+
+    size_t fillcount() const
+    {
+      // The read counter must be loaded first so that w >= r holds.
+      size_t r(m_rcount.load(std::memory_order_seq_cst));
+      size_t w(m_wcount.load(std::memory_order_seq_cst));
+      size_t fill(w - r);
+      return fill < m_length ? fill : m_length;
+    }
+
+    void waitReader(size_t pos) const
+    {
+      for (;;)
+        {
+          size_t reading(m_reading.load(std::memory_order_seq_cst));
+          if (reading == npos || slot(reading) != pos) { return; }
+          std::this_thread::yield();
+        }
+    }
+
+    /*!
+     * @if jp
+     * @brief rptr()/get() で読み出し位置の要素を固定する
+     * @return 固定した要素のカウント
+     * @else
+     * @brief Pin the element at the read position for rptr()/get()
+     * @return Counter of the pinned element
+     * @endif
+     */
+    size_t pin()
+    {
+      size_t pinned(m_reading.load(std::memory_order_relaxed));
+      if (pinned != npos) { return pinned; }
+      // set before m_reading, so that the writer seeing the pin sees it
+      m_peeking.store(true, std::memory_order_seq_cst);
+      for (;;)
+        {
+          size_t r(m_rcount.load(std::memory_order_acquire));
+          m_reading.store(r, std::memory_order_seq_cst);
+          // as read() does, make sure that it has not been dropped
+          if (m_rcount.load(std::memory_order_seq_cst) == r) { return r; }
+        }
+    }
+
+    void unpin()
+    {
+      m_reading.store(npos, std::memory_order_release);
+      m_peeking.store(false, std::memory_order_release);
+    }
+
+    BufferStatus overwriteOldest(const DataType& value, size_t& overwritten)
+    {
+      // The caller of rptr()/get() may hold the pinned elements for long,
+      // e.g. while sending them, so the new element is dropped instead of
+      // waiting for it.
+      size_t reading(m_reading.load(std::memory_order_seq_cst));
+      if (reading != npos &&
+          m_wcount.load(std::memory_order_relaxed) - reading > m_length &&
+          m_peeking.load(std::memory_order_seq_cst))
+        {
+          return BufferStatus::FULL;
+        }
+      // There is one spare slot beyond the buffer length, so the new
+      // element is stored first and the oldest one is dropped afterwards.
+      put(value);
+      size_t w(m_wcount.load(std::memory_order_relaxed) + 1);
+      m_wcount.store(w, std::memory_order_seq_cst);
+      size_t r(m_rcount.load(std::memory_order_acquire));
+      while (w - r > m_length)
+        {
+          if (m_rcount.compare_exchange_weak(r, r + 1))
+            {
+              overwritten = 1;
+              break;
+            }
+        }
+      return BufferStatus::OK;
+    }
+
+    template <class Predicate>
+    bool waitFor(condition& cond, std::chrono::nanoseconds timeout,
+                 Predicate pred)
+    {
+      std::unique_lock<std::mutex> guard(cond.mutex);
+      cond.waiters.fetch_add(1, std::memory_order_seq_cst);
+      bool ret(cond.cond.wait_for(guard, timeout, pred));
+      cond.waiters.fetch_sub(1, std::memory_order_relaxed);
+      return ret;
+    }
+
+    static void wakeup(condition& cond)
+    {
+      if (cond.waiters.load(std::memory_order_seq_cst) > 0)
+        {
+          std::lock_guard<std::mutex> guard(cond.mutex);
+          cond.cond.notify_one();
+        }
+    }
+
+    void initLength(const coil::Properties& prop)
+    {
+      if (!prop["length"].empty())
+        {
+          size_t n;
+          if (coil::stringTo(n, prop["length"].c_str()))
+            {
+              if (n > 0)
+                {
+                  this->length(n);
+                }
+            }
+        }
+    }
+
+    void initWritePolicy(const coil::Properties& prop)
+    {
+      std::string policy(coil::normalize(prop["write.full_policy"]));
+      if (policy == "overwrite")
+        {
+          m_overwrite = true;
+          m_timedwrite = false;
+        }
+      else if (policy == "do_nothing")
+        {
+          m_overwrite = false;
+          m_timedwrite = false;
+        }
+      else if (policy == "block")
+        {
+          m_overwrite = false;
+          m_timedwrite = true;
+
+          std::chrono::nanoseconds tm;
+          if (coil::stringTo(tm, prop["write.timeout"].c_str())
+              && !(tm < std::chrono::seconds::zero()))
+            {
+              m_wtimeout = tm;
+            }
+        }
+    }
+
+    void initReadPolicy(const coil::Properties& prop)
+    {
+      std::string policy(coil::normalize(prop["read.empty_policy"]));
+      if (policy == "readback")
+        {
+          m_readback = true;
+          m_timedread = false;
+        }
+      else if (policy == "do_nothing")
+        {
+          m_readback = false;
+          m_timedread = false;
+        }
+      else if (policy == "block")
+        {
+          m_readback = false;
+          m_timedread = true;
+          std::chrono::nanoseconds tm;
+          if (coil::stringTo(tm, prop["read.timeout"].c_str()))
+            {
+              m_rtimeout = tm;
+            }
+        }
+    }
+
+  private:
+    static constexpr size_t npos = (std::numeric_limits<size_t>::max)();
+
+    /*!
+     * @if jp
+     * @brief 上書きフラグ
+     * @else
+     * @brief Overwrite flag
+     * @endif
+     */
+    bool m_overwrite{true};
+
+    /*!
+     * @if jp
+     * @brief 読み戻しフラグ
+     * @else
+     * @brief Readback flag
+     * @endif
+     */
+    bool m_readback{true};
+
+    /*!
+     * @if jp
+     * @brief タイムアウト付き書き込みフラグ
+     * @else
+     * @brief Timedwrite flag
+     * @endif
+     */
+    bool m_timedwrite{false};
+
+    /*!
+     * @if jp
+     * @brief タイムアウト付き読み出しフラグ
+     * @else
+     * @brief Timedread flag
+     * @endif
+     */
+    bool m_timedread{false};
+
+    /*!
+     * @if jp
+     * @brief 書き込み時タイムアウト
+     * @else
+     * @brief Timeout time for writing
+     * @endif
+     */
+    std::chrono::nanoseconds m_wtimeout{std::chrono::seconds(1)};
+
+    /*!
+     * @if jp
+     * @brief 読み出し時タイムアウト
+     * @else
+     * @brief Timeout time of reading
+     * @endif
+     */
+    std::chrono::nanoseconds m_rtimeout{std::chrono::seconds(1)};
+
+    /*!
+     * @if jp
+     * @brief バッファ長
+     * @else
+     * @brief Buffer length
+     * @endif
+     */
+    size_t m_length;
+
+    /*!
+     * @if jp
+     * @brief 書き込みカウント (書き込みスレッドのみが更新する)
+     * @else
+     * @brief Counter for writing (updated only by the writer thread)
+     * @endif
+     */
+    std::atomic<size_t> m_wcount{0};
+
+    /*!
+     * @if jp
+     * @brief 読み出しカウント
+     *
+     * 読み出しスレッドが更新するが、overwrite ポリシーでは書き込みスレッ
+     * ドが最古の要素を捨てるために CAS で進めることがある。
+     *
+     * @else
+     * @brief Counter for reading
+     *
+     * Updated by the reader thread. Under the overwrite policy the writer
+     * thread may also advance it by CAS to drop the oldest element.
+     *
+     * @endif
+     */
+    std::atomic<size_t> m_rcount{0};
+
+    /*!
+     * @if jp
+     * @brief read() がコピー中、または rptr()/get() が固定した要素のカウ
+     *        ント (npos: なし)
+     * @else
+     * @brief Counter of the element being copied by read() or pinned by
+     *        rptr()/get() (npos: none)
+     * @endif
+     */
+    std::atomic<size_t> m_reading{npos};
+
+    /*!
+     * @if jp
+     * @brief m_reading が rptr()/get() による固定か
+     * @else
+     * @brief Whether m_reading is pinned by rptr()/get()
+     * @endif
+     */
+    std::atomic<bool> m_peeking{false};
+
+    /*!
+     * @if jp
+     * @brief バッファ配列
+     * @else
+     * @brief baffer array
+     * @endif
+     */
+    std::vector<DataType> m_buffer;
+
+    /*!
+     * @if jp
+     * @brief 空条件変数
+     * @else
+     * @brief empty condition variable
+     * @endif
+     */
+    condition m_empty;
+
+    /*!
+     * @if jp
+     * @brief 満杯条件変数
+     * @else
+     * @brief full condition variable
+     * @endif
+     */
+    condition m_full;
+  };
+
+  template <class T> SpscRingBuffer<T>::~SpscRingBuffer() = default; // no-inline because of its size.
+} // namespace RTC
+
+#endif  // RTC_SPSCRINGBUFFER_H
@@ -16,6 +16,7 @@
  *
  */
 #include <rtm/SystemLogger.h>
+#include <rtm/AsyncLogWriter.h>
 #include <rtm/Manager.h>
 
 #include <sstream>
@@ -85,7 +86,6 @@ namespace RTC
     : ::coil::LogStream(streambuf,
                         RTL_SILENT, RTL_PARANOID,  RTL_SILENT)
   {
-    setDateFormat(m_dateFormat.c_str());
   }
 
   Logger::~Logger() = default;
@@ -111,12 +111,7 @@ namespace RTC
    */
   void Logger::setDateFormat(const char* format)
   {
-    std::string fmt(format);
-    m_msEnable = std::string::npos != fmt.find("%Q");
-    m_usEnable = std::string::npos != fmt.find("%q");
-    if (m_msEnable){ fmt = coil::replaceString(std::move(fmt), "%Q", "#m#"); }
-    if (m_usEnable){ fmt = coil::replaceString(std::move(fmt), "%q", "#u#"); }
-    m_dateFormat = std::move(fmt);
+    m_dateFormat = std::make_shared<const DateFormat>(format);
   }
 
   void Logger::setClockType(const std::string& clocktype)
@@ -145,9 +140,36 @@ namespace RTC
    * @endif
    */
   std::string Logger::getDate()
+  {
+    return m_dateFormat->format(m_clock->gettime());
+  }
+
+  /*!
+   * @if jp
+   * @brief 日時フォーマットを解析する
+   * @else
+   * @brief Parse the date format
+   * @endif
+   */
+  Logger::DateFormat::DateFormat(const char* format)
+    : m_format(format)
+  {
+    m_msEnable = std::string::npos != m_format.find("%Q");
+    m_usEnable = std::string::npos != m_format.find("%q");
+    if (m_msEnable){ m_format = coil::replaceString(std::move(m_format), "%Q", "#m#"); }
+    if (m_usEnable){ m_format = coil::replaceString(std::move(m_format), "%q", "#u#"); }
+  }
+
+  /*!
+   * @if jp
+   * @brief 時刻を日時文字列に変換する
+   * @else
+   * @brief Convert the time to the date string
+   * @endif
+   */
+  std::string Logger::DateFormat::format(std::chrono::nanoseconds tm) const
   {
     char buf[MAXSIZE];
-    auto tm = m_clock->gettime();
     auto sec = std::chrono::duration_cast<std::chrono::seconds>(tm);
 
     time_t timer = sec.count();
@@ -158,7 +180,7 @@ namespace RTC
     {
         return std::string();
     }
-    strftime(buf, sizeof(buf), m_dateFormat.c_str(), &date);
+    strftime(buf, sizeof(buf), m_format.c_str(), &date);
 #else
     struct tm* date;
     date = gmtime(&timer);
@@ -166,7 +188,7 @@ namespace RTC
 #pragma GCC diagnostic ignored "-Wformat-nonliteral"
     // The format parameter is not literal, as it allows the user to change the format.
     // Therefore, we have controlled -Wformat-nonliteral with pragma.
-    strftime(buf, sizeof(buf), m_dateFormat.c_str(), date);
+    strftime(buf, sizeof(buf), m_format.c_str(), date);
 #pragma GCC diagnostic pop
 #endif
 
@@ -249,6 +271,12 @@ namespace RTC
   {
       if (ostream_type != nullptr)
       {
+          if (AsyncLogWriter::instance().push(ostream_type, level, m_name,
+                                              m_dateFormat,
+                                              m_clock->gettime(), mes))
+          {
+              return;
+          }
           std::string date = getDate();
           ostream_type->write(level, m_name, date, mes);
       }
@@ -282,7 +310,7 @@ namespace RTC
           std::vector<std::string> vec(prop);
           for (auto & str : vec)
           {
-              ostream_type->write(level, m_name, getDate(), str);
+              write(level, str);
           }
       }
   }
@@ -27,6 +27,8 @@
 #include <coil/stringutil.h>
 #include <coil/Properties.h>
 
+#include <chrono>
+#include <memory>
 #include <string>
 
 namespace RTC
@@ -114,6 +116,36 @@ namespace RTC
                       //     DEBUG, TRACE, VERBOSE, PARA)
       };
 
+    /*!
+     * @if jp
+     * @class DateFormat
+     * @brief ログヘッダの日時フォーマット
+     *
+     * setDateFormat() で指定した書式を解析した結果を保持し、時刻を日時
+     * 文字列に変換する。非同期出力ではログレコードと共に出力スレッドへ
+     * 渡される。
+     *
+     * @else
+     * @class DateFormat
+     * @brief Date format of the log header
+     *
+     * Holds the format given by setDateFormat() and converts a time to
+     * the date string. In the asynchronous output it is passed to the
+     * output thread with the log record.
+     *
+     * @endif
+     */
+    class DateFormat
+    {
+    public:
+      explicit DateFormat(const char* format);
+      std::string format(std::chrono::nanoseconds tm) const;
+    private:
+      std::string m_format;
+      bool m_msEnable{false};
+      bool m_usEnable{false};
+    };
+
     /*!
      * @if jp
      * @brief コンストラクタ
@@ -495,7 +527,8 @@ namespace RTC
 
   private:
     std::string m_name = "unknown";
-    std::string m_dateFormat = "%b %d %H:%M:%S.%Q";
+    std::shared_ptr<const DateFormat> m_dateFormat{
+      std::make_shared<const DateFormat>("%b %d %H:%M:%S.%Q")};
     coil::IClock* m_clock{&coil::ClockManager::instance().getClock("system")};
 
 #if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
@@ -513,8 +546,6 @@ namespace RTC
     static const char* const m_levelOutputString[];
     static const char* const m_levelColor[];
 #endif
-    bool m_msEnable{false};
-    bool m_usEnable{false};
   };
 
 
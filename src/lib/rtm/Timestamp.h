@@ -65,7 +65,7 @@ namespace RTC
     ~Timestamp() override = default;
     ReturnCode operator()(ConnectorInfo& info, DataType& data) override
     {
-      if (info.properties["timestamp_policy"] != m_tstype)
+      if (info.settings().timestamp_policy != m_tstype)
         {
           return NO_CHANGE;
         }
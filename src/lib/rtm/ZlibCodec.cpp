@@ -0,0 +1,67 @@
+// -*- C++ -*-
+/*!
+ * @file ZlibCodec.cpp
+ * @brief zlib compression codec
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <rtm/ZlibCodec.h>
+#include <coil/stringutil.h>
+
+#include <zlib.h>
+
+namespace RTC
+{
+  void ZlibCodec::init(const coil::Properties& prop)
+  {
+    std::string level(prop.getProperty("level"));
+    if (level.empty() || !coil::stringTo(m_level, level.c_str()) ||
+        m_level < 0 || m_level > 9)
+      {
+        m_level = Z_DEFAULT_COMPRESSION;
+      }
+  }
+
+  unsigned long ZlibCodec::compressBound(unsigned long length)
+  {
+    return ::compressBound(length);
+  }
+
+  bool ZlibCodec::compress(const unsigned char* src, unsigned long srclen,
+                           unsigned char* dst, unsigned long& dstlen)
+  {
+    uLongf len(dstlen);
+    if (::compress2(dst, &len, src, srclen, m_level) != Z_OK) { return false; }
+    dstlen = len;
+    return true;
+  }
+
+  bool ZlibCodec::decompress(const unsigned char* src, unsigned long srclen,
+                             unsigned char* dst, unsigned long dstlen)
+  {
+    uLongf len(dstlen);
+    return ::uncompress(dst, &len, src, srclen) == Z_OK && len == dstlen;
+  }
+} // namespace RTC
+
+extern "C"
+{
+  void ZlibCodecInit()
+  {
+    ::RTC::CompressionCodecFactory::
+      instance().addFactory("zlib",
+                            ::coil::Creator< ::RTC::CompressionCodec,
+                                             ::RTC::ZlibCodec>,
+                            ::coil::Destructor< ::RTC::CompressionCodec,
+                                                ::RTC::ZlibCodec>);
+  }
+}
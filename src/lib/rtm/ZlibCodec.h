@@ -0,0 +1,64 @@
+// -*- C++ -*-
+/*!
+ * @file ZlibCodec.h
+ * @brief zlib compression codec
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_ZLIBCODEC_H
+#define RTC_ZLIBCODEC_H
+
+#include <rtm/CompressionCodec.h>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class ZlibCodec
+   * @brief zlib 圧縮コーデック
+   *
+   * コーデック名は "zlib"。圧縮レベルは serializer.zlib.level (0-9、
+   * デフォルトは zlib の既定値) で指定する。
+   *
+   * @else
+   * @class ZlibCodec
+   * @brief zlib compression codec
+   *
+   * The codec name is "zlib". The compression level is given by
+   * serializer.zlib.level (0-9, zlib's default by default).
+   *
+   * @endif
+   */
+  class ZlibCodec : public CompressionCodec
+  {
+  public:
+    ZlibCodec() = default;
+    ~ZlibCodec() override = default;
+
+    void init(const coil::Properties& prop) override;
+    unsigned long compressBound(unsigned long length) override;
+    bool compress(const unsigned char* src, unsigned long srclen,
+                  unsigned char* dst, unsigned long& dstlen) override;
+    bool decompress(const unsigned char* src, unsigned long srclen,
+                    unsigned char* dst, unsigned long dstlen) override;
+
+  private:
+    int m_level{-1};
+  };
+} // namespace RTC
+
+extern "C"
+{
+  void ZlibCodecInit();
+}
+
+#endif  // RTC_ZLIBCODEC_H
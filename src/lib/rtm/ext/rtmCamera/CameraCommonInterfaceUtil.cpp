@@ -20,6 +20,7 @@
 
 
 #include "InterfaceDataTypesUtil.h"
+#include <rtm/CdrViewReader.h>
 #include <cstring>
 
 namespace CORBA_Util
@@ -55,5 +56,61 @@ namespace CORBA_Util
     copyData(data1.data, data2.data);
     data1.error_code = data2.error_code;
   }
+  template <>
+  bool deserializeView(RTC::CdrViewReader& cdr, Img::ImageData& data)
+  {
+#ifndef ORB_IS_RTORB
+    CORBA::ULong format(0);
+    const CORBA::Octet* buffer(nullptr);
+    uint32_t length(0);
+    if (!cdr.read(data.width) || !cdr.read(data.height) ||
+        !cdr.read(format) || format > static_cast<CORBA::ULong>(Img::Y16) ||
+        !cdr.readSequence(buffer, length))
+    {
+        return false;
+    }
+    data.format = static_cast<Img::ColorFormat>(format);
+    data.raw_data.replace(length, length, const_cast<CORBA::Octet*>(buffer), false);
+    return true;
+#else
+    (void)cdr;
+    (void)data;
+    return false;
+#endif
+  }
+  template <>
+  bool deserializeView(RTC::CdrViewReader& cdr, Img::CameraImage& data)
+  {
+    if (!cdr.read(data.captured_time.sec) || !cdr.read(data.captured_time.nsec) ||
+        !deserializeView(cdr, data.image))
+    {
+        return false;
+    }
+    for (_CORBA_ULong i = 0; i < 5; i++) {
+        if (!cdr.read(data.intrinsic.matrix_element[i])) { return false; }
+    }
+    // the distortion coefficients are few and copied
+    CORBA::ULong length(0);
+    if (!cdr.read(length) || length > cdr.remaining() / sizeof(CORBA::Double))
+    {
+        return false;
+    }
+    data.intrinsic.distortion_coefficient.length(length);
+    for (_CORBA_ULong i = 0; i < length; i++) {
+        if (!cdr.read(data.intrinsic.distortion_coefficient[i])) { return false; }
+    }
+    for (_CORBA_ULong i = 0; i < 4; i++) {
+        for (_CORBA_ULong j = 0; j < 4; j++) {
+            if (!cdr.read(data.extrinsic[i][j])) { return false; }
+        }
+    }
+    return true;
+  }
+  template <>
+  bool deserializeView(RTC::CdrViewReader& cdr, Img::TimedCameraImage& data)
+  {
+    return cdr.read(data.tm.sec) && cdr.read(data.tm.nsec) &&
+           deserializeView(cdr, data.data) && cdr.read(data.error_code);
+  }
 } // namespace CORBA_Util
 
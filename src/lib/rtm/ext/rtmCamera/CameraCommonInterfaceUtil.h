@@ -31,6 +31,12 @@ namespace CORBA_Util
   void copyData(Img::CameraImage& data1, const Img::CameraImage& data2);
   template <>
   void copyData(Img::TimedCameraImage& data1, const Img::TimedCameraImage& data2);
+  template <>
+  bool deserializeView(RTC::CdrViewReader& cdr, Img::ImageData& data);
+  template <>
+  bool deserializeView(RTC::CdrViewReader& cdr, Img::CameraImage& data);
+  template <>
+  bool deserializeView(RTC::CdrViewReader& cdr, Img::TimedCameraImage& data);
 } // namespace CORBA_Util
 
 
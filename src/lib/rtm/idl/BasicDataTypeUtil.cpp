@@ -20,6 +20,7 @@
 
 
 #include "BasicDataTypeUtil.h"
+#include <rtm/CdrViewReader.h>
 #include <cstring>
 
 namespace CORBA_Util
@@ -34,5 +35,24 @@ namespace CORBA_Util
         std::memcpy(&data1.data[0], &data2.data[0], data1.data.length());
     }
   }
+  template <>
+  bool deserializeView(RTC::CdrViewReader& cdr, RTC::TimedOctetSeq& data)
+  {
+#ifndef ORB_IS_RTORB
+    const CORBA::Octet* buffer(nullptr);
+    uint32_t length(0);
+    if (!cdr.read(data.tm.sec) || !cdr.read(data.tm.nsec) ||
+        !cdr.readSequence(buffer, length))
+    {
+        return false;
+    }
+    data.data.replace(length, length, const_cast<CORBA::Octet*>(buffer), false);
+    return true;
+#else
+    (void)cdr;
+    (void)data;
+    return false;
+#endif
+  }
 } // namespace CORBA_Util
 
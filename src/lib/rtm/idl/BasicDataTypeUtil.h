@@ -27,6 +27,8 @@ namespace CORBA_Util
 {
   template <>
   void copyData(RTC::TimedOctetSeq& data1, const RTC::TimedOctetSeq& data2);
+  template <>
+  bool deserializeView(RTC::CdrViewReader& cdr, RTC::TimedOctetSeq& data);
 } // namespace CORBA_Util
 
 
@@ -20,6 +20,7 @@
 
 
 #include "InterfaceDataTypesUtil.h"
+#include <rtm/CdrViewReader.h>
 #include <cstring>
 
 namespace CORBA_Util
@@ -38,5 +39,28 @@ namespace CORBA_Util
         std::memcpy(&data1.pixels[0], &data2.pixels[0], data1.pixels.length());
     }
   }
+  template <>
+  bool deserializeView(RTC::CdrViewReader& cdr, RTC::CameraImage& data)
+  {
+#ifndef ORB_IS_RTORB
+    const char* format(nullptr);
+    const CORBA::Octet* buffer(nullptr);
+    uint32_t length(0);
+    if (!cdr.read(data.tm.sec) || !cdr.read(data.tm.nsec) ||
+        !cdr.read(data.width) || !cdr.read(data.height) ||
+        !cdr.read(data.bpp) || !cdr.readString(format) ||
+        !cdr.read(data.fDiv) || !cdr.readSequence(buffer, length))
+    {
+        return false;
+    }
+    data.format = format;
+    data.pixels.replace(length, length, const_cast<CORBA::Octet*>(buffer), false);
+    return true;
+#else
+    (void)cdr;
+    (void)data;
+    return false;
+#endif
+  }
 } // namespace CORBA_Util
 
@@ -27,6 +27,8 @@ namespace CORBA_Util
 {
   template <>
   void copyData(RTC::CameraImage& data1, const RTC::CameraImage& data2);
+  template <>
+  bool deserializeView(RTC::CdrViewReader& cdr, RTC::CameraImage& data);
 } // namespace CORBA_Util
 
 